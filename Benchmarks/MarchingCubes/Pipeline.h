@@ -24,6 +24,7 @@
 #include <dax/cont/UnstructuredGrid.h>
 #include <dax/cont/VectorOperations.h>
 
+#include <dax/worklet/FlyingEdges.h>
 #include <dax/worklet/Magnitude.h>
 #include <dax/worklet/MarchingCubes.h>
 
@@ -47,8 +48,42 @@ void PrintResults(int pipeline, double time)
             << pipeline << "," << time << std::endl;
 }
 
+void RunFlyingEdgesPipeline(const dax::cont::UniformGrid<> &grid,
+                            dax::cont::ArrayHandle<dax::Scalar> field)
+{
+  std::cout << "Running pipeline 3: Magnitude -> FlyingEdges" << std::endl;
+
+  dax::cont::UnstructuredGrid<dax::CellTagTriangle> outGrid;
+  dax::cont::Scheduler<> schedule;
+
+  dax::cont::Timer<> timer;
+
+  //flying edges makes the merged points directly, so this is compared
+  //with pipeline 2
+  schedule.Invoke(dax::worklet::FlyingEdges(ISOVALUE),
+                  grid, outGrid, field);
+
+  double time = timer.GetElapsedTime();
+
+  std::cout << "number of coordinates in: " << grid.GetNumberOfPoints() << std::endl;
+  std::cout << "number of coordinates out: " << outGrid.GetNumberOfPoints() << std::endl;
+  std::cout << "number of cells out: " << outGrid.GetNumberOfCells() << std::endl;
+  PrintResults(3, time);
+}
+
 void RunDAXPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
 {
+  if (pipeline == dax::testing::ArgumentsParser::FLYING_EDGES)
+    {
+    dax::cont::ArrayHandle<dax::Scalar> magnitude;
+    dax::cont::Scheduler<> schedule;
+    schedule.Invoke(dax::worklet::Magnitude(),
+          grid.GetPointCoordinates(),
+          magnitude);
+    RunFlyingEdgesPipeline(grid, magnitude);
+    return;
+    }
+
   std::cout << "Running pipeline 1: Magnitude -> MarchingCubes" << std::endl;
 
   dax::cont::UnstructuredGrid<dax::CellTagTriangle> outGrid;
@@ -62,17 +97,19 @@ void RunDAXPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
   dax::cont::Timer<> timer;
 
   //schedule marching cubes worklet generate step
-  typedef dax::cont::GenerateInterpolatedCells<dax::worklet::MarchingCubesTopology> GenerateIC;
+  typedef dax::cont::GenerateInterpolatedCells<dax::worklet::MarchingCubesCaseTopology> GenerateIC;
   typedef GenerateIC::ClassifyResultType  ClassifyResultType;
 
-  dax::worklet::MarchingCubesClassify classifyWorklet(ISOVALUE);
-  dax::worklet::MarchingCubesTopology generateWorklet(ISOVALUE);
+  dax::worklet::MarchingCubesCaseClassify classifyWorklet(ISOVALUE);
+  dax::worklet::MarchingCubesCaseTopology generateWorklet(ISOVALUE);
 
 
-  //run the first step
+  //run the first step, which also saves the case of each cell so that the
+  //generate step does not compute it again
   ClassifyResultType classification; //array handle for the first step classification
+  dax::cont::ArrayHandle<unsigned char> cases;
   schedule.Invoke(classifyWorklet, grid,
-                   intermediate1, classification);
+                   intermediate1, classification, cases);
 
   //construct the topology generation worklet
   GenerateIC generate(classification,generateWorklet);
@@ -82,7 +119,9 @@ void RunDAXPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
 
   //run the second step
   schedule.Invoke(generate,
-                   grid, outGrid, intermediate1);
+                   grid, outGrid, cases,
+                   dax::exec::make_ExecutionWholeArrayConst(
+                     intermediate1.PrepareForInput()));
 
   double time = timer.GetElapsedTime();
 
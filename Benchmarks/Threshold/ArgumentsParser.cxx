@@ -91,6 +91,10 @@ bool dax::testing::ArgumentsParser::parseArguments(int argc, char* argv[])
       {
       this->Pipeline = CELL_THRESHOLD;
       }
+    if (pipelineflag == 2)
+      {
+      this->Pipeline = TETRAHEDRALIZE_COMPRESSED_CONNECTIVITY;
+      }
     }
 
   delete[] options;
@@ -29,7 +29,8 @@ public:
 
   enum PipelineMode
     {
-    CELL_THRESHOLD = 1
+    CELL_THRESHOLD = 1,
+    TETRAHEDRALIZE_COMPRESSED_CONNECTIVITY = 2
     };
   PipelineMode pipeline() const
     { return this->Pipeline; }
@@ -21,6 +21,7 @@
 #include <dax/CellTraits.h>
 
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCompressedConnectivity.h>
 #include <dax/cont/Scheduler.h>
 #include <dax/cont/GenerateTopology.h>
 #include <dax/cont/Timer.h>
@@ -28,7 +29,9 @@
 #include <dax/cont/UnstructuredGrid.h>
 #include <dax/cont/VectorOperations.h>
 
+#include <dax/worklet/CellAverage.h>
 #include <dax/worklet/Magnitude.h>
+#include <dax/worklet/Tetrahedralize.h>
 #include <dax/worklet/Threshold.h>
 
 #include <vector>
@@ -158,7 +161,7 @@ void PrintContentsToStream(dax::cont::UnstructuredGrid<T>& grid, Stream &stream)
     }
   }
 
-void RunDAXPipeline(const dax::cont::UniformGrid<> &grid)
+void RunThresholdPipeline(const dax::cont::UniformGrid<> &grid)
 {
   std::cout << "Running pipeline 1: Magnitude -> Threshold" << std::endl;
 
@@ -207,6 +210,121 @@ void RunDAXPipeline(const dax::cont::UniformGrid<> &grid)
   CheckValues(resultHandle);
 }
 
+template<typename DeltaType, class GridType>
+double RunCompressedCellAverage(
+    const GridType &grid,
+    const dax::cont::ArrayHandle<dax::Scalar> &field,
+    const dax::cont::ArrayHandle<dax::Scalar> &expected)
+{
+  typedef dax::CellTraits<typename GridType::CellTag> CellTraits;
+  typedef dax::cont::ArrayHandleCompressedConnectivity<
+      dax::cont::ArrayHandle<DeltaType>,CellTraits::NUM_VERTICES>
+      CompressedConnectionsType;
+  typedef dax::cont::UnstructuredGrid<
+      typename GridType::CellTag,
+      typename CompressedConnectionsType::ArrayContainerControlTag,
+      DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG> CompressedGridType;
+
+  dax::cont::Timer<> timer;
+  CompressedConnectionsType connections(grid.GetCellConnections());
+  double compressTime = timer.GetElapsedTime();
+  CompressedGridType compressedGrid(connections, grid.GetPointCoordinates());
+
+  const double numberOfValues = grid.GetCellConnections().GetNumberOfValues();
+  const double regularBytes = numberOfValues*sizeof(dax::Id);
+  const double compressedBytes = grid.GetNumberOfCells()*sizeof(dax::Id)
+      + numberOfValues*sizeof(DeltaType);
+  std::cout << "connections: " << regularBytes << " bytes, compressed with "
+            << sizeof(DeltaType) << " byte deltas: " << compressedBytes
+            << " bytes (" << (100*compressedBytes)/regularBytes << "%)"
+            << std::endl;
+  std::cout << "compression time: " << compressTime << std::endl;
+
+  dax::cont::ArrayHandle<dax::Scalar> averages;
+  dax::cont::Scheduler<> schedule;
+  timer.Reset();
+  schedule.Invoke(dax::worklet::CellAverage(), compressedGrid, field, averages);
+  double time = timer.GetElapsedTime();
+
+  for (dax::Id index = 0; index < averages.GetNumberOfValues(); index++)
+    {
+    if (averages.GetPortalConstControl().Get(index)
+        != expected.GetPortalConstControl().Get(index))
+      {
+      std::cout << "*** Compressed connections gave a different result at "
+                << index << std::endl;
+      exit(1);
+      }
+    }
+  return time;
+}
+
+void RunCompressedConnectivityPipeline(const dax::cont::UniformGrid<> &grid)
+{
+  std::cout << "Running pipeline 2: Tetrahedralize -> CellAverage with "
+            << "compressed connections" << std::endl;
+
+  typedef dax::cont::UnstructuredGrid<dax::CellTagTetrahedron> TetGridType;
+  typedef dax::cont::GenerateTopology<
+      dax::worklet::Tetrahedralize,
+      dax::cont::ArrayHandleConstantValue<dax::Id> > GenTets;
+
+  dax::cont::Scheduler<> schedule;
+  TetGridType tetGrid;
+  GenTets generateTets(GenTets::ClassifyResultType(5,grid.GetNumberOfCells()));
+  generateTets.SetRemoveDuplicatePoints(false);
+  schedule.Invoke(generateTets, grid, tetGrid);
+
+  // The tetrahedra use the points of the uniform grid.
+  dax::cont::internal::DeviceAdapterAlgorithm<
+      DAX_DEFAULT_DEVICE_ADAPTER_TAG>::Copy(grid.GetPointCoordinates(),
+                                            tetGrid.GetPointCoordinates());
+  std::cout << "tetrahedralize GetNumberOfCells: " << tetGrid.GetNumberOfCells()
+            << std::endl;
+
+  dax::cont::ArrayHandle<dax::Scalar> field;
+  schedule.Invoke(dax::worklet::Magnitude(),
+                  tetGrid.GetPointCoordinates(),
+                  field);
+
+  dax::cont::ArrayHandle<dax::Scalar> averages;
+  dax::cont::Timer<> timer;
+  schedule.Invoke(dax::worklet::CellAverage(), tetGrid, field, averages);
+  double regularTime = timer.GetElapsedTime();
+  std::cout << "CellAverage time with regular connections: " << regularTime
+            << std::endl;
+
+  // The points of a tetrahedron all lie on one voxel, so the largest delta
+  // is one point plus one row plus one slice of the grid.
+  dax::Id3 dims = dax::extentDimensions(grid.GetExtent());
+  dax::Id maxDelta = dims[0]*dims[1] + dims[0] + 1;
+  double time;
+  if (maxDelta <= 0xffff)
+    {
+    time = RunCompressedCellAverage<unsigned short>(tetGrid, field, averages);
+    }
+  else
+    {
+    time = RunCompressedCellAverage<unsigned int>(tetGrid, field, averages);
+    }
+  std::cout << "CellAverage time with compressed connections: " << time
+            << std::endl;
+
+  PrintResults(2, time);
+}
+
+void RunDAXPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
+{
+  if (pipeline == dax::testing::ArgumentsParser::TETRAHEDRALIZE_COMPRESSED_CONNECTIVITY)
+    {
+    RunCompressedConnectivityPipeline(grid);
+    }
+  else
+    {
+    RunThresholdPipeline(grid);
+    }
+}
+
 
 } // Anonymous namespace
 
@@ -249,6 +249,25 @@ typedef internal::Int64Type Id __attribute__ ((aligned(DAX_SIZE_ID)));
 #error Unknown Id Size
 #endif
 
+// Connections and per-cell counts index the points of a single mesh, so they
+// are kept at 32 bits when Id is 64 bits (halving the size of the largest
+// arrays) unless DAX_USE_64BIT_CONNECTIVITY_IDS is set. Totals and offsets
+// that can overflow should still use Id.
+#if DAX_SIZE_CONNECTIVITY_ID == DAX_SIZE_ID
+
+/// Represents a point index in cell connections or a per-cell count.
+typedef dax::Id ConnectivityId;
+
+#elif DAX_SIZE_CONNECTIVITY_ID == 4
+
+/// Represents a point index in cell connections or a per-cell count.
+typedef internal::Int32Type ConnectivityId
+    __attribute__ ((aligned(DAX_SIZE_CONNECTIVITY_ID)));
+
+#else
+#error Unknown ConnectivityId Size
+#endif
+
 #ifdef DAX_USE_DOUBLE_PRECISION
 
 /// Scalar corresponds to a floating point number.
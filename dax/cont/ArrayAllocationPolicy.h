@@ -0,0 +1,251 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayAllocationPolicy_h
+#define __dax_cont_ArrayAllocationPolicy_h
+
+#include <dax/Types.h>
+#include <dax/cont/ErrorControlBadValue.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/// The default alignment, in bytes, of the arrays allocated by the basic
+/// control array container. It defaults to the size of a cache line, which is
+/// also wide enough for any SIMD load on current CPUs. Define it before
+/// including any Dax header to change the compiled in default.
+///
+#ifndef DAX_ARRAY_ALLOCATION_ALIGNMENT
+#define DAX_ARRAY_ALLOCATION_ALIGNMENT 64
+#endif
+
+namespace dax {
+namespace cont {
+
+/// Describes how the basic control array container and the execution array
+/// managers that share memory with it lay out large arrays in memory. The
+/// policy is global to the process; get and set it with
+/// GetArrayAllocationPolicy and SetArrayAllocationPolicy.
+///
+/// Huge pages and NUMA placement are hints. They only apply to arrays of at
+/// least \c LargeArrayThreshold bytes and are silently ignored on platforms
+/// (or kernels) that do not support them.
+///
+struct ArrayAllocationPolicy
+{
+  enum NumaPlacementType {
+    /// Leave page placement to the operating system's default policy.
+    NUMA_DEFAULT,
+    /// Spread the pages of an array round robin across all allowed nodes.
+    /// Good for arrays that are read by every thread in no particular order.
+    NUMA_INTERLEAVE,
+    /// Place each page on the node of the thread that first touches it. Use
+    /// with \c ParallelFirstTouch so that pages land on the node of the thread
+    /// that will later process them.
+    NUMA_LOCAL
+  };
+
+  DAX_CONT_EXPORT
+  ArrayAllocationPolicy()
+    : Alignment(DAX_ARRAY_ALLOCATION_ALIGNMENT),
+      HugePages(false),
+      NumaPlacement(NUMA_DEFAULT),
+      ParallelFirstTouch(false),
+      LargeArrayThreshold(2*1024*1024) {  }
+
+  /// Alignment in bytes of the first value of every array. Must be a power of
+  /// two and a multiple of the size of a pointer.
+  std::size_t Alignment;
+
+  /// When true, large arrays are aligned to and advised as transparent huge
+  /// pages, which cuts TLB misses when streaming through big fields.
+  bool HugePages;
+
+  /// Which NUMA node the pages of large arrays are placed on.
+  NumaPlacementType NumaPlacement;
+
+  /// When true, device adapters that share memory with the control
+  /// environment (TBB and OpenMP) initialize the arrays they allocate for
+  /// output in parallel, using the same partitioning as their schedule, so
+  /// that each page is first touched by the thread that will write it.
+  bool ParallelFirstTouch;
+
+  /// Arrays smaller than this many bytes ignore the huge page, NUMA, and
+  /// first touch settings.
+  std::size_t LargeArrayThreshold;
+};
+
+namespace internal {
+
+DAX_CONT_EXPORT
+dax::cont::ArrayAllocationPolicy &GlobalArrayAllocationPolicy()
+{
+  static dax::cont::ArrayAllocationPolicy policy;
+  return policy;
+}
+
+} // namespace internal
+
+/// Returns the allocation policy currently used for new arrays.
+///
+DAX_CONT_EXPORT
+const dax::cont::ArrayAllocationPolicy &GetArrayAllocationPolicy()
+{
+  return dax::cont::internal::GlobalArrayAllocationPolicy();
+}
+
+/// Changes the allocation policy used for arrays allocated from now on.
+/// Arrays that are already allocated keep their layout.
+///
+DAX_CONT_EXPORT
+void SetArrayAllocationPolicy(const dax::cont::ArrayAllocationPolicy &policy)
+{
+  if (   (policy.Alignment < sizeof(void*))
+      || ((policy.Alignment & (policy.Alignment - 1)) != 0))
+    {
+    throw dax::cont::ErrorControlBadValue(
+          "Array allocation alignment must be a power of two no smaller than "
+          "a pointer.");
+    }
+  dax::cont::internal::GlobalArrayAllocationPolicy() = policy;
+}
+
+namespace internal {
+
+/// Allocates \c numberOfBytes of uninitialized memory following the current
+/// ArrayAllocationPolicy. The memory is aligned to at least \c minAlignment
+/// bytes (which must be a power of two) and must be released with
+/// FreeArrayMemory. Throws std::bad_alloc on failure.
+///
+DAX_CONT_EXPORT
+void *AllocateArrayMemory(std::size_t numberOfBytes,
+                          std::size_t minAlignment = 1)
+{
+  const dax::cont::ArrayAllocationPolicy &policy =
+      dax::cont::GetArrayAllocationPolicy();
+
+  std::size_t alignment = policy.Alignment;
+  if (alignment < minAlignment) { alignment = minAlignment; }
+
+  const bool largeArray = (numberOfBytes >= policy.LargeArrayThreshold);
+  if (largeArray && policy.HugePages)
+    {
+    // Align (and pad) to the huge page size so that no huge page is shared
+    // with another allocation.
+    const std::size_t hugePageSize = 2*1024*1024;
+    if (alignment < hugePageSize) { alignment = hugePageSize; }
+    }
+  else if (largeArray
+           && (policy.NumaPlacement != ArrayAllocationPolicy::NUMA_DEFAULT))
+    {
+    // NUMA placement works on whole pages.
+    const std::size_t pageSize = 4096;
+    if (alignment < pageSize) { alignment = pageSize; }
+    }
+  if (largeArray)
+    {
+    // Rounding up must not wrap around to a small size.
+    if (numberOfBytes > std::numeric_limits<std::size_t>::max()-(alignment-1))
+      {
+      throw std::bad_alloc();
+      }
+    numberOfBytes = ((numberOfBytes + alignment - 1)/alignment)*alignment;
+    }
+
+  void *memory = NULL;
+#ifdef _WIN32
+  memory = _aligned_malloc(numberOfBytes, alignment);
+#else
+  if (posix_memalign(&memory, alignment, numberOfBytes) != 0)
+    {
+    memory = NULL;
+    }
+#endif
+  if (memory == NULL)
+    {
+    throw std::bad_alloc();
+    }
+
+#ifdef __linux__
+  // These are only hints, so any error is ignored and leaves the default
+  // placement.
+  if (largeArray)
+    {
+#ifdef MADV_HUGEPAGE
+    if (policy.HugePages)
+      {
+      madvise(memory, numberOfBytes, MADV_HUGEPAGE);
+      }
+#endif
+#if defined(SYS_mbind) && defined(SYS_get_mempolicy)
+    // Use the raw system calls (with the constants from linux/mempolicy.h)
+    // so that we do not depend on libnuma.
+    if (policy.NumaPlacement == ArrayAllocationPolicy::NUMA_INTERLEAVE)
+      {
+      const int MPOL_F_MEMS_ALLOWED_FLAG = (1 << 2);
+      const int MPOL_INTERLEAVE_MODE = 3;
+      const unsigned long MAX_NODES = 1024;
+      const std::size_t MASK_WORDS = MAX_NODES/(8*sizeof(unsigned long));
+      unsigned long nodeMask[MASK_WORDS] = { 0 };
+      if (syscall(SYS_get_mempolicy, NULL, nodeMask, MAX_NODES, NULL,
+                  MPOL_F_MEMS_ALLOWED_FLAG) == 0)
+        {
+        syscall(SYS_mbind, memory, numberOfBytes, MPOL_INTERLEAVE_MODE,
+                nodeMask, MAX_NODES, 0);
+        }
+      }
+    else if (policy.NumaPlacement == ArrayAllocationPolicy::NUMA_LOCAL)
+      {
+      const int MPOL_LOCAL_MODE = 4;
+      syscall(SYS_mbind, memory, numberOfBytes, MPOL_LOCAL_MODE,
+              NULL, 0, 0);
+      }
+#endif
+    }
+#endif
+
+  return memory;
+}
+
+/// Releases memory returned by AllocateArrayMemory.
+///
+DAX_CONT_EXPORT
+void FreeArrayMemory(void *memory)
+{
+#ifdef _WIN32
+  _aligned_free(memory);
+#else
+  free(memory);
+#endif
+}
+
+} // namespace internal
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayAllocationPolicy_h
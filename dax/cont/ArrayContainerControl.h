@@ -120,6 +120,21 @@ public:
   DAX_CONT_EXPORT
   void Shrink(dax::Id numberOfValues);
 
+  /// \brief Makes room for at least \c numberOfValues values.
+  ///
+  /// Optional; only needed by arrays that use ArrayHandle::Reserve. The size
+  /// and values of the array are unchanged.
+  DAX_CONT_EXPORT
+  void Reserve(dax::Id numberOfValues);
+
+  /// \brief Increases the size of the array without changing its values.
+  ///
+  /// Optional; only needed by arrays that use ArrayHandle::Grow. The values
+  /// from indices 0 to the preexisting size - 1 are kept and the rest are
+  /// undefined. Reallocations should grow the capacity geometrically.
+  DAX_CONT_EXPORT
+  void Grow(dax::Id numberOfValues);
+
   /// \brief Frees any resources (i.e. memory) stored in this array.
   ///
   /// After calling this method GetNumberOfValues will return 0 and
@@ -17,12 +17,19 @@
 #define __dax__cont__ArrayContainerControlBasic_h
 
 #include <dax/Types.h>
+#include <dax/cont/ArrayAllocationPolicy.h>
 #include <dax/cont/ArrayContainerControl.h>
 #include <dax/cont/ArrayPortalFromIterators.h>
 #include <dax/cont/Assert.h>
 #include <dax/cont/ErrorControlBadValue.h>
 #include <dax/cont/ErrorControlOutOfMemory.h>
 
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <new>
+
 namespace dax {
 namespace cont {
 
@@ -33,6 +40,9 @@ namespace internal {
 
 /// A basic implementation of an ArrayContainerControl object.
 ///
+/// The memory is allocated following the global ArrayAllocationPolicy, so by
+/// default every array starts on a cache line boundary.
+///
 /// \todo This container does \em not construct the values within the array.
 /// Thus, it is important to not use this class with any type that will fail if
 /// not constructed. These are things like basic types (int, float, etc.) and
@@ -47,18 +57,6 @@ public:
   typedef dax::cont::ArrayPortalFromIterators<ValueType*> PortalType;
   typedef dax::cont::ArrayPortalFromIterators<const ValueType*> PortalConstType;
 
-private:
-  /// The original design of this class provided an allocator as a template
-  /// parameters. That messed things up, though, because other templated
-  /// classes assume that the \c ArrayContainerControl has one template
-  /// parameter. There are other ways to allow you to specify the allocator,
-  /// but it is uncertain whether that would ever be useful. So, instead of
-  /// jumping through hoops implementing them, just fix the allocator for now.
-  ///
-  typedef std::allocator<ValueType> AllocatorType;
-
-public:
-
   ArrayContainerControl() : Array(NULL), NumberOfValues(0), AllocatedSize(0) { }
 
   ~ArrayContainerControl()
@@ -68,11 +66,10 @@ public:
 
   void ReleaseResources()
   {
-    if (this->NumberOfValues > 0)
+    if (this->AllocatedSize > 0)
       {
       DAX_ASSERT_CONT(this->Array != NULL);
-      AllocatorType allocator;
-      allocator.deallocate(this->Array, this->AllocatedSize);
+      dax::cont::internal::FreeArrayMemory(this->Array);
       this->Array = NULL;
       this->NumberOfValues = 0;
       this->AllocatedSize = 0;
@@ -96,8 +93,7 @@ public:
       {
       if (numberOfValues > 0)
         {
-        AllocatorType allocator;
-        this->Array = allocator.allocate(numberOfValues);
+        this->Array = AllocateValues(numberOfValues);
         this->AllocatedSize  = numberOfValues;
         this->NumberOfValues = numberOfValues;
         }
@@ -123,6 +119,64 @@ public:
     return this->NumberOfValues;
   }
 
+  /// Returns the number of values the array can hold before it has to be
+  /// reallocated.
+  ///
+  dax::Id GetCapacity() const
+  {
+    return this->AllocatedSize;
+  }
+
+  /// \brief Makes room for at least \c numberOfValues values.
+  ///
+  /// The size and values of the array are unchanged, but growing the array to
+  /// up to \c numberOfValues (with Allocate or Grow) will not reallocate it.
+  ///
+  void Reserve(dax::Id numberOfValues)
+  {
+    if (numberOfValues <= this->AllocatedSize) { return; }
+
+    ValueType *newArray;
+    try
+      {
+      newArray = AllocateValues(numberOfValues);
+      }
+    catch (std::bad_alloc err)
+      {
+      // The old array is left as it was.
+      throw dax::cont::ErrorControlOutOfMemory(
+            "Could not allocate basic control array.");
+      }
+
+    const dax::Id numberOfValuesToKeep = this->NumberOfValues;
+    if (numberOfValuesToKeep > 0)
+      {
+      std::copy(this->Array, this->Array + numberOfValuesToKeep, newArray);
+      }
+    this->ReleaseResources();
+    this->Array = newArray;
+    this->NumberOfValues = numberOfValuesToKeep;
+    this->AllocatedSize = numberOfValues;
+  }
+
+  /// \brief Changes the size of the array without changing its values.
+  ///
+  /// Unlike Allocate, the values from indices 0 to the preexisting size - 1
+  /// are kept. Values past the preexisting size are undefined. When the array
+  /// has to be reallocated, its capacity is at least doubled so that growing
+  /// an array a piece at a time takes amortized constant time per value.
+  ///
+  void Grow(dax::Id numberOfValues)
+  {
+    if (numberOfValues > this->AllocatedSize)
+      {
+      dax::Id newCapacity = 2*this->AllocatedSize;
+      if (newCapacity < numberOfValues) { newCapacity = numberOfValues; }
+      this->Reserve(newCapacity);
+      }
+    this->NumberOfValues = numberOfValues;
+  }
+
   void Shrink(dax::Id numberOfValues)
   {
     if (numberOfValues > this->GetNumberOfValues())
@@ -151,7 +205,8 @@ public:
   /// ArrayContainerControl will never deallocate the array. This is
   /// helpful for taking a reference for an array created internally by Dax and
   /// not having to keep a Dax object around. Obviously the caller becomes
-  /// responsible for destroying the memory.
+  /// responsible for destroying the memory, which must be released with
+  /// dax::cont::internal::FreeArrayMemory.
   ///
   ValueType *StealArray()
   {
@@ -163,6 +218,21 @@ public:
   }
 
 private:
+  // Allocates room for numberOfValues values, throwing std::bad_alloc when
+  // their size in bytes does not fit in a std::size_t.
+  static ValueType *AllocateValues(dax::Id numberOfValues)
+  {
+    if (static_cast<std::size_t>(numberOfValues)
+        > std::numeric_limits<std::size_t>::max()/sizeof(ValueType))
+      {
+      throw std::bad_alloc();
+      }
+    return static_cast<ValueType*>(
+          dax::cont::internal::AllocateArrayMemory(
+            static_cast<std::size_t>(numberOfValues)*sizeof(ValueType),
+            boost::alignment_of<ValueType>::value));
+  }
+
   // Not implemented.
   ArrayContainerControl(const ArrayContainerControl<ValueType, ArrayContainerControlTagBasic> &src);
   void operator=(const ArrayContainerControl<ValueType, ArrayContainerControlTagBasic> &src);
@@ -0,0 +1,343 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayContainerControlCartesianProduct_h
+#define __dax_cont_ArrayContainerControlCartesianProduct_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/ArrayPortal.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/IteratorFromArrayPortal.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+
+/// \brief An array portal for the cartesian product of three axis portals.
+///
+/// ArrayPortalCartesianProduct holds three one dimensional array portals, one
+/// per axis, and implicitly represents every combination of their values. The
+/// x axis varies fastest followed by the y and then the z axis, which matches
+/// the point ordering of structured grids. So for example if we have the axis
+/// portals X = [0,1], Y = [0,2] and Z = [5] then
+///
+/// Product[0] = (X[0], Y[0], Z[0]) = (0,0,5).
+/// Product[1] = (X[1], Y[0], Z[0]) = (1,0,5).
+/// Product[2] = (X[0], Y[1], Z[0]) = (0,2,5). etc ...
+///
+/// The ArrayPortalCartesianProduct is used in the execution environment by
+/// arrays with an ArrayContainerControlTagCartesianProduct container.
+///
+template<class AxisPortalType>
+class ArrayPortalCartesianProduct
+{
+public:
+  typedef typename AxisPortalType::ValueType ComponentType;
+  typedef dax::Tuple<ComponentType,3> ValueType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCartesianProduct() {  }
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCartesianProduct(const AxisPortalType &xAxis,
+                              const AxisPortalType &yAxis,
+                              const AxisPortalType &zAxis)
+    : XAxis(xAxis), YAxis(yAxis), ZAxis(zAxis) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->XAxis.GetNumberOfValues()
+        * this->YAxis.GetNumberOfValues()
+        * this->ZAxis.GetNumberOfValues();
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(dax::Id index) const
+  {
+    const dax::Id xDim = this->XAxis.GetNumberOfValues();
+    const dax::Id yDim = this->YAxis.GetNumberOfValues();
+    const dax::Id slice = index % (xDim*yDim);
+    return ValueType(this->XAxis.Get(slice % xDim),
+                     this->YAxis.Get(slice / xDim),
+                     this->ZAxis.Get(index / (xDim*yDim)));
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const AxisPortalType &GetXAxis() const { return this->XAxis; }
+  DAX_EXEC_CONT_EXPORT
+  const AxisPortalType &GetYAxis() const { return this->YAxis; }
+  DAX_EXEC_CONT_EXPORT
+  const AxisPortalType &GetZAxis() const { return this->ZAxis; }
+
+  typedef dax::cont::IteratorFromArrayPortal<
+      ArrayPortalCartesianProduct<AxisPortalType> > IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const
+  {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const
+  {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+private:
+  AxisPortalType XAxis;
+  AxisPortalType YAxis;
+  AxisPortalType ZAxis;
+};
+
+/// \brief The control array portal of a cartesian product array.
+///
+/// This control portal holds the three axis ArrayHandles rather than their
+/// portals so that the ArrayTransfer of the cartesian product container can
+/// prepare each axis array for the execution environment on its own.
+///
+template<class AxisHandleType>
+class ArrayPortalCartesianProductControl
+{
+public:
+  typedef typename AxisHandleType::ValueType ComponentType;
+  typedef dax::Tuple<ComponentType,3> ValueType;
+
+  DAX_CONT_EXPORT
+  ArrayPortalCartesianProductControl() {  }
+
+  DAX_CONT_EXPORT
+  ArrayPortalCartesianProductControl(const AxisHandleType &xAxis,
+                                     const AxisHandleType &yAxis,
+                                     const AxisHandleType &zAxis)
+    : XAxis(xAxis), YAxis(yAxis), ZAxis(zAxis) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->XAxis.GetNumberOfValues()
+        * this->YAxis.GetNumberOfValues()
+        * this->ZAxis.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  ValueType Get(dax::Id index) const
+  {
+    typedef dax::cont::ArrayPortalCartesianProduct<
+        typename AxisHandleType::PortalConstControl> PortalType;
+    return PortalType(this->XAxis.GetPortalConstControl(),
+                      this->YAxis.GetPortalConstControl(),
+                      this->ZAxis.GetPortalConstControl()).Get(index);
+  }
+
+  DAX_CONT_EXPORT const AxisHandleType &GetXAxis() const { return this->XAxis; }
+  DAX_CONT_EXPORT const AxisHandleType &GetYAxis() const { return this->YAxis; }
+  DAX_CONT_EXPORT const AxisHandleType &GetZAxis() const { return this->ZAxis; }
+
+  typedef dax::cont::IteratorFromArrayPortal<
+      ArrayPortalCartesianProductControl<AxisHandleType> > IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const
+  {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const
+  {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+private:
+  AxisHandleType XAxis;
+  AxisHandleType YAxis;
+  AxisHandleType ZAxis;
+};
+
+/// \brief An implementation for read-only cartesian product arrays.
+///
+/// The points of an axis aligned grid with nonuniform spacing are completely
+/// defined by one array of coordinates per axis. Rather than storing every
+/// point, an ArrayHandle with an ArrayContainerControlTagCartesianProduct
+/// container computes each point from the three axis arrays. Like implicit
+/// arrays, the ArrayHandle must be constructed with the control portal, and
+/// it will raise an error on any operation that tries to modify it.
+///
+template<class AxisHandleType>
+struct ArrayContainerControlTagCartesianProduct {  };
+
+namespace internal {
+
+template<class AxisHandleType>
+class ArrayContainerControl<
+    dax::Tuple<typename AxisHandleType::ValueType,3>,
+    ArrayContainerControlTagCartesianProduct<AxisHandleType> >
+{
+public:
+  typedef dax::Tuple<typename AxisHandleType::ValueType,3> ValueType;
+  typedef dax::cont::ArrayPortalCartesianProductControl<AxisHandleType>
+      PortalConstType;
+
+  // This is meant to be invalid. Because cartesian product arrays are read
+  // only, you should only be able to use the const version.
+  struct PortalType {
+    typedef void *ValueType;
+    typedef void *IteratorType;
+  };
+
+  // All these methods do nothing but raise errors.
+  PortalType GetPortal() {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays are read-only.");
+  }
+  PortalConstType GetPortalConst() const {
+    // This does not work because the ArrayHandle holds the constant
+    // ArrayPortal, not the container.
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product container does not store array portal.  "
+          "Perhaps you did not set the ArrayPortal when "
+          "constructing the ArrayHandle.");
+  }
+  dax::Id GetNumberOfValues() const {
+    // This does not work because the ArrayHandle holds the constant
+    // ArrayPortal, not the container.
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product container does not store array portal.  "
+          "Perhaps you did not set the ArrayPortal when "
+          "constructing the ArrayHandle.");
+  }
+  void Allocate(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays are read-only.");
+  }
+  void Shrink(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays are read-only.");
+  }
+  void ReleaseResources() {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays are read-only.");
+  }
+};
+
+/// ArrayTransfer for cartesian product arrays. Only the axis arrays are
+/// transferred to the execution environment. The points themselves are
+/// computed on demand by the execution portal.
+///
+template<class AxisHandleType, class DeviceAdapterTag>
+class ArrayTransfer<
+    dax::Tuple<typename AxisHandleType::ValueType,3>,
+    ArrayContainerControlTagCartesianProduct<AxisHandleType>,
+    DeviceAdapterTag>
+{
+private:
+  typedef ArrayContainerControlTagCartesianProduct<AxisHandleType>
+      ArrayContainerControlTag;
+  typedef dax::Tuple<typename AxisHandleType::ValueType,3> T;
+  typedef dax::cont::internal::ArrayContainerControl<T,ArrayContainerControlTag>
+      ContainerType;
+
+public:
+  typedef T ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+  typedef PortalControl PortalExecution;
+  typedef dax::cont::ArrayPortalCartesianProduct<
+      typename AxisHandleType::PortalConstExecution> PortalConstExecution;
+
+  ArrayTransfer() : PortalValid(false) {  }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->PortalValid);
+    return this->Axes.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT void LoadDataForInput(PortalConstControl portal) {
+    this->Axes = portal;
+    this->Portal = PortalConstExecution(portal.GetXAxis().PrepareForInput(),
+                                        portal.GetYAxis().PrepareForInput(),
+                                        portal.GetZAxis().PrepareForInput());
+    this->PortalValid = true;
+  }
+
+  DAX_CONT_EXPORT void LoadDataForInPlace(
+      ContainerType &daxNotUsed(controlArray))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays cannot be used for output or in place.");
+  }
+
+  DAX_CONT_EXPORT void AllocateArrayForOutput(
+      ContainerType &daxNotUsed(controlArray),
+      dax::Id daxNotUsed(numberOfValues))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays cannot be used for output.");
+  }
+  DAX_CONT_EXPORT void RetrieveOutputData(
+      ContainerType &daxNotUsed(controlArray)) const
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays cannot be used for output.");
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    DAX_ASSERT_CONT(this->PortalValid);
+    std::copy(this->Axes.GetIteratorBegin(),
+              this->Axes.GetIteratorEnd(),
+              dest);
+  }
+
+  DAX_CONT_EXPORT void Shrink(dax::Id daxNotUsed(numberOfValues))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays cannot be resized.");
+  }
+
+  DAX_CONT_EXPORT PortalExecution GetPortalExecution()
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays are read-only.  (Get the const portal.)");
+  }
+  DAX_CONT_EXPORT PortalConstExecution GetPortalConstExecution() const
+  {
+    DAX_ASSERT_CONT(this->PortalValid);
+    return this->Portal;
+  }
+
+  DAX_CONT_EXPORT void ReleaseResources() {  }
+
+private:
+  PortalConstControl Axes;
+  PortalConstExecution Portal;
+  bool PortalValid;
+};
+
+} // namespace internal
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayContainerControlCartesianProduct_h
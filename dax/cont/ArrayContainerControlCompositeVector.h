@@ -0,0 +1,459 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayContainerControlCompositeVector_h
+#define __dax_cont_ArrayContainerControlCompositeVector_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/ArrayPortal.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/IteratorFromArrayPortal.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+
+/// \brief An array portal that combines component portals into tuples.
+///
+/// ArrayPortalCompositeVector holds \c NumComponents array portals of the
+/// same type and presents them as a single array of \c dax::Tuple values.
+/// Value \c i of the composite array is the tuple made up of value \c i from
+/// each of the component portals. So for example if we have the three
+/// component portals X = [0,1,2], Y = [3,4,5] and Z = [6,7,8] then
+///
+/// Composite[0] = (X[0], Y[0], Z[0]) = (0,3,6).
+/// Composite[1] = (X[1], Y[1], Z[1]) = (1,4,7). etc ...
+///
+/// Setting a value in the composite array writes each component back to the
+/// corresponding component portal. This portal is used in the execution
+/// environment by arrays with an ArrayContainerControlTagCompositeVector
+/// container.
+///
+template<class ComponentPortalType, int NumComponents>
+class ArrayPortalCompositeVector
+{
+public:
+  typedef typename ComponentPortalType::ValueType ComponentType;
+  typedef dax::Tuple<ComponentType,NumComponents> ValueType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCompositeVector() {  }
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCompositeVector(const ComponentPortalType *componentPortals)
+  {
+    for (int component = 0; component < NumComponents; component++)
+      {
+      this->Portals[component] = componentPortals[component];
+      }
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->Portals[0].GetNumberOfValues();
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(dax::Id index) const
+  {
+    ValueType value;
+    for (int component = 0; component < NumComponents; component++)
+      {
+      value[component] = this->Portals[component].Get(index);
+      }
+    return value;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  void Set(dax::Id index, const ValueType &value) const
+  {
+    for (int component = 0; component < NumComponents; component++)
+      {
+      this->Portals[component].Set(index, value[component]);
+      }
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const ComponentPortalType &GetComponentPortal(int component) const
+  {
+    return this->Portals[component];
+  }
+
+  typedef dax::cont::IteratorFromArrayPortal<
+      ArrayPortalCompositeVector<ComponentPortalType,NumComponents> >
+    IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const
+  {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const
+  {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+private:
+  ComponentPortalType Portals[NumComponents];
+};
+
+/// \brief The control array portal of a composite vector array.
+///
+/// Values are read from and written to the control portals of the
+/// components, which the container gets once when it builds this portal.
+/// The component ArrayHandles are also held, but only so that the
+/// ArrayTransfer for the composite vector container can prepare each
+/// component for the execution environment without ever interleaving the
+/// data.
+///
+template<class ComponentHandleType, class ComponentPortalType, int NumComponents>
+class ArrayPortalCompositeVectorControl
+{
+public:
+  typedef typename ComponentHandleType::ValueType ComponentType;
+  typedef dax::Tuple<ComponentType,NumComponents> ValueType;
+
+  DAX_CONT_EXPORT
+  ArrayPortalCompositeVectorControl() {  }
+
+  DAX_CONT_EXPORT
+  ArrayPortalCompositeVectorControl(const ComponentHandleType *components,
+                                    const ComponentPortalType *portals)
+    : Portals(portals)
+  {
+    for (int component = 0; component < NumComponents; component++)
+      {
+      this->Components[component] = components[component];
+      }
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->Portals.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  ValueType Get(dax::Id index) const
+  {
+    return this->Portals.Get(index);
+  }
+
+  DAX_CONT_EXPORT
+  void Set(dax::Id index, const ValueType &value) const
+  {
+    this->Portals.Set(index, value);
+  }
+
+  DAX_CONT_EXPORT
+  const ComponentHandleType &GetComponent(int component) const
+  {
+    return this->Components[component];
+  }
+
+  typedef dax::cont::IteratorFromArrayPortal<
+      ArrayPortalCompositeVectorControl<
+        ComponentHandleType,ComponentPortalType,NumComponents> >
+    IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const
+  {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const
+  {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+private:
+  ArrayPortalCompositeVector<ComponentPortalType,NumComponents> Portals;
+  ComponentHandleType Components[NumComponents];
+};
+
+/// \brief A container that presents several arrays as one array of tuples.
+///
+/// It is often the case that the components of a vector field are held in
+/// separate arrays (for example, separate x, y, and z coordinate arrays).
+/// Rather than interleaving these into a new array of \c dax::Tuple values,
+/// an ArrayHandle with an ArrayContainerControlTagCompositeVector container
+/// references the \c NumComponents component ArrayHandles (which must all be
+/// of type \c ComponentHandleType) and reads and writes them directly in both
+/// the control and execution environments.
+///
+/// Because the component arrays are owned by their own handles, a composite
+/// vector array cannot allocate itself in the control environment. It can,
+/// however, be used as an output in the execution environment, in which case
+/// each of the component arrays is allocated.
+///
+template<class ComponentHandleType, int NumComponents>
+struct ArrayContainerControlTagCompositeVector {  };
+
+namespace internal {
+
+template<class ComponentHandleType, int NumComponents>
+class ArrayContainerControl<
+    dax::Tuple<typename ComponentHandleType::ValueType, NumComponents>,
+    ArrayContainerControlTagCompositeVector<ComponentHandleType,NumComponents> >
+{
+public:
+  typedef dax::Tuple<typename ComponentHandleType::ValueType, NumComponents>
+      ValueType;
+  typedef dax::cont::ArrayPortalCompositeVectorControl<
+      ComponentHandleType,
+      typename ComponentHandleType::PortalControl,
+      NumComponents> PortalType;
+  typedef dax::cont::ArrayPortalCompositeVectorControl<
+      ComponentHandleType,
+      typename ComponentHandleType::PortalConstControl,
+      NumComponents> PortalConstType;
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl() {  }
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl(const ComponentHandleType *components)
+  {
+    for (int component = 0; component < NumComponents; component++)
+      {
+      this->Components[component] = components[component];
+      }
+  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal()
+  {
+    typename ComponentHandleType::PortalControl portals[NumComponents];
+    for (int component = 0; component < NumComponents; component++)
+      {
+      portals[component] = this->Components[component].GetPortalControl();
+      }
+    return PortalType(this->Components, portals);
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const
+  {
+    typename ComponentHandleType::PortalConstControl portals[NumComponents];
+    for (int component = 0; component < NumComponents; component++)
+      {
+      portals[component] =
+          this->Components[component].GetPortalConstControl();
+      }
+    return PortalConstType(this->Components, portals);
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->Components[0].GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id daxNotUsed(numberOfValues))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Composite vector arrays cannot be allocated in the control "
+          "environment.  Allocate the component arrays instead.");
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues)
+  {
+    for (int component = 0; component < NumComponents; component++)
+      {
+      this->Components[component].Shrink(numberOfValues);
+      }
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources()
+  {
+    for (int component = 0; component < NumComponents; component++)
+      {
+      this->Components[component].ReleaseResources();
+      }
+  }
+
+  DAX_CONT_EXPORT
+  const ComponentHandleType &GetComponent(int component) const
+  {
+    return this->Components[component];
+  }
+
+private:
+  ComponentHandleType Components[NumComponents];
+};
+
+/// ArrayTransfer for composite vector arrays. Rather than transferring the
+/// composite array as a whole, each component array is prepared for the
+/// execution environment through its own ArrayHandle, so no interleaved copy
+/// is ever made in either environment.
+///
+template<class ComponentHandleType, int NumComponents, class DeviceAdapterTag>
+class ArrayTransfer<
+    dax::Tuple<typename ComponentHandleType::ValueType, NumComponents>,
+    ArrayContainerControlTagCompositeVector<ComponentHandleType,NumComponents>,
+    DeviceAdapterTag>
+{
+private:
+  typedef ArrayContainerControlTagCompositeVector<
+      ComponentHandleType,NumComponents> ArrayContainerControlTag;
+  typedef dax::Tuple<typename ComponentHandleType::ValueType, NumComponents>
+      T;
+  typedef dax::cont::internal::ArrayContainerControl<T,ArrayContainerControlTag>
+      ContainerType;
+
+  typedef typename ComponentHandleType::PortalConstControl
+      ComponentPortalConstControl;
+  typedef typename ComponentHandleType::PortalExecution
+      ComponentPortalExecution;
+  typedef typename ComponentHandleType::PortalConstExecution
+      ComponentPortalConstExecution;
+
+public:
+  typedef T ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+  typedef dax::cont::ArrayPortalCompositeVector<
+      ComponentPortalExecution,NumComponents> PortalExecution;
+  typedef dax::cont::ArrayPortalCompositeVector<
+      ComponentPortalConstExecution,NumComponents> PortalConstExecution;
+
+  ArrayTransfer() : ComponentsValid(false) {  }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->ComponentsValid);
+    return this->Components[0].GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT void LoadDataForInput(PortalConstControl portal)
+  {
+    for (int component = 0; component < NumComponents; component++)
+      {
+      this->Components[component] = portal.GetComponent(component);
+      }
+    this->ComponentsValid = true;
+    // Preparing each component here (rather than waiting for the const
+    // execution portal to be requested) makes sure any transfer errors are
+    // raised at the same point as for other array containers.
+    this->GetPortalConstExecution();
+  }
+
+  DAX_CONT_EXPORT void LoadDataForInPlace(ContainerType &controlArray)
+  {
+    ComponentPortalExecution portals[NumComponents];
+    for (int component = 0; component < NumComponents; component++)
+      {
+      this->Components[component] = controlArray.GetComponent(component);
+      portals[component] = this->Components[component].PrepareForInPlace();
+      }
+    this->ComponentsValid = true;
+    this->Portal = PortalExecution(portals);
+  }
+
+  DAX_CONT_EXPORT void AllocateArrayForOutput(ContainerType &controlArray,
+                                              dax::Id numberOfValues)
+  {
+    ComponentPortalExecution portals[NumComponents];
+    for (int component = 0; component < NumComponents; component++)
+      {
+      this->Components[component] = controlArray.GetComponent(component);
+      portals[component] =
+          this->Components[component].PrepareForOutput(numberOfValues);
+      }
+    this->ComponentsValid = true;
+    this->Portal = PortalExecution(portals);
+  }
+
+  DAX_CONT_EXPORT void RetrieveOutputData(
+      ContainerType &daxNotUsed(controlArray)) const
+  {
+    // Nothing to do. The component arrays hold the data and retrieve it
+    // themselves when their control portals are requested.
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    DAX_ASSERT_CONT(this->ComponentsValid);
+    ComponentPortalConstControl portals[NumComponents];
+    for (int component = 0; component < NumComponents; component++)
+      {
+      portals[component] = this->Components[component].GetPortalConstControl();
+      }
+    ArrayPortalCompositeVector<ComponentPortalConstControl,NumComponents>
+        portal(portals);
+    std::copy(portal.GetIteratorBegin(), portal.GetIteratorEnd(), dest);
+  }
+
+  DAX_CONT_EXPORT void Shrink(dax::Id numberOfValues)
+  {
+    DAX_ASSERT_CONT(this->ComponentsValid);
+    for (int component = 0; component < NumComponents; component++)
+      {
+      this->Components[component].Shrink(numberOfValues);
+      }
+  }
+
+  DAX_CONT_EXPORT PortalExecution GetPortalExecution()
+  {
+    return this->Portal;
+  }
+
+  DAX_CONT_EXPORT PortalConstExecution GetPortalConstExecution() const
+  {
+    DAX_ASSERT_CONT(this->ComponentsValid);
+    // The components are asked for their input portals every time because
+    // they may have been changed since they were last prepared. This does
+    // nothing if a component is already valid in the execution environment.
+    ComponentPortalConstExecution portals[NumComponents];
+    for (int component = 0; component < NumComponents; component++)
+      {
+      portals[component] = this->Components[component].PrepareForInput();
+      }
+    return PortalConstExecution(portals);
+  }
+
+  DAX_CONT_EXPORT void ReleaseResources()
+  {
+    // Nothing to do. The execution resources belong to the component arrays,
+    // which release them on their own when their control data is modified.
+    // Releasing them here could drop the only copy of output data.
+  }
+
+private:
+  ComponentHandleType Components[NumComponents];
+  bool ComponentsValid;
+  PortalExecution Portal;
+};
+
+} // namespace internal
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayContainerControlCompositeVector_h
@@ -0,0 +1,418 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayContainerControlCompressedConnectivity_h
+#define __dax_cont_ArrayContainerControlCompressedConnectivity_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayPortal.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/IteratorFromArrayPortal.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/internal/TopologyUnstructured.h>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+
+/// \brief An array portal that decodes compressed cell connections.
+///
+/// Cell connections typically reference points that are close to each other
+/// in index space. ArrayPortalCompressedConnectivity represents the
+/// connections of each cell (of \c NumVertices vertices) as one full
+/// \c dax::ConnectivityId base (the smallest point index of the cell) held in one portal
+/// and a narrow, non-negative delta for each vertex held in a second portal.
+/// Value \c i of the array is
+///
+/// Bases[i / NumVertices] + Deltas[i]
+///
+/// This portal is used in the execution environment by arrays with an
+/// ArrayContainerControlTagCompressedConnectivity container.
+///
+template<class BasePortalType, class DeltaPortalType, int NumVertices>
+class ArrayPortalCompressedConnectivity
+{
+public:
+  typedef dax::ConnectivityId ValueType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCompressedConnectivity() {  }
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCompressedConnectivity(const BasePortalType &bases,
+                                    const DeltaPortalType &deltas)
+    : Bases(bases), Deltas(deltas) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->Deltas.GetNumberOfValues();
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(dax::Id index) const
+  {
+    return this->Bases.Get(index/NumVertices)
+        + static_cast<ValueType>(this->Deltas.Get(index));
+  }
+
+  /// Decodes all the vertices of a cell, reading the base only once.
+  ///
+  template<class CellTag>
+  DAX_EXEC_CONT_EXPORT
+  void GetCell(dax::Id cellIndex,
+               dax::exec::CellVertices<CellTag> &vertices) const
+  {
+    const dax::Id base = this->Bases.Get(cellIndex);
+    const dax::Id start = cellIndex*NumVertices;
+    for (int vertexIndex = 0; vertexIndex < NumVertices; vertexIndex++)
+      {
+      vertices[vertexIndex] =
+          base + static_cast<dax::Id>(this->Deltas.Get(start + vertexIndex));
+      }
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const BasePortalType &GetBasePortal() const { return this->Bases; }
+
+  DAX_EXEC_CONT_EXPORT
+  const DeltaPortalType &GetDeltaPortal() const { return this->Deltas; }
+
+  typedef dax::cont::IteratorFromArrayPortal<
+      ArrayPortalCompressedConnectivity<
+        BasePortalType,DeltaPortalType,NumVertices> > IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const
+  {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const
+  {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+private:
+  BasePortalType Bases;
+  DeltaPortalType Deltas;
+};
+
+/// \brief The control array portal of a compressed connectivity array.
+///
+/// This control portal holds the ArrayHandles of the bases and deltas so that
+/// the ArrayTransfer for the compressed connectivity container can prepare
+/// them for the execution environment. The connections are never expanded in
+/// either environment.
+///
+template<class DeltaHandleType, int NumVertices>
+class ArrayPortalCompressedConnectivityControl
+{
+public:
+  typedef dax::ConnectivityId ValueType;
+  typedef dax::cont::ArrayHandle<
+      dax::ConnectivityId,
+      typename DeltaHandleType::ArrayContainerControlTag,
+      typename DeltaHandleType::DeviceAdapterTag> BaseHandleType;
+
+  DAX_CONT_EXPORT
+  ArrayPortalCompressedConnectivityControl() {  }
+
+  DAX_CONT_EXPORT
+  ArrayPortalCompressedConnectivityControl(const BaseHandleType &bases,
+                                           const DeltaHandleType &deltas)
+    : Bases(bases), Deltas(deltas) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->Deltas.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  ValueType Get(dax::Id index) const
+  {
+    return this->Bases.GetPortalConstControl().Get(index/NumVertices)
+        + static_cast<ValueType>(
+          this->Deltas.GetPortalConstControl().Get(index));
+  }
+
+  DAX_CONT_EXPORT
+  const BaseHandleType &GetBases() const { return this->Bases; }
+
+  DAX_CONT_EXPORT
+  const DeltaHandleType &GetDeltas() const { return this->Deltas; }
+
+  typedef dax::cont::IteratorFromArrayPortal<
+      ArrayPortalCompressedConnectivityControl<DeltaHandleType,NumVertices> >
+    IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const
+  {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const
+  {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+private:
+  BaseHandleType Bases;
+  DeltaHandleType Deltas;
+};
+
+/// \brief A container of cell connections stored as bases and narrow deltas.
+///
+/// The connections array of an unstructured grid holds \c NumVertices full
+/// point indices for every cell, which dominates the memory and bandwidth
+/// of large meshes such as the output of Tetrahedralize. An ArrayHandle with
+/// an ArrayContainerControlTagCompressedConnectivity container stores one
+/// \c dax::ConnectivityId per cell and a narrow delta (of the value type of
+/// \c DeltaHandleType, for example <tt>unsigned short</tt>) per vertex. Use it
+/// as the CellConnectionsContainerControlTag of an UnstructuredGrid to run
+/// worklets directly on the compressed connections; the topology decodes each
+/// cell as a whole when its connections are requested.
+///
+/// Compressed connections are read only. They are built from a regular
+/// connections array with ArrayHandleCompressedConnectivity.
+///
+template<class DeltaHandleType, int NumVertices>
+struct ArrayContainerControlTagCompressedConnectivity {  };
+
+namespace internal {
+
+template<class DeltaHandleType, int NumVertices>
+class ArrayContainerControl<
+    dax::ConnectivityId,
+    ArrayContainerControlTagCompressedConnectivity<DeltaHandleType,NumVertices> >
+{
+public:
+  typedef dax::ConnectivityId ValueType;
+  typedef dax::cont::ArrayPortalCompressedConnectivityControl<
+      DeltaHandleType,NumVertices> PortalType;
+  typedef PortalType PortalConstType;
+  typedef typename PortalType::BaseHandleType BaseHandleType;
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl() {  }
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl(const BaseHandleType &bases,
+                        const DeltaHandleType &deltas)
+    : Bases(bases), Deltas(deltas) {  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal() { return PortalType(this->Bases, this->Deltas); }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const
+  {
+    return PortalConstType(this->Bases, this->Deltas);
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->Deltas.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id daxNotUsed(numberOfValues))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Compressed connectivity arrays cannot be allocated.  Compress an "
+          "existing connections array instead.");
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues)
+  {
+    if ((numberOfValues % NumVertices) != 0)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Compressed connectivity arrays can only be shrunk to whole "
+            "cells.");
+      }
+    this->Bases.Shrink(numberOfValues/NumVertices);
+    this->Deltas.Shrink(numberOfValues);
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources()
+  {
+    this->Bases.ReleaseResources();
+    this->Deltas.ReleaseResources();
+  }
+
+private:
+  BaseHandleType Bases;
+  DeltaHandleType Deltas;
+};
+
+/// ArrayTransfer for compressed connectivity arrays. The base and delta
+/// arrays are prepared for the execution environment through their own
+/// ArrayHandles and decoded on the fly by the execution portal.
+///
+template<class DeltaHandleType, int NumVertices, class DeviceAdapterTag>
+class ArrayTransfer<
+    dax::ConnectivityId,
+    ArrayContainerControlTagCompressedConnectivity<DeltaHandleType,NumVertices>,
+    DeviceAdapterTag>
+{
+private:
+  typedef ArrayContainerControlTagCompressedConnectivity<
+      DeltaHandleType,NumVertices> ArrayContainerControlTag;
+  typedef dax::cont::internal::ArrayContainerControl<
+      dax::ConnectivityId,ArrayContainerControlTag> ContainerType;
+  typedef typename ContainerType::BaseHandleType BaseHandleType;
+
+public:
+  typedef dax::ConnectivityId ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+  typedef dax::cont::ArrayPortalCompressedConnectivity<
+      typename BaseHandleType::PortalExecution,
+      typename DeltaHandleType::PortalExecution,
+      NumVertices> PortalExecution;
+  typedef dax::cont::ArrayPortalCompressedConnectivity<
+      typename BaseHandleType::PortalConstExecution,
+      typename DeltaHandleType::PortalConstExecution,
+      NumVertices> PortalConstExecution;
+
+  ArrayTransfer() : ArraysValid(false) {  }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    return this->Arrays.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT void LoadDataForInput(PortalConstControl portal)
+  {
+    this->Arrays = portal;
+    this->ArraysValid = true;
+    // Prepare the arrays now so that any transfer errors are raised at the
+    // same point as for other array containers.
+    this->GetPortalConstExecution();
+  }
+
+  DAX_CONT_EXPORT void LoadDataForInPlace(
+      ContainerType &daxNotUsed(controlArray))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Compressed connectivity arrays cannot be used for in-place "
+          "operations.");
+  }
+
+  DAX_CONT_EXPORT void AllocateArrayForOutput(
+      ContainerType &daxNotUsed(controlArray),
+      dax::Id daxNotUsed(numberOfValues))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Compressed connectivity arrays cannot be used for output.  "
+          "Generate regular connections and compress them afterward.");
+  }
+
+  DAX_CONT_EXPORT void RetrieveOutputData(
+      ContainerType &daxNotUsed(controlArray)) const
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Compressed connectivity arrays cannot be used for output.");
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    std::copy(this->Arrays.GetIteratorBegin(),
+              this->Arrays.GetIteratorEnd(),
+              dest);
+  }
+
+  DAX_CONT_EXPORT void Shrink(dax::Id daxNotUsed(numberOfValues))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Compressed connectivity arrays cannot be resized.");
+  }
+
+  DAX_CONT_EXPORT PortalExecution GetPortalExecution()
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Compressed connectivity arrays are read only.");
+  }
+
+  DAX_CONT_EXPORT PortalConstExecution GetPortalConstExecution() const
+  {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    return PortalConstExecution(this->Arrays.GetBases().PrepareForInput(),
+                                this->Arrays.GetDeltas().PrepareForInput());
+  }
+
+  DAX_CONT_EXPORT void ReleaseResources()
+  {
+    // Nothing to do. The execution resources belong to the base and delta
+    // arrays, which release them on their own.
+  }
+
+private:
+  PortalConstControl Arrays;
+  bool ArraysValid;
+};
+
+} // namespace internal
+
+}
+} // namespace dax::cont
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+/// Compressed connections decode a whole cell at a time so that the base is
+/// read once per cell rather than once per vertex.
+///
+template<class BasePortalType, class DeltaPortalType, int NumVertices>
+struct CellConnectionsPortalTraits<
+    dax::cont::ArrayPortalCompressedConnectivity<
+      BasePortalType,DeltaPortalType,NumVertices> >
+{
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  static void GetCellConnections(
+      const dax::cont::ArrayPortalCompressedConnectivity<
+        BasePortalType,DeltaPortalType,NumVertices> &connections,
+      dax::Id cellIndex,
+      dax::exec::CellVertices<CellTag> &vertices)
+  {
+    connections.GetCell(cellIndex, vertices);
+  }
+};
+
+}
+}
+} // namespace dax::exec::internal
+
+#endif //__dax_cont_ArrayContainerControlCompressedConnectivity_h
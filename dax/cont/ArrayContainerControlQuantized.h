@@ -0,0 +1,588 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayContainerControlQuantized_h
+#define __dax_cont_ArrayContainerControlQuantized_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/ArrayPortal.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/IteratorFromArrayPortal.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+
+/// \brief A 16-bit (IEEE 754 binary16) floating point value.
+///
+/// Half only holds the bits of the value; it is meant to be used as the
+/// storage type of an ArrayHandleQuantized, which converts to and from
+/// \c dax::Scalar when values are read and written.
+///
+struct Half
+{
+  unsigned short Bits;
+};
+
+namespace internal {
+
+/// Converts between the narrow values stored in a quantized array and
+/// \c dax::Scalar. The general implementation simply casts, which is
+/// appropriate for signed integers and floating point types.
+///
+template<typename StorageType>
+struct QuantizedValueTraits
+{
+  DAX_EXEC_CONT_EXPORT
+  static dax::Scalar Decode(StorageType value)
+  {
+    return static_cast<dax::Scalar>(value);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  static StorageType Encode(dax::Scalar value)
+  {
+    return static_cast<StorageType>(value);
+  }
+};
+
+template<>
+struct QuantizedValueTraits<unsigned char>
+{
+  DAX_EXEC_CONT_EXPORT
+  static dax::Scalar Decode(unsigned char value)
+  {
+    return static_cast<dax::Scalar>(value);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  static unsigned char Encode(dax::Scalar value)
+  {
+    if (value <= 0) { return 0; }
+    if (value >= 255) { return 255; }
+    return static_cast<unsigned char>(value + dax::Scalar(0.5));
+  }
+};
+
+template<>
+struct QuantizedValueTraits<unsigned short>
+{
+  DAX_EXEC_CONT_EXPORT
+  static dax::Scalar Decode(unsigned short value)
+  {
+    return static_cast<dax::Scalar>(value);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  static unsigned short Encode(dax::Scalar value)
+  {
+    if (value <= 0) { return 0; }
+    if (value >= 65535) { return 65535; }
+    return static_cast<unsigned short>(value + dax::Scalar(0.5));
+  }
+};
+
+template<>
+struct QuantizedValueTraits<dax::cont::Half>
+{
+  DAX_EXEC_CONT_EXPORT
+  static dax::Scalar Decode(dax::cont::Half value)
+  {
+    const dax::internal::UInt32Type sign =
+        static_cast<dax::internal::UInt32Type>(value.Bits & 0x8000) << 16;
+    const dax::internal::UInt32Type exponent = (value.Bits >> 10) & 0x1f;
+    const dax::internal::UInt32Type mantissa = value.Bits & 0x3ff;
+
+    FloatBits result;
+    if (exponent == 0)
+      {
+      // Zero or denormal, which is mantissa * 2^-24.
+      float magnitude = static_cast<float>(mantissa) * 5.9604644775390625e-8f;
+      return static_cast<dax::Scalar>(sign ? -magnitude : magnitude);
+      }
+    else if (exponent == 0x1f)
+      {
+      // Infinity or NaN.
+      result.Bits = sign | 0x7f800000 | (mantissa << 13);
+      }
+    else
+      {
+      result.Bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+      }
+    return static_cast<dax::Scalar>(result.Value);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  static dax::cont::Half Encode(dax::Scalar value)
+  {
+    FloatBits input;
+    input.Value = static_cast<float>(value);
+    const dax::internal::UInt32Type sign = (input.Bits >> 16) & 0x8000;
+    const dax::internal::UInt32Type magnitude = input.Bits & 0x7fffffff;
+
+    dax::internal::UInt32Type bits;
+    if (magnitude >= 0x7f800000)
+      {
+      // Infinity or NaN (keep NaN quiet).
+      bits = 0x7c00 | ((magnitude > 0x7f800000) ? 0x200 : 0);
+      }
+    else if (magnitude >= 0x477ff000)
+      {
+      // Rounds to a value larger than the biggest half.
+      bits = 0x7c00;
+      }
+    else if (magnitude < 0x33000000)
+      {
+      // Rounds to zero.
+      bits = 0;
+      }
+    else if (magnitude < 0x38800000)
+      {
+      // Denormal half. Shift the full mantissa into place and round to
+      // nearest even.
+      const int shift = 126 - static_cast<int>(magnitude >> 23);
+      const dax::internal::UInt32Type mantissa =
+          (magnitude & 0x007fffff) | 0x00800000;
+      const dax::internal::UInt32Type remainder =
+          mantissa & ((1u << shift) - 1);
+      const dax::internal::UInt32Type halfway = 1u << (shift - 1);
+      bits = mantissa >> shift;
+      if ((remainder > halfway) || ((remainder == halfway) && (bits & 1)))
+        {
+        bits++;
+        }
+      }
+    else
+      {
+      // Normal half. Rebias the exponent and round the mantissa to nearest
+      // even (a carry correctly bumps the exponent).
+      bits = (magnitude - 0x38000000) >> 13;
+      const dax::internal::UInt32Type remainder = magnitude & 0x1fff;
+      if ((remainder > 0x1000) || ((remainder == 0x1000) && (bits & 1)))
+        {
+        bits++;
+        }
+      }
+
+    dax::cont::Half result;
+    result.Bits = static_cast<unsigned short>(sign | bits);
+    return result;
+  }
+
+private:
+  union FloatBits {
+    float Value;
+    dax::internal::UInt32Type Bits;
+  };
+};
+
+} // namespace internal
+
+/// \brief An array portal that decodes narrow values to \c dax::Scalar.
+///
+/// ArrayPortalQuantized wraps a portal of narrow values (for example
+/// <tt>unsigned char</tt>, <tt>unsigned short</tt>, or dax::cont::Half) and
+/// presents them as \c dax::Scalar values. A value is decoded as
+///
+/// scalar = Scale * stored + Offset
+///
+/// and setting a value encodes it with the inverse, rounding and clamping to
+/// the range of the storage type. This portal is used in the execution
+/// environment by arrays with an ArrayContainerControlTagQuantized container.
+///
+template<class StoragePortalType>
+class ArrayPortalQuantized
+{
+  typedef dax::cont::internal::QuantizedValueTraits<
+      typename StoragePortalType::ValueType> Traits;
+public:
+  typedef typename StoragePortalType::ValueType StorageType;
+  typedef dax::Scalar ValueType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalQuantized() : Scale(1), Offset(0) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalQuantized(const StoragePortalType &storagePortal,
+                       dax::Scalar scale,
+                       dax::Scalar offset)
+    : StoragePortal(storagePortal), Scale(scale), Offset(offset) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->StoragePortal.GetNumberOfValues();
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(dax::Id index) const
+  {
+    return this->Scale*Traits::Decode(this->StoragePortal.Get(index))
+        + this->Offset;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  void Set(dax::Id index, const ValueType &value) const
+  {
+    this->StoragePortal.Set(index,
+                            Traits::Encode((value - this->Offset)/this->Scale));
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const StoragePortalType &GetStoragePortal() const
+  {
+    return this->StoragePortal;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Scalar GetScale() const { return this->Scale; }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Scalar GetOffset() const { return this->Offset; }
+
+  typedef dax::cont::IteratorFromArrayPortal<
+      ArrayPortalQuantized<StoragePortalType> > IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const
+  {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const
+  {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+private:
+  StoragePortalType StoragePortal;
+  dax::Scalar Scale;
+  dax::Scalar Offset;
+};
+
+/// \brief The control array portal of a quantized array.
+///
+/// Values are decoded from (and encoded to) the control portal of the
+/// ArrayHandle of narrow values, which the container gets once when it builds
+/// this portal. The handle itself is also held so that the ArrayTransfer for
+/// the quantized container can prepare the narrow values for the execution
+/// environment, so the data is never widened in either environment.
+///
+template<class StorageHandleType, class StoragePortalType>
+class ArrayPortalQuantizedControl
+{
+public:
+  typedef typename StorageHandleType::ValueType StorageType;
+  typedef dax::Scalar ValueType;
+
+  DAX_CONT_EXPORT
+  ArrayPortalQuantizedControl() {  }
+
+  DAX_CONT_EXPORT
+  ArrayPortalQuantizedControl(const StorageHandleType &storage,
+                              const StoragePortalType &storagePortal,
+                              dax::Scalar scale,
+                              dax::Scalar offset)
+    : Portal(storagePortal, scale, offset), Storage(storage) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->Portal.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  ValueType Get(dax::Id index) const
+  {
+    return this->Portal.Get(index);
+  }
+
+  DAX_CONT_EXPORT
+  void Set(dax::Id index, const ValueType &value) const
+  {
+    this->Portal.Set(index, value);
+  }
+
+  DAX_CONT_EXPORT
+  const StorageHandleType &GetStorage() const { return this->Storage; }
+
+  DAX_CONT_EXPORT
+  dax::Scalar GetScale() const { return this->Portal.GetScale(); }
+
+  DAX_CONT_EXPORT
+  dax::Scalar GetOffset() const { return this->Portal.GetOffset(); }
+
+  typedef dax::cont::IteratorFromArrayPortal<
+      ArrayPortalQuantizedControl<StorageHandleType,StoragePortalType> >
+    IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const
+  {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const
+  {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+private:
+  ArrayPortalQuantized<StoragePortalType> Portal;
+  StorageHandleType Storage;
+};
+
+/// \brief A container of \c dax::Scalar values stored in a narrower type.
+///
+/// Many data sets (for example 8-bit or 16-bit sensor volumes) do not need the
+/// full precision of \c dax::Scalar, and widening them quadruples the memory
+/// and bandwidth required. An ArrayHandle with an
+/// ArrayContainerControlTagQuantized container references an ArrayHandle of
+/// narrow values (of type \c StorageHandleType) and decodes them to
+/// \c dax::Scalar (with an optional scale and offset) whenever a value is
+/// read, in both the control and execution environments.
+///
+/// Because the narrow values are owned by their own handle, a quantized array
+/// cannot allocate itself in the control environment. It can, however, be
+/// used as an output in the execution environment, in which case the storage
+/// array is allocated and written values are encoded.
+///
+template<class StorageHandleType>
+struct ArrayContainerControlTagQuantized {  };
+
+namespace internal {
+
+template<class StorageHandleType>
+class ArrayContainerControl<
+    dax::Scalar,
+    ArrayContainerControlTagQuantized<StorageHandleType> >
+{
+public:
+  typedef dax::Scalar ValueType;
+  typedef dax::cont::ArrayPortalQuantizedControl<
+      StorageHandleType, typename StorageHandleType::PortalControl>
+    PortalType;
+  typedef dax::cont::ArrayPortalQuantizedControl<
+      StorageHandleType, typename StorageHandleType::PortalConstControl>
+    PortalConstType;
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl() : Scale(1), Offset(0) {  }
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl(const StorageHandleType &storage,
+                        dax::Scalar scale,
+                        dax::Scalar offset)
+    : Storage(storage), Scale(scale), Offset(offset) {  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal()
+  {
+    return PortalType(this->Storage,
+                      this->Storage.GetPortalControl(),
+                      this->Scale,
+                      this->Offset);
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const
+  {
+    return PortalConstType(this->Storage,
+                           this->Storage.GetPortalConstControl(),
+                           this->Scale,
+                           this->Offset);
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->Storage.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id daxNotUsed(numberOfValues))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Quantized arrays cannot be allocated in the control environment.  "
+          "Allocate the storage array instead.");
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues)
+  {
+    this->Storage.Shrink(numberOfValues);
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources()
+  {
+    this->Storage.ReleaseResources();
+  }
+
+  DAX_CONT_EXPORT
+  const StorageHandleType &GetStorage() const { return this->Storage; }
+
+  DAX_CONT_EXPORT
+  dax::Scalar GetScale() const { return this->Scale; }
+
+  DAX_CONT_EXPORT
+  dax::Scalar GetOffset() const { return this->Offset; }
+
+private:
+  StorageHandleType Storage;
+  dax::Scalar Scale;
+  dax::Scalar Offset;
+};
+
+/// ArrayTransfer for quantized arrays. The narrow storage array is prepared
+/// for the execution environment through its own ArrayHandle and decoded on
+/// the fly by the execution portal, so only the narrow values are ever moved.
+///
+template<class StorageHandleType, class DeviceAdapterTag>
+class ArrayTransfer<
+    dax::Scalar,
+    ArrayContainerControlTagQuantized<StorageHandleType>,
+    DeviceAdapterTag>
+{
+private:
+  typedef ArrayContainerControlTagQuantized<StorageHandleType>
+      ArrayContainerControlTag;
+  typedef dax::cont::internal::ArrayContainerControl<
+      dax::Scalar,ArrayContainerControlTag> ContainerType;
+
+  typedef typename StorageHandleType::PortalExecution StoragePortalExecution;
+  typedef typename StorageHandleType::PortalConstExecution
+      StoragePortalConstExecution;
+
+public:
+  typedef dax::Scalar ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+  typedef dax::cont::ArrayPortalQuantized<StoragePortalExecution>
+      PortalExecution;
+  typedef dax::cont::ArrayPortalQuantized<StoragePortalConstExecution>
+      PortalConstExecution;
+
+  ArrayTransfer() : Scale(1), Offset(0), StorageValid(false) {  }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->StorageValid);
+    return this->Storage.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT void LoadDataForInput(PortalConstControl portal)
+  {
+    this->Storage = portal.GetStorage();
+    this->Scale = portal.GetScale();
+    this->Offset = portal.GetOffset();
+    this->StorageValid = true;
+    // Prepare the storage now so that any transfer errors are raised at the
+    // same point as for other array containers.
+    this->GetPortalConstExecution();
+  }
+
+  DAX_CONT_EXPORT void LoadDataForInPlace(ContainerType &controlArray)
+  {
+    this->Storage = controlArray.GetStorage();
+    this->Scale = controlArray.GetScale();
+    this->Offset = controlArray.GetOffset();
+    this->StorageValid = true;
+
+    this->Portal = PortalExecution(this->Storage.PrepareForInPlace(),
+                                   this->Scale,
+                                   this->Offset);
+  }
+
+  DAX_CONT_EXPORT void AllocateArrayForOutput(ContainerType &controlArray,
+                                              dax::Id numberOfValues)
+  {
+    this->Storage = controlArray.GetStorage();
+    this->Scale = controlArray.GetScale();
+    this->Offset = controlArray.GetOffset();
+    this->StorageValid = true;
+
+    this->Portal = PortalExecution(
+          this->Storage.PrepareForOutput(numberOfValues),
+          this->Scale,
+          this->Offset);
+  }
+
+  DAX_CONT_EXPORT void RetrieveOutputData(
+      ContainerType &daxNotUsed(controlArray)) const
+  {
+    // Nothing to do. The storage array holds the data and retrieves it itself
+    // when its control portal is requested.
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    DAX_ASSERT_CONT(this->StorageValid);
+    dax::cont::ArrayPortalQuantized<
+        typename StorageHandleType::PortalConstControl>
+        portal(this->Storage.GetPortalConstControl(), this->Scale, this->Offset);
+    std::copy(portal.GetIteratorBegin(), portal.GetIteratorEnd(), dest);
+  }
+
+  DAX_CONT_EXPORT void Shrink(dax::Id numberOfValues)
+  {
+    DAX_ASSERT_CONT(this->StorageValid);
+    this->Storage.Shrink(numberOfValues);
+  }
+
+  DAX_CONT_EXPORT PortalExecution GetPortalExecution()
+  {
+    return this->Portal;
+  }
+
+  DAX_CONT_EXPORT PortalConstExecution GetPortalConstExecution() const
+  {
+    DAX_ASSERT_CONT(this->StorageValid);
+    // The storage is asked for its input portal every time because it may
+    // have been changed since it was last prepared. This does nothing if it is
+    // already valid in the execution environment.
+    return PortalConstExecution(this->Storage.PrepareForInput(),
+                                this->Scale,
+                                this->Offset);
+  }
+
+  DAX_CONT_EXPORT void ReleaseResources()
+  {
+    // Nothing to do. The execution resources belong to the storage array,
+    // which releases them on its own when its control data is modified.
+  }
+
+private:
+  StorageHandleType Storage;
+  dax::Scalar Scale;
+  dax::Scalar Offset;
+  bool StorageValid;
+  PortalExecution Portal;
+};
+
+} // namespace internal
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayContainerControlQuantized_h
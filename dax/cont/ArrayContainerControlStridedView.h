@@ -0,0 +1,96 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayContainerControlStridedView_h
+#define __dax_cont_ArrayContainerControlStridedView_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlView.h>
+#include <dax/cont/ErrorControlBadValue.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief Where the values of a strided view are in its parent array.
+///
+/// The values of a strided view form a block of \c Dimensions values, with
+/// the first dimension varying fastest. The value at block location
+/// (i, j, k) is at index <tt>Start + i*Strides[0] + j*Strides[1] +
+/// k*Strides[2]</tt> of the parent. A sub-block of a structured point or cell
+/// field, possibly subsampled, is a strided view of that field.
+///
+/// An ArrayHandle with an ArrayContainerControlTagView container using this
+/// layout is a strided view. Unlike a contiguous view, it cannot be resized,
+/// so as an output it has to be written with exactly as many values as it
+/// holds.
+///
+struct StridedViewLayout
+{
+  dax::Id Start;
+  dax::Id3 Dimensions;
+  dax::Id3 Strides;
+
+  DAX_EXEC_CONT_EXPORT
+  StridedViewLayout()
+    : Start(0),
+      Dimensions(dax::make_Id3(0, 0, 0)),
+      Strides(dax::make_Id3(0, 0, 0)) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  StridedViewLayout(dax::Id start, dax::Id3 dimensions, dax::Id3 strides)
+    : Start(start), Dimensions(dimensions), Strides(strides) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->Dimensions[0]*this->Dimensions[1]*this->Dimensions[2];
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetParentIndex(dax::Id index) const
+  {
+    const dax::Id i = index % this->Dimensions[0];
+    const dax::Id jk = index / this->Dimensions[0];
+    const dax::Id j = jk % this->Dimensions[1];
+    const dax::Id k = jk / this->Dimensions[1];
+    return this->Start
+        + i*this->Strides[0] + j*this->Strides[1] + k*this->Strides[2];
+  }
+
+  /// The largest parent index used, or -1 for an empty view.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetLastParentIndex() const
+  {
+    if (this->GetNumberOfValues() <= 0) { return -1; }
+    return this->GetParentIndex(this->GetNumberOfValues() - 1);
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues)
+  {
+    if (numberOfValues != this->GetNumberOfValues())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Strided array views cannot be resized.");
+      }
+  }
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayContainerControlStridedView_h
@@ -0,0 +1,167 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayContainerControlUserMemory_h
+#define __dax_cont_ArrayContainerControlUserMemory_h
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/ArrayPortalFromIterators.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/ErrorControlOutOfMemory.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace dax {
+namespace cont {
+
+/// \brief A container for caller-owned memory.
+///
+/// An ArrayContainerControl with this tag wraps a buffer owned by the caller
+/// (for example a field of a simulation) without copying it. Unlike an
+/// ArrayHandle constructed from a user portal, which is read only, the buffer
+/// can be written in the control environment and used for in place and output
+/// operations in the execution environment, so worklets write their results
+/// directly into the caller's memory.
+///
+/// The buffer has a fixed capacity. The array can be allocated (for example
+/// by \c PrepareForOutput) to any size up to the capacity, and an attempt to
+/// allocate more throws an ErrorControlOutOfMemory rather than reallocating
+/// the caller's memory. By default the buffer is only borrowed and is never
+/// freed; a deleter can be given to pass ownership of the buffer to the array,
+/// in which case the deleter is called when the last reference to the array
+/// goes away.
+///
+struct ArrayContainerControlTagUserMemory {  };
+
+namespace internal {
+
+template <typename ValueT>
+class ArrayContainerControl<ValueT, dax::cont::ArrayContainerControlTagUserMemory>
+{
+public:
+  typedef ValueT ValueType;
+  typedef dax::cont::ArrayPortalFromIterators<ValueType*> PortalType;
+  typedef dax::cont::ArrayPortalFromIterators<const ValueType*> PortalConstType;
+
+  /// The type of the function called to release an owned buffer.
+  ///
+  typedef void (*DeleterType)(ValueType *);
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl() : NumberOfValues(0), Capacity(0) {  }
+
+  /// Wraps \c array, which currently holds \c numberOfValues values and has
+  /// room for \c capacity values. If \c deleter is not NULL, the container
+  /// takes ownership of the buffer and releases it with \c deleter.
+  ///
+  DAX_CONT_EXPORT
+  ArrayContainerControl(ValueType *array,
+                        dax::Id numberOfValues,
+                        dax::Id capacity,
+                        DeleterType deleter = NULL)
+    : NumberOfValues(numberOfValues), Capacity(capacity)
+  {
+    if ((numberOfValues < 0) || (numberOfValues > capacity))
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "User memory holds more values than its capacity.");
+      }
+    if (deleter != NULL)
+      {
+      this->Array = boost::shared_ptr<ValueType>(array, deleter);
+      }
+    else
+      {
+      this->Array = boost::shared_ptr<ValueType>(array, BorrowedDeleter());
+      }
+  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal()
+  {
+    return PortalType(this->Array.get(),
+                      this->Array.get() + this->NumberOfValues);
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const
+  {
+    return PortalConstType(this->Array.get(),
+                           this->Array.get() + this->NumberOfValues);
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->NumberOfValues;
+  }
+
+  /// Returns the number of values the user buffer has room for.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetCapacity() const
+  {
+    return this->Capacity;
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id numberOfValues)
+  {
+    if (numberOfValues > this->Capacity)
+      {
+      throw dax::cont::ErrorControlOutOfMemory(
+            "Requested size exceeds the capacity of the user memory.");
+      }
+    this->NumberOfValues = numberOfValues;
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues)
+  {
+    if (numberOfValues > this->NumberOfValues)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Shrink method cannot be used to grow array.");
+      }
+    this->NumberOfValues = numberOfValues;
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources()
+  {
+    // The buffer belongs to the caller (or is released by its deleter when
+    // the last copy of this container goes away), so only forget the values.
+    this->NumberOfValues = 0;
+  }
+
+private:
+  struct BorrowedDeleter
+  {
+    void operator()(ValueType *) const {  }
+  };
+
+  boost::shared_ptr<ValueType> Array;
+  dax::Id NumberOfValues;
+  dax::Id Capacity;
+};
+
+} // namespace internal
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayContainerControlUserMemory_h
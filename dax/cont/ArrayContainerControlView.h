@@ -0,0 +1,502 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayContainerControlView_h
+#define __dax_cont_ArrayContainerControlView_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/IteratorFromArrayPortal.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+
+/// \brief Where the values of a contiguous view are in its parent array.
+///
+/// The \c NumberOfValues values of the view start at index \c Start of the
+/// parent. This is the layout of ArrayHandleView. Other layouts, such as
+/// StridedViewLayout, provide the same methods: the number of values, the
+/// parent index of each value, the largest parent index used (-1 for an
+/// empty view) and a Shrink that throws when the view cannot hold the given
+/// number of values.
+///
+struct ViewLayout
+{
+  dax::Id Start;
+  dax::Id NumberOfValues;
+
+  DAX_EXEC_CONT_EXPORT
+  ViewLayout() : Start(0), NumberOfValues(0) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  ViewLayout(dax::Id start, dax::Id numberOfValues)
+    : Start(start), NumberOfValues(numberOfValues) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const { return this->NumberOfValues; }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetParentIndex(dax::Id index) const { return this->Start + index; }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetLastParentIndex() const
+  {
+    return this->Start + this->NumberOfValues - 1;
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues)
+  {
+    if (numberOfValues > this->NumberOfValues)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "An array view cannot be resized to hold more values than its "
+            "window of the parent array.");
+      }
+    this->NumberOfValues = numberOfValues;
+  }
+};
+
+template<class ParentPortalType, class LayoutType = dax::cont::ViewLayout>
+class ArrayPortalView;
+
+namespace internal {
+
+/// The iterators of a view portal go through the Get and Set of the portal.
+///
+template<class ParentPortalType, class LayoutType>
+struct ArrayPortalViewIterators
+{
+  typedef dax::cont::ArrayPortalView<ParentPortalType,LayoutType> PortalType;
+  typedef dax::cont::IteratorFromArrayPortal<PortalType> IteratorType;
+
+  DAX_CONT_EXPORT
+  static IteratorType GetBegin(const PortalType &portal)
+  {
+    return IteratorType(portal);
+  }
+
+  DAX_CONT_EXPORT
+  static IteratorType GetEnd(const PortalType &portal)
+  {
+    return IteratorType(portal, portal.GetNumberOfValues());
+  }
+};
+
+/// The iterators of a contiguous view are the iterators of the parent offset
+/// to the start of the window, so algorithms that work on raw iterators (such
+/// as sorting) run directly on the parent's memory.
+///
+template<class ParentPortalType>
+struct ArrayPortalViewIterators<ParentPortalType, dax::cont::ViewLayout>
+{
+  typedef dax::cont::ArrayPortalView<ParentPortalType,dax::cont::ViewLayout>
+      PortalType;
+  typedef typename ParentPortalType::IteratorType IteratorType;
+
+  DAX_CONT_EXPORT
+  static IteratorType GetBegin(const PortalType &portal)
+  {
+    return portal.GetParentPortal().GetIteratorBegin()
+        + portal.GetLayout().Start;
+  }
+
+  DAX_CONT_EXPORT
+  static IteratorType GetEnd(const PortalType &portal)
+  {
+    return GetBegin(portal) + portal.GetNumberOfValues();
+  }
+};
+
+} // namespace internal
+
+/// \brief An array portal that gives a view into another portal.
+///
+/// ArrayPortalView presents the values of a parent portal picked by a layout
+/// (by default a contiguous ViewLayout) as an array of its own. Values are
+/// read from and written to the parent, so nothing is copied. This portal is
+/// used in the execution environment by arrays with an
+/// ArrayContainerControlTagView container.
+///
+template<class ParentPortalType, class LayoutType>
+class ArrayPortalView
+{
+public:
+  typedef typename ParentPortalType::ValueType ValueType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalView() {  }
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalView(const ParentPortalType &parentPortal,
+                  const LayoutType &layout)
+    : ParentPortal(parentPortal), Layout(layout) {  }
+
+  /// Copy constructor for any other ArrayPortalView with a parent portal
+  /// type that can be copied to this parent portal type. This allows us to do
+  /// any type casting that the parent portals do (like the non-const to const
+  /// cast).
+  ///
+  template<class OtherParentPortalType>
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalView(const ArrayPortalView<OtherParentPortalType,LayoutType> &src)
+    : ParentPortal(src.GetParentPortal()), Layout(src.GetLayout()) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->Layout.GetNumberOfValues();
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(dax::Id index) const
+  {
+    return this->ParentPortal.Get(this->Layout.GetParentIndex(index));
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  void Set(dax::Id index, const ValueType &value) const
+  {
+    this->ParentPortal.Set(this->Layout.GetParentIndex(index), value);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const ParentPortalType &GetParentPortal() const
+  {
+    return this->ParentPortal;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const LayoutType &GetLayout() const { return this->Layout; }
+
+  typedef typename dax::cont::internal::ArrayPortalViewIterators<
+      ParentPortalType,LayoutType>::IteratorType IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const
+  {
+    return dax::cont::internal::ArrayPortalViewIterators<
+        ParentPortalType,LayoutType>::GetBegin(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const
+  {
+    return dax::cont::internal::ArrayPortalViewIterators<
+        ParentPortalType,LayoutType>::GetEnd(*this);
+  }
+
+private:
+  ParentPortalType ParentPortal;
+  LayoutType Layout;
+};
+
+/// \brief The control array portal of a view array.
+///
+/// Rather than holding a portal, this control portal holds the ArrayHandle of
+/// the parent array so that values are always read from (and written to) the
+/// current data of the parent, wherever it is valid.
+///
+template<class ParentHandleType, class LayoutType = dax::cont::ViewLayout>
+class ArrayPortalViewControl
+{
+public:
+  typedef typename ParentHandleType::ValueType ValueType;
+
+  DAX_CONT_EXPORT
+  ArrayPortalViewControl() {  }
+
+  DAX_CONT_EXPORT
+  ArrayPortalViewControl(const ParentHandleType &parent,
+                         const LayoutType &layout)
+    : Parent(parent), Layout(layout) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->Layout.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  ValueType Get(dax::Id index) const
+  {
+    return this->Parent.GetPortalConstControl().Get(
+          this->Layout.GetParentIndex(index));
+  }
+
+  DAX_CONT_EXPORT
+  void Set(dax::Id index, const ValueType &value) const
+  {
+    // ArrayHandle is a reference, so writing through a copy modifies the
+    // same array.
+    ParentHandleType handle = this->Parent;
+    handle.GetPortalControl().Set(this->Layout.GetParentIndex(index), value);
+  }
+
+  DAX_CONT_EXPORT
+  const ParentHandleType &GetParent() const { return this->Parent; }
+
+  DAX_CONT_EXPORT
+  const LayoutType &GetLayout() const { return this->Layout; }
+
+  typedef dax::cont::IteratorFromArrayPortal<
+      ArrayPortalViewControl<ParentHandleType,LayoutType> > IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const
+  {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const
+  {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+private:
+  ParentHandleType Parent;
+  LayoutType Layout;
+};
+
+/// \brief A container for a view of another array.
+///
+/// An ArrayHandle with an ArrayContainerControlTagView container references
+/// an ArrayHandle (of type \c ParentHandleType) and presents the values
+/// picked by a layout as an array of its own: a contiguous window with the
+/// default ViewLayout, a strided block with StridedViewLayout. The values are
+/// never copied; both the control and execution portals index into the
+/// parent's storage, and the parent array's own handle keeps track of where
+/// its data is valid.
+///
+/// A view cannot change the size of its parent. It cannot be allocated in the
+/// control environment, and using it as an output in the execution
+/// environment writes into the view of the (already allocated) parent,
+/// leaving the rest of the parent untouched. How many values the output can
+/// hold is up to the layout.
+///
+template<class ParentHandleType, class LayoutType = dax::cont::ViewLayout>
+struct ArrayContainerControlTagView {  };
+
+namespace internal {
+
+template<class ParentHandleType, class LayoutType>
+class ArrayContainerControl<
+    typename ParentHandleType::ValueType,
+    ArrayContainerControlTagView<ParentHandleType,LayoutType> >
+{
+public:
+  typedef typename ParentHandleType::ValueType ValueType;
+  typedef dax::cont::ArrayPortalViewControl<ParentHandleType,LayoutType>
+      PortalType;
+  typedef PortalType PortalConstType;
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl() {  }
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl(const ParentHandleType &parent,
+                        const LayoutType &layout)
+    : Parent(parent), Layout(layout) {  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal()
+  {
+    return PortalType(this->Parent, this->Layout);
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const
+  {
+    return PortalConstType(this->Parent, this->Layout);
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->Layout.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id daxNotUsed(numberOfValues))
+  {
+    throw dax::cont::ErrorControlBadValue(
+          "Array views cannot be allocated in the control environment.  "
+          "Allocate the parent array instead.");
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues)
+  {
+    this->Layout.Shrink(numberOfValues);
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources()
+  {
+    // The data belongs to the parent array, so just forget the view.
+    this->Layout = LayoutType();
+  }
+
+private:
+  ParentHandleType Parent;
+  LayoutType Layout;
+};
+
+/// ArrayTransfer for array views. The parent array is prepared for the
+/// execution environment through its own ArrayHandle (so the parent tracks
+/// whether its control or execution data is current) and the execution portal
+/// indexes into it.
+///
+template<class ParentHandleType, class LayoutType, class DeviceAdapterTag>
+class ArrayTransfer<
+    typename ParentHandleType::ValueType,
+    ArrayContainerControlTagView<ParentHandleType,LayoutType>,
+    DeviceAdapterTag>
+{
+private:
+  typedef ArrayContainerControlTagView<ParentHandleType,LayoutType>
+      ArrayContainerControlTag;
+  typedef dax::cont::internal::ArrayContainerControl<
+      typename ParentHandleType::ValueType,ArrayContainerControlTag>
+      ContainerType;
+
+public:
+  typedef typename ParentHandleType::ValueType ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+  typedef dax::cont::ArrayPortalView<
+      typename ParentHandleType::PortalExecution,LayoutType> PortalExecution;
+  typedef dax::cont::ArrayPortalView<
+      typename ParentHandleType::PortalConstExecution,LayoutType>
+      PortalConstExecution;
+
+  ArrayTransfer() : ViewValid(false) {  }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->ViewValid);
+    return this->View.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT void LoadDataForInput(PortalConstControl portal)
+  {
+    this->View = portal;
+    this->ViewValid = true;
+    // Prepare the parent now so that any transfer errors are raised at the
+    // same point as for other array containers.
+    this->GetPortalConstExecution();
+  }
+
+  DAX_CONT_EXPORT void LoadDataForInPlace(ContainerType &controlArray)
+  {
+    this->View = controlArray.GetPortalConst();
+    this->ViewValid = true;
+    this->GetPortalExecution();
+  }
+
+  DAX_CONT_EXPORT void AllocateArrayForOutput(ContainerType &controlArray,
+                                              dax::Id numberOfValues)
+  {
+    const PortalConstControl portal = controlArray.GetPortalConst();
+    LayoutType layout = portal.GetLayout();
+    layout.Shrink(numberOfValues);
+    this->View = PortalConstControl(portal.GetParent(), layout);
+    this->ViewValid = true;
+    // Only the view is written, so the rest of the parent has to be kept.
+    this->GetPortalExecution();
+  }
+
+  DAX_CONT_EXPORT void RetrieveOutputData(ContainerType &controlArray) const
+  {
+    // The parent holds the data and retrieves it itself when its control
+    // portal is requested. Only the size of the view may have changed.
+    controlArray.Shrink(this->View.GetNumberOfValues());
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    DAX_ASSERT_CONT(this->ViewValid);
+    std::copy(this->View.GetIteratorBegin(), this->View.GetIteratorEnd(),
+              dest);
+  }
+
+  DAX_CONT_EXPORT void Shrink(dax::Id numberOfValues)
+  {
+    DAX_ASSERT_CONT(this->ViewValid);
+    LayoutType layout = this->View.GetLayout();
+    layout.Shrink(numberOfValues);
+    this->View = PortalConstControl(this->View.GetParent(), layout);
+  }
+
+  DAX_CONT_EXPORT PortalExecution GetPortalExecution()
+  {
+    DAX_ASSERT_CONT(this->ViewValid);
+    this->CheckLayout();
+    // The parent is prepared every time because its data may have been
+    // moved (or modified in the control environment) since it was last
+    // prepared. This also marks the parent's control data as stale, which is
+    // what we want since the portal returned may be written to.
+    ParentHandleType parent = this->View.GetParent();
+    return PortalExecution(parent.PrepareForInPlace(),
+                           this->View.GetLayout());
+  }
+
+  DAX_CONT_EXPORT PortalConstExecution GetPortalConstExecution() const
+  {
+    DAX_ASSERT_CONT(this->ViewValid);
+    this->CheckLayout();
+    // The parent is asked for its input portal every time because it may
+    // have been changed since it was last prepared. This does nothing if it is
+    // already valid in the execution environment.
+    return PortalConstExecution(this->View.GetParent().PrepareForInput(),
+                                this->View.GetLayout());
+  }
+
+  DAX_CONT_EXPORT void ReleaseResources()
+  {
+    // Nothing to do. The execution resources belong to the parent array,
+    // which releases them on its own when its control data is modified.
+  }
+
+private:
+  DAX_CONT_EXPORT void CheckLayout() const
+  {
+    if (this->View.GetLayout().GetLastParentIndex()
+        >= this->View.GetParent().GetNumberOfValues())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "The parent array of a view has been shrunk past the values of "
+            "the view.");
+      }
+  }
+
+  PortalConstControl View;
+  bool ViewValid;
+};
+
+} // namespace internal
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayContainerControlView_h
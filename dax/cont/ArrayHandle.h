@@ -100,6 +100,25 @@ public:
     this->Internals->ExecutionArrayValid = false;
   }
 
+protected:
+  /// Constructs an ArrayHandle around an already constructed control
+  /// container. This is used by specialized array handles whose containers
+  /// reference data held elsewhere (such as the component arrays of an
+  /// ArrayHandleCompositeVector) rather than being allocated by the handle.
+  ///
+  DAX_CONT_EXPORT explicit ArrayHandle(
+      const ArrayContainerControlType &container)
+    : Internals(new InternalStruct)
+  {
+    this->Internals->UserPortalValid = false;
+
+    this->Internals->ControlArray = container;
+    this->Internals->ControlArrayValid = true;
+
+    this->Internals->ExecutionArrayValid = false;
+  }
+
+public:
   /// Get the array portal of the control array.
   ///
   DAX_CONT_EXPORT PortalControl GetPortalControl()
@@ -166,6 +185,24 @@ public:
       }
   }
 
+  /// Returns a key that is the same for this handle and all of its copies
+  /// (which share the same data) and different for any other array that is
+  /// alive. Used to track which operations use which arrays.
+  ///
+  DAX_CONT_EXPORT const void *GetArrayId() const
+  {
+    return this->Internals.get();
+  }
+
+  /// Returns the number of handles (this one and its copies) currently
+  /// sharing the array. Used to find arrays that nothing outside of a set of
+  /// known handles refers to.
+  ///
+  DAX_CONT_EXPORT long GetNumberOfReferences() const
+  {
+    return this->Internals.use_count();
+  }
+
   /// Copies data into the given iterator for the control environment. This
   /// method can skip copying into an internally managed control array.
   ///
@@ -226,6 +263,90 @@ public:
     DAX_ASSERT_CONT(this->GetNumberOfValues() == numberOfValues);
   }
 
+  /// \brief Makes room to grow the array without reallocating it.
+  ///
+  /// After this call the array can be grown (with Grow) to up to \c
+  /// numberOfValues without being reallocated. The size and values of the
+  /// array are unchanged. The room is made in the environment currently
+  /// holding the data. An array with no data becomes a valid, empty array in
+  /// the control environment.
+  ///
+  DAX_CONT_EXPORT void Reserve(dax::Id numberOfValues)
+  {
+    if (this->Internals->UserPortalValid)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "ArrayHandle has a read-only control portal.");
+      }
+    if (this->Internals->ExecutionArrayValid
+        && !this->Internals->ControlArrayValid)
+      {
+      this->Internals->ExecutionArray.Reserve(this->Internals->ControlArray,
+                                              numberOfValues);
+      }
+    else
+      {
+      // Reallocating the control array invalidates any execution array that
+      // shares it.
+      this->ReleaseResourcesExecution();
+      if (!this->Internals->ControlArrayValid)
+        {
+        this->Internals->ControlArray.Allocate(0);
+        this->Internals->ControlArrayValid = true;
+        }
+      this->Internals->ControlArray.Reserve(numberOfValues);
+      }
+  }
+
+  /// \brief Increases the size of the array without changing its values.
+  ///
+  /// This is the opposite of Shrink. The number of entries in the array is
+  /// changed to \c numberOfValues, which must be equal or greater than the
+  /// preexisting size. The data in the array (from indices 0 to the
+  /// preexisting size - 1) are the same, and the values past them are
+  /// undefined until written, for example through the portal returned by
+  /// PrepareForInPlace. The array is grown in the environment currently
+  /// holding the data, and when it has to be reallocated its capacity is at
+  /// least doubled, so an array collected a piece at a time (see
+  /// DeviceAdapterAlgorithm::Append) takes amortized constant time per value.
+  ///
+  DAX_CONT_EXPORT void Grow(dax::Id numberOfValues)
+  {
+    dax::Id originalNumberOfValues = this->GetNumberOfValues();
+
+    if (numberOfValues < originalNumberOfValues)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "ArrayHandle::Grow cannot be used to shrink array.");
+      }
+    if (this->Internals->UserPortalValid)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "ArrayHandle has a read-only control portal.");
+      }
+
+    if (this->Internals->ExecutionArrayValid
+        && !this->Internals->ControlArrayValid)
+      {
+      this->Internals->ExecutionArray.Grow(this->Internals->ControlArray,
+                                           numberOfValues);
+      }
+    else
+      {
+      // Reallocating the control array invalidates any execution array that
+      // shares it.
+      this->ReleaseResourcesExecution();
+      if (!this->Internals->ControlArrayValid)
+        {
+        this->Internals->ControlArray.Allocate(0);
+        this->Internals->ControlArrayValid = true;
+        }
+      this->Internals->ControlArray.Grow(numberOfValues);
+      }
+
+    DAX_ASSERT_CONT(this->GetNumberOfValues() == numberOfValues);
+  }
+
   /// Releases any resources being used in the execution environment (that are
   /// not being shared by the control environment).
   ///
@@ -497,4 +618,8 @@ make_ArrayHandle(const std::vector<T,Allocator> &array)
 //handles when you include array handle
 #include <dax/cont/ArrayHandleCounting.h>
 #include <dax/cont/ArrayHandleConstantValue.h>
+#include <dax/cont/ArrayHandleCompositeVector.h>
+#include <dax/cont/ArrayHandleQuantized.h>
+#include <dax/cont/ArrayHandleUserMemory.h>
+#include <dax/cont/ArrayHandleView.h>
 #endif //__dax_cont_ArrayHandle_h
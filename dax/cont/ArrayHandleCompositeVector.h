@@ -0,0 +1,116 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleCompositeVector_h
+#define __dax_cont_ArrayHandleCompositeVector_h
+
+#include <dax/cont/ArrayContainerControlCompositeVector.h>
+#include <dax/cont/ArrayHandle.h>
+
+namespace dax {
+namespace cont {
+
+/// ArrayHandleCompositeVectors are a specialization of ArrayHandles. They
+/// reference \c NumComponents ArrayHandles of the same type and present them
+/// as a single array of \c dax::Tuple values without copying. For example,
+/// three \c dax::Scalar arrays holding separate x, y, and z coordinates can be
+/// used wherever an array of \c dax::Vector3 is expected. The composite array
+/// can be read and written in both the control and execution environments;
+/// writes go directly to the component arrays.
+template<class ComponentHandleType, int NumComponents>
+class ArrayHandleCompositeVector
+    : public ArrayHandle<
+        dax::Tuple<typename ComponentHandleType::ValueType, NumComponents>,
+        dax::cont::ArrayContainerControlTagCompositeVector<
+          ComponentHandleType,NumComponents>,
+        typename ComponentHandleType::DeviceAdapterTag>
+{
+public:
+  typedef dax::cont::ArrayHandle<
+      dax::Tuple<typename ComponentHandleType::ValueType, NumComponents>,
+      dax::cont::ArrayContainerControlTagCompositeVector<
+        ComponentHandleType,NumComponents>,
+      typename ComponentHandleType::DeviceAdapterTag> superclass;
+  typedef dax::cont::internal::ArrayContainerControl<
+      typename superclass::ValueType,
+      typename superclass::ArrayContainerControlTag> ContainerType;
+
+  /// Constructs a composite array from an array of \c NumComponents handles.
+  /// All of the components must have the same number of values.
+  ///
+  ArrayHandleCompositeVector(const ComponentHandleType *components)
+    : superclass(ContainerType(components))
+  {
+    for (int component = 1; component < NumComponents; component++)
+      {
+      if (components[component].GetNumberOfValues()
+          != components[0].GetNumberOfValues())
+        {
+        throw dax::cont::ErrorControlBadValue(
+              "All components of a composite vector array must have the "
+              "same number of values.");
+        }
+      }
+  }
+};
+
+/// A convenience function for creating an ArrayHandleCompositeVector of two
+/// components.
+template<class ComponentHandleType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleCompositeVector<ComponentHandleType,2>
+make_ArrayHandleCompositeVector(const ComponentHandleType &component0,
+                                const ComponentHandleType &component1)
+{
+  ComponentHandleType components[2] = { component0, component1 };
+  return dax::cont::ArrayHandleCompositeVector<ComponentHandleType,2>(
+        components);
+}
+
+/// A convenience function for creating an ArrayHandleCompositeVector of three
+/// components. When the components are arrays of \c dax::Scalar, the result
+/// is an array of \c dax::Vector3.
+template<class ComponentHandleType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleCompositeVector<ComponentHandleType,3>
+make_ArrayHandleCompositeVector(const ComponentHandleType &component0,
+                                const ComponentHandleType &component1,
+                                const ComponentHandleType &component2)
+{
+  ComponentHandleType components[3] = { component0, component1, component2 };
+  return dax::cont::ArrayHandleCompositeVector<ComponentHandleType,3>(
+        components);
+}
+
+/// A convenience function for creating an ArrayHandleCompositeVector of four
+/// components.
+template<class ComponentHandleType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleCompositeVector<ComponentHandleType,4>
+make_ArrayHandleCompositeVector(const ComponentHandleType &component0,
+                                const ComponentHandleType &component1,
+                                const ComponentHandleType &component2,
+                                const ComponentHandleType &component3)
+{
+  ComponentHandleType components[4] =
+    { component0, component1, component2, component3 };
+  return dax::cont::ArrayHandleCompositeVector<ComponentHandleType,4>(
+        components);
+}
+
+}
+}
+
+#endif //__dax_cont_ArrayHandleCompositeVector_h
@@ -0,0 +1,194 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleCompressedConnectivity_h
+#define __dax_cont_ArrayHandleCompressedConnectivity_h
+
+#include <dax/cont/ArrayContainerControlCompressedConnectivity.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+
+#include <dax/exec/internal/ErrorMessageBuffer.h>
+
+namespace dax {
+namespace cont {
+
+namespace internal {
+
+/// Computes the base and deltas of each cell from a regular connections
+/// array. Raises an error if a delta does not fit in the delta type.
+///
+template<class ConnectionsPortalType,
+         class BasePortalType,
+         class DeltaPortalType,
+         int NumVertices>
+struct CompressConnectivityKernel
+{
+  typedef typename DeltaPortalType::ValueType DeltaType;
+
+  DAX_CONT_EXPORT
+  CompressConnectivityKernel(const ConnectionsPortalType &connections,
+                             const BasePortalType &bases,
+                             const DeltaPortalType &deltas)
+    : Connections(connections), Bases(bases), Deltas(deltas) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id cellIndex) const
+  {
+    const dax::Id start = cellIndex*NumVertices;
+    dax::Id base = this->Connections.Get(start);
+    for (int vertexIndex = 1; vertexIndex < NumVertices; vertexIndex++)
+      {
+      dax::Id pointIndex = this->Connections.Get(start + vertexIndex);
+      base = (pointIndex < base) ? pointIndex : base;
+      }
+    this->Bases.Set(cellIndex, base);
+
+    for (int vertexIndex = 0; vertexIndex < NumVertices; vertexIndex++)
+      {
+      const dax::Id delta = this->Connections.Get(start + vertexIndex) - base;
+      const DeltaType narrowDelta = static_cast<DeltaType>(delta);
+      if (static_cast<dax::Id>(narrowDelta) != delta)
+        {
+        this->ErrorMessage.RaiseError(
+              "Cell connections span too many points for the delta type of "
+              "the compressed connectivity array.");
+        }
+      this->Deltas.Set(start + vertexIndex, narrowDelta);
+      }
+  }
+
+  DAX_CONT_EXPORT
+  void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &errorMessage)
+  {
+    this->ErrorMessage = errorMessage;
+  }
+
+  ConnectionsPortalType Connections;
+  BasePortalType Bases;
+  DeltaPortalType Deltas;
+  dax::exec::internal::ErrorMessageBuffer ErrorMessage;
+};
+
+} // namespace internal
+
+/// ArrayHandleCompressedConnectivity is a specialization of ArrayHandle for
+/// the connections of an unstructured grid. It stores a point index base for
+/// each cell of \c NumVertices vertices and a narrow delta (held in an array
+/// of type \c DeltaHandleType) for each vertex, reducing the size of the
+/// connections of a hexahedral mesh with 32-bit connectivity ids from 32 bytes
+/// per cell to 20 bytes per cell with <tt>unsigned short</tt> deltas. The connections are
+/// decoded when the topology of a cell is requested, so the compressed array
+/// can be used directly as the connections of an UnstructuredGrid.
+///
+template<class DeltaHandleType, int NumVertices>
+class ArrayHandleCompressedConnectivity
+    : public ArrayHandle<
+        dax::ConnectivityId,
+        dax::cont::ArrayContainerControlTagCompressedConnectivity<
+          DeltaHandleType,NumVertices>,
+        typename DeltaHandleType::DeviceAdapterTag>
+{
+public:
+  typedef dax::cont::ArrayHandle<
+      dax::ConnectivityId,
+      dax::cont::ArrayContainerControlTagCompressedConnectivity<
+        DeltaHandleType,NumVertices>,
+      typename DeltaHandleType::DeviceAdapterTag> superclass;
+  typedef dax::cont::internal::ArrayContainerControl<
+      typename superclass::ValueType,
+      typename superclass::ArrayContainerControlTag> ContainerType;
+  typedef typename ContainerType::BaseHandleType BaseHandleType;
+  typedef typename DeltaHandleType::DeviceAdapterTag DeviceAdapterTag;
+
+  /// Constructs the compressed array from already computed bases (one per
+  /// cell) and deltas (one per vertex).
+  ///
+  ArrayHandleCompressedConnectivity(const BaseHandleType &bases,
+                                    const DeltaHandleType &deltas)
+    : superclass(ContainerType(bases, deltas))
+  {
+    if (bases.GetNumberOfValues()*NumVertices != deltas.GetNumberOfValues())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Compressed connectivity needs one delta per vertex of each "
+            "base.");
+      }
+  }
+
+  /// Compresses a regular connections array in the execution environment.
+  /// Throws an ErrorExecution if the point indices of a cell span more than
+  /// the delta type can hold.
+  ///
+  template<class ConnectionsContainerTag>
+  explicit ArrayHandleCompressedConnectivity(
+      const dax::cont::ArrayHandle<
+        dax::ConnectivityId,ConnectionsContainerTag,DeviceAdapterTag> &connections)
+    : superclass(Compress(connections)) {  }
+
+private:
+  template<class ConnectionsContainerTag>
+  static ContainerType Compress(
+      const dax::cont::ArrayHandle<
+        dax::ConnectivityId,ConnectionsContainerTag,DeviceAdapterTag> &connections)
+  {
+    if ((connections.GetNumberOfValues() % NumVertices) != 0)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Connections array does not hold a whole number of cells.");
+      }
+    const dax::Id numberOfCells = connections.GetNumberOfValues()/NumVertices;
+
+    BaseHandleType bases;
+    DeltaHandleType deltas;
+    typedef dax::cont::internal::CompressConnectivityKernel<
+        typename dax::cont::ArrayHandle<
+          dax::ConnectivityId,ConnectionsContainerTag,DeviceAdapterTag>::PortalConstExecution,
+        typename BaseHandleType::PortalExecution,
+        typename DeltaHandleType::PortalExecution,
+        NumVertices> KernelType;
+    KernelType kernel(connections.PrepareForInput(),
+                      bases.PrepareForOutput(numberOfCells),
+                      deltas.PrepareForOutput(connections.GetNumberOfValues()));
+    dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(
+          kernel, numberOfCells);
+
+    return ContainerType(bases, deltas);
+  }
+};
+
+/// A convenience function that compresses the connections of an unstructured
+/// grid of \c CellTag cells using \c DeltaType deltas (for example
+/// <tt>make_ArrayHandleCompressedConnectivity<dax::CellTagTetrahedron,
+/// unsigned short>(grid.GetCellConnections())</tt>).
+///
+template<class CellTag, typename DeltaType, class ContainerTag, class Device>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleCompressedConnectivity<
+    dax::cont::ArrayHandle<DeltaType,ContainerTag,Device>,
+    dax::CellTraits<CellTag>::NUM_VERTICES>
+make_ArrayHandleCompressedConnectivity(
+    const dax::cont::ArrayHandle<dax::ConnectivityId,ContainerTag,Device> &connections)
+{
+  return dax::cont::ArrayHandleCompressedConnectivity<
+      dax::cont::ArrayHandle<DeltaType,ContainerTag,Device>,
+      dax::CellTraits<CellTag>::NUM_VERTICES>(connections);
+}
+
+}
+}
+
+#endif //__dax_cont_ArrayHandleCompressedConnectivity_h
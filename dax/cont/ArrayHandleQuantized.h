@@ -0,0 +1,78 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleQuantized_h
+#define __dax_cont_ArrayHandleQuantized_h
+
+#include <dax/cont/ArrayContainerControlQuantized.h>
+#include <dax/cont/ArrayHandle.h>
+
+namespace dax {
+namespace cont {
+
+/// ArrayHandleQuantizeds are a specialization of ArrayHandles. They reference
+/// an ArrayHandle of narrow values (such as <tt>unsigned char</tt>,
+/// <tt>unsigned short</tt>, or dax::cont::Half) and present it as an array of
+/// \c dax::Scalar, decoding each value as <tt>scale * stored + offset</tt>
+/// when it is read. The narrow values are what get transferred to the
+/// execution environment, so a quantized array can be passed to any worklet
+/// expecting a scalar field at a fraction of the memory and bandwidth.
+template<class StorageHandleType>
+class ArrayHandleQuantized
+    : public ArrayHandle<
+        dax::Scalar,
+        dax::cont::ArrayContainerControlTagQuantized<StorageHandleType>,
+        typename StorageHandleType::DeviceAdapterTag>
+{
+public:
+  typedef dax::cont::ArrayHandle<
+      dax::Scalar,
+      dax::cont::ArrayContainerControlTagQuantized<StorageHandleType>,
+      typename StorageHandleType::DeviceAdapterTag> superclass;
+  typedef dax::cont::internal::ArrayContainerControl<
+      typename superclass::ValueType,
+      typename superclass::ArrayContainerControlTag> ContainerType;
+
+  ArrayHandleQuantized(const StorageHandleType &storage,
+                       dax::Scalar scale = 1,
+                       dax::Scalar offset = 0)
+    : superclass(ContainerType(storage, scale, offset))
+  {
+    if (scale == 0)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "The scale of a quantized array cannot be zero.");
+      }
+  }
+};
+
+/// A convenience function for creating an ArrayHandleQuantized. It takes the
+/// array of narrow values and the scale and offset used to decode them.
+template<class StorageHandleType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleQuantized<StorageHandleType>
+make_ArrayHandleQuantized(const StorageHandleType &storage,
+                          dax::Scalar scale = 1,
+                          dax::Scalar offset = 0)
+{
+  return dax::cont::ArrayHandleQuantized<StorageHandleType>(storage,
+                                                            scale,
+                                                            offset);
+}
+
+}
+}
+
+#endif //__dax_cont_ArrayHandleQuantized_h
@@ -0,0 +1,97 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleStridedView_h
+#define __dax_cont_ArrayHandleStridedView_h
+
+#include <dax/cont/ArrayContainerControlStridedView.h>
+#include <dax/cont/ArrayHandle.h>
+
+namespace dax {
+namespace cont {
+
+/// ArrayHandleStridedViews are a specialization of ArrayHandles. They
+/// reference a block of the values of another ArrayHandle, laid out with a
+/// start index, the dimensions of the block and a stride per dimension, and
+/// present it as an array of its own without copying. The point or cell
+/// field of a box region of a structured grid, possibly subsampled, is such
+/// a view of the field of the whole grid.
+///
+/// Used as an output, a strided view has to be written with exactly as many
+/// values as it holds; the parent array is not resized and its values
+/// outside the view are preserved.
+///
+template<class ParentHandleType>
+class ArrayHandleStridedView
+    : public ArrayHandle<
+        typename ParentHandleType::ValueType,
+        dax::cont::ArrayContainerControlTagView<
+          ParentHandleType,dax::cont::StridedViewLayout>,
+        typename ParentHandleType::DeviceAdapterTag>
+{
+public:
+  typedef dax::cont::ArrayHandle<
+      typename ParentHandleType::ValueType,
+      dax::cont::ArrayContainerControlTagView<
+        ParentHandleType,dax::cont::StridedViewLayout>,
+      typename ParentHandleType::DeviceAdapterTag> superclass;
+  typedef dax::cont::internal::ArrayContainerControl<
+      typename superclass::ValueType,
+      typename superclass::ArrayContainerControlTag> ContainerType;
+
+  ArrayHandleStridedView() {  }
+
+  ArrayHandleStridedView(const ParentHandleType &parent,
+                         const dax::cont::StridedViewLayout &layout)
+    : superclass(ContainerType(parent, layout))
+  {
+    for (int dimension = 0; dimension < 3; dimension++)
+      {
+      if ((layout.Dimensions[dimension] < 0)
+          || (layout.Strides[dimension] < 0))
+        {
+        throw dax::cont::ErrorControlBadValue(
+              "Strided array view has negative dimensions or strides.");
+        }
+      }
+    if ((layout.Start < 0)
+        || (layout.GetLastParentIndex() >= parent.GetNumberOfValues()))
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Strided array view is outside of the parent array.");
+      }
+  }
+};
+
+/// A convenience function for creating an ArrayHandleStridedView. It takes
+/// the parent array, the index of the first value, the dimensions of the
+/// block and the distance in the parent between consecutive values along
+/// each dimension.
+template<class ParentHandleType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleStridedView<ParentHandleType>
+make_ArrayHandleStridedView(const ParentHandleType &parent,
+                            dax::Id start,
+                            const dax::Id3 &dimensions,
+                            const dax::Id3 &strides)
+{
+  return dax::cont::ArrayHandleStridedView<ParentHandleType>(
+        parent, dax::cont::StridedViewLayout(start, dimensions, strides));
+}
+
+}
+}
+
+#endif //__dax_cont_ArrayHandleStridedView_h
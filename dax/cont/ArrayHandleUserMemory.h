@@ -0,0 +1,95 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleUserMemory_h
+#define __dax_cont_ArrayHandleUserMemory_h
+
+#include <dax/cont/ArrayContainerControlUserMemory.h>
+#include <dax/cont/ArrayHandle.h>
+
+namespace dax {
+namespace cont {
+
+/// ArrayHandleUserMemorys are a specialization of ArrayHandles that wrap a
+/// buffer owned by the caller. The buffer is used directly (without copying)
+/// in the control environment and, for devices that share memory with the
+/// control environment, in the execution environment as well. It can be used
+/// as an input, in place, or as an output of up to \c capacity values.
+///
+template<typename T, class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class ArrayHandleUserMemory
+    : public ArrayHandle<
+        T, dax::cont::ArrayContainerControlTagUserMemory, DeviceAdapterTag>
+{
+public:
+  typedef dax::cont::ArrayHandle<
+      T, dax::cont::ArrayContainerControlTagUserMemory, DeviceAdapterTag>
+      superclass;
+  typedef dax::cont::internal::ArrayContainerControl<
+      typename superclass::ValueType,
+      typename superclass::ArrayContainerControlTag> ContainerType;
+  typedef typename ContainerType::DeleterType DeleterType;
+
+  ArrayHandleUserMemory() : Capacity(0) {  }
+
+  /// Wraps \c array, which holds \c numberOfValues values and has room for
+  /// \c capacity values. The buffer stays owned by the caller unless a
+  /// \c deleter is given, in which case the array releases it with the
+  /// deleter when the last copy of this handle is destroyed.
+  ///
+  ArrayHandleUserMemory(T *array,
+                        dax::Id numberOfValues,
+                        dax::Id capacity,
+                        DeleterType deleter = NULL)
+    : superclass(ContainerType(array, numberOfValues, capacity, deleter)),
+      Capacity(capacity) {  }
+
+  /// Returns the number of values the user buffer has room for.
+  ///
+  dax::Id GetCapacity() const { return this->Capacity; }
+
+private:
+  dax::Id Capacity;
+};
+
+/// A convenience function for wrapping a caller-owned buffer. The array holds
+/// \c numberOfValues values and can grow (for example when used as an
+/// output) up to \c capacity values. The buffer is borrowed and never freed.
+///
+template<typename T>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleUserMemory<T>
+make_ArrayHandleUserMemory(T *array, dax::Id numberOfValues, dax::Id capacity)
+{
+  return dax::cont::ArrayHandleUserMemory<T>(array, numberOfValues, capacity);
+}
+
+/// A convenience function for wrapping a caller-owned buffer that is both
+/// filled and sized to \c numberOfValues.
+///
+template<typename T>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleUserMemory<T>
+make_ArrayHandleUserMemory(T *array, dax::Id numberOfValues)
+{
+  return dax::cont::ArrayHandleUserMemory<T>(array,
+                                             numberOfValues,
+                                             numberOfValues);
+}
+
+}
+}
+
+#endif //__dax_cont_ArrayHandleUserMemory_h
@@ -0,0 +1,83 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleView_h
+#define __dax_cont_ArrayHandleView_h
+
+#include <dax/cont/ArrayContainerControlView.h>
+#include <dax/cont/ArrayHandle.h>
+
+namespace dax {
+namespace cont {
+
+/// ArrayHandleViews are a specialization of ArrayHandles. They reference a
+/// contiguous window of \c length values starting at index \c start of another
+/// ArrayHandle and present it as an array of its own, without copying. Views
+/// can be read and written in both environments and can be passed to any
+/// worklet, which makes them handy for processing an array in blocks or for
+/// writing the outputs of several operations into parts of one array.
+///
+/// Used as an output, a view can hold at most \c length values; the parent
+/// array is not resized and its values outside the window are preserved.
+///
+template<class ParentHandleType>
+class ArrayHandleView
+    : public ArrayHandle<
+        typename ParentHandleType::ValueType,
+        dax::cont::ArrayContainerControlTagView<ParentHandleType>,
+        typename ParentHandleType::DeviceAdapterTag>
+{
+public:
+  typedef dax::cont::ArrayHandle<
+      typename ParentHandleType::ValueType,
+      dax::cont::ArrayContainerControlTagView<ParentHandleType>,
+      typename ParentHandleType::DeviceAdapterTag> superclass;
+  typedef dax::cont::internal::ArrayContainerControl<
+      typename superclass::ValueType,
+      typename superclass::ArrayContainerControlTag> ContainerType;
+
+  ArrayHandleView() {  }
+
+  ArrayHandleView(const ParentHandleType &parent,
+                  dax::Id start,
+                  dax::Id length)
+    : superclass(ContainerType(parent,
+                               dax::cont::ViewLayout(start, length)))
+  {
+    if ((start < 0) || (length < 0)
+        || (start + length > parent.GetNumberOfValues()))
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Array view window is outside of the parent array.");
+      }
+  }
+};
+
+/// A convenience function for creating an ArrayHandleView. It takes the
+/// parent array and the start index and length of the window.
+template<class ParentHandleType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleView<ParentHandleType>
+make_ArrayHandleView(const ParentHandleType &parent,
+                     dax::Id start,
+                     dax::Id length)
+{
+  return dax::cont::ArrayHandleView<ParentHandleType>(parent, start, length);
+}
+
+}
+}
+
+#endif //__dax_cont_ArrayHandleView_h
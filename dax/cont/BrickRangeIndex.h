@@ -0,0 +1,208 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_BrickRangeIndex_h
+#define __dax_cont_BrickRangeIndex_h
+
+#include <dax/Extent.h>
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <dax/exec/internal/kernel/BrickRangeWorklets.h>
+#include <dax/exec/internal/kernel/GenerateWorklets.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief An index of the range of a point field over bricks of cells.
+///
+/// The cells of a uniform grid are grouped in bricks of BrickSize cells
+/// along each axis, and the minimum and maximum of the field over the points
+/// of each brick are computed once. Queries then return the cells of the
+/// bricks whose range overlaps the queried value or range. This is a
+/// superset of the cells that a contour or threshold of the same field can
+/// keep, found in time proportional to the number of bricks plus the number
+/// of returned cells.
+///
+/// The returned cell ids are meant to be given to the classification
+/// worklet as a permutation of the grid and to GenerateTopology or
+/// GenerateInterpolatedCells with SetInputCellIds, so that only these cells
+/// are classified and generated:
+///
+/// \code
+/// index.GetCellsContaining(isovalue, cellIds);
+/// scheduler.Invoke(MarchingCubesClassify(isovalue),
+///                  make_Permutation(cellIds, grid, grid.GetNumberOfCells()),
+///                  field, classification);
+/// GenerateInterpolatedCells<MarchingCubesTopology> generate(classification,
+///                                                           topology);
+/// generate.SetInputCellIds(cellIds);
+/// scheduler.Invoke(generate, grid, outGrid, field);
+/// \endcode
+///
+/// With MarchingCubesCaseClassify over the permutation, the case array it
+/// writes has one value per candidate cell, but MarchingCubesCaseTopology
+/// looks cases up by input cell id. Give it a case array covering every cell
+/// of the grid; a shorter one makes the scheduler throw ErrorControlBadValue.
+///
+/// The index must be rebuilt when the field values change.
+///
+template<typename ValueType = dax::Scalar,
+         class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class BrickRangeIndex
+{
+public:
+  typedef dax::cont::ArrayHandle<
+      dax::Id, dax::cont::ArrayContainerControlTagBasic, DeviceAdapterTag>
+      IdArrayType;
+  typedef dax::cont::ArrayHandle<
+      ValueType, dax::cont::ArrayContainerControlTagBasic, DeviceAdapterTag>
+      RangeArrayType;
+
+  template<class Container>
+  DAX_CONT_EXPORT BrickRangeIndex(
+      const dax::cont::UniformGrid<DeviceAdapterTag> &grid,
+      const dax::cont::ArrayHandle<ValueType,Container,DeviceAdapterTag> &field,
+      dax::Id brickSize = 8)
+    : BrickSize(brickSize)
+  {
+    if (brickSize < 1)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "The brick size must be at least one cell.");
+      }
+    if (field.GetNumberOfValues() != grid.GetNumberOfPoints())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "The field must have one value per point of the grid.");
+      }
+
+    this->CellDimensions = dax::extentCellDimensions(grid.GetExtent());
+    for (int axis = 0; axis < 3; ++axis)
+      {
+      this->BrickDimensions[axis] =
+          (this->CellDimensions[axis] + brickSize - 1) / brickSize;
+      }
+
+    const dax::Id numBricks = this->GetNumberOfBricks();
+    if (numBricks < 1) { return; }
+
+    typedef dax::exec::internal::kernel::ComputeBrickRanges<
+        typename dax::cont::ArrayHandle<
+          ValueType,Container,DeviceAdapterTag>::PortalConstExecution,
+        typename RangeArrayType::PortalExecution,
+        typename IdArrayType::PortalExecution> ComputeRangesType;
+
+    ComputeRangesType computeRanges(
+          field.PrepareForInput(),
+          this->Minimums.PrepareForOutput(numBricks),
+          this->Maximums.PrepareForOutput(numBricks),
+          this->CellCounts.PrepareForOutput(numBricks),
+          this->CellDimensions,
+          this->BrickDimensions,
+          this->BrickSize);
+    dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(
+          computeRanges, numBricks);
+  }
+
+  DAX_CONT_EXPORT dax::Id GetBrickSize() const { return this->BrickSize; }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfBricks() const
+  {
+    return this->BrickDimensions[0] * this->BrickDimensions[1]
+        * this->BrickDimensions[2];
+  }
+
+  /// Fills \c cellIds with the cells of the bricks whose range contains
+  /// \c value, which includes every cell an isosurface of that value
+  /// crosses. Returns the number of cells.
+  ///
+  DAX_CONT_EXPORT dax::Id GetCellsContaining(ValueType value,
+                                             IdArrayType &cellIds) const
+  {
+    return this->GetCellsOverlapping(value, value, cellIds);
+  }
+
+  /// Fills \c cellIds with the cells of the bricks whose range overlaps
+  /// [\c low, \c high], which includes every cell a threshold of that range
+  /// keeps. Returns the number of cells.
+  ///
+  DAX_CONT_EXPORT dax::Id GetCellsOverlapping(ValueType low,
+                                              ValueType high,
+                                              IdArrayType &cellIds) const
+  {
+    typedef dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithm;
+
+    const dax::Id numBricks = this->GetNumberOfBricks();
+    if (numBricks < 1)
+      {
+      cellIds = IdArrayType();
+      return 0;
+      }
+
+    IdArrayType counts;
+    dax::cont::Scheduler<DeviceAdapterTag> scheduler;
+    scheduler.Invoke(
+          dax::exec::internal::kernel::CountBrickCandidates<ValueType>(low,
+                                                                      high),
+          this->Minimums, this->Maximums, this->CellCounts, counts);
+
+    IdArrayType scannedCounts;
+    const dax::Id numCells = Algorithm::ScanInclusive(counts, scannedCounts);
+    if (numCells < 1)
+      {
+      cellIds = IdArrayType();
+      return 0;
+      }
+
+    //find the brick of each candidate cell the same way the generate
+    //schedulers find the input cell of each output cell
+    cellIds.PrepareForOutput(numCells);
+    scheduler.Invoke(dax::exec::internal::kernel::Index(), cellIds);
+    Algorithm::UpperBounds(scannedCounts, cellIds);
+
+    typedef dax::exec::internal::kernel::BrickCandidatesToCellIds<
+        typename IdArrayType::PortalConstExecution,
+        typename IdArrayType::PortalExecution> ToCellIdsType;
+    ToCellIdsType toCellIds(scannedCounts.PrepareForInput(),
+                            counts.PrepareForInput(),
+                            cellIds.PrepareForInPlace(),
+                            this->CellDimensions,
+                            this->BrickDimensions,
+                            this->BrickSize);
+    Algorithm::Schedule(toCellIds, numCells);
+    return numCells;
+  }
+
+private:
+  dax::Id BrickSize;
+  dax::Id3 CellDimensions;
+  dax::Id3 BrickDimensions;
+  RangeArrayType Minimums;
+  RangeArrayType Maximums;
+  IdArrayType CellCounts;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_BrickRangeIndex_h
@@ -0,0 +1,199 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ExtractUniformSubGrid_h
+#define __dax_cont_ExtractUniformSubGrid_h
+
+#include <dax/Extent.h>
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayHandleStridedView.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+
+/// \brief Extracts a box region of a uniform grid, possibly subsampled.
+///
+/// The region (or volume of interest) is given as an extent in the index
+/// space of the input grid and is clipped to the input extent. A sample rate
+/// larger than 1 in a dimension keeps every sample rate'th point along it,
+/// starting at the minimum of the region.
+///
+/// The output is a UniformGrid of its own: its extent starts at the minimum
+/// of the region and its origin and spacing are set so that every output
+/// point has the coordinates of the input point it was taken from. Nothing
+/// is computed in the execution environment. The point and cell fields of
+/// the output are strided views of the fields of the input, so they are
+/// not copied either:
+///
+/// \code
+/// dax::cont::ExtractUniformSubGrid<> extract(grid, voi, dax::make_Id3(2,2,2));
+/// scheduler.Invoke(worklet,
+///                  extract.GetOutputGrid(),
+///                  extract.GetPointFieldView(pointField),
+///                  result);
+/// \endcode
+///
+/// Each output cell takes the value of the input cell at its minimum
+/// corner, which is the whole output cell when the sample rate is 1.
+///
+template <class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class ExtractUniformSubGrid
+{
+public:
+  typedef dax::cont::UniformGrid<DeviceAdapterTag> GridType;
+
+  DAX_CONT_EXPORT
+  ExtractUniformSubGrid(const GridType &inputGrid,
+                        const dax::Extent3 &volumeOfInterest,
+                        const dax::Id3 &sampleRate = dax::make_Id3(1, 1, 1))
+    : InputGrid(inputGrid), SampleRate(sampleRate)
+  {
+    const dax::Extent3 &extent = inputGrid.GetExtent();
+    for (int dimension = 0; dimension < 3; dimension++)
+      {
+      if (sampleRate[dimension] < 1)
+        {
+        throw dax::cont::ErrorControlBadValue(
+              "The sample rate of a sub grid has to be at least 1.");
+        }
+      this->VolumeOfInterest.Min[dimension] =
+          std::max(volumeOfInterest.Min[dimension], extent.Min[dimension]);
+      this->VolumeOfInterest.Max[dimension] =
+          std::min(volumeOfInterest.Max[dimension], extent.Max[dimension]);
+      if (this->VolumeOfInterest.Min[dimension]
+          > this->VolumeOfInterest.Max[dimension])
+        {
+        throw dax::cont::ErrorControlBadValue(
+              "The volume of interest does not overlap the grid.");
+        }
+      }
+
+    const dax::Id3 &min = this->VolumeOfInterest.Min;
+    dax::Id3 dimensions;
+    dax::Vector3 origin;
+    dax::Vector3 spacing;
+    for (int dimension = 0; dimension < 3; dimension++)
+      {
+      dimensions[dimension] = 1 + (this->VolumeOfInterest.Max[dimension]
+                                   - min[dimension]) / sampleRate[dimension];
+      spacing[dimension] =
+          inputGrid.GetSpacing()[dimension] * sampleRate[dimension];
+      // Point min of the output is at point min of the input.
+      origin[dimension] = inputGrid.GetOrigin()[dimension]
+          - inputGrid.GetSpacing()[dimension]
+            * static_cast<dax::Scalar>((sampleRate[dimension] - 1)
+                                       * min[dimension]);
+      }
+    this->OutputGrid.SetExtent(min,
+                               min + dimensions - dax::make_Id3(1, 1, 1));
+    this->OutputGrid.SetOrigin(origin);
+    this->OutputGrid.SetSpacing(spacing);
+  }
+
+  /// The extracted grid.
+  ///
+  DAX_CONT_EXPORT
+  const GridType &GetOutputGrid() const { return this->OutputGrid; }
+
+  DAX_CONT_EXPORT
+  const GridType &GetInputGrid() const { return this->InputGrid; }
+
+  /// The volume of interest clipped to the extent of the input grid.
+  ///
+  DAX_CONT_EXPORT
+  const dax::Extent3 &GetVolumeOfInterest() const
+  {
+    return this->VolumeOfInterest;
+  }
+
+  DAX_CONT_EXPORT
+  const dax::Id3 &GetSampleRate() const { return this->SampleRate; }
+
+  /// Returns the values of a point field of the input grid at the points of
+  /// the output grid, without copying them.
+  ///
+  template<class FieldHandleType>
+  DAX_CONT_EXPORT
+  dax::cont::ArrayHandleStridedView<FieldHandleType>
+  GetPointFieldView(const FieldHandleType &pointField) const
+  {
+    if (pointField.GetNumberOfValues() != this->InputGrid.GetNumberOfPoints())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Point field does not match the points of the input grid.");
+      }
+    const dax::Id3 dimensions =
+        dax::extentDimensions(this->InputGrid.GetExtent());
+    return dax::cont::make_ArrayHandleStridedView(
+          pointField,
+          this->InputGrid.ComputePointIndex(this->VolumeOfInterest.Min),
+          dax::extentDimensions(this->OutputGrid.GetExtent()),
+          this->GetStrides(dimensions));
+  }
+
+  /// Returns the values of a cell field of the input grid at the cells of
+  /// the output grid, without copying them.
+  ///
+  template<class FieldHandleType>
+  DAX_CONT_EXPORT
+  dax::cont::ArrayHandleStridedView<FieldHandleType>
+  GetCellFieldView(const FieldHandleType &cellField) const
+  {
+    if (cellField.GetNumberOfValues() != this->InputGrid.GetNumberOfCells())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Cell field does not match the cells of the input grid.");
+      }
+    if (this->OutputGrid.GetNumberOfCells() == 0)
+      {
+      // The region is flat, so its minimum may not be at any cell.
+      return dax::cont::make_ArrayHandleStridedView(
+            cellField, 0, dax::make_Id3(0, 0, 0), dax::make_Id3(0, 0, 0));
+      }
+    const dax::Id3 dimensions =
+        dax::extentCellDimensions(this->InputGrid.GetExtent());
+    return dax::cont::make_ArrayHandleStridedView(
+          cellField,
+          this->InputGrid.ComputeCellIndex(this->VolumeOfInterest.Min),
+          dax::extentCellDimensions(this->OutputGrid.GetExtent()),
+          this->GetStrides(dimensions));
+  }
+
+private:
+  DAX_CONT_EXPORT
+  dax::Id3 GetStrides(const dax::Id3 &inputDimensions) const
+  {
+    return dax::make_Id3(
+          this->SampleRate[0],
+          this->SampleRate[1]*inputDimensions[0],
+          this->SampleRate[2]*inputDimensions[0]*inputDimensions[1]);
+  }
+
+  GridType InputGrid;
+  dax::Extent3 VolumeOfInterest;
+  dax::Id3 SampleRate;
+  GridType OutputGrid;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ExtractUniformSubGrid_h
@@ -17,6 +17,7 @@
 #ifndef __dax_cont_GenerateInterpolatedCells_h
 #define __dax_cont_GenerateInterpolatedCells_h
 
+#include <boost/mpl/if.hpp>
 #include <boost/type_traits/is_base_of.hpp>
 
 #include <dax/Types.h>
@@ -25,9 +26,13 @@
 #include <dax/exec/internal/GridTopologies.h>
 #include <dax/exec/WorkletInterpolatedCell.h>
 
+#include <dax/cont/ArrayContainerControlBasic.h>
 #include <dax/cont/ArrayHandle.h>
 #include <dax/cont/DeviceAdapter.h>
 
+#include <dax/exec/internal/kernel/GenerateWorklets.h>
+
+
 namespace dax {
 namespace cont {
 
@@ -36,6 +41,59 @@ namespace cont {
 //GenerateInterpolatedCells
 namespace internal {
   class GenerateInterpolatedCellsBase {};
+
+  /// The end of a list of point fields interpolated together with the
+  /// coordinates.
+  struct NoInterpolatedPointFields
+  {
+    typedef dax::exec::internal::kernel::NoFieldPortals PortalsType;
+
+    PortalsType PrepareForInterpolation(dax::Id)
+    {
+      return PortalsType();
+    }
+  };
+
+  /// A list of input and output point fields interpolated together with the
+  /// coordinates. The handles are only turned into execution portals once
+  /// the number of output points is known. When \c NormalizeValues is set,
+  /// the interpolated vectors are normalized, which turns gradients into
+  /// normals.
+  template<class InputType,
+           class OutputType,
+           class NextType = NoInterpolatedPointFields,
+           bool NormalizeValues = false>
+  class InterpolatedPointFieldList
+  {
+  public:
+    typedef typename boost::mpl::if_c<
+        NormalizeValues,
+        dax::exec::internal::kernel::NormalPortalPair<
+          typename InputType::PortalConstExecution,
+          typename OutputType::PortalExecution,
+          typename NextType::PortalsType>,
+        dax::exec::internal::kernel::FieldPortalPair<
+          typename InputType::PortalConstExecution,
+          typename OutputType::PortalExecution,
+          typename NextType::PortalsType> >::type PortalsType;
+
+    InterpolatedPointFieldList(const InputType &input,
+                               const OutputType &output,
+                               const NextType &next = NextType())
+      : Input(input), Output(output), Next(next) {  }
+
+    PortalsType PrepareForInterpolation(dax::Id numPoints)
+    {
+      return PortalsType(this->Input.PrepareForInput(),
+                         this->Output.PrepareForOutput(numPoints),
+                         this->Next.PrepareForInterpolation(numPoints));
+    }
+
+  private:
+    InputType Input;
+    OutputType Output;
+    NextType Next;
+  };
 }
 
 /// GenerateInterpolatedCells is the control environment representation of a
@@ -43,7 +101,8 @@ namespace internal {
 /// and will generate a new coordinates and topology
 template<
     class WorkletType_,
-    class ClassifyHandleType = dax::cont::ArrayHandle< dax::Id >
+    class ClassifyHandleType = dax::cont::ArrayHandle< dax::Id >,
+    class PointFieldsType_ = dax::cont::internal::NoInterpolatedPointFields
     >
 
 class GenerateInterpolatedCells :
@@ -61,9 +120,18 @@ public:
   typedef typename ClassifyHandleType::ValueType ClassifyType;
   typedef ClassifyHandleType ClassifyResultType;
 
+  typedef typename ClassifyHandleType::DeviceAdapterTag DeviceAdapterTag;
+  typedef PointFieldsType_ PointFieldsType;
+
+  typedef dax::cont::ArrayHandle<
+          dax::Id,
+          ArrayContainerControlTagBasic,
+          typename ClassifyHandleType::DeviceAdapterTag> InputCellIdsType;
+
   GenerateInterpolatedCells(const ClassifyResultType &classification):
     RemoveDuplicatePoints(true),
     ReleaseClassification(true),
+    UseInputCellIds(false),
     Classification(classification),
     Worklet()
     {
@@ -74,12 +142,30 @@ public:
                             const WorkletType& work):
     RemoveDuplicatePoints(true),
     ReleaseClassification(true),
+    UseInputCellIds(false),
     Classification(classification),
     Worklet(work)
     {
     BOOST_MPL_ASSERT((Worklet_Should_Inherit_From_WorkletGenerateCells));
     }
 
+  /// Copies the settings of another GenerateInterpolatedCells of the same
+  /// worklet, interpolating \c pointFields instead of its point fields.
+  template<class OtherPointFieldsType>
+  GenerateInterpolatedCells(
+      const GenerateInterpolatedCells<
+        WorkletType,ClassifyHandleType,OtherPointFieldsType> &other,
+      const PointFieldsType &pointFields):
+    RemoveDuplicatePoints(other.GetRemoveDuplicatePoints()),
+    ReleaseClassification(other.GetReleaseClassification()),
+    UseInputCellIds(other.GetUseInputCellIds()),
+    InputCellIds(other.GetInputCellIds()),
+    Classification(other.GetClassification()),
+    PointFields(pointFields),
+    Worklet(other.GetWorklet())
+    {
+    }
+
   void SetReleaseClassification(bool b){ ReleaseClassification = b; }
   bool GetReleaseClassification() const { return ReleaseClassification; }
 
@@ -89,12 +175,177 @@ public:
   void SetRemoveDuplicatePoints(bool b){ RemoveDuplicatePoints = b; }
   bool GetRemoveDuplicatePoints() const { return RemoveDuplicatePoints; }
 
+  /// Returns a copy of this object that also interpolates point fields of
+  /// the input grid onto the points of the output grid. Fields of any value
+  /// type can be given; they are interpolated with the same edge weights as
+  /// the coordinates and merged the same way, so each output ends up with one
+  /// value per output point. The coordinates and all the fields are
+  /// interpolated in one pass over the output points.
+  ///
+  /// Each call takes up to three input and output pairs. For more fields,
+  /// call it again on the result:
+  ///
+  /// \code
+  /// scheduler.Invoke(generate.WithInterpolatedPointFields(in1, out1,
+  ///                                                       in2, out2,
+  ///                                                       in3, out3)
+  ///                          .WithInterpolatedPointFields(in4, out4),
+  ///                  grid, outGrid, field);
+  /// \endcode
+  ///
+  template<typename T1, class CIn1, class COut1>
+  GenerateInterpolatedCells<
+    WorkletType,ClassifyHandleType,
+    dax::cont::internal::InterpolatedPointFieldList<
+      dax::cont::ArrayHandle<T1,CIn1,DeviceAdapterTag>,
+      dax::cont::ArrayHandle<T1,COut1,DeviceAdapterTag>,
+      PointFieldsType> >
+  WithInterpolatedPointFields(
+      const dax::cont::ArrayHandle<T1,CIn1,DeviceAdapterTag> &input1,
+      const dax::cont::ArrayHandle<T1,COut1,DeviceAdapterTag> &output1) const
+    {
+    typedef dax::cont::internal::InterpolatedPointFieldList<
+        dax::cont::ArrayHandle<T1,CIn1,DeviceAdapterTag>,
+        dax::cont::ArrayHandle<T1,COut1,DeviceAdapterTag>,
+        PointFieldsType> List1;
+    return GenerateInterpolatedCells<
+        WorkletType,ClassifyHandleType,List1>(
+          *this,
+          List1(input1, output1, this->PointFields));
+    }
+
+  template<typename T1, class CIn1, class COut1,
+           typename T2, class CIn2, class COut2>
+  GenerateInterpolatedCells<
+    WorkletType,ClassifyHandleType,
+    dax::cont::internal::InterpolatedPointFieldList<
+      dax::cont::ArrayHandle<T1,CIn1,DeviceAdapterTag>,
+      dax::cont::ArrayHandle<T1,COut1,DeviceAdapterTag>,
+    dax::cont::internal::InterpolatedPointFieldList<
+      dax::cont::ArrayHandle<T2,CIn2,DeviceAdapterTag>,
+      dax::cont::ArrayHandle<T2,COut2,DeviceAdapterTag>,
+      PointFieldsType> > >
+  WithInterpolatedPointFields(
+      const dax::cont::ArrayHandle<T1,CIn1,DeviceAdapterTag> &input1,
+      const dax::cont::ArrayHandle<T1,COut1,DeviceAdapterTag> &output1,
+      const dax::cont::ArrayHandle<T2,CIn2,DeviceAdapterTag> &input2,
+      const dax::cont::ArrayHandle<T2,COut2,DeviceAdapterTag> &output2) const
+    {
+    typedef dax::cont::internal::InterpolatedPointFieldList<
+        dax::cont::ArrayHandle<T2,CIn2,DeviceAdapterTag>,
+        dax::cont::ArrayHandle<T2,COut2,DeviceAdapterTag>,
+        PointFieldsType> List2;
+    typedef dax::cont::internal::InterpolatedPointFieldList<
+        dax::cont::ArrayHandle<T1,CIn1,DeviceAdapterTag>,
+        dax::cont::ArrayHandle<T1,COut1,DeviceAdapterTag>,
+        List2> List1;
+    return GenerateInterpolatedCells<
+        WorkletType,ClassifyHandleType,List1>(
+          *this,
+          List1(input1, output1,
+          List2(input2, output2, this->PointFields)));
+    }
+
+  template<typename T1, class CIn1, class COut1,
+           typename T2, class CIn2, class COut2,
+           typename T3, class CIn3, class COut3>
+  GenerateInterpolatedCells<
+    WorkletType,ClassifyHandleType,
+    dax::cont::internal::InterpolatedPointFieldList<
+      dax::cont::ArrayHandle<T1,CIn1,DeviceAdapterTag>,
+      dax::cont::ArrayHandle<T1,COut1,DeviceAdapterTag>,
+    dax::cont::internal::InterpolatedPointFieldList<
+      dax::cont::ArrayHandle<T2,CIn2,DeviceAdapterTag>,
+      dax::cont::ArrayHandle<T2,COut2,DeviceAdapterTag>,
+    dax::cont::internal::InterpolatedPointFieldList<
+      dax::cont::ArrayHandle<T3,CIn3,DeviceAdapterTag>,
+      dax::cont::ArrayHandle<T3,COut3,DeviceAdapterTag>,
+      PointFieldsType> > > >
+  WithInterpolatedPointFields(
+      const dax::cont::ArrayHandle<T1,CIn1,DeviceAdapterTag> &input1,
+      const dax::cont::ArrayHandle<T1,COut1,DeviceAdapterTag> &output1,
+      const dax::cont::ArrayHandle<T2,CIn2,DeviceAdapterTag> &input2,
+      const dax::cont::ArrayHandle<T2,COut2,DeviceAdapterTag> &output2,
+      const dax::cont::ArrayHandle<T3,CIn3,DeviceAdapterTag> &input3,
+      const dax::cont::ArrayHandle<T3,COut3,DeviceAdapterTag> &output3) const
+    {
+    typedef dax::cont::internal::InterpolatedPointFieldList<
+        dax::cont::ArrayHandle<T3,CIn3,DeviceAdapterTag>,
+        dax::cont::ArrayHandle<T3,COut3,DeviceAdapterTag>,
+        PointFieldsType> List3;
+    typedef dax::cont::internal::InterpolatedPointFieldList<
+        dax::cont::ArrayHandle<T2,CIn2,DeviceAdapterTag>,
+        dax::cont::ArrayHandle<T2,COut2,DeviceAdapterTag>,
+        List3> List2;
+    typedef dax::cont::internal::InterpolatedPointFieldList<
+        dax::cont::ArrayHandle<T1,CIn1,DeviceAdapterTag>,
+        dax::cont::ArrayHandle<T1,COut1,DeviceAdapterTag>,
+        List2> List1;
+    return GenerateInterpolatedCells<
+        WorkletType,ClassifyHandleType,List1>(
+          *this,
+          List1(input1, output1,
+          List2(input2, output2,
+          List3(input3, output3, this->PointFields))));
+    }
+
+  PointFieldsType GetInterpolatedPointFields() const { return PointFields; }
+
+  /// Returns a copy of this object that also gives each point of the output
+  /// grid a normal, interpolated from \c pointGradients, the gradient of the
+  /// contoured field at the points of the input grid (see
+  /// dax::worklet::PointGradient), and normalized. The normals point toward
+  /// increasing field values. They are interpolated in the same pass as the
+  /// coordinates, so shading the surface needs no adjacency between the
+  /// output cells.
+  template<class CIn, class COut>
+  GenerateInterpolatedCells<
+    WorkletType,ClassifyHandleType,
+    dax::cont::internal::InterpolatedPointFieldList<
+      dax::cont::ArrayHandle<dax::Vector3,CIn,DeviceAdapterTag>,
+      dax::cont::ArrayHandle<dax::Vector3,COut,DeviceAdapterTag>,
+      PointFieldsType, true> >
+  WithPointNormals(
+      const dax::cont::ArrayHandle<dax::Vector3,CIn,DeviceAdapterTag>
+          &pointGradients,
+      const dax::cont::ArrayHandle<dax::Vector3,COut,DeviceAdapterTag>
+          &normals) const
+    {
+    typedef dax::cont::internal::InterpolatedPointFieldList<
+        dax::cont::ArrayHandle<dax::Vector3,CIn,DeviceAdapterTag>,
+        dax::cont::ArrayHandle<dax::Vector3,COut,DeviceAdapterTag>,
+        PointFieldsType, true> NormalsList;
+    return GenerateInterpolatedCells<
+        WorkletType,ClassifyHandleType,NormalsList>(
+          *this,
+          NormalsList(pointGradients, normals, this->PointFields));
+    }
+
+  /// Restricts the generation to the listed input cells, for example the
+  /// candidates found with a dax::cont::BrickRangeIndex. The classification
+  /// then holds one value per listed cell instead of one per input cell.
+  void SetInputCellIds(const InputCellIdsType &cellIds)
+    {
+    InputCellIds = cellIds;
+    UseInputCellIds = true;
+    }
+  void ClearInputCellIds()
+    {
+    InputCellIds = InputCellIdsType();
+    UseInputCellIds = false;
+    }
+  bool GetUseInputCellIds() const { return UseInputCellIds; }
+  InputCellIdsType GetInputCellIds() const { return InputCellIds; }
+
   WorkletType GetWorklet() const {return Worklet; }
 
 private:
   bool RemoveDuplicatePoints;
   bool ReleaseClassification;
+  bool UseInputCellIds;
+  InputCellIdsType InputCellIds;
   ClassifyResultType Classification;
+  PointFieldsType PointFields;
   WorkletType Worklet;
 
 };
@@ -17,12 +17,14 @@
 #ifndef __dax_cont_GenerateTopology_h
 #define __dax_cont_GenerateTopology_h
 
+#include <boost/shared_ptr.hpp>
 #include <boost/type_traits/is_base_of.hpp>
 
 #include <dax/Types.h>
 
 #include <dax/exec/internal/ErrorMessageBuffer.h>
 #include <dax/exec/internal/GridTopologies.h>
+#include <dax/exec/internal/kernel/GenerateWorklets.h>
 #include <dax/exec/WorkletGenerateTopology.h>
 
 #include <dax/cont/ArrayHandle.h>
@@ -40,10 +42,12 @@ namespace internal {
 
 /// GenerateTopology is the control enviorment representation of a
 /// an algorithm that takes a classification of a given input topology
-/// and will generate a new topology, but doesn't create new cells
+/// and will generate a new topology, but doesn't create new cells.
+/// The classification holds the number of output cells for each input cell,
+/// so it defaults to the narrower dax::ConnectivityId.
 template<
     class WorkletType_,
-    class ClassifyHandleType = dax::cont::ArrayHandle< dax::Id >
+    class ClassifyHandleType = dax::cont::ArrayHandle< dax::ConnectivityId >
     >
 
 class GenerateTopology :
@@ -58,21 +62,44 @@ class GenerateTopology :
 public:
   typedef WorkletType_ WorkletType;
 
-  //mask type is the internal
-  typedef dax::Id MaskType;
+  //the point mask only flags the points that are used, so a byte is enough
+  typedef unsigned char MaskType;
 
   typedef dax::cont::ArrayHandle<
           MaskType,
           ArrayContainerControlTagBasic,
           typename ClassifyHandleType::DeviceAdapterTag> PointMaskType;
 
+  //new id of each used point of the input grid, the exclusive scan of the
+  //point mask
+  typedef dax::cont::ArrayHandle<
+          dax::Id,
+          ArrayContainerControlTagBasic,
+          typename ClassifyHandleType::DeviceAdapterTag> PointMapType;
+
+  //input cell of each output cell, filled in when the topology is generated.
+  //Like the point mask it is shared by all copies of this object.
+  typedef dax::cont::ArrayHandle<
+          dax::Id,
+          ArrayContainerControlTagBasic,
+          typename ClassifyHandleType::DeviceAdapterTag> CellMapType;
+
   typedef ClassifyHandleType ClassifyResultType;
 
+  typedef dax::cont::ArrayHandle<
+          dax::Id,
+          ArrayContainerControlTagBasic,
+          typename ClassifyHandleType::DeviceAdapterTag> InputCellIdsType;
+
   GenerateTopology(ClassifyResultType classification):
     RemoveDuplicatePoints(true),
     ReleaseClassification(true),
+    UseInputCellIds(false),
     Classification(classification),
     PointMask(),
+    PointMap(),
+    NumberOfCompactPoints(new dax::Id(0)),
+    CellMap(),
     Worklet()
     {
     BOOST_MPL_ASSERT((Worklet_Should_Inherit_From_WorkletGenerateTopology));
@@ -81,8 +108,12 @@ public:
   GenerateTopology(ClassifyResultType classification, WorkletType& work):
     RemoveDuplicatePoints(true),
     ReleaseClassification(true),
+    UseInputCellIds(false),
     Classification(classification),
     PointMask(),
+    PointMap(),
+    NumberOfCompactPoints(new dax::Id(0)),
+    CellMap(),
     Worklet(work)
     {
     BOOST_MPL_ASSERT((Worklet_Should_Inherit_From_WorkletGenerateTopology));
@@ -93,14 +124,115 @@ public:
       const dax::cont::ArrayHandle<T,Container1,DeviceAdapter>& input,
       dax::cont::ArrayHandle<T,Container2,DeviceAdapter>& output)
     {
-    if(this->GetRemoveDuplicatePoints())
-      {
-      dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapter>::
-          StreamCompact(input, this->PointMask, output);
-
-      return true;
-      }
-    return false;
+    return this->CompactPointFields(input, output);
+    }
+
+  /// Compacts point fields of the input grid to the points of the generated
+  /// grid. All the fields are moved in one pass that reuses the point mask
+  /// and point map computed when the topology was generated, so it is
+  /// cheaper than a CompactPointField call per field. Returns false, leaving
+  /// the outputs alone, when duplicate points are not removed.
+  template<typename T1, typename CIn1, typename COut1, typename DeviceAdapter>
+  bool CompactPointFields(
+      const dax::cont::ArrayHandle<T1,CIn1,DeviceAdapter>& input1,
+      dax::cont::ArrayHandle<T1,COut1,DeviceAdapter>& output1)
+    {
+    if(!this->GetRemoveDuplicatePoints()) { return false; }
+    const dax::Id n = this->GetNumberOfCompactPoints();
+    return this->SchedulePointFields<DeviceAdapter>(
+          dax::exec::internal::kernel::make_FieldPortalPair(
+            input1.PrepareForInput(), output1.PrepareForOutput(n)));
+    }
+
+  template<typename T1, typename CIn1, typename COut1,
+           typename T2, typename CIn2, typename COut2, typename DeviceAdapter>
+  bool CompactPointFields(
+      const dax::cont::ArrayHandle<T1,CIn1,DeviceAdapter>& input1,
+      dax::cont::ArrayHandle<T1,COut1,DeviceAdapter>& output1,
+      const dax::cont::ArrayHandle<T2,CIn2,DeviceAdapter>& input2,
+      dax::cont::ArrayHandle<T2,COut2,DeviceAdapter>& output2)
+    {
+    if(!this->GetRemoveDuplicatePoints()) { return false; }
+    const dax::Id n = this->GetNumberOfCompactPoints();
+    return this->SchedulePointFields<DeviceAdapter>(
+          dax::exec::internal::kernel::make_FieldPortalPair(
+            input1.PrepareForInput(), output1.PrepareForOutput(n),
+          dax::exec::internal::kernel::make_FieldPortalPair(
+            input2.PrepareForInput(), output2.PrepareForOutput(n))));
+    }
+
+  template<typename T1, typename CIn1, typename COut1,
+           typename T2, typename CIn2, typename COut2,
+           typename T3, typename CIn3, typename COut3, typename DeviceAdapter>
+  bool CompactPointFields(
+      const dax::cont::ArrayHandle<T1,CIn1,DeviceAdapter>& input1,
+      dax::cont::ArrayHandle<T1,COut1,DeviceAdapter>& output1,
+      const dax::cont::ArrayHandle<T2,CIn2,DeviceAdapter>& input2,
+      dax::cont::ArrayHandle<T2,COut2,DeviceAdapter>& output2,
+      const dax::cont::ArrayHandle<T3,CIn3,DeviceAdapter>& input3,
+      dax::cont::ArrayHandle<T3,COut3,DeviceAdapter>& output3)
+    {
+    if(!this->GetRemoveDuplicatePoints()) { return false; }
+    const dax::Id n = this->GetNumberOfCompactPoints();
+    return this->SchedulePointFields<DeviceAdapter>(
+          dax::exec::internal::kernel::make_FieldPortalPair(
+            input1.PrepareForInput(), output1.PrepareForOutput(n),
+          dax::exec::internal::kernel::make_FieldPortalPair(
+            input2.PrepareForInput(), output2.PrepareForOutput(n),
+          dax::exec::internal::kernel::make_FieldPortalPair(
+            input3.PrepareForInput(), output3.PrepareForOutput(n)))));
+    }
+
+  /// Copies cell fields of the input grid to the cells of the generated
+  /// grid, each output cell taking the value of the input cell it was
+  /// generated from. All the fields are moved in one pass over the cell map
+  /// kept when the topology was generated.
+  template<typename T1, typename CIn1, typename COut1, typename DeviceAdapter>
+  void CompactCellFields(
+      const dax::cont::ArrayHandle<T1,CIn1,DeviceAdapter>& input1,
+      dax::cont::ArrayHandle<T1,COut1,DeviceAdapter>& output1)
+    {
+    const dax::Id n = this->CellMap.GetNumberOfValues();
+    this->ScheduleCellFields<DeviceAdapter>(
+          dax::exec::internal::kernel::make_FieldPortalPair(
+            input1.PrepareForInput(), output1.PrepareForOutput(n)));
+    }
+
+  template<typename T1, typename CIn1, typename COut1,
+           typename T2, typename CIn2, typename COut2, typename DeviceAdapter>
+  void CompactCellFields(
+      const dax::cont::ArrayHandle<T1,CIn1,DeviceAdapter>& input1,
+      dax::cont::ArrayHandle<T1,COut1,DeviceAdapter>& output1,
+      const dax::cont::ArrayHandle<T2,CIn2,DeviceAdapter>& input2,
+      dax::cont::ArrayHandle<T2,COut2,DeviceAdapter>& output2)
+    {
+    const dax::Id n = this->CellMap.GetNumberOfValues();
+    this->ScheduleCellFields<DeviceAdapter>(
+          dax::exec::internal::kernel::make_FieldPortalPair(
+            input1.PrepareForInput(), output1.PrepareForOutput(n),
+          dax::exec::internal::kernel::make_FieldPortalPair(
+            input2.PrepareForInput(), output2.PrepareForOutput(n))));
+    }
+
+  template<typename T1, typename CIn1, typename COut1,
+           typename T2, typename CIn2, typename COut2,
+           typename T3, typename CIn3, typename COut3, typename DeviceAdapter>
+  void CompactCellFields(
+      const dax::cont::ArrayHandle<T1,CIn1,DeviceAdapter>& input1,
+      dax::cont::ArrayHandle<T1,COut1,DeviceAdapter>& output1,
+      const dax::cont::ArrayHandle<T2,CIn2,DeviceAdapter>& input2,
+      dax::cont::ArrayHandle<T2,COut2,DeviceAdapter>& output2,
+      const dax::cont::ArrayHandle<T3,CIn3,DeviceAdapter>& input3,
+      dax::cont::ArrayHandle<T3,COut3,DeviceAdapter>& output3)
+    {
+    const dax::Id n = this->CellMap.GetNumberOfValues();
+    this->ScheduleCellFields<DeviceAdapter>(
+          dax::exec::internal::kernel::make_FieldPortalPair(
+            input1.PrepareForInput(), output1.PrepareForOutput(n),
+          dax::exec::internal::kernel::make_FieldPortalPair(
+            input2.PrepareForInput(), output2.PrepareForOutput(n),
+          dax::exec::internal::kernel::make_FieldPortalPair(
+            input3.PrepareForInput(), output3.PrepareForOutput(n)))));
     }
 
   void SetReleaseClassification(bool b){ ReleaseClassification = b; }
@@ -112,17 +244,72 @@ public:
   PointMaskType GetPointMask() { return PointMask; }
   const PointMaskType GetPointMask() const { return PointMask; }
 
+  PointMapType GetPointMap() { return PointMap; }
+  const PointMapType GetPointMap() const { return PointMap; }
+
+  //the scheduler is handed a copy of this object, so the number of points
+  //it keeps is shared between the copies like the arrays are
+  dax::Id GetNumberOfCompactPoints() const { return *NumberOfCompactPoints; }
+  void SetNumberOfCompactPoints(dax::Id n) { *NumberOfCompactPoints = n; }
+
+  CellMapType GetCellMap() const { return CellMap; }
+
 
   void SetRemoveDuplicatePoints(bool b){ RemoveDuplicatePoints = b; }
   bool GetRemoveDuplicatePoints() const { return RemoveDuplicatePoints; }
 
+  /// Restricts the generation to the listed input cells, for example the
+  /// candidates found with a dax::cont::BrickRangeIndex. The classification
+  /// then holds one value per listed cell instead of one per input cell.
+  void SetInputCellIds(const InputCellIdsType &cellIds)
+    {
+    InputCellIds = cellIds;
+    UseInputCellIds = true;
+    }
+  void ClearInputCellIds()
+    {
+    InputCellIds = InputCellIdsType();
+    UseInputCellIds = false;
+    }
+  bool GetUseInputCellIds() const { return UseInputCellIds; }
+  InputCellIdsType GetInputCellIds() const { return InputCellIds; }
+
   WorkletType GetWorklet() const {return Worklet; }
 
 private:
+  template<typename DeviceAdapter, typename FieldsType>
+  bool SchedulePointFields(const FieldsType &fields)
+    {
+    dax::exec::internal::kernel::CompactPointFields<
+        typename PointMaskType::PortalConstExecution,
+        typename PointMapType::PortalConstExecution,
+        FieldsType> compact(this->PointMask.PrepareForInput(),
+                            this->PointMap.PrepareForInput(),
+                            fields);
+    dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapter>::Schedule(
+          compact, this->PointMask.GetNumberOfValues());
+    return true;
+    }
+
+  template<typename DeviceAdapter, typename FieldsType>
+  void ScheduleCellFields(const FieldsType &fields)
+    {
+    dax::exec::internal::kernel::CompactCellFields<
+        typename CellMapType::PortalConstExecution,
+        FieldsType> compact(this->CellMap.PrepareForInput(), fields);
+    dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapter>::Schedule(
+          compact, this->CellMap.GetNumberOfValues());
+    }
+
   bool RemoveDuplicatePoints;
   bool ReleaseClassification;
+  bool UseInputCellIds;
+  InputCellIdsType InputCellIds;
   ClassifyResultType Classification;
   PointMaskType PointMask;
+  PointMapType PointMap;
+  boost::shared_ptr<dax::Id> NumberOfCompactPoints;
+  CellMapType CellMap;
   WorkletType Worklet;
 
 };
@@ -0,0 +1,173 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#if !defined(BOOST_PP_IS_ITERATING)
+
+#ifndef __dax_cont_InvocationGroup_h
+#define __dax_cont_InvocationGroup_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/scheduling/PipelineInvocation.h>
+#include <dax/cont/scheduling/PipelineStages.h>
+#include <dax/cont/scheduling/VerifyUserArgLength.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+#if !(__cplusplus >= 201103L)
+# include <dax/internal/ParameterPackCxx03.h>
+#endif // !(__cplusplus >= 201103L)
+
+namespace dax { namespace cont {
+
+/// \brief A set of independent worklet invocations to be run together.
+///
+/// Add takes the same arguments as Scheduler::Invoke but only records the
+/// invocation. Passing the group to Scheduler::InvokeConcurrently then runs
+/// all of them with a single schedule of the device adapter, so that small
+/// invocations share the threads instead of each one waiting for the
+/// previous one to finish.
+///
+/// The invocations must be independent: none of them may write an array
+/// that another invocation of the group reads or writes, including through a
+/// view or another wrapper of the array. Invocations whose arrays cannot all
+/// be identified (see PipelineNode::HasUntrackedAccesses) are run alone.
+///
+template <class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class InvocationGroup
+{
+  typedef boost::shared_ptr<dax::cont::scheduling::PipelineNode> NodePointer;
+
+public:
+#if __cplusplus >= 201103L
+  // Note any changes to this method must be reflected in the
+  // C++03 implementation.
+  template <class WorkletType, typename...T>
+  DAX_CONT_EXPORT void Add(WorkletType w, T...a)
+    {
+    typedef dax::cont::scheduling::VerifyUserArgLength<WorkletType,
+              sizeof...(T)> WorkletUserArgs;
+    //if you are getting this error you are passing less arguments than requested
+    //in the control signature of this worklet
+    DAX_ASSERT_ARG_LENGTH((typename WorkletUserArgs::NotEnoughParameters));
+
+    //if you are getting this error you are passing too many arguments
+    //than requested in the control signature of this worklet
+    DAX_ASSERT_ARG_LENGTH((typename WorkletUserArgs::TooManyParameters));
+
+    typedef typename dax::cont::scheduling::PipelineInvocation<
+        DeviceAdapterTag, WorkletType(T...)>::type NodeType;
+    this->Nodes.push_back(NodePointer(new NodeType(w, a...)));
+    }
+#else // !(__cplusplus >= 201103L)
+  // For C++03 use Boost.Preprocessor file iteration to simulate
+  // parameter packs by enumerating implementations for all argument
+  // counts.
+#     define BOOST_PP_ITERATION_PARAMS_1 (3, (2, 10, <dax/cont/InvocationGroup.h>))
+#     include BOOST_PP_ITERATE()
+#endif // !(__cplusplus >= 201103L)
+
+  /// Returns the number of invocations added since the group was last run.
+  ///
+  DAX_CONT_EXPORT dax::Id GetNumberOfInvocations() const
+  {
+    return static_cast<dax::Id>(this->Nodes.size());
+  }
+
+  /// Removes all the invocations without running them.
+  ///
+  DAX_CONT_EXPORT void Clear() { this->Nodes.clear(); }
+
+private:
+  friend class dax::cont::Scheduler<DeviceAdapterTag>;
+
+  /// Runs all the invocations and empties the group. Called by
+  /// Scheduler::InvokeConcurrently.
+  ///
+  DAX_CONT_EXPORT void Execute()
+  {
+    std::vector<NodePointer> nodes;
+    nodes.swap(this->Nodes);
+
+    for (std::size_t node1 = 0; node1 < nodes.size(); node1++)
+      {
+      for (std::size_t node2 = 0; node2 < node1; node2++)
+        {
+        if (dax::cont::scheduling::PipelineNodesShareArrays(*nodes[node1],
+                                                            *nodes[node2]))
+          {
+          throw dax::cont::ErrorControlBadValue(
+                "An invocation of the group writes an array that another "
+                "invocation of the group uses.");
+          }
+        }
+      }
+
+    // Invocations that need their own scheduler or may use arrays that are
+    // not tracked run first, one after the other. The rest run as one
+    // schedule.
+    std::vector<dax::cont::scheduling::PipelineStage> stages;
+    for (std::size_t node = 0; node < nodes.size(); node++)
+      {
+#ifdef DAX_CUDA
+      const bool splittable = false;
+#else
+      const bool splittable = nodes[node]->IsSplittable()
+          && !nodes[node]->HasUntrackedAccesses();
+#endif
+      if (!splittable || (nodes.size() == 1))
+        {
+        nodes[node]->Invoke();
+        continue;
+        }
+      dax::cont::scheduling::PipelineStage stage;
+      stage.Nodes.push_back(nodes[node].get());
+      stage.NumberOfValues = nodes[node]->Prepare();
+      stages.push_back(stage);
+      }
+    dax::cont::scheduling::SchedulePipelineStages<DeviceAdapterTag>(stages);
+  }
+
+  std::vector<NodePointer> Nodes;
+};
+
+} } //namespace dax::cont
+
+#endif //__dax_cont_InvocationGroup_h
+
+#else // defined(BOOST_PP_IS_ITERATING)
+  template <class WorkletType, _dax_pp_typename___T>
+  DAX_CONT_EXPORT void Add(WorkletType w, _dax_pp_params___(a))
+    {
+    typedef dax::cont::scheduling::VerifyUserArgLength<WorkletType,
+                _dax_pp_sizeof___T> WorkletUserArgs;
+    //if you are getting this error you are passing less arguments than requested
+    //in the control signature of this worklet
+    DAX_ASSERT_ARG_LENGTH((typename WorkletUserArgs::NotEnoughParameters));
+
+    //if you are getting this error you are passing too many arguments
+    //than requested in the control signature of this worklet
+    DAX_ASSERT_ARG_LENGTH((typename WorkletUserArgs::TooManyParameters));
+
+    typedef typename dax::cont::scheduling::PipelineInvocation<
+        DeviceAdapterTag, WorkletType(_dax_pp_T___)>::type NodeType;
+    this->Nodes.push_back(NodePointer(new NodeType(w, _dax_pp_args___(a))));
+    }
+#endif // defined(BOOST_PP_IS_ITERATING)
@@ -0,0 +1,226 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__cont__MultiBlockUniformGrid_h
+#define __dax__cont__MultiBlockUniformGrid_h
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/internal/GridTags.h>
+
+#include <dax/CellTag.h>
+#include <dax/Extent.h>
+
+#include <dax/exec/internal/TopologyMultiBlockUniform.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+namespace dax {
+namespace cont {
+
+/// \brief A set of uniform grid blocks scheduled as a single grid.
+///
+/// The cells of all the blocks are numbered one block after the other, as
+/// are the points, so a worklet invoked on this grid runs over the cells of
+/// every block with a single schedule. Point fields are given as one array
+/// holding the values of each block's points in block order, and cell
+/// fields come out the same way. GetPointOffset and GetCellOffset give where
+/// the values of a block start in these concatenated arrays.
+///
+/// Copies of a MultiBlockUniformGrid share their blocks.
+///
+template <class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class MultiBlockUniformGrid
+{
+public:
+  typedef dax::CellTagVoxel CellTag;
+  typedef dax::cont::internal::MultiBlockUniformGridTag GridTypeTag;
+
+  typedef dax::cont::UniformGrid<DeviceAdapterTag> BlockType;
+
+  DAX_CONT_EXPORT
+  MultiBlockUniformGrid() : Internals(new InternalStruct)
+  {
+    this->Internals->CellOffsets.push_back(0);
+    this->Internals->PointOffsets.push_back(0);
+  }
+
+  /// Adds a block after the last one and returns its index.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id AddBlock(const BlockType &block)
+  {
+    InternalStruct &internals = *this->Internals;
+    internals.Blocks.push_back(block);
+    internals.CellOffsets.push_back(
+          internals.CellOffsets.back() + block.GetNumberOfCells());
+    internals.PointOffsets.push_back(
+          internals.PointOffsets.back() + block.GetNumberOfPoints());
+    internals.PointDimensions.push_back(
+          dax::extentDimensions(block.GetExtent()));
+    internals.ArraysValid = false;
+    return this->GetNumberOfBlocks() - 1;
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfBlocks() const
+  {
+    return static_cast<dax::Id>(this->Internals->Blocks.size());
+  }
+
+  DAX_CONT_EXPORT
+  const BlockType &GetBlock(dax::Id block) const
+  {
+    return this->Internals->Blocks[block];
+  }
+
+  /// The index of the first cell (and cell field value) of the given block.
+  /// Passing the number of blocks gives the total number of cells.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetCellOffset(dax::Id block) const
+  {
+    return this->Internals->CellOffsets[block];
+  }
+
+  /// The index of the first point (and point field value) of the given
+  /// block. Passing the number of blocks gives the total number of points.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetPointOffset(dax::Id block) const
+  {
+    return this->Internals->PointOffsets[block];
+  }
+
+  /// Get the number of points in all the blocks.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const {
+    return this->Internals->PointOffsets.back();
+  }
+
+  /// Get the number of cells in all the blocks.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const {
+    return this->Internals->CellOffsets.back();
+  }
+
+  typedef dax::cont::ArrayHandle<
+      dax::Vector3,
+      dax::cont::ArrayContainerControlTagBasic,
+      DeviceAdapterTag> PointCoordinatesType;
+
+  /// Returns the coordinates of the points of all the blocks. Unlike for a
+  /// single uniform grid the array is explicit; it is computed on each call.
+  ///
+  DAX_CONT_EXPORT
+  PointCoordinatesType GetPointCoordinates() const {
+    PointCoordinatesType coordinates;
+    coordinates.Grow(this->GetNumberOfPoints());
+    typename PointCoordinatesType::PortalControl portal =
+        coordinates.GetPortalControl();
+    dax::Id pointIndex = 0;
+    for (dax::Id block = 0; block < this->GetNumberOfBlocks(); block++)
+      {
+      const BlockType &grid = this->GetBlock(block);
+      for (dax::Id index = 0; index < grid.GetNumberOfPoints(); index++)
+        {
+        portal.Set(pointIndex++, grid.ComputePointCoordinates(index));
+        }
+      }
+    return coordinates;
+  }
+
+  typedef dax::cont::ArrayHandle<
+      dax::Id, dax::cont::ArrayContainerControlTagBasic, DeviceAdapterTag>
+      IdArrayType;
+  typedef dax::cont::ArrayHandle<
+      dax::Id3, dax::cont::ArrayContainerControlTagBasic, DeviceAdapterTag>
+      Id3ArrayType;
+
+  typedef dax::exec::internal::TopologyMultiBlockUniform<
+      typename IdArrayType::PortalConstExecution,
+      typename Id3ArrayType::PortalConstExecution>
+      TopologyStructConstExecution;
+  typedef TopologyStructConstExecution TopologyStructExecution;
+
+  /// Prepares this topology to be used as an input to an operation in the
+  /// execution environment.  Returns a structure that can be used directly
+  /// in the execution environment. The block tables are only transferred
+  /// again after blocks are added.
+  ///
+  DAX_CONT_EXPORT
+  TopologyStructConstExecution PrepareForInput() const {
+    InternalStruct &internals = *this->Internals;
+    if (internals.Blocks.empty())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "MultiBlockUniformGrid has no blocks.");
+      }
+    if (!internals.ArraysValid)
+      {
+      internals.CellOffsetsArray = dax::cont::make_ArrayHandle(
+            internals.CellOffsets,
+            dax::cont::ArrayContainerControlTagBasic(),
+            DeviceAdapterTag());
+      internals.PointOffsetsArray = dax::cont::make_ArrayHandle(
+            internals.PointOffsets,
+            dax::cont::ArrayContainerControlTagBasic(),
+            DeviceAdapterTag());
+      internals.PointDimensionsArray = dax::cont::make_ArrayHandle(
+            internals.PointDimensions,
+            dax::cont::ArrayContainerControlTagBasic(),
+            DeviceAdapterTag());
+      internals.ArraysValid = true;
+      }
+    TopologyStructConstExecution topology;
+    topology.CellOffsets = internals.CellOffsetsArray.PrepareForInput();
+    topology.PointOffsets = internals.PointOffsetsArray.PrepareForInput();
+    topology.PointDimensions =
+        internals.PointDimensionsArray.PrepareForInput();
+    topology.NumberOfBlocks = this->GetNumberOfBlocks();
+    return topology;
+  }
+
+private:
+  struct InternalStruct
+  {
+    InternalStruct() : ArraysValid(false) {  }
+
+    std::vector<BlockType> Blocks;
+    std::vector<dax::Id> CellOffsets;
+    std::vector<dax::Id> PointOffsets;
+    std::vector<dax::Id3> PointDimensions;
+
+    // These reference the vectors above and are rebuilt when they change.
+    bool ArraysValid;
+    IdArrayType CellOffsetsArray;
+    IdArrayType PointOffsetsArray;
+    Id3ArrayType PointDimensionsArray;
+  };
+
+  boost::shared_ptr<InternalStruct> Internals;
+};
+
+}
+}
+
+#endif //__dax__cont__MultiBlockUniformGrid_h
@@ -0,0 +1,63 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_NumaDomainScheduling_h
+#define __dax_cont_NumaDomainScheduling_h
+
+#include <dax/cont/internal/NumaDomains.h>
+
+namespace dax {
+namespace cont {
+
+namespace internal {
+
+DAX_CONT_EXPORT
+bool &GlobalNumaDomainScheduling()
+{
+  static bool enabled = false;
+  return enabled;
+}
+
+} // namespace internal
+
+/// Turns NUMA domain decomposition on or off for the schedules of the device
+/// adapters that run on the host (TBB and OpenMP). When on, the index space
+/// (or the k planes of a UniformGrid extent) is split into one contiguous
+/// slab per NUMA domain, each slab is run by threads pinned to that domain,
+/// and the same split is replayed by every schedule of the same size. Repeated
+/// passes over the same arrays (and the parallel first touch of the
+/// ArrayAllocationPolicy) thus keep touching node local memory.
+///
+/// With TBB, the slab of each domain runs in a task arena of that domain,
+/// which needs TBB 4.3 or later.
+///
+DAX_CONT_EXPORT
+void SetNumaDomainScheduling(bool enable)
+{
+  dax::cont::internal::GlobalNumaDomainScheduling() = enable;
+}
+
+/// Returns whether NUMA domain decomposition is used by host schedules.
+///
+DAX_CONT_EXPORT
+bool GetNumaDomainScheduling()
+{
+  return dax::cont::internal::GlobalNumaDomainScheduling();
+}
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_NumaDomainScheduling_h
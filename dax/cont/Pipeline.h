@@ -0,0 +1,450 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#if !defined(BOOST_PP_IS_ITERATING)
+
+#ifndef __dax_cont_Pipeline_h
+#define __dax_cont_Pipeline_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/scheduling/PipelineInvocation.h>
+#include <dax/cont/scheduling/PipelineStages.h>
+#include <dax/cont/scheduling/VerifyUserArgLength.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#if !(__cplusplus >= 201103L)
+# include <dax/internal/ParameterPackCxx03.h>
+#endif // !(__cplusplus >= 201103L)
+
+namespace dax { namespace cont {
+
+/// \brief Records worklet invocations and runs them later as a graph.
+///
+/// Invoke takes the same arguments as Scheduler::Invoke but only records the
+/// invocation. Execute then builds the dependency graph of the recorded
+/// invocations from the arrays they read and write and runs it:
+///
+/// \li Invocations that do not depend on each other run concurrently in a
+/// single schedule of the device adapter.
+///
+/// \li A chain of map field invocations over arrays of the same size is
+/// fused: each block of values goes through the whole chain before the next
+/// block is started, so intermediate values are read back from cache. When
+/// the chain writes intermediate arrays that the calling code no longer
+/// holds and that nothing outside the chain reads, the chain is run one
+/// chunk of DAX_PIPELINE_CHUNK_SIZE values at a time and each of those
+/// arrays is replaced by a chunk-sized scratch array, so they are never
+/// allocated to full size.
+///
+/// \li Each invocation, along with its copies of the argument arrays, is
+/// dropped as soon as it has run. An intermediate array that the calling
+/// code no longer holds is therefore freed right after its last consumer
+/// instead of living to the end of the pipeline, and its memory is available
+/// to the arrays allocated by the invocations that follow.
+///
+/// Dependencies are found through ArrayHandle arguments and the arrays of
+/// grid arguments. Views, composite vectors and the other wrapper arrays
+/// count as uses of the arrays holding their values. Invocations that need
+/// their own scheduler (like topology generation) or that may use arrays
+/// that cannot be identified (such as those held by an execution object)
+/// are run alone, after everything recorded before them and before
+/// everything recorded after them. Fusion and concurrency run worklets from the host, so they
+/// are turned off when compiling for CUDA.
+///
+template <class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class Pipeline
+{
+  typedef boost::shared_ptr<dax::cont::scheduling::PipelineNode> NodePointer;
+
+public:
+  DAX_CONT_EXPORT Pipeline() : Fusion(true), Concurrency(true) {  }
+
+#if __cplusplus >= 201103L
+  // Note any changes to this method must be reflected in the
+  // C++03 implementation.
+  template <class WorkletType, typename...T>
+  DAX_CONT_EXPORT void Invoke(WorkletType w, T...a)
+    {
+    typedef dax::cont::scheduling::VerifyUserArgLength<WorkletType,
+              sizeof...(T)> WorkletUserArgs;
+    //if you are getting this error you are passing less arguments than requested
+    //in the control signature of this worklet
+    DAX_ASSERT_ARG_LENGTH((typename WorkletUserArgs::NotEnoughParameters));
+
+    //if you are getting this error you are passing too many arguments
+    //than requested in the control signature of this worklet
+    DAX_ASSERT_ARG_LENGTH((typename WorkletUserArgs::TooManyParameters));
+
+    typedef typename dax::cont::scheduling::PipelineInvocation<
+        DeviceAdapterTag, WorkletType(T...)>::type NodeType;
+    this->Nodes.push_back(NodePointer(new NodeType(w, a...)));
+    }
+#else // !(__cplusplus >= 201103L)
+  // For C++03 use Boost.Preprocessor file iteration to simulate
+  // parameter packs by enumerating implementations for all argument
+  // counts.
+#     define BOOST_PP_ITERATION_PARAMS_1 (3, (2, 10, <dax/cont/Pipeline.h>))
+#     include BOOST_PP_ITERATE()
+#endif // !(__cplusplus >= 201103L)
+
+  /// Returns the number of invocations recorded since the last Execute.
+  ///
+  DAX_CONT_EXPORT dax::Id GetNumberOfInvocations() const
+  {
+    return static_cast<dax::Id>(this->Nodes.size());
+  }
+
+  /// Turns fusion of map field chains on or off. On by default.
+  ///
+  DAX_CONT_EXPORT void SetFusion(bool fusion) { this->Fusion = fusion; }
+  DAX_CONT_EXPORT bool GetFusion() const { return this->Fusion; }
+
+  /// Turns concurrent execution of independent invocations on or off. On by
+  /// default.
+  ///
+  DAX_CONT_EXPORT void SetConcurrency(bool concurrency)
+  {
+    this->Concurrency = concurrency;
+  }
+  DAX_CONT_EXPORT bool GetConcurrency() const { return this->Concurrency; }
+
+  /// Runs all the invocations recorded since the last call. The pipeline is
+  /// empty afterward (even if an invocation throws) and can record a new
+  /// graph.
+  ///
+  DAX_CONT_EXPORT void Execute()
+  {
+    // Take the nodes so that they are dropped however we leave.
+    std::vector<NodePointer> nodes;
+    nodes.swap(this->Nodes);
+    const std::size_t numberOfNodes = nodes.size();
+
+    std::vector<std::vector<std::size_t> > predecessors(numberOfNodes);
+    for (std::size_t later = 0; later < numberOfNodes; later++)
+      {
+      for (std::size_t earlier = 0; earlier < later; earlier++)
+        {
+        if (DependsOn(*nodes[later], *nodes[earlier]))
+          {
+          predecessors[later].push_back(earlier);
+          }
+        }
+      }
+
+    // Put each elementwise node in the group of its predecessors when they
+    // all are in one group of elementwise nodes. Only the first node of a
+    // group can depend on other groups, so the groups form a graph too.
+    std::vector<std::vector<std::size_t> > groups;
+    std::vector<std::size_t> groupOfNode(numberOfNodes);
+    for (std::size_t node = 0; node < numberOfNodes; node++)
+      {
+      bool joined = false;
+      if (this->CanSplit() && this->Fusion
+          && nodes[node]->IsElementwise() && !predecessors[node].empty())
+        {
+        const std::size_t group = groupOfNode[predecessors[node].back()];
+        joined = nodes[groups[group].front()]->IsElementwise();
+        for (std::size_t index = 0;
+             joined && (index < predecessors[node].size());
+             index++)
+          {
+          joined = (groupOfNode[predecessors[node][index]] == group);
+          }
+        if (joined)
+          {
+          groups[group].push_back(node);
+          groupOfNode[node] = group;
+          }
+        }
+      if (!joined)
+        {
+        groupOfNode[node] = groups.size();
+        groups.push_back(std::vector<std::size_t>(1, node));
+        }
+      }
+
+    // Groups of the same level do not depend on each other.
+    std::vector<std::size_t> groupLevels(groups.size(), 0);
+    std::size_t numberOfLevels = 0;
+    for (std::size_t group = 0; group < groups.size(); group++)
+      {
+      const std::vector<std::size_t> &firstPredecessors =
+          predecessors[groups[group].front()];
+      for (std::size_t index = 0; index < firstPredecessors.size(); index++)
+        {
+        groupLevels[group] = std::max(
+              groupLevels[group],
+              groupLevels[groupOfNode[firstPredecessors[index]]] + 1);
+        }
+      numberOfLevels = std::max(numberOfLevels, groupLevels[group] + 1);
+      }
+
+    for (std::size_t level = 0; level < numberOfLevels; level++)
+      {
+      std::vector<std::size_t> levelGroups;
+      for (std::size_t group = 0; group < groups.size(); group++)
+        {
+        if (groupLevels[group] == level) { levelGroups.push_back(group); }
+        }
+      this->ExecuteLevel(nodes, groups, levelGroups);
+
+      // Drop the nodes that ran along with their references to arrays.
+      for (std::size_t index = 0; index < levelGroups.size(); index++)
+        {
+        const std::vector<std::size_t> &group = groups[levelGroups[index]];
+        for (std::size_t node = 0; node < group.size(); node++)
+          {
+          nodes[group[node]].reset();
+          }
+        }
+      }
+  }
+
+private:
+  static bool CanSplit()
+  {
+#ifdef DAX_CUDA
+    return false;
+#else
+    return true;
+#endif
+  }
+
+  /// True if \c later has to wait for \c earlier: they share an array that
+  /// at least one of them writes, one of them uses arrays that are not
+  /// tracked, or one of them cannot be split.
+  ///
+  static bool DependsOn(const dax::cont::scheduling::PipelineNode &later,
+                        const dax::cont::scheduling::PipelineNode &earlier)
+  {
+    if (!later.IsSplittable() || !earlier.IsSplittable()) { return true; }
+    return dax::cont::scheduling::PipelineNodesConflict(later, earlier);
+  }
+
+  /// True if the first node of \c group using \c array only writes it.
+  ///
+  static bool FirstUseOverwrites(const std::vector<NodePointer> &nodes,
+                                 const std::vector<std::size_t> &group,
+                                 const void *array)
+  {
+    for (std::size_t node = 0; node < group.size(); node++)
+      {
+      const std::vector<dax::cont::scheduling::PipelineArrayAccess> &accesses
+          = nodes[group[node]]->GetAccesses();
+      bool used = false;
+      bool overwritten = true;
+      for (std::size_t index = 0; index < accesses.size(); index++)
+        {
+        if (accesses[index].Array != array) { continue; }
+        used = true;
+        overwritten = overwritten
+            && accesses[index].Write && !accesses[index].Read;
+        }
+      if (used) { return overwritten; }
+      }
+    return false;
+  }
+
+  /// Runs a fused group one chunk at a time if it has intermediate arrays:
+  /// arrays it overwrites that are only referred to by the group's
+  /// arguments (\c counts holds the references of all the nodes still to
+  /// run). Each chunk is a schedule of its own. Returns false, having run
+  /// nothing, if the group has no intermediates or cannot run in chunks.
+  ///
+  bool ExecuteInChunks(
+      const std::vector<NodePointer> &nodes,
+      const std::vector<std::size_t> &group,
+      const dax::cont::scheduling::PipelineHandleCounts &counts) const
+  {
+    dax::cont::scheduling::PipelineHandleCounts groupCounts;
+    for (std::size_t node = 0; node < group.size(); node++)
+      {
+      dax::cont::scheduling::PipelineNode *pipelineNode =
+          nodes[group[node]].get();
+      if (!pipelineNode->CanRunInChunks()) { return false; }
+      pipelineNode->CountArrayHandles(groupCounts);
+      }
+    const dax::Id numberOfValues = nodes[group.front()]->CountValues();
+    if (numberOfValues <= DAX_PIPELINE_CHUNK_SIZE) { return false; }
+
+    dax::cont::scheduling::PipelineScratchArrays scratch(
+          DAX_PIPELINE_CHUNK_SIZE);
+    std::set<const void *> outputs;
+    for (dax::cont::scheduling::PipelineHandleCounts::const_iterator
+         array = groupCounts.begin(); array != groupCounts.end(); array++)
+      {
+      if (!FirstUseOverwrites(nodes, group, array->first))
+        {
+        // The later nodes are sized by the arrays the group writes, which
+        // will have the size of the first node. The arrays it only reads
+        // must have that size too.
+        if (array->second.NumberOfValues != numberOfValues) { return false; }
+        continue;
+        }
+      const dax::cont::scheduling::PipelineHandleCount &total =
+          counts.find(array->first)->second;
+      if ((array->second.Arguments == total.Arguments)
+          && (total.Arguments == total.References))
+        {
+        scratch.Add(array->first);
+        }
+      else
+        {
+        outputs.insert(array->first);
+        }
+      }
+    if (scratch.IsEmpty()) { return false; }
+
+    dax::cont::scheduling::PipelineStage stage;
+    for (std::size_t node = 0; node < group.size(); node++)
+      {
+      stage.Nodes.push_back(nodes[group[node]].get());
+      stage.Nodes.back()->AllocateChunkedOutputs(numberOfValues, outputs);
+      }
+    for (dax::Id begin = 0;
+         begin < numberOfValues;
+         begin += DAX_PIPELINE_CHUNK_SIZE)
+      {
+      stage.NumberOfValues = std::min<dax::Id>(DAX_PIPELINE_CHUNK_SIZE,
+                                               numberOfValues - begin);
+      for (std::size_t node = 0; node < stage.Nodes.size(); node++)
+        {
+        stage.Nodes[node]->PrepareChunk(begin, stage.NumberOfValues, scratch);
+        }
+      dax::cont::scheduling::SchedulePipelineStages<DeviceAdapterTag>(
+            std::vector<dax::cont::scheduling::PipelineStage>(1, stage));
+      }
+    return true;
+  }
+
+  void ExecuteLevel(const std::vector<NodePointer> &nodes,
+                    const std::vector<std::vector<std::size_t> > &groups,
+                    const std::vector<std::size_t> &levelGroups) const
+  {
+    // Count the references before any node of the level holds bindings.
+    dax::cont::scheduling::PipelineHandleCounts counts;
+    for (std::size_t node = 0; node < nodes.size(); node++)
+      {
+      if (nodes[node]) { nodes[node]->CountArrayHandles(counts); }
+      }
+
+    std::vector<dax::cont::scheduling::PipelineStage> stages;
+    std::vector<dax::cont::scheduling::PipelineStage> sequentialStages;
+    for (std::size_t index = 0; index < levelGroups.size(); index++)
+      {
+      const std::vector<std::size_t> &group = groups[levelGroups[index]];
+      dax::cont::scheduling::PipelineNode *first = nodes[group.front()].get();
+      if ((group.size() > 1) && this->ExecuteInChunks(nodes, group, counts))
+        {
+        continue;
+        }
+      if ((group.size() == 1)
+          && (!this->CanSplit()
+              || !first->IsSplittable()
+              || !this->Concurrency
+              || (levelGroups.size() == 1)))
+        {
+        // Nothing to fuse or to run alongside. Use the regular scheduler.
+        first->Invoke();
+        continue;
+        }
+
+      dax::cont::scheduling::PipelineStage stage;
+      bool sameSize = true;
+      for (std::size_t node = 0; node < group.size(); node++)
+        {
+        dax::cont::scheduling::PipelineNode *pipelineNode =
+            nodes[group[node]].get();
+        const dax::Id count = pipelineNode->Prepare();
+        if (node == 0) { stage.NumberOfValues = count; }
+        sameSize = sameSize && (count == stage.NumberOfValues);
+        stage.Nodes.push_back(pipelineNode);
+        }
+
+      if (sameSize)
+        {
+        stages.push_back(stage);
+        }
+      else
+        {
+        // Cannot fuse after all. Run the nodes one after the other.
+        for (std::size_t node = 0; node < group.size(); node++)
+          {
+          dax::cont::scheduling::PipelineStage single;
+          single.Nodes.push_back(stage.Nodes[node]);
+          single.NumberOfValues = 0;
+          sequentialStages.push_back(single);
+          }
+        }
+      }
+
+    if (!this->Concurrency)
+      {
+      for (std::size_t index = 0; index < stages.size(); index++)
+        {
+        dax::cont::scheduling::SchedulePipelineStages<DeviceAdapterTag>(
+              std::vector<dax::cont::scheduling::PipelineStage>(
+                1, stages[index]));
+        }
+      }
+    else
+      {
+      dax::cont::scheduling::SchedulePipelineStages<DeviceAdapterTag>(stages);
+      }
+    for (std::size_t index = 0; index < sequentialStages.size(); index++)
+      {
+      // The size of an unfused node is the size it was prepared with.
+      dax::cont::scheduling::PipelineStage &stage = sequentialStages[index];
+      stage.NumberOfValues = stage.Nodes.front()->Prepare();
+      dax::cont::scheduling::SchedulePipelineStages<DeviceAdapterTag>(
+            std::vector<dax::cont::scheduling::PipelineStage>(1, stage));
+      }
+  }
+
+  std::vector<NodePointer> Nodes;
+  bool Fusion;
+  bool Concurrency;
+};
+
+} } //namespace dax::cont
+
+#endif //__dax_cont_Pipeline_h
+
+#else // defined(BOOST_PP_IS_ITERATING)
+  template <class WorkletType, _dax_pp_typename___T>
+  DAX_CONT_EXPORT void Invoke(WorkletType w, _dax_pp_params___(a))
+    {
+    typedef dax::cont::scheduling::VerifyUserArgLength<WorkletType,
+                _dax_pp_sizeof___T> WorkletUserArgs;
+    //if you are getting this error you are passing less arguments than requested
+    //in the control signature of this worklet
+    DAX_ASSERT_ARG_LENGTH((typename WorkletUserArgs::NotEnoughParameters));
+
+    //if you are getting this error you are passing too many arguments
+    //than requested in the control signature of this worklet
+    DAX_ASSERT_ARG_LENGTH((typename WorkletUserArgs::TooManyParameters));
+
+    typedef typename dax::cont::scheduling::PipelineInvocation<
+        DeviceAdapterTag, WorkletType(_dax_pp_T___)>::type NodeType;
+    this->Nodes.push_back(NodePointer(new NodeType(w, _dax_pp_args___(a))));
+    }
+#endif // defined(BOOST_PP_IS_ITERATING)
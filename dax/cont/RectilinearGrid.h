@@ -0,0 +1,222 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__cont__RectilinearGrid_h
+#define __dax__cont__RectilinearGrid_h
+
+#include <dax/cont/ArrayContainerControlCartesianProduct.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/internal/GridTags.h>
+
+#include <dax/CellTag.h>
+#include <dax/Extent.h>
+
+#include <dax/exec/internal/TopologyRectilinear.h>
+
+namespace dax {
+namespace cont {
+
+/// This class defines the topology of a rectilinear grid. A rectilinear grid
+/// is axis aligned like a uniform grid, but the spacing between grid points
+/// can vary along each axis. The grid is defined by three one dimensional
+/// arrays giving the coordinates of the grid planes along the x, y, and z
+/// axes. The point coordinates are the cartesian product of these arrays and
+/// the cells are voxels with the same implicit connectivity as a uniform grid,
+/// so neither points nor connections are stored.
+///
+template <
+    class AxisArrayContainerControlTag = DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+    class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class RectilinearGrid
+{
+public:
+  typedef dax::CellTagVoxel CellTag;
+  typedef dax::cont::internal::RectilinearGridTag GridTypeTag;
+
+  typedef dax::cont::ArrayHandle<
+      dax::Scalar, AxisArrayContainerControlTag, DeviceAdapterTag>
+      AxisCoordinatesType;
+
+  DAX_CONT_EXPORT
+  RectilinearGrid() {  }
+
+  DAX_CONT_EXPORT
+  RectilinearGrid(AxisCoordinatesType xCoordinates,
+                  AxisCoordinatesType yCoordinates,
+                  AxisCoordinatesType zCoordinates)
+    : XCoordinates(xCoordinates),
+      YCoordinates(yCoordinates),
+      ZCoordinates(zCoordinates) {  }
+
+  /// The axis coordinate arrays give the location of the grid planes along
+  /// each axis. Their lengths define the number of points in each dimension.
+  ///
+  DAX_CONT_EXPORT
+  const AxisCoordinatesType &GetXCoordinates() const {
+    return this->XCoordinates;
+  }
+  DAX_CONT_EXPORT
+  void SetXCoordinates(AxisCoordinatesType coordinates) {
+    this->XCoordinates = coordinates;
+  }
+  DAX_CONT_EXPORT
+  const AxisCoordinatesType &GetYCoordinates() const {
+    return this->YCoordinates;
+  }
+  DAX_CONT_EXPORT
+  void SetYCoordinates(AxisCoordinatesType coordinates) {
+    this->YCoordinates = coordinates;
+  }
+  DAX_CONT_EXPORT
+  const AxisCoordinatesType &GetZCoordinates() const {
+    return this->ZCoordinates;
+  }
+  DAX_CONT_EXPORT
+  void SetZCoordinates(AxisCoordinatesType coordinates) {
+    this->ZCoordinates = coordinates;
+  }
+
+  /// The extent defines the minimum and maximum (inclusive) indices in each
+  /// dimension. For a rectilinear grid it always starts at (0, 0, 0) and is
+  /// defined by the lengths of the axis coordinate arrays.
+  ///
+  DAX_CONT_EXPORT
+  dax::Extent3 GetExtent() const {
+    dax::Extent3 extent;
+    extent.Min = dax::make_Id3(0, 0, 0);
+    extent.Max = dax::make_Id3(this->XCoordinates.GetNumberOfValues() - 1,
+                               this->YCoordinates.GetNumberOfValues() - 1,
+                               this->ZCoordinates.GetNumberOfValues() - 1);
+    return extent;
+  }
+
+  // Helper functions
+
+  /// Get the number of points.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const {
+    dax::Id3 dims = dax::extentDimensions(this->GetExtent());
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Get the number of cells.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const {
+    dax::Id3 dims = dax::extentCellDimensions(this->GetExtent());
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Converts an i, j, k point location to a point index.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id ComputePointIndex(const dax::Id3 &ijk) const {
+    return dax::index3ToFlatIndex(ijk, this->GetExtent());
+  }
+
+  /// Converts an i, j, k cell location to a cell index.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id ComputeCellIndex(const dax::Id3 &ijk) const {
+    return dax::index3ToFlatIndexCell(ijk, this->GetExtent());
+  }
+
+  /// Converts a flat point index to an i, j, k point location.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id3 ComputePointLocation(dax::Id index) const {
+    return dax::flatIndexToIndex3(index, this->GetExtent());
+  }
+
+  /// Converts a flat cell index to an i, j, k cell location.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id3 ComputeCellLocation(dax::Id index) const {
+    return dax::flatIndexToIndex3Cell(index, this->GetExtent());
+  }
+
+  /// Given a point i, j, k location, computes the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id3 location) const {
+    return dax::make_Vector3(
+          this->XCoordinates.GetPortalConstControl().Get(location[0]),
+          this->YCoordinates.GetPortalConstControl().Get(location[1]),
+          this->ZCoordinates.GetPortalConstControl().Get(location[2]));
+  }
+
+  /// Given a point index, computes the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id index) const {
+    return this->ComputePointCoordinates(this->ComputePointLocation(index));
+  }
+
+  typedef dax::cont::ArrayHandle<
+      dax::Vector3,
+      dax::cont::ArrayContainerControlTagCartesianProduct<AxisCoordinatesType>,
+      DeviceAdapterTag> PointCoordinatesType;
+
+  /// Returns an array of the point coordinates. The array is computed on the
+  /// fly from the axis coordinate arrays, so only the axis arrays are ever
+  /// transferred to the execution environment.
+  ///
+  DAX_CONT_EXPORT
+  PointCoordinatesType GetPointCoordinates() const {
+    typedef typename PointCoordinatesType::PortalConstControl PortalType;
+    return PointCoordinatesType(PortalType(this->XCoordinates,
+                                           this->YCoordinates,
+                                           this->ZCoordinates));
+  }
+
+  typedef dax::exec::internal::TopologyRectilinear<
+      typename AxisCoordinatesType::PortalConstExecution>
+      TopologyStructConstExecution;
+  typedef TopologyStructConstExecution TopologyStructExecution;
+
+  /// Prepares this topology to be used as an input to an operation in the
+  /// execution environment.  Returns a structure that can be used directly
+  /// in the execution environment.
+  ///
+  DAX_CONT_EXPORT
+  TopologyStructConstExecution PrepareForInput() const {
+    if (   (this->XCoordinates.GetNumberOfValues() < 1)
+        || (this->YCoordinates.GetNumberOfValues() < 1)
+        || (this->ZCoordinates.GetNumberOfValues() < 1))
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "RectilinearGrid needs coordinates along all three axes.");
+      }
+    TopologyStructConstExecution topology;
+    topology.XCoordinates = this->XCoordinates.PrepareForInput();
+    topology.YCoordinates = this->YCoordinates.PrepareForInput();
+    topology.ZCoordinates = this->ZCoordinates.PrepareForInput();
+    topology.Extent = this->GetExtent();
+    return topology;
+  }
+
+private:
+  AxisCoordinatesType XCoordinates;
+  AxisCoordinatesType YCoordinates;
+  AxisCoordinatesType ZCoordinates;
+};
+
+}
+}
+
+#endif //__dax__cont__RectilinearGrid_h
@@ -25,6 +25,7 @@
 //include all the specialization of the scheduler class
 #include <dax/cont/scheduling/SchedulerDefault.h>
 #include <dax/cont/scheduling/SchedulerCells.h>
+#include <dax/cont/scheduling/SchedulerFlyingEdges.h>
 #include <dax/cont/scheduling/SchedulerGenerateInterpolatedCells.h>
 #include <dax/cont/scheduling/SchedulerGenerateTopology.h>
 #include <dax/cont/PermutationContainer.h>
@@ -35,10 +36,22 @@
 
 namespace dax { namespace cont {
 
+template <class DeviceAdapterTag> class InvocationGroup;
+
 template <class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
 class Scheduler
 {
 public:
+  /// Runs all the invocations added to \c group as a single schedule and
+  /// empties the group. The invocations must not depend on each other. See
+  /// InvocationGroup (declared in dax/cont/InvocationGroup.h).
+  ///
+  DAX_CONT_EXPORT void InvokeConcurrently(
+      dax::cont::InvocationGroup<DeviceAdapterTag> &group) const
+    {
+    group.Execute();
+    }
+
 #if __cplusplus >= 201103L
   // Note any changes to this method must be reflected in the
   // C++03 implementation.
@@ -0,0 +1,144 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__cont__SubsetUniformGrid_h
+#define __dax__cont__SubsetUniformGrid_h
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/internal/GridTags.h>
+
+#include <dax/CellTag.h>
+
+#include <dax/exec/internal/TopologySubsetUniform.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief A subset of the cells of a uniform grid.
+///
+/// Only the ids of the cells in the subset are stored. The connections and
+/// point coordinates come implicitly from the parent UniformGrid, so a
+/// subset keeping most cells of a grid takes one id per cell instead of the
+/// eight connections and the compacted coordinates of an unstructured grid.
+///
+/// The points of the subset are all the points of the parent, so point
+/// fields of the parent are used as they are. Cell fields hold one value per
+/// cell of the subset, in the order of the cell ids.
+///
+template <class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class SubsetUniformGrid
+{
+public:
+  typedef dax::CellTagVoxel CellTag;
+  typedef dax::cont::internal::SubsetUniformGridTag GridTypeTag;
+
+  typedef dax::cont::UniformGrid<DeviceAdapterTag> ParentGridType;
+  typedef dax::cont::ArrayHandle<
+      dax::Id, dax::cont::ArrayContainerControlTagBasic, DeviceAdapterTag>
+      CellIdsType;
+
+  DAX_CONT_EXPORT
+  SubsetUniformGrid() {  }
+
+  DAX_CONT_EXPORT
+  SubsetUniformGrid(const ParentGridType &parent, const CellIdsType &cellIds)
+    : Parent(parent), CellIds(cellIds) {  }
+
+  /// The grid the cells are taken from.
+  ///
+  DAX_CONT_EXPORT
+  const ParentGridType &GetParent() const { return this->Parent; }
+  void SetParent(const ParentGridType &parent) { this->Parent = parent; }
+
+  /// The id in the parent grid of each cell of the subset.
+  ///
+  DAX_CONT_EXPORT
+  const CellIdsType &GetCellIds() const { return this->CellIds; }
+  void SetCellIds(const CellIdsType &cellIds) { this->CellIds = cellIds; }
+
+  /// Get the number of points, which are the points of the parent.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const {
+    return this->Parent.GetNumberOfPoints();
+  }
+
+  /// Get the number of cells in the subset.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const {
+    return this->CellIds.GetNumberOfValues();
+  }
+
+  /// Given a point index, computes the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id index) const {
+    return this->Parent.ComputePointCoordinates(index);
+  }
+
+  typedef typename ParentGridType::PointCoordinatesType PointCoordinatesType;
+
+  DAX_CONT_EXPORT
+  PointCoordinatesType GetPointCoordinates() const {
+    return this->Parent.GetPointCoordinates();
+  }
+
+  typedef dax::exec::internal::TopologySubsetUniform<
+      typename CellIdsType::PortalConstExecution>
+      TopologyStructConstExecution;
+  typedef TopologyStructConstExecution TopologyStructExecution;
+
+  /// Prepares this topology to be used as an input to an operation in the
+  /// execution environment.  Returns a structure that can be used directly
+  /// in the execution environment.
+  ///
+  DAX_CONT_EXPORT
+  TopologyStructConstExecution PrepareForInput() const {
+    TopologyStructConstExecution topology;
+    topology.Parent = this->Parent.PrepareForInput();
+    topology.CellIds = this->CellIds.PrepareForInput();
+    return topology;
+  }
+
+private:
+  ParentGridType Parent;
+  CellIdsType CellIds;
+};
+
+/// Makes the subset of the cells of a uniform grid with a non-zero
+/// classification, such as the output of ThresholdClassify.
+///
+template<class DeviceAdapterTag, typename T, class Container>
+DAX_CONT_EXPORT
+dax::cont::SubsetUniformGrid<DeviceAdapterTag>
+make_SubsetUniformGrid(
+    const dax::cont::UniformGrid<DeviceAdapterTag> &parent,
+    const dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &classification)
+{
+  typename dax::cont::SubsetUniformGrid<DeviceAdapterTag>::CellIdsType
+      cellIds;
+  dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapterTag>::
+      StreamCompact(classification, cellIds);
+  return dax::cont::SubsetUniformGrid<DeviceAdapterTag>(parent, cellIds);
+}
+
+}
+}
+
+#endif //__dax__cont__SubsetUniformGrid_h
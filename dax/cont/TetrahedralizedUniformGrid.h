@@ -0,0 +1,115 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__cont__TetrahedralizedUniformGrid_h
+#define __dax__cont__TetrahedralizedUniformGrid_h
+
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/internal/GridTags.h>
+
+#include <dax/CellTag.h>
+
+#include <dax/exec/internal/TopologyTetrahedralizedUniform.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief A uniform grid viewed as a grid of tetrahedra.
+///
+/// Every voxel of the parent UniformGrid is split into 5 tetrahedra, like
+/// dax::worklet::Tetrahedralize does, but the connections of each
+/// tetrahedron are computed when they are needed from the voxel and the
+/// index of the tetrahedron in it. No connections are stored and no
+/// topology generation is run, so tetrahedron worklets can run directly on
+/// uniform data.
+///
+/// Tetrahedron \c n comes from voxel <tt>n / 5</tt> of the parent. The
+/// points are the points of the parent, so point fields of the parent are
+/// used as they are.
+///
+template <class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class TetrahedralizedUniformGrid
+{
+public:
+  typedef dax::CellTagTetrahedron CellTag;
+  typedef dax::cont::internal::TetrahedralizedUniformGridTag GridTypeTag;
+
+  typedef dax::cont::UniformGrid<DeviceAdapterTag> ParentGridType;
+
+  DAX_CONT_EXPORT
+  TetrahedralizedUniformGrid() {  }
+
+  DAX_CONT_EXPORT
+  TetrahedralizedUniformGrid(const ParentGridType &parent)
+    : Parent(parent) {  }
+
+  /// The grid whose voxels are split.
+  ///
+  DAX_CONT_EXPORT
+  const ParentGridType &GetParent() const { return this->Parent; }
+  void SetParent(const ParentGridType &parent) { this->Parent = parent; }
+
+  /// Get the number of points, which are the points of the parent.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const {
+    return this->Parent.GetNumberOfPoints();
+  }
+
+  /// Get the number of tetrahedra, 5 for each voxel of the parent.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const {
+    return 5*this->Parent.GetNumberOfCells();
+  }
+
+  /// Given a point index, computes the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id index) const {
+    return this->Parent.ComputePointCoordinates(index);
+  }
+
+  typedef typename ParentGridType::PointCoordinatesType PointCoordinatesType;
+
+  DAX_CONT_EXPORT
+  PointCoordinatesType GetPointCoordinates() const {
+    return this->Parent.GetPointCoordinates();
+  }
+
+  typedef dax::exec::internal::TopologyTetrahedralizedUniform
+      TopologyStructConstExecution;
+  typedef TopologyStructConstExecution TopologyStructExecution;
+
+  /// Prepares this topology to be used as an input to an operation in the
+  /// execution environment.  Returns a structure that can be used directly
+  /// in the execution environment.
+  ///
+  DAX_CONT_EXPORT
+  TopologyStructConstExecution PrepareForInput() const {
+    TopologyStructConstExecution topology;
+    topology.Parent = this->Parent.PrepareForInput();
+    return topology;
+  }
+
+private:
+  ParentGridType Parent;
+};
+
+}
+}
+
+#endif //__dax__cont__TetrahedralizedUniformGrid_h
@@ -47,7 +47,8 @@ public:
                                              dax::Vector3 spacing,
                                              dax::Extent3 extent)
   {
-    this->Offset = origin + spacing;
+    this->Origin = origin;
+    this->Spacing = spacing;
     this->Extent = extent;
 
     const dax::Id3 dims = dax::extentDimensions(extent);
@@ -61,9 +62,9 @@ public:
   ValueType Get(dax::Id index) const {
     dax::Id3 location = dax::flatIndexToIndex3(index, this->Extent);
     return dax::Vector3(
-          this->Offset[0] * location[0],
-          this->Offset[1] * location[1],
-          this->Offset[2] * location[2]);
+          this->Origin[0] + this->Spacing[0] * location[0],
+          this->Origin[1] + this->Spacing[1] * location[1],
+          this->Origin[2] + this->Spacing[2] * location[2]);
   }
 
   DAX_CONT_EXPORT
@@ -77,7 +78,8 @@ public:
   }
 
 private:
-  dax::Vector3 Offset;
+  dax::Vector3 Origin;
+  dax::Vector3 Spacing;
   dax::Extent3 Extent;
   dax::Id NumberOfValues;
 };
@@ -41,7 +41,7 @@ public:
   typedef dax::cont::internal::UnstructuredGridOfCell<CellTag> GridTypeTag;
 
   typedef dax::cont::ArrayHandle<
-      dax::Id, CellConnectionsContainerControlTag, DeviceAdapterTag>
+      dax::ConnectivityId, CellConnectionsContainerControlTag, DeviceAdapterTag>
       CellConnectionsType;
   typedef dax::cont::ArrayHandle<
       dax::Vector3, PointsArrayContainerControlTag, DeviceAdapterTag>
@@ -62,7 +62,8 @@ public:
   /// The CellConnections array defines the connectivity of the mesh. The
   /// length of this array is CellType::NUM_POINTS times more than the number
   /// of cell. Each cell is represented by this number of points defining the
-  /// structure of the cell.
+  /// structure of the cell. The point indices are stored as
+  /// dax::ConnectivityId, which stays 32 bits in 64-bit id builds.
   ///
   DAX_CONT_EXPORT
   const CellConnectionsType &GetCellConnections() const {
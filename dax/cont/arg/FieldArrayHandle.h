@@ -67,6 +67,11 @@ public:
     this->Portal = this->Handle.PrepareForInput();
     }
 
+  DAX_CONT_EXPORT void ToExecution(dax::Id, boost::true_type,  boost::true_type)
+    { /* In place */
+    this->Portal = this->Handle.PrepareForInPlace();
+    }
+
   //we need to pass the number of elements to allocate
   DAX_CONT_EXPORT void ToExecution(dax::Id size)
     {
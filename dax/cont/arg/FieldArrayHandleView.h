@@ -0,0 +1,68 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_arg_FieldArrayHandleView_h
+#define __dax_cont_arg_FieldArrayHandleView_h
+
+#include <dax/Types.h>
+#include <dax/cont/arg/ConceptMap.h>
+#include <dax/cont/arg/Field.h>
+#include <dax/cont/arg/FieldArrayHandle.h>
+#include <dax/cont/ArrayHandleView.h>
+#include <dax/cont/sig/Tag.h>
+#include <dax/exec/arg/FieldPortal.h>
+#include <dax/internal/Tags.h>
+
+namespace dax { namespace cont { namespace arg {
+
+/// \headerfile FieldArrayHandleView.h dax/cont/arg/FieldArrayHandleView.h
+/// \brief Map array views to \c Field worklet parameters.
+template <typename Tags, typename ParentHandleType>
+class ConceptMap< Field(Tags),
+    dax::cont::ArrayHandleView<ParentHandleType> > :
+  public ConceptMap< Field(Tags),
+    typename dax::cont::ArrayHandleView<
+      ParentHandleType>::superclass >
+{
+  typedef dax::cont::ArrayHandleView<ParentHandleType> HandleType;
+  typedef ConceptMap< Field(Tags), typename HandleType::superclass >
+      superclass;
+public:
+  ConceptMap(HandleType handle):
+    superclass(handle)
+    {}
+};
+
+/// \headerfile FieldArrayHandleView.h dax/cont/arg/FieldArrayHandleView.h
+/// \brief Map array views to \c Field worklet parameters.
+template <typename Tags, typename ParentHandleType>
+class ConceptMap< Field(Tags),
+    const dax::cont::ArrayHandleView<ParentHandleType> > :
+  public ConceptMap< Field(Tags),
+    const typename dax::cont::ArrayHandleView<
+      ParentHandleType>::superclass >
+{
+  typedef dax::cont::ArrayHandleView<ParentHandleType> HandleType;
+  typedef ConceptMap< Field(Tags), const typename HandleType::superclass >
+      superclass;
+public:
+  ConceptMap(HandleType handle):
+    superclass(handle)
+    {}
+};
+
+} } } //namespace dax::cont::arg
+
+#endif //__dax_cont_arg_FieldArrayHandleView_h
@@ -20,6 +20,8 @@
 #include <dax/Types.h>
 #include <dax/cont/arg/ConceptMap.h>
 #include <dax/cont/arg/Field.h>
+#include <dax/cont/arg/Topology.h>
+#include <dax/cont/internal/GridTags.h>
 #include <dax/cont/PermutationContainer.h>
 #include <dax/cont/sig/Tag.h>
 #include <dax/cont/ErrorControlBadValue.h>
@@ -90,6 +92,66 @@ public:
     }
 };
 
+/// \headerfile FieldMap.h dax/cont/arg/FieldMap.h
+/// \brief The same lookup as above for a permutation of the cells of a grid.
+/// The scheduler of cell worklets also needs the cell and grid types of the
+/// topology. Since only the cells listed in Key are visited, the grid is
+/// reported as unspecified so that it is never scheduled with 3D indices.
+template <typename Tags, typename Key, typename Value>
+class ConceptMap< Topology(Tags), dax::cont::PermutationContainer<Key,Value> >
+{
+  typedef dax::internal::Tags<dax::cont::sig::Tag(dax::cont::sig::In)> KeyTags;
+
+  typedef dax::cont::arg::ConceptMap<Field(KeyTags), Key > KeyFieldType;
+  typedef dax::cont::arg::ConceptMap<Topology(Tags), Value > ValueFieldType;
+  typedef dax::cont::PermutationContainer<Key,Value> InputType;
+
+  InputType MapAdapter;
+  KeyFieldType KeyConcept;
+  ValueFieldType ValueConcept;
+
+public:
+  typedef typename ValueFieldType::DomainTags DomainTags;
+
+  typedef typename ValueFieldType::CellTypeTag CellTypeTag;
+  typedef dax::cont::internal::UnspecifiedGridTag GridTypeTag;
+  typedef typename ValueFieldType::ContArg ContArg;
+
+  typedef dax::exec::arg::FieldMap<Tags,
+          typename KeyFieldType::ExecArg,
+          typename ValueFieldType::ExecArg
+          > ExecArg;
+
+  ConceptMap(InputType input):
+    MapAdapter(input),
+    KeyConcept(input.Key()),
+    ValueConcept(input.Value())
+    {}
+
+  DAX_CONT_EXPORT ExecArg GetExecArg()
+    {
+    return ExecArg(KeyConcept.GetExecArg(),
+                   ValueConcept.GetExecArg());
+    }
+
+  DAX_CONT_EXPORT const ContArg& GetContArg() const
+    {
+    return this->ValueConcept.GetContArg();
+    }
+
+  DAX_CONT_EXPORT void ToExecution(dax::Id size)
+    {
+    this->KeyConcept.ToExecution(size);
+    this->ValueConcept.ToExecution(MapAdapter.GetValueSize() );
+    }
+
+  template<typename Domain>
+  DAX_CONT_EXPORT dax::Id GetDomainLength(Domain d) const
+    {
+    return this->KeyConcept.GetDomainLength(d);
+    }
+};
+
 } } } //namespace dax::cont::arg
 
 #endif //__dax_cont_arg_FieldMap_h
@@ -0,0 +1,70 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_arg_GeometryInterpolatedCellEdges_h
+#define __dax_cont_arg_GeometryInterpolatedCellEdges_h
+
+#include <dax/Types.h>
+#include <dax/CellTraits.h>
+#include <dax/internal/Tags.h>
+#include <dax/cont/arg/ConceptMap.h>
+#include <dax/cont/arg/Geometry.h>
+#include <dax/cont/internal/InterpolatedCellEdges.h>
+#include <dax/cont/sig/Tag.h>
+
+#include <dax/exec/arg/GeometryInterpolatedCell.h>
+
+namespace dax { namespace cont { namespace arg {
+
+/// \headerfile GeometryInterpolatedCellEdges.h dax/cont/arg/GeometryInterpolatedCellEdges.h
+/// \brief Map the interpolation edges of new cells to an execution side
+/// output geometry parameter
+template <typename Tags, typename CellTag, typename DeviceTag>
+class ConceptMap<Geometry(Tags),
+                 dax::cont::internal::InterpolatedCellEdges<CellTag,DeviceTag> >
+{
+  typedef dax::cont::internal::InterpolatedCellEdges<CellTag,DeviceTag>
+      EdgesType;
+  typedef typename EdgesType::EdgeArrayType::PortalExecution PortalType;
+
+  EdgesType Edges;
+  PortalType Portal;
+
+public:
+  typedef dax::exec::arg::GeometryInterpolatedCell<Tags,CellTag,PortalType>
+      ExecArg;
+  typedef typename dax::cont::arg::SupportedDomains<dax::cont::sig::Cell>::Tags DomainTags;
+
+  ConceptMap(EdgesType edges): Edges(edges) {}
+
+  ExecArg GetExecArg() { return ExecArg(this->Portal); }
+
+  //we need to pass the number of elements to allocate
+  void ToExecution(dax::Id size)
+    {
+    this->Portal = this->Edges.GetEdges().PrepareForOutput(
+                     size * dax::CellTraits<CellTag>::NUM_VERTICES );
+    }
+
+  dax::Id GetDomainLength(sig::Cell) const
+    {
+    return this->Edges.GetEdges().GetNumberOfValues() /
+        dax::CellTraits<CellTag>::NUM_VERTICES;
+    }
+};
+
+} } } //namespace dax::cont::arg
+
+#endif //__dax_cont_arg_GeometryInterpolatedCellEdges_h
@@ -20,13 +20,27 @@
 
 //Add all concept maps to this header so that schedulers can find them.
 #include <dax/cont/arg/ConceptMap.h>
+#include <dax/cont/arg/ExecutionObject.h>
 #include <dax/cont/arg/FieldArrayHandle.h>
+#include <dax/cont/arg/FieldArrayHandleCompositeVector.h>
 #include <dax/cont/arg/FieldArrayHandleConstantValue.h>
 #include <dax/cont/arg/FieldArrayHandleCounting.h>
+#include <dax/cont/arg/FieldArrayHandleQuantized.h>
+#include <dax/cont/arg/FieldArrayHandleStridedView.h>
+#include <dax/cont/arg/FieldArrayHandleUserMemory.h>
+#include <dax/cont/arg/FieldArrayHandleView.h>
 #include <dax/cont/arg/FieldConstant.h>
 #include <dax/cont/arg/FieldMap.h>
+#include <dax/cont/arg/GeometryInterpolatedCellEdges.h>
+#include <dax/cont/arg/GeometryRectilinearGrid.h>
+#include <dax/cont/arg/GeometrySubsetUniformGrid.h>
+#include <dax/cont/arg/GeometryTetrahedralizedUniformGrid.h>
 #include <dax/cont/arg/GeometryUniformGrid.h>
 #include <dax/cont/arg/GeometryUnstructuredGrid.h>
+#include <dax/cont/arg/TopologyMultiBlockUniformGrid.h>
+#include <dax/cont/arg/TopologyRectilinearGrid.h>
+#include <dax/cont/arg/TopologySubsetUniformGrid.h>
+#include <dax/cont/arg/TopologyTetrahedralizedUniformGrid.h>
 #include <dax/cont/arg/TopologyUniformGrid.h>
 #include <dax/cont/arg/TopologyUnstructuredGrid.h>
 
@@ -23,6 +23,8 @@ namespace dax { namespace cont { namespace arg {
 class Topology {
 public:
   class Vertices {  };
+  class CellId {  };
+  class CellIJK {  };
 };
 
 }}} // namespace dax::cont::arg
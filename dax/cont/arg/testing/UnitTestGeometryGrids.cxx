@@ -14,6 +14,9 @@
 //
 //=============================================================================
 
+#include <dax/cont/arg/GeometryRectilinearGrid.h>
+#include <dax/cont/arg/GeometrySubsetUniformGrid.h>
+#include <dax/cont/arg/GeometryTetrahedralizedUniformGrid.h>
 #include <dax/cont/arg/GeometryUniformGrid.h>
 #include <dax/cont/arg/GeometryUnstructuredGrid.h>
 
@@ -64,6 +67,17 @@ struct BindTopoGrids
 void TopoGrids()
   {
   dax::cont::internal::GridTesting::TryAllGridTypes(BindTopoGrids());
+  BindTopoGrids()(dax::cont::RectilinearGrid<>());
+
+  typedef dax::cont::SubsetUniformGrid<> SubsetGridType;
+  SubsetGridType subset;
+  verifyBindingExists<SubsetGridType,SubsetGridType>(subset, subset);
+  verifyConstBindingExists<SubsetGridType,SubsetGridType>(subset, subset);
+
+  typedef dax::cont::TetrahedralizedUniformGrid<> TetGridType;
+  TetGridType tets;
+  verifyBindingExists<TetGridType,TetGridType>(tets, tets);
+  verifyConstBindingExists<TetGridType,TetGridType>(tets, tets);
   }
 }
 
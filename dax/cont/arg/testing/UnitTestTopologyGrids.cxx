@@ -14,6 +14,9 @@
 //
 //=============================================================================
 
+#include <dax/cont/arg/TopologyRectilinearGrid.h>
+#include <dax/cont/arg/TopologySubsetUniformGrid.h>
+#include <dax/cont/arg/TopologyTetrahedralizedUniformGrid.h>
 #include <dax/cont/arg/TopologyUniformGrid.h>
 #include <dax/cont/arg/TopologyUnstructuredGrid.h>
 
@@ -65,6 +68,17 @@ struct BindTopoGrids
 void TopoGrids()
   {
   dax::cont::internal::GridTesting::TryAllGridTypes(BindTopoGrids());
+  BindTopoGrids()(dax::cont::RectilinearGrid<>());
+
+  typedef dax::cont::SubsetUniformGrid<> SubsetGridType;
+  SubsetGridType subset;
+  verifyBindingExists<SubsetGridType,SubsetGridType>(subset, subset);
+  verifyConstBindingExists<SubsetGridType,SubsetGridType>(subset, subset);
+
+  typedef dax::cont::TetrahedralizedUniformGrid<> TetGridType;
+  TetGridType tets;
+  verifyBindingExists<TetGridType,TetGridType>(tets, tets);
+  verifyConstBindingExists<TetGridType,TetGridType>(tets, tets);
   }
 }
 
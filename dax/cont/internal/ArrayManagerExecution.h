@@ -125,6 +125,25 @@ public:
   ///
   DAX_CONT_EXPORT void Shrink(dax::Id numberOfValues);
 
+  /// \brief Makes room to grow the array without reallocating it.
+  ///
+  /// Optional; only needed by arrays that use ArrayHandle::Reserve. The size
+  /// and values of the array are unchanged. If control and execution share
+  /// arrays, the room is made in \c controlArray.
+  ///
+  DAX_CONT_EXPORT void Reserve(ContainerType &controlArray,
+                               dax::Id numberOfValues);
+
+  /// \brief Increases the size of the array without changing its values.
+  ///
+  /// Optional; only needed by arrays that use ArrayHandle::Grow. The values
+  /// from indices 0 to the preexisting size - 1 are kept. Reallocations should
+  /// grow the capacity geometrically. If control and execution share arrays,
+  /// \c controlArray is grown.
+  ///
+  DAX_CONT_EXPORT void Grow(ContainerType &controlArray,
+                            dax::Id numberOfValues);
+
   /// Returns an array portal that can be used in the execution environment.
   /// This portal was defined in either LoadDataForInput or
   /// AllocateArrayForOutput. If control and environment share memory space,
@@ -131,6 +131,28 @@ public:
       }
   }
 
+  /// Makes room in \p controlArray, which holds the data of this array, to
+  /// grow to \c numberOfValues without reallocating.
+  ///
+  DAX_CONT_EXPORT void Reserve(ContainerType &controlArray,
+                               dax::Id numberOfValues)
+  {
+    this->ResizeControlArray(controlArray);
+    controlArray.Reserve(numberOfValues);
+    this->SavePortals(controlArray);
+  }
+
+  /// Grows \p controlArray, which holds the data of this array, to
+  /// \c numberOfValues while keeping its values.
+  ///
+  DAX_CONT_EXPORT void Grow(ContainerType &controlArray,
+                            dax::Id numberOfValues)
+  {
+    this->ResizeControlArray(controlArray);
+    controlArray.Grow(numberOfValues);
+    this->SavePortals(controlArray);
+  }
+
   /// Returns the portal previously saved from an \c ArrayContainerControl.
   ///
   DAX_CONT_EXPORT PortalType GetPortal()
@@ -152,6 +174,24 @@ public:
   DAX_CONT_EXPORT void ReleaseResources() { }
 
 private:
+  // The saved portals may have been shrunk past the end of the control array.
+  DAX_CONT_EXPORT void ResizeControlArray(ContainerType &controlArray) const
+  {
+    DAX_ASSERT_CONT(this->PortalValid);
+    DAX_ASSERT_CONT(controlArray.GetPortalConst().GetIteratorBegin() ==
+                    this->ConstPortal.GetIteratorBegin());
+    controlArray.Shrink(this->ConstPortal.GetNumberOfValues());
+  }
+
+  DAX_CONT_EXPORT void SavePortals(ContainerType &controlArray)
+  {
+    this->Portal = controlArray.GetPortal();
+    this->PortalValid = true;
+
+    this->ConstPortal = controlArray.GetPortalConst();
+    this->ConstPortalValid = true;
+  }
+
   // Not implemented.
   ArrayManagerExecutionShareWithControl(
       ArrayManagerExecutionShareWithControl<T, ArrayContainerControlTag> &);
@@ -142,6 +142,32 @@ public:
     this->ArrayManager.Shrink(numberOfValues);
   }
 
+  /// \brief Makes room to grow the array without reallocating it.
+  ///
+  /// The array can then be grown to up to \c numberOfValues with Grow without
+  /// reallocating. The size and values of the array are unchanged. If control
+  /// and execution share arrays, the room is made in \c controlArray.
+  ///
+  DAX_CONT_EXPORT void Reserve(ContainerType &controlArray,
+                               dax::Id numberOfValues)
+  {
+    this->ArrayManager.Reserve(controlArray, numberOfValues);
+  }
+
+  /// \brief Increases the size of the array without changing its values.
+  ///
+  /// This is the opposite of Shrink. The data in the array (from indices 0 to
+  /// the preexisting size - 1) are the same, and the values past them are
+  /// undefined. The capacity grows geometrically so that repeatedly growing
+  /// an array takes amortized constant time per value. If control and
+  /// execution share arrays, \c controlArray is grown.
+  ///
+  DAX_CONT_EXPORT void Grow(ContainerType &controlArray,
+                            dax::Id numberOfValues)
+  {
+    this->ArrayManager.Grow(controlArray, numberOfValues);
+  }
+
   /// Returns an array portal that can be used in the execution environment.
   /// This portal was defined in either LoadDataForInput or
   /// AllocateArrayForOutput. If control and environment share memory space,
@@ -52,6 +52,20 @@ struct DeviceAdapterAlgorithm
       const dax::cont::ArrayHandle<T, CIn, DeviceAdapterTag> &input,
       dax::cont::ArrayHandle<T, COut, DeviceAdapterTag> &output);
 
+  /// \brief Append the contents of one ArrayHandle to the end of another
+  ///
+  /// Grows \c output (see ArrayHandle::Grow) by the size of \c input and
+  /// copies \c input into the new entries in parallel in the execution
+  /// environment. The values already in \c output are kept. Because the
+  /// capacity of \c output grows geometrically, collecting the results of
+  /// many blocks or time steps with repeated appends takes amortized constant
+  /// time per value. \c output may be an ArrayHandle with no data.
+  ///
+  template<typename T, class CIn, class COut>
+  DAX_CONT_EXPORT static void Append(
+      const dax::cont::ArrayHandle<T, CIn, DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T, COut, DeviceAdapterTag> &output);
+
   /// \brief Output is the first index in input for each item in values that wouldn't alter the ordering of input
   ///
   /// LowerBounds is a vectorized search. From each value in \c values it finds
@@ -61,11 +75,11 @@ struct DeviceAdapterAlgorithm
   /// \par Requirements:
   /// \arg \c input must already be sorted
   ///
-  template<typename T, class CIn, class CVal, class COut>
+  template<typename T, typename U, class CIn, class CVal, class COut>
   DAX_CONT_EXPORT static void LowerBounds(
       const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag>& input,
       const dax::cont::ArrayHandle<T,CVal,DeviceAdapterTag>& values,
-      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag>& output);
+      dax::cont::ArrayHandle<U,COut,DeviceAdapterTag>& output);
 
   /// \brief Output is the first index in input for each item in values that wouldn't alter the ordering of input
   ///
@@ -77,11 +91,11 @@ struct DeviceAdapterAlgorithm
   /// \par Requirements:
   /// \arg \c input must already be sorted
   ///
-  template<typename T, class CIn, class CVal, class COut, class Compare>
+  template<typename T, typename U, class CIn, class CVal, class COut, class Compare>
   DAX_CONT_EXPORT static void LowerBounds(
       const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag>& input,
       const dax::cont::ArrayHandle<T,CVal,DeviceAdapterTag>& values,
-      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag>& output,
+      dax::cont::ArrayHandle<U,COut,DeviceAdapterTag>& output,
       Compare comp);
 
   /// \brief A special version of LowerBounds that does an in place operation.
@@ -89,12 +103,12 @@ struct DeviceAdapterAlgorithm
   /// This version of lower bounds performs an in place operation where each
   /// value in the \c values_output array is replaced by the index in \c input
   /// where it occurs. Because this is an in place operation, the type of the
-  /// arrays is limited to dax::Id.
+  /// arrays is limited to index types (dax::Id or dax::ConnectivityId).
   ///
-  template<class CIn, class COut>
+  template<typename T, class CIn, class COut>
   DAX_CONT_EXPORT static void LowerBounds(
-      const dax::cont::ArrayHandle<dax::Id,CIn,DeviceAdapterTag>& input,
-      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag>& values_output);
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag>& input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>& values_output);
 
   /// \brief Compute an inclusive prefix sum operation on the input ArrayHandle.
   ///
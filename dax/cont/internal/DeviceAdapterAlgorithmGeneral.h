@@ -143,6 +143,54 @@ public:
     DerivedAlgorithm::Schedule(kernel, arraySize);
   }
 
+private:
+  template<class InputPortalType, class OutputPortalType>
+  struct AppendKernel {
+    InputPortalType InputPortal;
+    OutputPortalType OutputPortal;
+    dax::Id OutputOffset;
+
+    DAX_CONT_EXPORT
+    AppendKernel(InputPortalType inputPortal,
+                 OutputPortalType outputPortal,
+                 dax::Id outputOffset)
+      : InputPortal(inputPortal),
+        OutputPortal(outputPortal),
+        OutputOffset(outputOffset) {  }
+
+    DAX_EXEC_EXPORT
+    void operator()(dax::Id index) const {
+      this->OutputPortal.Set(index + this->OutputOffset,
+                             this->InputPortal.Get(index));
+    }
+
+    DAX_CONT_EXPORT
+    void SetErrorMessageBuffer(const dax::exec::internal::ErrorMessageBuffer &)
+    {  }
+  };
+
+public:
+  template<typename T, class CIn, class COut>
+  DAX_CONT_EXPORT static void Append(
+      const dax::cont::ArrayHandle<T, CIn, DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T, COut, DeviceAdapterTag> &output)
+  {
+    dax::Id inputSize = input.GetNumberOfValues();
+    dax::Id outputSize = output.GetNumberOfValues();
+    if (inputSize < 1) { return; }
+
+    output.Grow(outputSize + inputSize);
+
+    AppendKernel<
+        typename dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag>::PortalConstExecution,
+        typename dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>::PortalExecution>
+        kernel(input.PrepareForInput(),
+               output.PrepareForInPlace(),
+               outputSize);
+
+    DerivedAlgorithm::Schedule(kernel, inputSize);
+  }
+
 private:
   template<class InputPortalType,class ValuesPortalType,class OutputPortalType>
   struct LowerBoundsKernel {
@@ -228,18 +276,18 @@ private:
 
 
 public:
-  template<typename T, class CIn, class CVal, class COut>
+  template<typename T, typename U, class CIn, class CVal, class COut>
   DAX_CONT_EXPORT static void LowerBounds(
       const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
       const dax::cont::ArrayHandle<T,CVal,DeviceAdapterTag> &values,
-      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag> &output)
+      dax::cont::ArrayHandle<U,COut,DeviceAdapterTag> &output)
   {
     dax::Id arraySize = values.GetNumberOfValues();
 
     LowerBoundsKernel<
         typename dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag>::PortalConstExecution,
         typename dax::cont::ArrayHandle<T,CVal,DeviceAdapterTag>::PortalConstExecution,
-        typename dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag>::PortalExecution>
+        typename dax::cont::ArrayHandle<U,COut,DeviceAdapterTag>::PortalExecution>
         kernel(input.PrepareForInput(),
                values.PrepareForInput(),
                output.PrepareForOutput(arraySize));
@@ -247,11 +295,11 @@ public:
     DerivedAlgorithm::Schedule(kernel, arraySize);
   }
 
-  template<typename T, class CIn, class CVal, class COut, class Compare>
+  template<typename T, typename U, class CIn, class CVal, class COut, class Compare>
   DAX_CONT_EXPORT static void LowerBounds(
       const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
       const dax::cont::ArrayHandle<T,CVal,DeviceAdapterTag> &values,
-      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag> &output,
+      dax::cont::ArrayHandle<U,COut,DeviceAdapterTag> &output,
       Compare comp)
   {
     dax::Id arraySize = values.GetNumberOfValues();
@@ -259,7 +307,7 @@ public:
     LowerBoundsComparisonKernel<
         typename dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag>::PortalConstExecution,
         typename dax::cont::ArrayHandle<T,CVal,DeviceAdapterTag>::PortalConstExecution,
-        typename dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag>::PortalExecution,
+        typename dax::cont::ArrayHandle<U,COut,DeviceAdapterTag>::PortalExecution,
         Compare>
         kernel(input.PrepareForInput(),
                values.PrepareForInput(),
@@ -269,10 +317,10 @@ public:
     DerivedAlgorithm::Schedule(kernel, arraySize);
   }
 
-  template<class CIn, class COut>
+  template<typename T, class CIn, class COut>
   DAX_CONT_EXPORT static void LowerBounds(
-      const dax::cont::ArrayHandle<dax::Id,CIn,DeviceAdapterTag> &input,
-      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag> &values_output)
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTag> &values_output)
   {
     DeviceAdapterAlgorithmGeneral<DerivedAlgorithm,DeviceAdapterTag>::
         LowerBounds(input, values_output, values_output);
@@ -59,17 +59,40 @@ public:
               outputPortal.GetIteratorBegin());
   }
 
-  template<typename T, class CIn, class CVal, class COut>
+  template<typename T, class CIn, class COut>
+  DAX_CONT_EXPORT static void Append(
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTagSerial>& input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTagSerial>& output)
+  {
+    typedef typename dax::cont::ArrayHandle<T,COut,DeviceAdapterTagSerial>
+        ::PortalExecution PortalOut;
+    typedef typename dax::cont::ArrayHandle<T,CIn,DeviceAdapterTagSerial>
+        ::PortalConstExecution PortalIn;
+
+    dax::Id inputSize = input.GetNumberOfValues();
+    dax::Id outputSize = output.GetNumberOfValues();
+    if (inputSize < 1) { return; }
+
+    output.Grow(outputSize + inputSize);
+    PortalIn inputPortal = input.PrepareForInput();
+    PortalOut outputPortal = output.PrepareForInPlace();
+
+    std::copy(inputPortal.GetIteratorBegin(),
+              inputPortal.GetIteratorEnd(),
+              outputPortal.GetIteratorBegin() + outputSize);
+  }
+
+  template<typename T, typename U, class CIn, class CVal, class COut>
   DAX_CONT_EXPORT static void LowerBounds(
       const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTagSerial>& input,
       const dax::cont::ArrayHandle<T,CVal,DeviceAdapterTagSerial>& values,
-      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTagSerial>& output)
+      dax::cont::ArrayHandle<U,COut,DeviceAdapterTagSerial>& output)
   {
     typedef typename dax::cont::ArrayHandle<T,CIn,DeviceAdapterTagSerial>
         ::PortalConstExecution PortalIn;
     typedef typename dax::cont::ArrayHandle<T,CVal,DeviceAdapterTagSerial>
         ::PortalConstExecution PortalVal;
-    typedef typename dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTagSerial>
+    typedef typename dax::cont::ArrayHandle<U,COut,DeviceAdapterTagSerial>
         ::PortalExecution PortalOut;
 
     dax::Id numberOfValues = values.GetNumberOfValues();
@@ -95,18 +118,18 @@ public:
       }
   }
 
-  template<typename T, class CIn, class CVal, class COut, class Compare>
+  template<typename T, typename U, class CIn, class CVal, class COut, class Compare>
   DAX_CONT_EXPORT static void LowerBounds(
       const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTagSerial>& input,
       const dax::cont::ArrayHandle<T,CVal,DeviceAdapterTagSerial>& values,
-      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTagSerial>& output,
+      dax::cont::ArrayHandle<U,COut,DeviceAdapterTagSerial>& output,
       Compare comp)
   {
     typedef typename dax::cont::ArrayHandle<T,CIn,DeviceAdapterTagSerial>
         ::PortalConstExecution PortalIn;
     typedef typename dax::cont::ArrayHandle<T,CVal,DeviceAdapterTagSerial>
         ::PortalConstExecution PortalVal;
-    typedef typename dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTagSerial>
+    typedef typename dax::cont::ArrayHandle<U,COut,DeviceAdapterTagSerial>
         ::PortalExecution PortalOut;
 
     dax::Id numberOfValues = values.GetNumberOfValues();
@@ -133,10 +156,10 @@ public:
       }
   }  
 
-  template<class CIn, class COut>
+  template<typename T, class CIn, class COut>
   DAX_CONT_EXPORT static void LowerBounds(
-      const dax::cont::ArrayHandle<dax::Id,CIn,DeviceAdapterTagSerial> &input,
-      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTagSerial>&values_output)
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTagSerial> &input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTagSerial>&values_output)
   {
     DeviceAdapterAlgorithm<dax::cont::DeviceAdapterTagSerial>::LowerBounds(
          input,values_output,values_output);
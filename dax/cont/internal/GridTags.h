@@ -37,6 +37,29 @@ struct UnstructuredGridOfCell : UnstructuredGridTag { };
 struct UniformGridTag {  };
 
 
+/// A tag you can use to identify when a grid is a rectilinear grid.
+///
+struct RectilinearGridTag {  };
+
+
+/// A tag you can use to identify when a grid is a set of uniform grid blocks
+/// indexed as a single grid.
+///
+struct MultiBlockUniformGridTag {  };
+
+
+/// A tag you can use to identify when a grid is a subset of the cells of a
+/// uniform grid.
+///
+struct SubsetUniformGridTag {  };
+
+
+/// A tag you can use to identify when a grid is a uniform grid with each
+/// voxel split into tetrahedra.
+///
+struct TetrahedralizedUniformGridTag {  };
+
+
 /// A tag you can use to state you don't have a grid.
 /// Mainly used by algorithms and schedulers to state they work on all grid
 /// types
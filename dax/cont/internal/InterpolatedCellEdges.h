@@ -0,0 +1,60 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_InterpolatedCellEdges_h
+#define __dax_cont_internal_InterpolatedCellEdges_h
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/exec/InterpolatedCellPoints.h>
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// \brief The output of a worklet that generates interpolated cells.
+///
+/// Holds the interpolation edge of every point of every new cell, one cell
+/// after the other, before the points are merged and interpolated. The
+/// GenerateInterpolatedCells scheduler passes it to the worklet in place of
+/// the output grid.
+///
+template<class CellTag_, class DeviceAdapterTag>
+class InterpolatedCellEdges
+{
+public:
+  typedef CellTag_ CellTag;
+  typedef dax::cont::ArrayHandle<dax::exec::InterpolationEdge,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> EdgeArrayType;
+
+  DAX_CONT_EXPORT InterpolatedCellEdges() {  }
+
+  DAX_CONT_EXPORT InterpolatedCellEdges(const EdgeArrayType &edges)
+    : Edges(edges) {  }
+
+  DAX_CONT_EXPORT const EdgeArrayType &GetEdges() const { return this->Edges; }
+  DAX_CONT_EXPORT EdgeArrayType &GetEdges() { return this->Edges; }
+
+private:
+  EdgeArrayType Edges;
+};
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_InterpolatedCellEdges_h
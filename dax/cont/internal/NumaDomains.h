@@ -0,0 +1,243 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_NumaDomains_h
+#define __dax_cont_internal_NumaDomains_h
+
+#include <dax/Types.h>
+
+#include <cstdio>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// Describes the NUMA domains (typically sockets) of the host and how an
+/// index space is decomposed over them. The domains are read once from
+/// <tt>/sys/devices/system/node</tt> on Linux. On other platforms, or when
+/// the information is not available, the host is a single domain and the
+/// decomposition reduces to a static partition.
+///
+class NumaDomains
+{
+public:
+  /// Returns the domains of this host.
+  ///
+  DAX_CONT_EXPORT static const NumaDomains &Get()
+  {
+    static NumaDomains domains;
+    return domains;
+  }
+
+  DAX_CONT_EXPORT int GetNumberOfDomains() const
+  {
+    return static_cast<int>(this->Cpus.size());
+  }
+
+  /// The number of cpus in the given domain. Zero if the cpus could not be
+  /// detected, in which case the domain cannot be pinned.
+  ///
+  DAX_CONT_EXPORT int GetNumberOfCpus(int domain) const
+  {
+    return static_cast<int>(this->Cpus[domain].size());
+  }
+
+  /// Returns the domain that thread \c threadIndex of a team of
+  /// \c numberOfThreads works in. Threads are given to domains in contiguous
+  /// blocks proportional to the number of cpus in each domain.
+  ///
+  DAX_CONT_EXPORT int GetDomainOfThread(int threadIndex,
+                                        int numberOfThreads) const
+  {
+    const int numberOfDomains = this->GetNumberOfDomains();
+    if (this->TotalCpus < 1) { return 0; }
+    int cpusBefore = 0;
+    for (int domain = 0; domain < numberOfDomains; domain++)
+      {
+      cpusBefore += this->GetNumberOfCpus(domain);
+      const dax::Id threadsEnd =
+          (static_cast<dax::Id>(numberOfThreads)*cpusBefore)/this->TotalCpus;
+      if (threadIndex < threadsEnd) { return domain; }
+      }
+    return numberOfDomains - 1;
+  }
+
+  /// Computes the contiguous range [\c begin, \c end) of the index space
+  /// [0, \c numberOfValues) processed by thread \c threadIndex of a team of
+  /// \c numberOfThreads. Range boundaries fall on multiples of
+  /// \c granularity (for example the size of a k plane). Since the threads
+  /// of a domain are contiguous, so is the slab of each domain.
+  ///
+  DAX_CONT_EXPORT static void GetThreadRange(int threadIndex,
+                                             int numberOfThreads,
+                                             dax::Id numberOfValues,
+                                             dax::Id granularity,
+                                             dax::Id &begin,
+                                             dax::Id &end)
+  {
+    const dax::Id numberOfBlocks =
+        (numberOfValues + granularity - 1)/granularity;
+    begin = ((numberOfBlocks*threadIndex)/numberOfThreads)*granularity;
+    end = ((numberOfBlocks*(threadIndex+1))/numberOfThreads)*granularity;
+    if (begin > numberOfValues) { begin = numberOfValues; }
+    if (end > numberOfValues) { end = numberOfValues; }
+  }
+
+  /// Computes the slab [\c begin, \c end) of [0, \c numberOfValues) given to
+  /// \c domain, proportional to its number of cpus and with boundaries on
+  /// multiples of \c granularity.
+  ///
+  DAX_CONT_EXPORT void GetDomainRange(int domain,
+                                      dax::Id numberOfValues,
+                                      dax::Id granularity,
+                                      dax::Id &begin,
+                                      dax::Id &end) const
+  {
+    if (this->TotalCpus < 1)
+      {
+      GetThreadRange(domain, this->GetNumberOfDomains(),
+                     numberOfValues, granularity, begin, end);
+      return;
+      }
+    int cpusBefore = 0;
+    for (int index = 0; index < domain; index++)
+      {
+      cpusBefore += this->GetNumberOfCpus(index);
+      }
+    const int cpusThrough = cpusBefore + this->GetNumberOfCpus(domain);
+    const dax::Id numberOfBlocks =
+        (numberOfValues + granularity - 1)/granularity;
+    begin = ((numberOfBlocks*cpusBefore)/this->TotalCpus)*granularity;
+    end = ((numberOfBlocks*cpusThrough)/this->TotalCpus)*granularity;
+    if (begin > numberOfValues) { begin = numberOfValues; }
+    if (end > numberOfValues) { end = numberOfValues; }
+  }
+
+  /// Restricts the calling thread to the cpus of the given domain. Does
+  /// nothing where thread affinity is not supported.
+  ///
+  DAX_CONT_EXPORT void PinCurrentThread(int domain) const
+  {
+#if defined(__linux__) && defined(CPU_SET)
+    const std::vector<int> &cpus = this->Cpus[domain];
+    if (cpus.empty()) { return; }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (std::size_t index = 0; index < cpus.size(); index++)
+      {
+      if (cpus[index] < CPU_SETSIZE) { CPU_SET(cpus[index], &cpuSet); }
+      }
+    sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+#else
+    (void)domain;
+#endif
+  }
+
+  /// The set of cpus a thread may run on, as saved by
+  /// SaveCurrentThreadAffinity.
+  ///
+  struct ThreadAffinity
+  {
+    ThreadAffinity() : Valid(false) {  }
+    bool Valid;
+#if defined(__linux__) && defined(CPU_SET)
+    cpu_set_t CpuSet;
+#endif
+  };
+
+  /// Saves the cpus the calling thread may run on, so that they can be
+  /// restored after the thread was pinned to a domain.
+  ///
+  DAX_CONT_EXPORT static void SaveCurrentThreadAffinity(
+      ThreadAffinity &affinity)
+  {
+#if defined(__linux__) && defined(CPU_SET)
+    affinity.Valid = (sched_getaffinity(0, sizeof(affinity.CpuSet),
+                                        &affinity.CpuSet) == 0);
+#else
+    affinity.Valid = false;
+#endif
+  }
+
+  /// Restores cpus saved with SaveCurrentThreadAffinity.
+  ///
+  DAX_CONT_EXPORT static void RestoreCurrentThreadAffinity(
+      const ThreadAffinity &affinity)
+  {
+#if defined(__linux__) && defined(CPU_SET)
+    if (affinity.Valid)
+      {
+      sched_setaffinity(0, sizeof(affinity.CpuSet), &affinity.CpuSet);
+      }
+#else
+    (void)affinity;
+#endif
+  }
+
+private:
+  DAX_CONT_EXPORT NumaDomains() : TotalCpus(0)
+  {
+#ifdef __linux__
+    // Node numbers are not necessarily contiguous.
+    const int MAX_NODES = 256;
+    for (int node = 0; node < MAX_NODES; node++)
+      {
+      char fileName[128];
+      std::sprintf(fileName, "/sys/devices/system/node/node%d/cpulist", node);
+      std::FILE *file = std::fopen(fileName, "r");
+      if (file == NULL) { continue; }
+      std::vector<int> cpus;
+      int first;
+      while (std::fscanf(file, "%d", &first) == 1)
+        {
+        int last = first;
+        int separator = std::fgetc(file);
+        if (separator == '-')
+          {
+          if (std::fscanf(file, "%d", &last) != 1) { break; }
+          separator = std::fgetc(file);
+          }
+        for (int cpu = first; cpu <= last; cpu++) { cpus.push_back(cpu); }
+        if (separator != ',') { break; }
+        }
+      std::fclose(file);
+      // Memory-only nodes have no cpus to run on.
+      if (!cpus.empty())
+        {
+        this->TotalCpus += static_cast<int>(cpus.size());
+        this->Cpus.push_back(cpus);
+        }
+      }
+#endif
+    if (this->Cpus.empty())
+      {
+      this->Cpus.push_back(std::vector<int>());
+      }
+  }
+
+  std::vector<std::vector<int> > Cpus;
+  int TotalCpus;
+};
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_NumaDomains_h
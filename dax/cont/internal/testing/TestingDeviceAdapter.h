@@ -648,6 +648,63 @@ private:
     DAX_TEST_ASSERT(randomData[5] == 4, "Got bad value - UpperBound");
   }
 
+  static DAX_CONT_EXPORT void TestAppend()
+  {
+    std::cout << "-------------------------------------------------" << std::endl;
+    std::cout << "Testing Append" << std::endl;
+    const dax::Id NUMBER_OF_BLOCKS = 5;
+
+    IdArrayHandle output;
+    for (dax::Id block = 0; block < NUMBER_OF_BLOCKS; block++)
+      {
+      dax::Id testData[ARRAY_SIZE];
+      for (dax::Id i = 0; i < ARRAY_SIZE; i++)
+        {
+        testData[i] = OFFSET + block*ARRAY_SIZE + i;
+        }
+      IdArrayHandle input = MakeArrayHandle(testData, ARRAY_SIZE);
+      Algorithm::Append(input, output);
+
+      DAX_TEST_ASSERT(output.GetNumberOfValues() == (block+1)*ARRAY_SIZE,
+                      "Append did not grow the array.");
+      if (block == 2)
+        {
+        // Make sure appending to data in the control environment works.
+        output.GetPortalConstControl();
+        output.ReleaseResourcesExecution();
+        }
+      }
+
+    // Appending nothing should leave the array alone.
+    IdArrayHandle empty;
+    Algorithm::Append(empty, output);
+    DAX_TEST_ASSERT(output.GetNumberOfValues() == NUMBER_OF_BLOCKS*ARRAY_SIZE,
+                    "Appending an empty array changed the size.");
+
+    for (dax::Id i = 0; i < NUMBER_OF_BLOCKS*ARRAY_SIZE; i++)
+      {
+      DAX_TEST_ASSERT(output.GetPortalConstControl().Get(i) == OFFSET + i,
+                      "Got bad value from Append.");
+      }
+
+    std::cout << "Testing Reserve" << std::endl;
+    IdArrayHandle reserved;
+    reserved.Reserve(ARRAY_SIZE);
+    DAX_TEST_ASSERT(reserved.GetNumberOfValues() == 0,
+                    "Reserve changed the size of an empty array.");
+    Algorithm::Append(output, reserved);
+    DAX_TEST_ASSERT(reserved.GetNumberOfValues() == NUMBER_OF_BLOCKS*ARRAY_SIZE,
+                    "Append to reserved array has wrong size.");
+    reserved.Reserve(2*NUMBER_OF_BLOCKS*ARRAY_SIZE);
+    Algorithm::Append(output, reserved);
+    for (dax::Id i = 0; i < 2*NUMBER_OF_BLOCKS*ARRAY_SIZE; i++)
+      {
+      DAX_TEST_ASSERT(reserved.GetPortalConstControl().Get(i)
+                      == OFFSET + (i % (NUMBER_OF_BLOCKS*ARRAY_SIZE)),
+                      "Got bad value after Reserve.");
+      }
+  }
+
   static DAX_CONT_EXPORT void TestSortWithComparisonObject()
   {
     std::cout << "-------------------------------------------------" << std::endl;
@@ -1019,6 +1076,7 @@ private:
       TestSortWithComparisonObject();
       TestLowerBoundstWithComparisonObject();
       TestOrderedUniqueValues(); //tests Copy, LowerBounds, Sort, Unique
+      TestAppend();
       TestContScheduler();
       TestStreamCompactWithStencil();
       TestStreamCompact();
@@ -24,6 +24,7 @@
 #include <dax/cont/ArrayContainerControlBasic.h>
 #include <dax/cont/ArrayHandle.h>
 #include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/RectilinearGrid.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/UnstructuredGrid.h>
 
@@ -52,9 +53,16 @@ private:
   template<typename U, class UCCT, class DAT>
   struct GridStorage<dax::cont::UnstructuredGrid<U,UCCT,UCCT,DAT> >
     {
-    std::vector<dax::Id> topology;
+    std::vector<dax::ConnectivityId> topology;
     std::vector<dax::Vector3> points;
     };
+  template<class UCCT, class DAT>
+  struct GridStorage<dax::cont::RectilinearGrid<UCCT,DAT> >
+    {
+    std::vector<dax::Scalar> xCoordinates;
+    std::vector<dax::Scalar> yCoordinates;
+    std::vector<dax::Scalar> zCoordinates;
+    };
   GridStorage<GridType> Info;
 
   typedef typename GridType::TopologyStructConstExecution TopoType;
@@ -194,6 +202,32 @@ private:
     grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(Size-1, Size-1, Size-1));
     }
 
+  // .......................................................... RectilinearGrid
+  void BuildGrid(
+    dax::cont::RectilinearGrid<ArrayContainerControlTag,DeviceAdapterTag>
+    &grid)
+    {
+      //make the spacing grow along each axis (and differ between axes) so
+      //that nothing can pass by assuming uniform spacing
+      this->Info.xCoordinates.clear();
+      this->Info.yCoordinates.clear();
+      this->Info.zCoordinates.clear();
+      for(dax::Id i=0; i < Size; ++i)
+        {
+        dax::Scalar position = static_cast<dax::Scalar>(i);
+        this->Info.xCoordinates.push_back(position*(1.0f + 0.25f*position));
+        this->Info.yCoordinates.push_back(position*(1.0f + 0.125f*position));
+        this->Info.zCoordinates.push_back(position*(0.5f + 0.25f*position));
+        }
+
+      grid = dax::cont::RectilinearGrid<
+             ArrayContainerControlTag,
+             DeviceAdapterTag>(
+          this->MakeArrayHandle(this->Info.xCoordinates),
+          this->MakeArrayHandle(this->Info.yCoordinates),
+          this->MakeArrayHandle(this->Info.zCoordinates));
+    }
+
   // ............................................................... Hexahedron
   void BuildGrid(
     dax::cont::UnstructuredGrid<
@@ -452,6 +486,33 @@ private:
     }
 };
 
+/// Copies the values of \p array into a std::vector so that tests can check
+/// them with plain indexing.
+///
+template<typename T, class ArrayContainerControlTag, class DeviceAdapterTag>
+std::vector<T> GetArrayValues(
+    const dax::cont::ArrayHandle<T,ArrayContainerControlTag,DeviceAdapterTag>
+        &array)
+{
+  std::vector<T> values(static_cast<std::size_t>(array.GetNumberOfValues()));
+  array.CopyInto(values.begin());
+  return values;
+}
+
+/// Builds a uniform grid with a non-zero origin, a non-unit spacing and an
+/// extent that starts at (0,-1,2) and ends at \p maxPoint. Tests use it to
+/// catch code that assumes an extent starting at 0.
+///
+template<class DeviceAdapterTag>
+dax::cont::UniformGrid<DeviceAdapterTag>
+MakeShiftedUniformGrid(const dax::Id3 &maxPoint, DeviceAdapterTag)
+{
+  dax::cont::UniformGrid<DeviceAdapterTag> grid;
+  grid.SetExtent(dax::make_Id3(0, -1, 2), maxPoint);
+  grid.SetOrigin(dax::make_Vector3(-1.0f, 0.5f, 2.0f));
+  grid.SetSpacing(dax::make_Vector3(0.5f, 1.0f, 0.25f));
+  return grid;
+}
 
 struct GridTesting
 {
@@ -0,0 +1,133 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/NumaDomainScheduling.h>
+#include <dax/cont/internal/NumaDomains.h>
+
+#include <dax/cont/internal/testing/Testing.h>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 1000;
+const dax::Id PLANE_SIZE = 30;
+
+void TestThreadRanges()
+{
+  std::cout << "Checking that thread ranges tile the index space." << std::endl;
+  const dax::cont::internal::NumaDomains &domains =
+      dax::cont::internal::NumaDomains::Get();
+  DAX_TEST_ASSERT(domains.GetNumberOfDomains() >= 1, "No NUMA domains.");
+
+  for (int numberOfThreads = 1; numberOfThreads < 9; numberOfThreads++)
+    {
+    dax::Id expectedBegin = 0;
+    int previousDomain = 0;
+    for (int threadIndex = 0; threadIndex < numberOfThreads; threadIndex++)
+      {
+      dax::Id begin;
+      dax::Id end;
+      dax::cont::internal::NumaDomains::GetThreadRange(threadIndex,
+                                                       numberOfThreads,
+                                                       ARRAY_SIZE,
+                                                       PLANE_SIZE,
+                                                       begin,
+                                                       end);
+      DAX_TEST_ASSERT(begin == expectedBegin, "Thread ranges not contiguous.");
+      DAX_TEST_ASSERT(begin <= end, "Bad thread range.");
+      DAX_TEST_ASSERT((begin % PLANE_SIZE) == 0,
+                      "Thread range not aligned to granularity.");
+      expectedBegin = end;
+
+      // Threads of a domain must be contiguous for its slab to be.
+      int domain = domains.GetDomainOfThread(threadIndex, numberOfThreads);
+      DAX_TEST_ASSERT(domain >= previousDomain, "Domains not in order.");
+      DAX_TEST_ASSERT(domain < domains.GetNumberOfDomains(), "Bad domain.");
+      previousDomain = domain;
+      }
+    DAX_TEST_ASSERT(expectedBegin == ARRAY_SIZE,
+                    "Thread ranges do not cover the index space.");
+    }
+}
+
+void TestDomainRanges()
+{
+  std::cout << "Checking that domain slabs tile the index space." << std::endl;
+  const dax::cont::internal::NumaDomains &domains =
+      dax::cont::internal::NumaDomains::Get();
+
+  dax::Id expectedBegin = 0;
+  for (int domain = 0; domain < domains.GetNumberOfDomains(); domain++)
+    {
+    dax::Id begin;
+    dax::Id end;
+    domains.GetDomainRange(domain, ARRAY_SIZE, PLANE_SIZE, begin, end);
+    DAX_TEST_ASSERT(begin == expectedBegin, "Domain slabs not contiguous.");
+    DAX_TEST_ASSERT((begin % PLANE_SIZE) == 0,
+                    "Domain slab not aligned to granularity.");
+    expectedBegin = end;
+    }
+  DAX_TEST_ASSERT(expectedBegin == ARRAY_SIZE,
+                  "Domain slabs do not cover the index space.");
+}
+
+void TestPinning()
+{
+  std::cout << "Checking that pinning a thread can be undone." << std::endl;
+  const dax::cont::internal::NumaDomains &domains =
+      dax::cont::internal::NumaDomains::Get();
+
+  dax::cont::internal::NumaDomains::ThreadAffinity original;
+  dax::cont::internal::NumaDomains::SaveCurrentThreadAffinity(original);
+  domains.PinCurrentThread(domains.GetNumberOfDomains() - 1);
+  dax::cont::internal::NumaDomains::RestoreCurrentThreadAffinity(original);
+
+#if defined(__linux__) && defined(CPU_SET)
+  dax::cont::internal::NumaDomains::ThreadAffinity restored;
+  dax::cont::internal::NumaDomains::SaveCurrentThreadAffinity(restored);
+  DAX_TEST_ASSERT(original.Valid == restored.Valid,
+                  "Could not read the thread affinity again.");
+  if (original.Valid)
+    {
+    DAX_TEST_ASSERT(CPU_EQUAL(&original.CpuSet, &restored.CpuSet),
+                    "Thread affinity not restored.");
+    }
+#endif
+}
+
+void TestSchedulingFlag()
+{
+  DAX_TEST_ASSERT(!dax::cont::GetNumaDomainScheduling(),
+                  "NUMA domain scheduling should be off by default.");
+  dax::cont::SetNumaDomainScheduling(true);
+  DAX_TEST_ASSERT(dax::cont::GetNumaDomainScheduling(),
+                  "NUMA domain scheduling not turned on.");
+  dax::cont::SetNumaDomainScheduling(false);
+}
+
+void TestNumaDomains()
+{
+  TestThreadRanges();
+  TestDomainRanges();
+  TestPinning();
+  TestSchedulingFlag();
+}
+
+} // anonymous namespace
+
+int UnitTestNumaDomains(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestNumaDomains);
+}
@@ -38,6 +38,12 @@ namespace internal
     typedef dax::Id3 type;
   };
 
+  template<>
+  struct DetermineGridIndexType< dax::cont::internal::RectilinearGridTag >
+  {
+    typedef dax::Id3 type;
+  };
+
   template< class GridTypeTag>
   struct GenerateGridCount
   {
@@ -59,6 +65,19 @@ namespace internal
       return dax::extentCellDimensions(t.GetExtent());
       }
   };
+
+  template<>
+  struct GenerateGridCount< dax::cont::internal::RectilinearGridTag >
+  {
+    typedef dax::cont::internal::RectilinearGridTag GridTypeTag;
+    typedef DetermineGridIndexType<GridTypeTag>::type ReturnType;
+
+    template<class Topo>
+    ReturnType operator()(const Topo& t) const
+      {
+      return dax::extentCellDimensions(t.GetExtent());
+      }
+  };
 }
 
 template< class Bindings >
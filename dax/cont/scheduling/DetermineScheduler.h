@@ -30,6 +30,7 @@
 //scheduler implementation to choose
 #include <dax/cont/GenerateTopology.h>
 #include <dax/cont/GenerateInterpolatedCells.h>
+#include <dax/exec/WorkletFlyingEdges.h>
 #include <dax/exec/WorkletMapCell.h>
 
 //include the scheduler implementation tags
@@ -73,6 +74,17 @@ namespace internal
     typedef dax::cont::scheduling::GenerateInterpolatedCellsTag SchedulerTag;
   };
 
+  template<typename WorkType>
+  struct is_FlyingEdges
+  {
+    //if worktype derives from WorkletFlyingEdges
+    //the typedef 'type' will be true
+    typedef typename boost::is_base_of<
+                        dax::exec::WorkletFlyingEdges,
+                        WorkType >::type Valid;
+    typedef dax::cont::scheduling::FlyingEdgesTag SchedulerTag;
+  };
+
   template<typename WorkType>
   struct is_CellBased
   {
@@ -98,6 +110,7 @@ template<class WorkType> class DetermineScheduler
 {
   typedef internal::is_GenerateTopo<WorkType> IsTopoType;
   typedef internal::is_GenerateCells<WorkType> IsGenCoordsType;
+  typedef internal::is_FlyingEdges<WorkType> IsFlyingEdgesType;
   typedef internal::is_CellBased<WorkType> IsCellType;
   typedef internal::is_DefaultType<WorkType> IsDefaultType;
 
@@ -112,7 +125,7 @@ template<class WorkType> class DetermineScheduler
   //and than insert that class to the vector
 
   typedef boost::mpl::vector<IsTopoType,IsGenCoordsType,
-                             IsCellType,IsDefaultType>
+                             IsFlyingEdgesType,IsCellType,IsDefaultType>
         PossibleSchedulers;
 
   //search for the first scheduler that 'type' typedef is set to the true_type
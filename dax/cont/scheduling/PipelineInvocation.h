@@ -0,0 +1,1100 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#if !defined(BOOST_PP_IS_ITERATING)
+
+#ifndef __dax_cont_scheduling_PipelineInvocation_h
+#define __dax_cont_scheduling_PipelineInvocation_h
+
+#include <dax/Types.h>
+
+#include <dax/Extent.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayContainerControlCartesianProduct.h>
+#include <dax/cont/ArrayContainerControlCompositeVector.h>
+#include <dax/cont/ArrayContainerControlCompressedConnectivity.h>
+#include <dax/cont/ArrayContainerControlConstantValue.h>
+#include <dax/cont/ArrayContainerControlImplicit.h>
+#include <dax/cont/ArrayContainerControlQuantized.h>
+#include <dax/cont/ArrayContainerControlView.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleView.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/MultiBlockUniformGrid.h>
+#include <dax/cont/RectilinearGrid.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/SubsetUniformGrid.h>
+#include <dax/cont/TetrahedralizedUniformGrid.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+#include <dax/cont/arg/Field.h>
+#include <dax/cont/internal/Bindings.h>
+
+#include <dax/cont/scheduling/CollectCount.h>
+#include <dax/cont/scheduling/CreateExecutionResources.h>
+#include <dax/cont/scheduling/DetermineScheduler.h>
+#include <dax/cont/scheduling/SchedulerTags.h>
+
+#include <dax/cont/sig/Tag.h>
+
+#include <dax/exec/internal/ErrorMessageBuffer.h>
+#include <dax/exec/internal/Functor.h>
+
+#include <dax/internal/GetNthType.h>
+#include <dax/internal/Members.h>
+
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <map>
+#include <set>
+#include <vector>
+
+#if !(__cplusplus >= 201103L)
+# include <dax/internal/ParameterPackCxx03.h>
+#endif // !(__cplusplus >= 201103L)
+
+namespace dax { namespace cont { namespace scheduling {
+
+/// Records that an invocation reads or writes the array identified by
+/// \c Array (see ArrayHandle::GetArrayId). A null \c Array stands for
+/// arrays that the invocation may use but that cannot be identified, such as
+/// those held by an execution object or a permutation. \c Remapped is set
+/// when the argument reaches \c Array through an index mapping (such as the
+/// window of a view), so that value i of the argument is not value i of
+/// \c Array. \c Read is cleared for arguments that are only written.
+///
+struct PipelineArrayAccess
+{
+  PipelineArrayAccess(const void *array, bool write)
+    : Array(array), Write(write), Read(!write), Remapped(false) {  }
+
+  const void *Array;
+  bool Write;
+  bool Read;
+  bool Remapped;
+};
+
+/// For one array, the number of arguments of a set of nodes that are basic
+/// ArrayHandles of the array, and the number of handles sharing the array
+/// (see ArrayHandle::GetNumberOfReferences). When both are equal for all
+/// the nodes still to run, nothing else refers to the array.
+///
+struct PipelineHandleCount
+{
+  PipelineHandleCount() : Arguments(0), References(0), NumberOfValues(0) {  }
+
+  dax::Id Arguments;
+  long References;
+  dax::Id NumberOfValues;
+};
+
+typedef std::map<const void *, PipelineHandleCount> PipelineHandleCounts;
+
+/// \brief Chunk-sized arrays standing in for the intermediates of a chain.
+///
+/// A fused chain can be run one chunk of values at a time (see
+/// PipelineNode::PrepareChunk). An array that the chain writes before
+/// reading it, and that nothing outside the chain refers to, is then never
+/// allocated to its full size: every chunk uses the same scratch array,
+/// which holds a single chunk.
+///
+class PipelineScratchArrays
+{
+public:
+  DAX_CONT_EXPORT PipelineScratchArrays(dax::Id chunkSize)
+    : ChunkSize(chunkSize) {  }
+
+  DAX_CONT_EXPORT void Add(const void *array)
+  {
+    this->Arrays[array];
+  }
+
+  DAX_CONT_EXPORT bool Contains(const void *array) const
+  {
+    return this->Arrays.find(array) != this->Arrays.end();
+  }
+
+  DAX_CONT_EXPORT bool IsEmpty() const { return this->Arrays.empty(); }
+
+  /// Returns the scratch array standing in for \c array, which must have
+  /// been added. It is allocated in the execution environment on first use.
+  ///
+  template<class HandleType>
+  DAX_CONT_EXPORT HandleType Get(const void *array)
+  {
+    boost::shared_ptr<void> &scratch = this->Arrays[array];
+    if (!scratch)
+      {
+      boost::shared_ptr<HandleType> handle(new HandleType);
+      handle->PrepareForOutput(this->ChunkSize);
+      scratch = handle;
+      }
+    return *static_cast<HandleType *>(scratch.get());
+  }
+
+private:
+  dax::Id ChunkSize;
+  std::map<const void *, boost::shared_ptr<void> > Arrays;
+};
+
+/// \brief A worklet invocation recorded for later execution.
+///
+/// A node can always be run with Invoke, which goes through the regular
+/// dax::cont::Scheduler. Splittable nodes (those handled by the default and
+/// cell schedulers) can also be run in pieces: Prepare binds the arguments
+/// and sets up their execution resources, after which ExecuteRange runs any
+/// range of work indices. This lets dax::cont::Pipeline run several nodes in
+/// one schedule.
+///
+class PipelineNode
+{
+public:
+  virtual ~PipelineNode() {  }
+
+  /// Runs the invocation right away through dax::cont::Scheduler.
+  ///
+  virtual void Invoke() = 0;
+
+  /// True if Prepare and ExecuteRange can be used.
+  ///
+  virtual bool IsSplittable() const = 0;
+
+  /// True if the node is splittable, every argument is a Field and every
+  /// array is tracked and not remapped, so that the invocation for a work
+  /// index only touches that index of its arrays. Elementwise nodes of the
+  /// same size can be fused.
+  ///
+  virtual bool IsElementwise() const = 0;
+
+  /// Binds the arguments, allocates the output arrays and loads the input
+  /// arrays in the execution environment. Returns the number of work
+  /// indices to run.
+  ///
+  virtual dax::Id Prepare() = 0;
+
+  virtual void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &errorMessage) = 0;
+
+  /// Runs the work indices [\c begin, \c end). Must only be called from
+  /// execution environments that share the host, after Prepare or
+  /// PrepareChunk.
+  ///
+  virtual void ExecuteRange(dax::Id begin, dax::Id end) const = 0;
+
+  /// True if the node is elementwise and all of its arrays are basic
+  /// ArrayHandles, so that it can be run in chunks.
+  ///
+  virtual bool CanRunInChunks() = 0;
+
+  /// Returns the number of work indices, like Prepare, without allocating
+  /// or loading anything.
+  ///
+  virtual dax::Id CountValues() = 0;
+
+  /// Adds the basic ArrayHandle arguments of the node to \c counts.
+  ///
+  virtual void CountArrayHandles(PipelineHandleCounts &counts) = 0;
+
+  /// Allocates the output arguments whose arrays are in \c arrays to hold
+  /// \c numberOfValues values, and removes those arrays from the set. Run
+  /// before the first PrepareChunk so that chunks write into windows of
+  /// the full arrays.
+  ///
+  virtual void AllocateChunkedOutputs(dax::Id numberOfValues,
+                                      std::set<const void *> &arrays) = 0;
+
+  /// Like Prepare, but binds only the values [\c begin, \c begin+\c count)
+  /// of each array, or the first \c count values of the scratch array
+  /// standing in for it. ExecuteRange then takes indices within the chunk.
+  ///
+  virtual dax::Id PrepareChunk(
+      dax::Id begin,
+      dax::Id count,
+      dax::cont::scheduling::PipelineScratchArrays &scratch) = 0;
+
+  /// The arrays read and written by the invocation. Views, composite
+  /// vectors and the other wrapper arrays are recorded as the arrays holding
+  /// their values, so two handles sharing storage have a common entry.
+  ///
+  const std::vector<PipelineArrayAccess> &GetAccesses() const
+  {
+    return this->Accesses;
+  }
+
+  /// True if the invocation may use arrays missing from GetAccesses, in
+  /// which case it has to be assumed to conflict with any other invocation.
+  ///
+  bool HasUntrackedAccesses() const
+  {
+    for (std::size_t index = 0; index < this->Accesses.size(); index++)
+      {
+      if (this->Accesses[index].Array == NULL) { return true; }
+      }
+    return false;
+  }
+
+protected:
+  std::vector<PipelineArrayAccess> Accesses;
+};
+
+/// True if the two nodes use a common tracked array that at least one of
+/// them writes.
+///
+DAX_CONT_EXPORT
+bool PipelineNodesShareArrays(
+    const dax::cont::scheduling::PipelineNode &node1,
+    const dax::cont::scheduling::PipelineNode &node2)
+{
+  const std::vector<PipelineArrayAccess> &accesses1 = node1.GetAccesses();
+  const std::vector<PipelineArrayAccess> &accesses2 = node2.GetAccesses();
+  for (std::size_t i = 0; i < accesses1.size(); i++)
+    {
+    for (std::size_t j = 0; j < accesses2.size(); j++)
+      {
+      if ((accesses1[i].Array != NULL)
+          && (accesses1[i].Array == accesses2[j].Array)
+          && (accesses1[i].Write || accesses2[j].Write))
+        {
+        return true;
+        }
+      }
+    }
+  return false;
+}
+
+/// True if the two nodes cannot run at the same time: they share an array
+/// that at least one of them writes, or either of them uses arrays that are
+/// not tracked.
+///
+DAX_CONT_EXPORT
+bool PipelineNodesConflict(const dax::cont::scheduling::PipelineNode &node1,
+                           const dax::cont::scheduling::PipelineNode &node2)
+{
+  return node1.HasUntrackedAccesses()
+      || node2.HasUntrackedAccesses()
+      || PipelineNodesShareArrays(node1, node2);
+}
+
+namespace internal {
+
+DAX_CONT_EXPORT void AddUntrackedPipelineAccess(
+    bool write, std::vector<PipelineArrayAccess> &accesses)
+{
+  accesses.push_back(PipelineArrayAccess(NULL, write));
+}
+
+// Arrays with a container not listed below are not tracked.
+template<typename T, class Container, class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::ArrayHandle<T,Container,Device> &,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses)
+{
+  AddUntrackedPipelineAccess(write, accesses);
+}
+
+template<typename T, class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::ArrayHandle<
+      T,dax::cont::ArrayContainerControlTagBasic,Device> &handle,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses)
+{
+  accesses.push_back(PipelineArrayAccess(handle.GetArrayId(), write));
+}
+
+template<typename T, class Portal, class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::ArrayHandle<
+      T,dax::cont::ArrayContainerControlTagImplicit<Portal>,Device> &,
+    bool,
+    std::vector<PipelineArrayAccess> &)
+{
+  // Computed values, nothing is stored.
+}
+
+template<typename T, typename ConstantType, class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::ArrayHandle<
+      T,dax::cont::ArrayContainerControlTagConstantValue<ConstantType>,Device>
+      &,
+    bool,
+    std::vector<PipelineArrayAccess> &)
+{
+  // Computed values, nothing is stored.
+}
+
+// The wrapper arrays below keep the handles of the arrays holding their
+// values in their control portal. Those handles are resolved in turn
+// through AddHeldArrayAccesses, which sees all the overloads.
+template<typename HandleType>
+DAX_CONT_EXPORT void AddHeldArrayAccesses(
+    const HandleType &handle,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses);
+
+DAX_CONT_EXPORT void MarkPipelineAccessesRemapped(
+    std::vector<PipelineArrayAccess> &accesses, std::size_t first)
+{
+  for (std::size_t index = first; index < accesses.size(); index++)
+    {
+    accesses[index].Remapped = true;
+    }
+}
+
+template<typename HandleType>
+DAX_CONT_EXPORT bool GetPipelinePortal(
+    const HandleType &handle,
+    typename HandleType::PortalConstControl &portal,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses)
+{
+  try
+    {
+    portal = handle.GetPortalConstControl();
+    return true;
+    }
+  catch (dax::cont::ErrorControlBadValue)
+    {
+    // An empty wrapper does not know its arrays yet.
+    AddUntrackedPipelineAccess(write, accesses);
+    return false;
+    }
+}
+
+template<typename T, class Parent, class Layout, class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::ArrayHandle<
+      T,dax::cont::ArrayContainerControlTagView<Parent,Layout>,Device>
+      &handle,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses)
+{
+  typename dax::cont::ArrayHandle<
+      T,dax::cont::ArrayContainerControlTagView<Parent,Layout>,Device>
+      ::PortalConstControl portal;
+  if (GetPipelinePortal(handle, portal, write, accesses))
+    {
+    const std::size_t first = accesses.size();
+    AddHeldArrayAccesses(portal.GetParent(), write, accesses);
+    MarkPipelineAccessesRemapped(accesses, first);
+    }
+}
+
+template<typename T, class Component, int NumComponents, class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::ArrayHandle<
+      T,
+      dax::cont::ArrayContainerControlTagCompositeVector<
+        Component,NumComponents>,
+      Device> &handle,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses)
+{
+  typename dax::cont::ArrayHandle<
+      T,
+      dax::cont::ArrayContainerControlTagCompositeVector<
+        Component,NumComponents>,
+      Device>::PortalConstControl portal;
+  if (GetPipelinePortal(handle, portal, write, accesses))
+    {
+    for (int component = 0; component < NumComponents; component++)
+      {
+      AddHeldArrayAccesses(portal.GetComponent(component), write, accesses);
+      }
+    }
+}
+
+template<typename T, class Storage, class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::ArrayHandle<
+      T,dax::cont::ArrayContainerControlTagQuantized<Storage>,Device> &handle,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses)
+{
+  typename dax::cont::ArrayHandle<
+      T,dax::cont::ArrayContainerControlTagQuantized<Storage>,Device>
+      ::PortalConstControl portal;
+  if (GetPipelinePortal(handle, portal, write, accesses))
+    {
+    AddHeldArrayAccesses(portal.GetStorage(), write, accesses);
+    }
+}
+
+template<typename T, class Axis, class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::ArrayHandle<
+      T,dax::cont::ArrayContainerControlTagCartesianProduct<Axis>,Device>
+      &handle,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses)
+{
+  typename dax::cont::ArrayHandle<
+      T,dax::cont::ArrayContainerControlTagCartesianProduct<Axis>,Device>
+      ::PortalConstControl portal;
+  if (GetPipelinePortal(handle, portal, write, accesses))
+    {
+    const std::size_t first = accesses.size();
+    AddHeldArrayAccesses(portal.GetXAxis(), write, accesses);
+    AddHeldArrayAccesses(portal.GetYAxis(), write, accesses);
+    AddHeldArrayAccesses(portal.GetZAxis(), write, accesses);
+    MarkPipelineAccessesRemapped(accesses, first);
+    }
+}
+
+template<typename T, class Delta, int NumVertices, class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::ArrayHandle<
+      T,
+      dax::cont::ArrayContainerControlTagCompressedConnectivity<
+        Delta,NumVertices>,
+      Device> &handle,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses)
+{
+  typename dax::cont::ArrayHandle<
+      T,
+      dax::cont::ArrayContainerControlTagCompressedConnectivity<
+        Delta,NumVertices>,
+      Device>::PortalConstControl portal;
+  if (GetPipelinePortal(handle, portal, write, accesses))
+    {
+    const std::size_t first = accesses.size();
+    AddHeldArrayAccesses(portal.GetBases(), write, accesses);
+    AddHeldArrayAccesses(portal.GetDeltas(), write, accesses);
+    MarkPipelineAccessesRemapped(accesses, first);
+    }
+}
+
+template<typename HandleType>
+DAX_CONT_EXPORT void AddHeldArrayAccesses(
+    const HandleType &handle,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses)
+{
+  AddPipelineAccesses(handle, write, accesses);
+}
+
+template<typename T>
+class IsArrayHandle
+{
+  typedef char YesType;
+  struct NoType { char Dummy[2]; };
+
+  template<typename U, class Container, class Device>
+  static YesType Test(const dax::cont::ArrayHandle<U,Container,Device> *);
+  static NoType Test(...);
+public:
+  typedef boost::integral_constant<
+      bool, sizeof(Test(static_cast<T*>(0))) == sizeof(YesType)> type;
+};
+
+template<typename T>
+DAX_CONT_EXPORT void AddObjectPipelineAccesses(
+    const T &argument,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses,
+    boost::true_type)
+{
+  // A subclass of ArrayHandle, such as ArrayHandleView.
+  typedef dax::cont::ArrayHandle<typename T::ValueType,
+                                 typename T::ArrayContainerControlTag,
+                                 typename T::DeviceAdapterTag> HandleType;
+  AddHeldArrayAccesses(static_cast<const HandleType &>(argument),
+                       write,
+                       accesses);
+}
+
+template<typename T>
+DAX_CONT_EXPORT void AddObjectPipelineAccesses(
+    const T &argument,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses,
+    boost::false_type)
+{
+  if (!boost::is_arithmetic<T>::value)
+    {
+    // Some other object (such as an execution object) that may hold arrays.
+    AddUntrackedPipelineAccess(write, accesses);
+    }
+}
+
+template<typename T>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const T &argument, bool write, std::vector<PipelineArrayAccess> &accesses)
+{
+  AddObjectPipelineAccesses(argument,
+                            write,
+                            accesses,
+                            typename IsArrayHandle<T>::type());
+}
+
+template<typename T, int Size>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::Tuple<T,Size> &, bool, std::vector<PipelineArrayAccess> &)
+{
+  // A constant.
+}
+
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::Extent3 &, bool, std::vector<PipelineArrayAccess> &)
+{
+  // A constant.
+}
+
+template<class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::UniformGrid<Device> &,
+    bool,
+    std::vector<PipelineArrayAccess> &)
+{
+  // Structured grids are values.
+}
+
+template<class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::TetrahedralizedUniformGrid<Device> &,
+    bool,
+    std::vector<PipelineArrayAccess> &)
+{
+  // Structured grids are values.
+}
+
+template<class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::MultiBlockUniformGrid<Device> &,
+    bool,
+    std::vector<PipelineArrayAccess> &)
+{
+  // The block arrays are owned by the grid and never written by worklets.
+}
+
+template<class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::SubsetUniformGrid<Device> &grid,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses)
+{
+  AddPipelineAccesses(grid.GetCellIds(), write, accesses);
+}
+
+template<class Container, class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::RectilinearGrid<Container,Device> &grid,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses)
+{
+  AddPipelineAccesses(grid.GetXCoordinates(), write, accesses);
+  AddPipelineAccesses(grid.GetYCoordinates(), write, accesses);
+  AddPipelineAccesses(grid.GetZCoordinates(), write, accesses);
+}
+
+template<typename CellTag, class ConnectionsTag, class PointsTag, class Device>
+DAX_CONT_EXPORT void AddPipelineAccesses(
+    const dax::cont::UnstructuredGrid<
+      CellTag,ConnectionsTag,PointsTag,Device> &grid,
+    bool write,
+    std::vector<PipelineArrayAccess> &accesses)
+{
+  AddPipelineAccesses(grid.GetCellConnections(), write, accesses);
+  AddPipelineAccesses(grid.GetPointCoordinates(), write, accesses);
+}
+
+/// Holds argument \c N of an invocation of \c WorkletType along with what
+/// its ControlSignature says about it.
+///
+template<class WorkletType, int N, typename ArgumentType>
+class PipelineArgument
+{
+  typedef typename dax::internal::GetNthType<
+      N, typename WorkletType::ControlSignature>::type ParameterType;
+  typedef dax::cont::internal::detail::GetConceptAndTagsImpl<ParameterType>
+      ConceptAndTags;
+public:
+  typedef typename ConceptAndTags::Concept Concept;
+  typedef typename ConceptAndTags::Tags Tags;
+
+  DAX_CONT_EXPORT PipelineArgument(const ArgumentType &value)
+    : Value(value) {  }
+
+  ArgumentType Value;
+};
+
+template<class WorkletType>
+struct PipelineArgumentMap
+{
+  template<int N, typename ArgumentType>
+  struct Get
+  {
+    typedef PipelineArgument<WorkletType,N,ArgumentType> type;
+  };
+};
+
+class CollectPipelineAccesses
+{
+public:
+  CollectPipelineAccesses(std::vector<PipelineArrayAccess> &accesses,
+                          bool &allFields)
+    : Accesses(accesses), AllFields(allFields) {  }
+
+  template<class ArgumentType>
+  void operator()(const ArgumentType &argument) const
+  {
+    typedef typename ArgumentType::Tags Tags;
+    const std::size_t first = this->Accesses.size();
+    AddPipelineAccesses(argument.Value,
+                        Tags::template Has<dax::cont::sig::Out>::value,
+                        this->Accesses);
+    for (std::size_t index = first; index < this->Accesses.size(); index++)
+      {
+      this->Accesses[index].Read =
+          !Tags::template Has<dax::cont::sig::Out>::value
+          || Tags::template Has<dax::cont::sig::In>::value;
+      }
+    this->AllFields = this->AllFields && boost::is_same<
+        typename ArgumentType::Concept, dax::cont::arg::Field>::value;
+  }
+
+private:
+  std::vector<PipelineArrayAccess> &Accesses;
+  bool &AllFields;
+};
+
+/// The type an argument is bound as when its node runs a chunk: a view of
+/// the chunk's window for basic ArrayHandles, the argument itself for
+/// constants. \c Valid is false for arguments that cannot be run in chunks.
+///
+template<typename T>
+struct PipelineChunkArgument
+{
+  static const bool Valid = boost::is_arithmetic<T>::value;
+  typedef T type;
+
+  DAX_CONT_EXPORT static type Make(const T &argument,
+                                   dax::Id,
+                                   dax::Id,
+                                   PipelineScratchArrays &)
+  {
+    return argument;
+  }
+};
+
+template<typename T, int Size>
+struct PipelineChunkArgument<dax::Tuple<T,Size> >
+{
+  static const bool Valid = true;
+  typedef dax::Tuple<T,Size> type;
+
+  DAX_CONT_EXPORT static type Make(const type &argument,
+                                   dax::Id,
+                                   dax::Id,
+                                   PipelineScratchArrays &)
+  {
+    return argument;
+  }
+};
+
+template<typename T, class Device>
+struct PipelineChunkArgument<
+    dax::cont::ArrayHandle<T,dax::cont::ArrayContainerControlTagBasic,Device> >
+{
+  typedef dax::cont::ArrayHandle<
+      T,dax::cont::ArrayContainerControlTagBasic,Device> HandleType;
+
+  static const bool Valid = true;
+  typedef dax::cont::ArrayHandleView<HandleType> type;
+
+  DAX_CONT_EXPORT static type Make(const HandleType &handle,
+                                   dax::Id begin,
+                                   dax::Id count,
+                                   PipelineScratchArrays &scratch)
+  {
+    if (scratch.Contains(handle.GetArrayId()))
+      {
+      return type(scratch.template Get<HandleType>(handle.GetArrayId()),
+                  0,
+                  count);
+      }
+    return type(handle, begin, count);
+  }
+};
+
+template<typename T>
+DAX_CONT_EXPORT typename PipelineChunkArgument<T>::type
+MakePipelineChunkArgument(const T &argument,
+                          dax::Id begin,
+                          dax::Id count,
+                          PipelineScratchArrays &scratch)
+{
+  return PipelineChunkArgument<T>::Make(argument, begin, count, scratch);
+}
+
+class CheckPipelineChunkArguments
+{
+public:
+  CheckPipelineChunkArguments(bool &valid) : Valid(valid) {  }
+
+  template<class ArgumentType>
+  void operator()(const ArgumentType &argument) const
+  {
+    this->Valid = this->Valid && IsValid(argument.Value);
+  }
+
+private:
+  template<typename T>
+  static bool IsValid(const T &) { return PipelineChunkArgument<T>::Valid; }
+
+  bool &Valid;
+};
+
+template<typename T>
+DAX_CONT_EXPORT void CountPipelineHandle(const T &, PipelineHandleCounts &)
+{
+  // Not a basic array.
+}
+
+template<typename T, class Device>
+DAX_CONT_EXPORT void CountPipelineHandle(
+    const dax::cont::ArrayHandle<
+      T,dax::cont::ArrayContainerControlTagBasic,Device> &handle,
+    PipelineHandleCounts &counts)
+{
+  PipelineHandleCount &count = counts[handle.GetArrayId()];
+  count.Arguments++;
+  count.References = handle.GetNumberOfReferences();
+  count.NumberOfValues = handle.GetNumberOfValues();
+}
+
+class CountPipelineHandles
+{
+public:
+  CountPipelineHandles(PipelineHandleCounts &counts) : Counts(counts) {  }
+
+  template<class ArgumentType>
+  void operator()(const ArgumentType &argument) const
+  {
+    CountPipelineHandle(argument.Value, this->Counts);
+  }
+
+private:
+  PipelineHandleCounts &Counts;
+};
+
+template<typename T>
+DAX_CONT_EXPORT void AllocatePipelineOutput(
+    const T &, dax::Id, std::set<const void *> &)
+{
+  // Not a basic array.
+}
+
+template<typename T, class Device>
+DAX_CONT_EXPORT void AllocatePipelineOutput(
+    const dax::cont::ArrayHandle<
+      T,dax::cont::ArrayContainerControlTagBasic,Device> &handle,
+    dax::Id numberOfValues,
+    std::set<const void *> &arrays)
+{
+  if (arrays.erase(handle.GetArrayId()) > 0)
+    {
+    // ArrayHandle is a reference, so allocating a copy allocates the array.
+    dax::cont::ArrayHandle<
+        T,dax::cont::ArrayContainerControlTagBasic,Device> output = handle;
+    output.PrepareForOutput(numberOfValues);
+    }
+}
+
+class AllocatePipelineOutputs
+{
+public:
+  AllocatePipelineOutputs(dax::Id numberOfValues,
+                          std::set<const void *> &arrays)
+    : NumberOfValues(numberOfValues), Arrays(arrays) {  }
+
+  template<class ArgumentType>
+  void operator()(const ArgumentType &argument) const
+  {
+    if (ArgumentType::Tags::template Has<dax::cont::sig::Out>::value)
+      {
+      AllocatePipelineOutput(argument.Value,
+                             this->NumberOfValues,
+                             this->Arrays);
+      }
+  }
+
+private:
+  dax::Id NumberOfValues;
+  std::set<const void *> &Arrays;
+};
+
+template<typename SchedulerTag>
+struct IsSplittableScheduler
+{
+  static const bool value =
+      boost::is_same<SchedulerTag,
+                     dax::cont::scheduling::ScheduleDefaultTag>::value
+      || boost::is_same<SchedulerTag,
+                        dax::cont::scheduling::ScheduleCellsTag>::value;
+};
+
+template<class DeviceAdapterTag, typename Invocation, typename NumList>
+class PipelineInvocationImpl;
+
+} // namespace internal
+
+#define _dax_PipelineInvocation_Argument(n) \
+  this->Arguments.template Get<n>().Value
+
+#define _dax_PipelineInvocation_ChunkArgumentType(n)                   \
+  typename PipelineChunkArgument<typename dax::internal::GetNthType<    \
+      n, void(_dax_pp_T___)>::type>::type
+
+#define _dax_PipelineInvocation_ChunkArgument(n)                       \
+  MakePipelineChunkArgument(this->Arguments.template Get<n>().Value,    \
+                            begin,                                      \
+                            count,                                      \
+                            scratch)
+
+#define _dax_PipelineInvocationImpl                                     \
+  typedef WorkletType ControlInvocationSignature(_dax_pp_T___);         \
+  typedef dax::internal::Members<                                       \
+      void(_dax_pp_T___), PipelineArgumentMap<WorkletType>              \
+    > ArgumentsType;                                                    \
+  typedef dax::cont::internal::Bindings<ControlInvocationSignature>     \
+      BindingsType;                                                     \
+  typedef dax::exec::internal::Functor<ControlInvocationSignature>      \
+      FunctorType;                                                      \
+  typedef WorkletType ChunkInvocationSignature(                         \
+      _dax_pp_enum___(_dax_PipelineInvocation_ChunkArgumentType));      \
+  typedef dax::cont::internal::Bindings<ChunkInvocationSignature>       \
+      ChunkBindingsType;                                                \
+  typedef dax::exec::internal::Functor<ChunkInvocationSignature>        \
+      ChunkFunctorType;                                                 \
+  typedef typename dax::cont::scheduling::DetermineScheduler<           \
+      WorkletType>::SchedulerTag SchedulerTag;                          \
+public:                                                                 \
+  DAX_CONT_EXPORT                                                       \
+  PipelineInvocationImpl(WorkletType worklet, _dax_pp_params___(a)):    \
+    Worklet(worklet), Arguments(_dax_pp_args___(a))                     \
+    {                                                                   \
+    bool allFields = true;                                              \
+    this->Arguments.ForEachCont(                                        \
+          CollectPipelineAccesses(this->Accesses, allFields));          \
+    this->AllFields = allFields;                                        \
+    bool chunkable = true;                                              \
+    this->Arguments.ForEachCont(CheckPipelineChunkArguments(chunkable)); \
+    this->Chunkable = chunkable;                                        \
+    }                                                                   \
+  DAX_CONT_EXPORT virtual void Invoke()                                 \
+    {                                                                   \
+    dax::cont::Scheduler<DeviceAdapterTag> scheduler;                   \
+    scheduler.Invoke(this->Worklet,                                     \
+                     _dax_pp_enum___(_dax_PipelineInvocation_Argument)); \
+    }                                                                   \
+  DAX_CONT_EXPORT virtual bool IsSplittable() const                     \
+    {                                                                   \
+    return IsSplittableScheduler<SchedulerTag>::value;                  \
+    }                                                                   \
+  DAX_CONT_EXPORT virtual bool IsElementwise() const                    \
+    {                                                                   \
+    if (!this->AllFields || !boost::is_same<                            \
+          SchedulerTag, dax::cont::scheduling::ScheduleDefaultTag>::value) \
+      {                                                                 \
+      return false;                                                     \
+      }                                                                 \
+    for (std::size_t index = 0; index < this->Accesses.size(); index++) \
+      {                                                                 \
+      if ((this->Accesses[index].Array == NULL)                         \
+          || this->Accesses[index].Remapped)                            \
+        {                                                               \
+        return false;                                                   \
+        }                                                               \
+      }                                                                 \
+    return true;                                                        \
+    }                                                                   \
+  DAX_CONT_EXPORT virtual dax::Id Prepare()                             \
+    {                                                                   \
+    this->Bindings.reset(new BindingsType(                              \
+          _dax_pp_enum___(_dax_PipelineInvocation_Argument)));          \
+    dax::Id count = 1;                                                  \
+    this->Bindings->ForEachCont(                                        \
+          dax::cont::scheduling::CollectCount<                          \
+            typename WorkletType::DomainType>(count));                  \
+    this->Bindings->ForEachCont(                                        \
+          dax::cont::scheduling::CreateExecutionResources(count));      \
+    this->Functor.reset(new FunctorType(this->Worklet, *this->Bindings)); \
+    return count;                                                       \
+    }                                                                   \
+  DAX_CONT_EXPORT virtual void SetErrorMessageBuffer(                   \
+      const dax::exec::internal::ErrorMessageBuffer &errorMessage)      \
+    {                                                                   \
+    dax::exec::internal::ErrorMessageBuffer buffer(errorMessage);       \
+    if (this->ChunkFunctor)                                             \
+      {                                                                 \
+      this->ChunkFunctor->SetErrorMessageBuffer(buffer);                \
+      }                                                                 \
+    else                                                                \
+      {                                                                 \
+      this->Functor->SetErrorMessageBuffer(buffer);                     \
+      }                                                                 \
+    }                                                                   \
+  virtual void ExecuteRange(dax::Id begin, dax::Id end) const           \
+    {                                                                   \
+    if (this->ChunkFunctor)                                             \
+      {                                                                 \
+      const ChunkFunctorType &functor = *this->ChunkFunctor;            \
+      for (dax::Id index = begin; index < end; index++)                 \
+        {                                                               \
+        functor(index);                                                 \
+        }                                                               \
+      return;                                                           \
+      }                                                                 \
+    const FunctorType &functor = *this->Functor;                        \
+    for (dax::Id index = begin; index < end; index++)                   \
+      {                                                                 \
+      functor(index);                                                   \
+      }                                                                 \
+    }                                                                   \
+  DAX_CONT_EXPORT virtual bool CanRunInChunks()                         \
+    {                                                                   \
+    return this->Chunkable && this->IsElementwise();                    \
+    }                                                                   \
+  DAX_CONT_EXPORT virtual dax::Id CountValues()                         \
+    {                                                                   \
+    BindingsType bindings(                                              \
+          _dax_pp_enum___(_dax_PipelineInvocation_Argument));           \
+    dax::Id count = 1;                                                  \
+    bindings.ForEachCont(                                               \
+          dax::cont::scheduling::CollectCount<                          \
+            typename WorkletType::DomainType>(count));                  \
+    return count;                                                       \
+    }                                                                   \
+  DAX_CONT_EXPORT virtual void CountArrayHandles(                       \
+      PipelineHandleCounts &counts)                                     \
+    {                                                                   \
+    this->Arguments.ForEachCont(CountPipelineHandles(counts));          \
+    }                                                                   \
+  DAX_CONT_EXPORT virtual void AllocateChunkedOutputs(                  \
+      dax::Id numberOfValues, std::set<const void *> &arrays)           \
+    {                                                                   \
+    this->Arguments.ForEachCont(                                        \
+          AllocatePipelineOutputs(numberOfValues, arrays));             \
+    }                                                                   \
+  DAX_CONT_EXPORT virtual dax::Id PrepareChunk(                         \
+      dax::Id begin,                                                    \
+      dax::Id count,                                                    \
+      dax::cont::scheduling::PipelineScratchArrays &scratch)            \
+    {                                                                   \
+    this->ChunkFunctor.reset();                                         \
+    this->ChunkBindings.reset(new ChunkBindingsType(                    \
+          _dax_pp_enum___(_dax_PipelineInvocation_ChunkArgument)));     \
+    dax::Id chunkCount = 1;                                             \
+    this->ChunkBindings->ForEachCont(                                   \
+          dax::cont::scheduling::CollectCount<                          \
+            typename WorkletType::DomainType>(chunkCount));             \
+    this->ChunkBindings->ForEachCont(                                   \
+          dax::cont::scheduling::CreateExecutionResources(chunkCount)); \
+    this->ChunkFunctor.reset(                                           \
+          new ChunkFunctorType(this->Worklet, *this->ChunkBindings));   \
+    return chunkCount;                                                  \
+    }                                                                   \
+private:                                                                \
+  WorkletType Worklet;                                                  \
+  ArgumentsType Arguments;                                              \
+  bool AllFields;                                                       \
+  bool Chunkable;                                                       \
+  boost::scoped_ptr<BindingsType> Bindings;                             \
+  boost::scoped_ptr<FunctorType> Functor;                               \
+  boost::scoped_ptr<ChunkBindingsType> ChunkBindings;                   \
+  boost::scoped_ptr<ChunkFunctorType> ChunkFunctor;
+
+namespace internal {
+
+# if __cplusplus >= 201103L
+#  define _dax_pp_T___ T...
+#  define _dax_pp_params___(x) T...x
+#  define _dax_pp_args___(x) std::forward<T>(x)...
+#  define _dax_pp_enum___(x) x(N)...
+template <class DeviceAdapterTag, typename WorkletType, typename...T, int...N>
+class PipelineInvocationImpl<DeviceAdapterTag,
+                             WorkletType(T...),
+                             dax::internal::detail::NumList<N...> >
+  : public dax::cont::scheduling::PipelineNode
+{
+  _dax_PipelineInvocationImpl
+};
+#  undef _dax_pp_T___
+#  undef _dax_pp_params___
+#  undef _dax_pp_args___
+#  undef _dax_pp_enum___
+
+template <class DeviceAdapterTag, typename Invocation>
+struct PipelineInvocationImplLookup;
+template <class DeviceAdapterTag, typename WorkletType, typename...T>
+struct PipelineInvocationImplLookup<DeviceAdapterTag, WorkletType(T...)>
+{
+  typedef PipelineInvocationImpl<
+      DeviceAdapterTag,
+      WorkletType(T...),
+      typename dax::internal::detail::Nums<sizeof...(T)>::type> type;
+};
+# else // !(__cplusplus >= 201103L)
+template <class DeviceAdapterTag, typename Invocation>
+struct PipelineInvocationImplLookup
+{
+  typedef PipelineInvocationImpl<DeviceAdapterTag, Invocation, void> type;
+};
+#  define BOOST_PP_ITERATION_PARAMS_1 (3, (2, 10, <dax/cont/scheduling/PipelineInvocation.h>))
+#  include BOOST_PP_ITERATE()
+# endif // !(__cplusplus >= 201103L)
+
+} // namespace internal
+
+# undef _dax_PipelineInvocationImpl
+# undef _dax_PipelineInvocation_Argument
+# undef _dax_PipelineInvocation_ChunkArgumentType
+# undef _dax_PipelineInvocation_ChunkArgument
+
+/// \brief The PipelineNode type recording an invocation.
+///
+/// \c Invocation is the control invocation signature, that is the worklet
+/// type called with the argument types. The node is constructed from the
+/// worklet and the arguments.
+///
+template <class DeviceAdapterTag, typename Invocation>
+struct PipelineInvocation
+{
+  typedef typename internal::PipelineInvocationImplLookup<
+      DeviceAdapterTag, Invocation>::type type;
+};
+
+} } } //namespace dax::cont::scheduling
+
+#endif //__dax_cont_scheduling_PipelineInvocation_h
+
+#else // defined(BOOST_PP_IS_ITERATING)
+
+template <class DeviceAdapterTag, typename WorkletType, _dax_pp_typename___T>
+class PipelineInvocationImpl<DeviceAdapterTag, WorkletType(_dax_pp_T___), void>
+  : public dax::cont::scheduling::PipelineNode
+{
+  _dax_PipelineInvocationImpl
+};
+
+#endif // defined(BOOST_PP_IS_ITERATING)
@@ -0,0 +1,147 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_scheduling_PipelineStages_h
+#define __dax_cont_scheduling_PipelineStages_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/scheduling/PipelineInvocation.h>
+
+#include <dax/exec/internal/ErrorMessageBuffer.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace dax { namespace cont { namespace scheduling {
+
+/// A list of prepared, splittable nodes of the same size that are run
+/// together: each block of work indices is run through every node in order
+/// before moving to the next block, so the values a node passes to the next
+/// are still in cache when they are read.
+///
+struct PipelineStage
+{
+  PipelineStage() : NumberOfValues(0) {  }
+
+  std::vector<dax::cont::scheduling::PipelineNode *> Nodes;
+  dax::Id NumberOfValues;
+};
+
+/// The number of work indices of a stage run by each instance of the
+/// PipelineKernel.
+///
+#ifndef DAX_PIPELINE_BLOCK_SIZE
+#define DAX_PIPELINE_BLOCK_SIZE 1024
+#endif
+
+/// The number of values of a fused chain run by each schedule when the
+/// chain's intermediate arrays are replaced by scratch arrays of this size
+/// (see dax::cont::Pipeline). A chunk holds many blocks so that its
+/// schedule still spreads over all the threads.
+///
+#ifndef DAX_PIPELINE_CHUNK_SIZE
+#define DAX_PIPELINE_CHUNK_SIZE (64*DAX_PIPELINE_BLOCK_SIZE)
+#endif
+
+/// Runs a set of stages as a single schedule over all of their blocks. The
+/// stages are independent of each other, so their blocks run concurrently.
+///
+class PipelineKernel
+{
+public:
+  DAX_CONT_EXPORT
+  PipelineKernel(const dax::cont::scheduling::PipelineStage *stages,
+                 const dax::Id *blockOffsets,
+                 dax::Id numberOfStages)
+    : Stages(stages),
+      BlockOffsets(blockOffsets),
+      NumberOfStages(numberOfStages) {  }
+
+  DAX_CONT_EXPORT
+  void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &errorMessage)
+  {
+    for (dax::Id stage = 0; stage < this->NumberOfStages; stage++)
+      {
+      const std::vector<PipelineNode *> &nodes = this->Stages[stage].Nodes;
+      for (std::size_t node = 0; node < nodes.size(); node++)
+        {
+        nodes[node]->SetErrorMessageBuffer(errorMessage);
+        }
+      }
+  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id block) const
+  {
+    // BlockOffsets holds NumberOfStages+1 ascending entries.
+    const dax::Id stage = static_cast<dax::Id>(
+          std::upper_bound(this->BlockOffsets,
+                           this->BlockOffsets + this->NumberOfStages + 1,
+                           block)
+          - this->BlockOffsets) - 1;
+    const PipelineStage &pipelineStage = this->Stages[stage];
+
+    const dax::Id begin =
+        (block - this->BlockOffsets[stage])*DAX_PIPELINE_BLOCK_SIZE;
+    const dax::Id end =
+        std::min(begin + DAX_PIPELINE_BLOCK_SIZE,
+                 pipelineStage.NumberOfValues);
+    for (std::size_t node = 0; node < pipelineStage.Nodes.size(); node++)
+      {
+      pipelineStage.Nodes[node]->ExecuteRange(begin, end);
+      }
+  }
+
+private:
+  const dax::cont::scheduling::PipelineStage *Stages;
+  const dax::Id *BlockOffsets;
+  dax::Id NumberOfStages;
+};
+
+/// Runs the given independent stages, whose nodes must already be prepared,
+/// with a single Schedule of the device adapter.
+///
+template<class DeviceAdapterTag>
+DAX_CONT_EXPORT
+void SchedulePipelineStages(
+    const std::vector<dax::cont::scheduling::PipelineStage> &stages)
+{
+  if (stages.empty()) { return; }
+
+  std::vector<dax::Id> blockOffsets(stages.size() + 1);
+  blockOffsets[0] = 0;
+  for (std::size_t stage = 0; stage < stages.size(); stage++)
+    {
+    const dax::Id numberOfBlocks =
+        (stages[stage].NumberOfValues + DAX_PIPELINE_BLOCK_SIZE - 1)
+        / DAX_PIPELINE_BLOCK_SIZE;
+    blockOffsets[stage+1] = blockOffsets[stage] + numberOfBlocks;
+    }
+  if (blockOffsets.back() < 1) { return; }
+
+  dax::cont::scheduling::PipelineKernel kernel(
+        &stages.front(),
+        &blockOffsets.front(),
+        static_cast<dax::Id>(stages.size()));
+  dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(
+        kernel, blockOffsets.back());
+}
+
+} } } //namespace dax::cont::scheduling
+
+#endif //__dax_cont_scheduling_PipelineStages_h
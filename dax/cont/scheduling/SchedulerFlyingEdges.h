@@ -0,0 +1,165 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_scheduling_SchedulerFlyingEdges_h
+#define __dax_cont_scheduling_SchedulerFlyingEdges_h
+
+#include <dax/Extent.h>
+#include <dax/Types.h>
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/scheduling/Scheduler.h>
+#include <dax/cont/scheduling/SchedulerTags.h>
+
+#include <dax/exec/internal/kernel/FlyingEdgesWorklets.h>
+
+namespace dax { namespace cont { namespace scheduling {
+
+/// Runs a flying edges isosurface worklet over a uniform grid. Unlike the
+/// GenerateInterpolatedCells scheduler nothing is sorted or searched: three
+/// passes over the rows of points along x count the cut edges and the
+/// triangles of each row, and once these counts are scanned every row
+/// writes its own points and triangles, which already share their points.
+///
+/// The worklet is invoked with the input grid, the output grid and the point
+/// field to contour:
+///
+/// \code
+/// scheduler.Invoke(dax::worklet::FlyingEdges(isoValue),
+///                  grid, outGrid, field);
+/// \endcode
+///
+template <class DeviceAdapterTag>
+class Scheduler<DeviceAdapterTag,dax::cont::scheduling::FlyingEdgesTag>
+{
+public:
+  //default constructor so we can instantiate const schedulers
+  DAX_CONT_EXPORT Scheduler(){}
+
+  template <class WorkletType,
+            class OutputGridType,
+            class FieldContainerTag>
+  DAX_CONT_EXPORT void Invoke(
+      WorkletType worklet,
+      const dax::cont::UniformGrid<DeviceAdapterTag> &inputGrid,
+      OutputGridType outputGrid,
+      const dax::cont::ArrayHandle<
+          dax::Scalar,FieldContainerTag,DeviceAdapterTag> &field) const
+  {
+    typedef dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithm;
+    typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
+        DeviceAdapterTag> IdArrayHandleType;
+    typedef dax::cont::ArrayHandle<unsigned char,ArrayContainerControlTagBasic,
+        DeviceAdapterTag> ByteArrayHandleType;
+    typedef typename dax::cont::ArrayHandle<
+        dax::Scalar,FieldContainerTag,DeviceAdapterTag>::PortalConstExecution
+        FieldPortalType;
+
+    const dax::Id3 dims = dax::extentDimensions(inputGrid.GetExtent());
+    if (dims[0] < 2 || dims[1] < 2 || dims[2] < 2)
+      {
+      //there are no cells to contour
+      outputGrid.GetPointCoordinates().PrepareForOutput(0);
+      outputGrid.GetCellConnections().PrepareForOutput(0);
+      return;
+      }
+    const dax::Id numRows = dims[1]*dims[2];
+
+    //first pass: classify the x edges of each row
+    ByteArrayHandleType edgeCases;
+    IdArrayHandleType xCounts;
+    IdArrayHandleType xMins;
+    IdArrayHandleType xMaxs;
+    dax::exec::internal::kernel::FlyingEdgesClassifyXEdges<
+        FieldPortalType,
+        typename ByteArrayHandleType::PortalExecution,
+        typename IdArrayHandleType::PortalExecution>
+      classifyXEdges(field.PrepareForInput(),
+                     worklet.GetIsoValue(),
+                     edgeCases.PrepareForOutput(numRows*(dims[0]-1)),
+                     xCounts.PrepareForOutput(numRows),
+                     xMins.PrepareForOutput(numRows),
+                     xMaxs.PrepareForOutput(numRows),
+                     dims);
+    Algorithm::Schedule(classifyXEdges, numRows);
+
+    //second pass: count the points and triangles of each row
+    typedef dax::exec::internal::kernel::detail::FlyingEdgesCases<
+        typename ByteArrayHandleType::PortalConstExecution,
+        typename IdArrayHandleType::PortalConstExecution> CasesType;
+    const CasesType cases(edgeCases.PrepareForInput(),
+                          xMins.PrepareForInput(),
+                          xMaxs.PrepareForInput(),
+                          dims);
+
+    IdArrayHandleType yCounts;
+    IdArrayHandleType pointCounts;
+    IdArrayHandleType triangleCounts;
+    dax::exec::internal::kernel::FlyingEdgesCountRow<
+        typename ByteArrayHandleType::PortalConstExecution,
+        typename IdArrayHandleType::PortalConstExecution,
+        typename IdArrayHandleType::PortalExecution>
+      countRows(cases,
+                xCounts.PrepareForInput(),
+                yCounts.PrepareForOutput(numRows),
+                pointCounts.PrepareForOutput(numRows),
+                triangleCounts.PrepareForOutput(numRows));
+    Algorithm::Schedule(countRows, numRows);
+
+    IdArrayHandleType pointOffsets;
+    IdArrayHandleType triangleOffsets;
+    const dax::Id numPoints =
+        Algorithm::ScanExclusive(pointCounts, pointOffsets);
+    const dax::Id numTriangles =
+        Algorithm::ScanExclusive(triangleCounts, triangleOffsets);
+    pointCounts.ReleaseResources();
+    triangleCounts.ReleaseResources();
+
+    //third pass: each row writes its points and triangles
+    const dax::Vector3 spacing = inputGrid.GetSpacing();
+    const dax::Vector3 origin =
+        inputGrid.GetOrigin() + spacing * dax::make_Vector3(
+          static_cast<dax::Scalar>(inputGrid.GetExtent().Min[0]),
+          static_cast<dax::Scalar>(inputGrid.GetExtent().Min[1]),
+          static_cast<dax::Scalar>(inputGrid.GetExtent().Min[2]));
+
+    dax::exec::internal::kernel::FlyingEdgesGenerate<
+        FieldPortalType,
+        typename ByteArrayHandleType::PortalConstExecution,
+        typename IdArrayHandleType::PortalConstExecution,
+        typename OutputGridType::PointCoordinatesType::PortalExecution,
+        typename OutputGridType::CellConnectionsType::PortalExecution>
+      generate(field.PrepareForInput(),
+               worklet.GetIsoValue(),
+               cases,
+               xCounts.PrepareForInput(),
+               yCounts.PrepareForInput(),
+               pointOffsets.PrepareForInput(),
+               triangleOffsets.PrepareForInput(),
+               origin,
+               spacing,
+               outputGrid.GetPointCoordinates().PrepareForOutput(numPoints),
+               outputGrid.GetCellConnections().PrepareForOutput(
+                 3*numTriangles));
+    Algorithm::Schedule(generate, numRows);
+  }
+};
+
+} } } //dax::cont::scheduling
+
+#endif //__dax_cont_scheduling_SchedulerFlyingEdges_h
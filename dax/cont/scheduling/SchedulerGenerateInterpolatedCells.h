@@ -21,16 +21,17 @@
 #include <dax/Types.h>
 #include <dax/CellTraits.h>
 #include <dax/cont/arg/ConceptMap.h>
+#include <dax/cont/internal/InterpolatedCellEdges.h>
 #include <dax/cont/DeviceAdapter.h>
 #include <dax/cont/Scheduler.h>
 #include <dax/cont/scheduling/AddVisitIndexArg.h>
 #include <dax/cont/scheduling/SchedulerDefault.h>
 #include <dax/cont/scheduling/SchedulerTags.h>
+#include <dax/cont/scheduling/VerifyCellFieldLength.h>
 #include <dax/cont/scheduling/VerifyUserArgLength.h>
 #include <dax/cont/sig/Arg.h>
 #include <dax/cont/sig/Tag.h>
 #include <dax/cont/sig/VisitIndex.h>
-#include <dax/math/Compare.h>
 
 #include <dax/exec/internal/kernel/GenerateWorklets.h>
 
@@ -84,84 +85,91 @@ public:
 #endif
 
 private:
-//take the input grid and the interpolated grid to produce the new points
-//that fill the output grid. In the future the user should be able to
-//to specify the coordinate array to interpolate on, instead of it
+//take the interpolation edges written by the worklet and produce the
+//topology and points of the output grid. In the future the user should be
+//able to specify the coordinate array to interpolate on, instead of it
 //being based on the input grid. This would allow us to do some smarter
 //contouring on moving coordinate fields, where the classification doesn't change
 template <typename InputGrid,
-          typename OutputGrid>
+          typename OutputGrid,
+          typename EdgeArrayType,
+          typename PointFieldsType>
 DAX_CONT_EXPORT void ResolveCoordinates(const InputGrid& inputGrid,
                                         OutputGrid& outputGrid,
-                                        bool removeDuplicates ) const
+                                        const EdgeArrayType& edges,
+                                        bool removeDuplicates,
+                                        PointFieldsType pointFields) const
 {
-  typedef typename OutputGrid::PointCoordinatesType::ArrayContainerControlTag
-      ArrayContainerControlTag;
   typedef dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapterTag>
       Algorithm;
+
+  EdgeArrayType records;
   if(removeDuplicates)
     {
-    // the sort and unique will get us the subset of new points
-    // the lower bounds on the subset and the original coords, will produce
+    // the sort and unique of the edges will get us the subset of new points,
+    // since points on the same edge with the same weight are the same point.
+    // the lower bounds on the subset and the original edges will produce
     // the resulting topology array
-
-    dax::math::SortLess comparisonFunctor;
-    typename OutputGrid::PointCoordinatesType uniqueCoords;
-
-    Algorithm::Copy(outputGrid.GetPointCoordinates(),
-                    uniqueCoords);
-
-    typedef dax::cont::ArrayHandle<
-        dax::Id3,ArrayContainerControlTag,DeviceAdapterTag> IdArrayType;
-    IdArrayType* coordsAsIds;
-    coordsAsIds = reinterpret_cast<IdArrayType*>(&uniqueCoords);
-
-
-    Algorithm::Sort(*coordsAsIds, comparisonFunctor );
-    Algorithm::Unique(uniqueCoords);
-    Algorithm::LowerBounds(uniqueCoords,
-                           outputGrid.GetPointCoordinates(),
-                           outputGrid.GetCellConnections(),
-                           comparisonFunctor );
-
-    //reduce and resize outputGrid
-    //outputGrid.SetPointCoordinates(uniqueCoords);
-    Algorithm::Copy(uniqueCoords,outputGrid.GetPointCoordinates());
+    Algorithm::Copy(edges, records);
+    Algorithm::Sort(records);
+    Algorithm::Unique(records);
+    Algorithm::LowerBounds(records, edges, outputGrid.GetCellConnections());
+    }
+  else
+    {
+    //every point of every cell is its own point
+    records = edges;
+    outputGrid.GetCellConnections().PrepareForOutput(
+          edges.GetNumberOfValues());
+    this->DefaultScheduler.Invoke(dax::exec::internal::kernel::Index(),
+                                  outputGrid.GetCellConnections());
     }
 
-  //all we have to do is convert the interpolated cell coords into real coords.
-  //The vector 3 that is the coords have the correct point ids we need to read
-  //we just don't have a nice way to map those to a functor.
-
-  //1. We write worklet that has access to all the points, easy to write
-  //no clue on the speed.
-
-  //2. talk to bob to see how he did this in parallel, I expect it is far
-  //more complicated than what I am going to do
-
-  //end result is I am going to use the raw schedule and not write a proper
-  //worklet to this step
+  //the coordinates head the list of point fields, so that they and all the
+  //fields, normals included, are interpolated in one pass over the new points
   typedef typename InputGrid::PointCoordinatesType::PortalConstExecution InPortalType;
   typedef typename OutputGrid::PointCoordinatesType::PortalExecution OutPortalType;
-
-  const dax::Id numPoints = outputGrid.GetNumberOfPoints();
-  dax::exec::internal::kernel::InterpolateEdgesToPoint<InPortalType,OutPortalType>
-    interpolate( inputGrid.GetPointCoordinates().PrepareForInput(),
-                 outputGrid.GetPointCoordinates().PrepareForOutput(numPoints));
+  typedef dax::exec::internal::kernel::FieldPortalPair<
+      InPortalType, OutPortalType,
+      typename PointFieldsType::PortalsType> FieldsType;
+
+  const dax::Id numPoints = records.GetNumberOfValues();
+  dax::exec::internal::kernel::InterpolateEdgesToFields<
+      typename EdgeArrayType::PortalConstExecution, FieldsType>
+    interpolate( records.PrepareForInput(),
+                 FieldsType(
+                   inputGrid.GetPointCoordinates().PrepareForInput(),
+                   outputGrid.GetPointCoordinates().PrepareForOutput(numPoints),
+                   pointFields.PrepareForInterpolation(numPoints)));
 
   Algorithm::Schedule(interpolate, numPoints);
 }
 
+//replaces each index into the classification with the id of the input
+//cell that classification value is for
+template<class CellIdsType, class IdArrayHandleType>
+DAX_CONT_EXPORT void MapToInputCells(CellIdsType inputCellIds,
+                                     IdArrayHandleType& validCellRange) const
+  {
+  IdArrayHandleType cellIds;
+  this->DefaultScheduler.Invoke(dax::exec::internal::kernel::CopyId(),
+                   dax::cont::make_Permutation(validCellRange,inputCellIds,
+                                     inputCellIds.GetNumberOfValues()),
+                   cellIds);
+  validCellRange = cellIds;
+  }
+
 //want the basic implementation to be easily edited, instead of inside
 //the BOOST_PP block and unreadable. This version of GenerateNewTopology
 //handles the use case no parameters
 template <class WorkletType,
           typename ClassifyHandleType,
+          typename PointFieldsType,
           typename InputGrid,
           typename OutputGrid>
 DAX_CONT_EXPORT void GenerateNewTopology(
     dax::cont::GenerateInterpolatedCells<
-    WorkletType,ClassifyHandleType>& newTopo,
+    WorkletType,ClassifyHandleType,PointFieldsType>& newTopo,
     const InputGrid& inputGrid,
     OutputGrid& outputGrid) const
   {
@@ -214,17 +222,19 @@ DAX_CONT_EXPORT void GenerateNewTopology(
   AddVisitIndexFunctor createVisitIndex;
   createVisitIndex(this->DefaultScheduler,validCellRange,visitIndex);
 
-  //make fake indicies so that the worklet can write out the interpolated
-  //cell points information as geometry
-  outputGrid.GetCellConnections().PrepareForOutput(
-     numNewCells * dax::CellTraits<typename OutputGrid::CellTag>::NUM_VERTICES);
-  this->DefaultScheduler.Invoke(dax::exec::internal::kernel::Index(),
-                               outputGrid.GetCellConnections());
+  //when only some input cells were classified, the classification indices
+  //found above have to be mapped to the ids of those cells
+  if(newTopo.GetUseInputCellIds())
+    {
+    this->MapToInputCells(newTopo.GetInputCellIds(), validCellRange);
+    }
 
   //Next step is to set the scheduler to fill the output geometry
-  //with the interpolated cell values. We use the outputGrid,
-  //since a vec3 is what the interpolated cell values and the outputGrids
-  //coordinate space are
+  //with the interpolated cell values. The worklet writes the interpolation
+  //edge of each point of each new cell, which are only turned into points
+  //of the output grid once they are all known
+  dax::cont::internal::InterpolatedCellEdges<
+      typename OutputGrid::CellTag, DeviceAdapterTag> edges;
 
   //we get our magic here. we need to wrap some parameters and pass
   //them to the real scheduler
@@ -232,13 +242,14 @@ DAX_CONT_EXPORT void GenerateNewTopology(
   this->DefaultScheduler.Invoke(derivedWorklet,
                    dax::cont::make_Permutation(validCellRange,inputGrid,
                                              inputGrid.GetNumberOfCells()),
-                   outputGrid,
+                   edges,
                    visitIndex);
 
   //now that the interpolated grid is filled we now have to properly
   //fixup the topology and coordinates
-  this->ResolveCoordinates(inputGrid,outputGrid,
-                           newTopo.GetRemoveDuplicatePoints());
+  this->ResolveCoordinates(inputGrid,outputGrid,edges.GetEdges(),
+                           newTopo.GetRemoveDuplicatePoints(),
+                           newTopo.GetInterpolatedPointFields());
   }
 };
 
@@ -270,12 +281,13 @@ DAX_CONT_EXPORT void Invoke(WorkletType w, _dax_pp_params___(a)) const
 private:
 template <class WorkletType,
           typename ClassifyHandleType,
+          typename PointFieldsType,
           typename InputGrid,
           typename OutputGrid,
           _dax_pp_typename___T>
 DAX_CONT_EXPORT void GenerateNewTopology(
     dax::cont::GenerateInterpolatedCells<
-    WorkletType,ClassifyHandleType>& newTopo,
+    WorkletType,ClassifyHandleType,PointFieldsType>& newTopo,
     const InputGrid& inputGrid,
     OutputGrid& outputGrid,
     _dax_pp_params___(a)) const
@@ -285,6 +297,22 @@ DAX_CONT_EXPORT void GenerateNewTopology(
   typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
       DeviceAdapterTag> IdArrayHandleType;
 
+  //The worklet writes the interpolation edge of each point of each new
+  //cell, which are only turned into points of the output grid once they are
+  //all known
+  typedef dax::cont::internal::InterpolatedCellEdges<
+      typename OutputGrid::CellTag, DeviceAdapterTag> EdgesType;
+  EdgesType edges;
+
+  //input Field(Cell) arrays are looked up by input cell id, so check that
+  //they cover the input grid before doing any work
+  typedef WorkletType ControlInvocationSignature(
+      InputGrid, EdgesType, _dax_pp_T___);
+  dax::cont::internal::Bindings<ControlInvocationSignature>
+      userBindings(inputGrid, edges, _dax_pp_args___(a));
+  userBindings.ForEachCont(dax::cont::scheduling::VerifyCellFieldLength(
+                             inputGrid.GetNumberOfCells()));
+
   //do an inclusive scan of the cell count / cell mask to get the number
   //of cells in the output
   IdArrayHandleType scannedNewCellCounts;
@@ -329,31 +357,28 @@ DAX_CONT_EXPORT void GenerateNewTopology(
   AddVisitIndexFunctor createVisitIndex;
   createVisitIndex(this->DefaultScheduler,validCellRange,visitIndex);
 
-  //make fake indicies so that the worklet can write out the interpolated
-  //cell points information as geometry
-  outputGrid.GetCellConnections().PrepareForOutput(
-     numNewCells * dax::CellTraits<typename OutputGrid::CellTag>::NUM_VERTICES);
-  this->DefaultScheduler.Invoke(dax::exec::internal::kernel::Index(),
-                               outputGrid.GetCellConnections());
+  //when only some input cells were classified, the classification indices
+  //found above have to be mapped to the ids of those cells
+  if(newTopo.GetUseInputCellIds())
+    {
+    this->MapToInputCells(newTopo.GetInputCellIds(), validCellRange);
+    }
 
   //Next step is to set the scheduler to fill the output geometry
-  //with the interpolated cell values. We use the outputGrid,
-  //since a vec3 is what the interpolated cell values and the outputGrids
-  //coordinate space are
-
-  //we get our magic here. we need to wrap some parameters and pass
-  //them to the real scheduler
+  //with the interpolated cell values. we get our magic here. we need to
+  //wrap some parameters and pass them to the real scheduler
   DerivedWorkletType derivedWorklet(newTopo.GetWorklet());
   this->DefaultScheduler.Invoke(derivedWorklet,
                    dax::cont::make_Permutation(validCellRange,inputGrid,
                                              inputGrid.GetNumberOfCells()),
-                   outputGrid,
+                   edges,
                    _dax_pp_args___(a),
                    visitIndex);
 
   //now that the interpolated grid is filled we now have to properly
   //fixup the topology and coordinates
-  this->ResolveCoordinates(inputGrid,outputGrid,
-                           newTopo.GetRemoveDuplicatePoints());
+  this->ResolveCoordinates(inputGrid,outputGrid,edges.GetEdges(),
+                           newTopo.GetRemoveDuplicatePoints(),
+                           newTopo.GetInterpolatedPointFields());
   }
 #endif // defined(BOOST_PP_IS_ITERATING)
@@ -27,6 +27,7 @@
 #include <dax/cont/Scheduler.h>
 #include <dax/cont/scheduling/SchedulerTags.h>
 #include <dax/cont/scheduling/SchedulerDefault.h>
+#include <dax/cont/scheduling/VerifyCellFieldLength.h>
 #include <dax/cont/scheduling/VerifyUserArgLength.h>
 #include <dax/cont/scheduling/AddVisitIndexArg.h>
 
@@ -101,8 +102,8 @@ DAX_CONT_EXPORT void GenerateNewTopology(
   //of cells in the output
   IdArrayHandleType scannedNewCellCounts;
   const dax::Id numNewCells =
-      Algorithm::ScanInclusive(newTopo.GetClassification(),
-                               scannedNewCellCounts);
+      this->ScanCellCounts(newTopo.GetClassification(),
+                           scannedNewCellCounts);
 
   if(newTopo.GetReleaseClassification())
     {
@@ -110,8 +111,9 @@ DAX_CONT_EXPORT void GenerateNewTopology(
     }
 
   //fill the validCellRange with the values from 1 to size+1, this is used
-  //for the lower bounds to compute the right indices
-  IdArrayHandleType validCellRange;
+  //for the lower bounds to compute the right indices. It is the cell map of
+  //newTopo, so it is kept to compact cell fields once we are done.
+  IdArrayHandleType validCellRange = newTopo.GetCellMap();
   validCellRange.PrepareForOutput(numNewCells);
   this->DefaultScheduler.Invoke(dax::exec::internal::kernel::Index(),
                   validCellRange);
@@ -141,6 +143,13 @@ DAX_CONT_EXPORT void GenerateNewTopology(
   AddVisitIndexFunctor createVisitIndex;
   createVisitIndex(this->DefaultScheduler,validCellRange,visitIndex);
 
+  //when only some input cells were classified, the classification indices
+  //found above have to be mapped to the ids of those cells
+  if(newTopo.GetUseInputCellIds())
+    {
+    this->MapToInputCells(newTopo.GetInputCellIds(), validCellRange);
+    }
+
   DerivedWorkletType derivedWorklet(newTopo.GetWorklet());
 
   //we get our magic here. we need to wrap some paramemters and pass
@@ -153,67 +162,125 @@ DAX_CONT_EXPORT void GenerateNewTopology(
   //call this here as we have stripped out the input and output grids
   if(newTopo.GetRemoveDuplicatePoints())
     {
-    this->FillPointMask(inputGrid,outputGrid, newTopo.GetPointMask());
-    this->RemoveDuplicatePoints(inputGrid,outputGrid, newTopo.GetPointMask());
+    newTopo.SetNumberOfCompactPoints(
+          this->RemoveDuplicatePoints(inputGrid,outputGrid,
+                                      newTopo.GetPointMask(),
+                                      newTopo.GetPointMap()));
     }
   }
 
-template<class InGridType, class OutGridType, typename MaskType>
-DAX_CONT_EXPORT void FillPointMask(const InGridType &inGrid,
-                       const OutGridType &outGrid,
-                       MaskType mask) const
+//The classification holds a count of new cells per input cell, which fits
+//in a dax::ConnectivityId. The scanned offsets can overflow it, so they are
+//always computed as dax::Id.
+template<class Container, class OffsetsType>
+DAX_CONT_EXPORT dax::Id ScanCellCounts(
+    const dax::cont::ArrayHandle<dax::Id,Container,DeviceAdapterTag> &counts,
+    OffsetsType &offsets) const
   {
-  typedef typename MaskType::PortalExecution MaskPortalType;
-
-  // Clear out the mask, have to allocate the size first
-  // so that  works properly
-  mask.PrepareForOutput(inGrid.GetNumberOfPoints());
+  return dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapterTag>::
+      ScanInclusive(counts, offsets);
+  }
 
-  this->DefaultScheduler.Invoke(dax::exec::internal::kernel::ClearUsedPointsFunctor(),
-           mask);
+template<typename T, class Container, class OffsetsType>
+DAX_CONT_EXPORT dax::Id ScanCellCounts(
+    const dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &counts,
+    OffsetsType &offsets) const
+  {
+  offsets.PrepareForOutput(counts.GetNumberOfValues());
+  this->DefaultScheduler.Invoke(dax::exec::internal::kernel::CountToOffset(),
+                                counts, offsets);
+  return dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapterTag>::
+      ScanInclusive(offsets, offsets);
+  }
 
-  // Mark every point that is used at least once.
-  // This only works when outGrid is an UnstructuredGrid.
-  this->DefaultScheduler.Invoke(dax::exec::internal::kernel::GetUsedPointsFunctor(),
-           dax::cont::make_Permutation(outGrid.GetCellConnections(),
-           mask,
-           inGrid.GetNumberOfPoints()));
+//replaces each index into the classification with the id of the input
+//cell that classification value is for
+template<class CellIdsType, class IdArrayHandleType>
+DAX_CONT_EXPORT void MapToInputCells(CellIdsType inputCellIds,
+                                     IdArrayHandleType& validCellRange) const
+  {
+  IdArrayHandleType cellIds;
+  this->DefaultScheduler.Invoke(dax::exec::internal::kernel::CopyId(),
+                   dax::cont::make_Permutation(validCellRange,inputCellIds,
+                                     inputCellIds.GetNumberOfValues()),
+                   cellIds);
+  //copied rather than assigned, as validCellRange shares its storage with
+  //the cell map of the GenerateTopology
+  dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapterTag>::Copy(
+        cellIds, validCellRange);
   }
 
-template<typename InGridType,typename OutGridType, typename MaskType>
-DAX_CONT_EXPORT void RemoveDuplicatePoints(const InGridType &inGrid,
+//Removes the points of the input grid that no output cell uses. The used
+//points are flagged in a byte mask with one pass over the connections, and
+//the exclusive scan of that mask gives the new id of every used point, which
+//is gathered into the connections and used to compact the coordinates.
+//Returns the number of points kept.
+template<typename InGridType, typename OutGridType,
+         typename MaskType, typename PointMapType>
+DAX_CONT_EXPORT dax::Id RemoveDuplicatePoints(const InGridType &inGrid,
                         OutGridType& outGrid,
-                        MaskType const mask ) const
+                        MaskType mask,
+                        PointMapType pointMap) const
   {
     // Here we are assuming OutGridType is an UnstructuredGrid so that we
     // can set point and connectivity information.
 
     typedef dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapterTag>
         Algorithm;
-
-    //extract the point coordinates that we need for the new topology
-    Algorithm::StreamCompact(inGrid.GetPointCoordinates(),
-                             mask,
-                             outGrid.GetPointCoordinates());
-
     typedef typename OutGridType::CellConnectionsType CellConnectionsType;
+    typedef typename InGridType::PointCoordinatesType InPointCoordinatesType;
     typedef typename OutGridType::PointCoordinatesType PointCoordinatesType;
 
-    //compact the topology array to reference the extracted
-    //coordinates ids
-    {
-    // Make usedPointIds become a sorted array of used point indices.
-    // If entry i in usedPointIndices is j, then point index i in the
-    // output corresponds to point index j in the input.
-    typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
-        DeviceAdapterTag> IdArrayHandleType;
-    IdArrayHandleType usedPointIndices;
-    Algorithm::Copy(outGrid.GetCellConnections(), usedPointIndices);
-    Algorithm::Sort(usedPointIndices);
-    Algorithm::Unique(usedPointIndices);
+    const dax::Id numInPoints = inGrid.GetNumberOfPoints();
+    const dax::Id numConnections =
+        outGrid.GetCellConnections().GetNumberOfValues();
+
+    // Clear out the mask, have to allocate the size first
+    // so that  works properly
+    mask.PrepareForOutput(numInPoints);
+    this->DefaultScheduler.Invoke(
+          dax::exec::internal::kernel::ClearUsedPointsFunctor(), mask);
+
+    // Mark every point that is used at least once.
+    // This only works when outGrid is an UnstructuredGrid.
+    dax::exec::internal::kernel::MarkUsedPoints<
+        typename CellConnectionsType::PortalConstExecution,
+        typename MaskType::PortalExecution>
+      markPoints(outGrid.GetCellConnections().PrepareForInput(),
+                 mask.PrepareForInPlace());
+    Algorithm::Schedule(markPoints, numConnections);
+
+    // Each used point counts once, so the exclusive scan of the mask is the
+    // id of that point in the output.
+    pointMap.PrepareForOutput(numInPoints);
+    this->DefaultScheduler.Invoke(
+          dax::exec::internal::kernel::CountToOffset(), mask, pointMap);
+    const dax::Id numOutPoints = Algorithm::ScanExclusive(pointMap, pointMap);
+
     // Modify the connections of outGrid to point to compacted points.
-    Algorithm::LowerBounds(usedPointIndices, outGrid.GetCellConnections());
-    }
+    dax::exec::internal::kernel::RenumberPoints<
+        typename PointMapType::PortalConstExecution,
+        typename CellConnectionsType::PortalExecution>
+      renumber(pointMap.PrepareForInput(),
+               outGrid.GetCellConnections().PrepareForInPlace());
+    Algorithm::Schedule(renumber, numConnections);
+
+    //extract the point coordinates that we need for the new topology
+    typedef dax::exec::internal::kernel::FieldPortalPair<
+        typename InPointCoordinatesType::PortalConstExecution,
+        typename PointCoordinatesType::PortalExecution> CoordinatesType;
+    dax::exec::internal::kernel::CompactPointFields<
+        typename MaskType::PortalConstExecution,
+        typename PointMapType::PortalConstExecution,
+        CoordinatesType>
+      compact(mask.PrepareForInput(),
+              pointMap.PrepareForInput(),
+              CoordinatesType(inGrid.GetPointCoordinates().PrepareForInput(),
+                              outGrid.GetPointCoordinates().PrepareForOutput(
+                                numOutPoints)));
+    Algorithm::Schedule(compact, numInPoints);
+
+    return numOutPoints;
   }
 
   typedef dax::cont::scheduling::Scheduler<DeviceAdapterTag,
@@ -265,12 +332,21 @@ DAX_CONT_EXPORT void GenerateNewTopology(
   typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
       DeviceAdapterTag> IdArrayHandleType;
 
+  //input Field(Cell) arrays are looked up by input cell id, so check that
+  //they cover the input grid before doing any work
+  typedef WorkletType ControlInvocationSignature(
+      InputGrid, OutputGrid, _dax_pp_T___);
+  dax::cont::internal::Bindings<ControlInvocationSignature>
+      userBindings(inputGrid, outputGrid, _dax_pp_args___(a));
+  userBindings.ForEachCont(dax::cont::scheduling::VerifyCellFieldLength(
+                             inputGrid.GetNumberOfCells()));
+
   //do an inclusive scan of the cell count / cell mask to get the number
   //of cells in the output
   IdArrayHandleType scannedNewCellCounts;
   const dax::Id numNewCells =
-      Algorithm::ScanInclusive(newTopo.GetClassification(),
-                               scannedNewCellCounts);
+      this->ScanCellCounts(newTopo.GetClassification(),
+                           scannedNewCellCounts);
 
   if(newTopo.GetReleaseClassification())
     {
@@ -278,8 +354,9 @@ DAX_CONT_EXPORT void GenerateNewTopology(
     }
 
   //fill the validCellRange with the values from 0 to size, this is used
-  //for the upper bounds to compute the right indices
-  IdArrayHandleType validCellRange;
+  //for the upper bounds to compute the right indices. It is the cell map of
+  //newTopo, so it is kept to compact cell fields once we are done.
+  IdArrayHandleType validCellRange = newTopo.GetCellMap();
   validCellRange.PrepareForOutput(numNewCells);
   this->DefaultScheduler.Invoke(dax::exec::internal::kernel::Index(),
                     validCellRange);
@@ -309,6 +386,13 @@ DAX_CONT_EXPORT void GenerateNewTopology(
   AddVisitIndexFunctor createVisitIndex;
   createVisitIndex(this->DefaultScheduler,validCellRange,visitIndex);
 
+  //when only some input cells were classified, the classification indices
+  //found above have to be mapped to the ids of those cells
+  if(newTopo.GetUseInputCellIds())
+    {
+    this->MapToInputCells(newTopo.GetInputCellIds(), validCellRange);
+    }
+
   DerivedWorkletType derivedWorklet(newTopo.GetWorklet());
 
   //we get our magic here. we need to wrap some paramemters and pass
@@ -323,8 +407,10 @@ DAX_CONT_EXPORT void GenerateNewTopology(
   //call this here as we have stripped out the input and output grids
   if(newTopo.GetRemoveDuplicatePoints())
     {
-    this->FillPointMask(inputGrid,outputGrid, newTopo.GetPointMask());
-    this->RemoveDuplicatePoints(inputGrid,outputGrid, newTopo.GetPointMask());
+    newTopo.SetNumberOfCompactPoints(
+          this->RemoveDuplicatePoints(inputGrid,outputGrid,
+                                      newTopo.GetPointMask(),
+                                      newTopo.GetPointMap()));
     }
   }
 #endif // defined(BOOST_PP_IS_ITERATING)
@@ -31,6 +31,9 @@ struct GenerateTopologyTag{};
 //tag used to specify the Coordinates Generation
 struct GenerateInterpolatedCellsTag{};
 
+//tag used to specify the flying edges isosurface of a uniform grid
+struct FlyingEdgesTag{};
+
 } } } //dax::cont::scheduling
 
 #endif //__dax_cont_scheduling_SchedulerTags_h
@@ -0,0 +1,85 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_scheduling_VerifyCellFieldLength_h
+#define __dax_cont_scheduling_VerifyCellFieldLength_h
+
+#include <dax/Types.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/arg/ConceptMap.h>
+#include <dax/cont/arg/Field.h>
+#include <dax/cont/sig/Tag.h>
+
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+namespace dax { namespace cont { namespace scheduling {
+
+/// Visits the bound arguments of a generate worklet and throws an
+/// ErrorControlBadValue if an input Field(Cell) array holds fewer values
+/// than the input grid has cells. The generate schedulers look these arrays
+/// up by input cell id rather than by output cell index, so they must cover
+/// every cell of the input grid even when only some cells are classified.
+class VerifyCellFieldLength
+{
+  const dax::Id NumberOfCells;
+public:
+  VerifyCellFieldLength(dax::Id numberOfCells):
+    NumberOfCells(numberOfCells)
+    {}
+
+  template <typename C, typename A>
+  void operator()(const dax::cont::arg::ConceptMap<C,A>& concept) const
+    {
+    typedef dax::cont::arg::ConceptMap<C,A> ConceptType;
+    typedef dax::cont::arg::ConceptMapTraits<ConceptType> Traits;
+    typedef typename Traits::Tags Tags;
+
+    //constant values have no length, so only concept maps that report
+    //one are checked
+    typedef typename boost::mpl::and_<
+        boost::is_same<typename Traits::Concept, dax::cont::arg::Field>,
+        typename Tags::template Has<dax::cont::sig::Cell>,
+        boost::mpl::not_<typename Tags::template Has<dax::cont::sig::Out> >,
+        typename Traits::DomainTags::template Has<dax::cont::sig::AnyDomain>
+        >::type IsInputCellField;
+
+    this->Verify(concept, IsInputCellField());
+    }
+
+private:
+  template <typename ConceptType>
+  void Verify(const ConceptType& concept, boost::mpl::true_) const
+    {
+    if(concept.GetDomainLength(dax::cont::sig::Cell()) < this->NumberOfCells)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "An input Field(Cell) array of a generate worklet has fewer "
+            "values than the input grid has cells.");
+      }
+    }
+
+  template <typename ConceptType>
+  void Verify(const ConceptType&, boost::mpl::false_) const
+    {
+    //not an input cell field, so it is indexed by output cell
+    }
+};
+
+} } } //dax::cont::scheduling
+
+#endif //__dax_cont_scheduling_VerifyCellFieldLength_h
@@ -95,7 +95,7 @@ struct TemplatedTests
       DAX_TEST_ASSERT(test_equal(stolenArray[index], stolenArrayValue),
                       "Stolen array did not retain values.");
       }
-    delete[] stolenArray;
+    dax::cont::internal::FreeArrayMemory(stolenArray);
   }
 
   void BasicAllocation()
@@ -134,12 +134,120 @@ struct TemplatedTests
     catch(dax::cont::ErrorControlBadValue){}
   }
 
+  void GrowAllocation()
+  {
+    ArrayContainerType arrayContainer;
+    arrayContainer.Reserve(ARRAY_SIZE);
+    DAX_TEST_ASSERT(arrayContainer.GetNumberOfValues() == 0,
+                    "Reserve changed the size of the array.");
+    DAX_TEST_ASSERT(arrayContainer.GetCapacity() >= ARRAY_SIZE,
+                    "Reserve did not make room.");
+
+    arrayContainer.Grow(ARRAY_SIZE);
+    DAX_TEST_ASSERT(arrayContainer.GetNumberOfValues() == ARRAY_SIZE,
+                    "Array not grown correctly.");
+    DAX_TEST_ASSERT(arrayContainer.GetCapacity() == ARRAY_SIZE,
+                    "Grow reallocated a reserved array.");
+
+    const ValueType GROW_VALUE = dax::cont::VectorFill<ValueType>(71);
+    SetContainer(arrayContainer, GROW_VALUE);
+
+    // Growing one value at a time should only reallocate a few times.
+    int numberOfReallocations = 0;
+    for (dax::Id size = ARRAY_SIZE+1; size <= 8*ARRAY_SIZE; size++)
+      {
+      const dax::Id capacity = arrayContainer.GetCapacity();
+      arrayContainer.Grow(size);
+      if (arrayContainer.GetCapacity() != capacity)
+        {
+        numberOfReallocations++;
+        }
+      arrayContainer.GetPortal().Set(size-1, GROW_VALUE);
+      }
+    DAX_TEST_ASSERT(numberOfReallocations == 3,
+                    "Grow did not increase the capacity geometrically.");
+    DAX_TEST_ASSERT(CheckContainer(arrayContainer, GROW_VALUE),
+                    "Grow did not keep the values.");
+
+    arrayContainer.Shrink(ARRAY_SIZE);
+    arrayContainer.Reserve(16*ARRAY_SIZE);
+    DAX_TEST_ASSERT(arrayContainer.GetNumberOfValues() == ARRAY_SIZE,
+                    "Reserve changed the size of the array.");
+    DAX_TEST_ASSERT(CheckContainer(arrayContainer, GROW_VALUE),
+                    "Reserve did not keep the values.");
+
+    arrayContainer.Shrink(0);
+    arrayContainer.ReleaseResources();
+    DAX_TEST_ASSERT(arrayContainer.GetCapacity() == 0,
+                    "Array not released correctly.");
+  }
+
+  void AlignedAllocation()
+  {
+    const dax::cont::ArrayAllocationPolicy defaultPolicy =
+        dax::cont::GetArrayAllocationPolicy();
+    DAX_TEST_ASSERT(defaultPolicy.Alignment == DAX_ARRAY_ALLOCATION_ALIGNMENT,
+                    "Unexpected default alignment.");
+
+    ArrayContainerType arrayContainer;
+    arrayContainer.Allocate(ARRAY_SIZE);
+    DAX_TEST_ASSERT(
+          reinterpret_cast<std::size_t>(
+            arrayContainer.GetPortal().GetIteratorBegin())
+          % defaultPolicy.Alignment == 0,
+          "Array not aligned to the default alignment.");
+
+    // Large arrays with huge pages and interleaved NUMA placement. Both are
+    // hints, so all we can check is that the memory is usable.
+    dax::cont::ArrayAllocationPolicy largePolicy = defaultPolicy;
+    largePolicy.Alignment = 128;
+    largePolicy.HugePages = true;
+    largePolicy.NumaPlacement =
+        dax::cont::ArrayAllocationPolicy::NUMA_INTERLEAVE;
+    largePolicy.LargeArrayThreshold = ARRAY_SIZE*sizeof(ValueType);
+    dax::cont::SetArrayAllocationPolicy(largePolicy);
+
+    ArrayContainerType largeContainer;
+    largeContainer.Allocate(ARRAY_SIZE);
+    DAX_TEST_ASSERT(
+          reinterpret_cast<std::size_t>(
+            largeContainer.GetPortal().GetIteratorBegin())
+          % largePolicy.Alignment == 0,
+          "Array not aligned to the requested alignment.");
+    const ValueType LARGE_ALLOC_VALUE = dax::cont::VectorFill<ValueType>(93);
+    SetContainer(largeContainer, LARGE_ALLOC_VALUE);
+    DAX_TEST_ASSERT(CheckContainer(largeContainer, LARGE_ALLOC_VALUE),
+                    "Large array not holding value.");
+
+    largePolicy.NumaPlacement = dax::cont::ArrayAllocationPolicy::NUMA_LOCAL;
+    dax::cont::SetArrayAllocationPolicy(largePolicy);
+    largeContainer.Allocate(ARRAY_SIZE*2);
+    SetContainer(largeContainer, LARGE_ALLOC_VALUE);
+    DAX_TEST_ASSERT(CheckContainer(largeContainer, LARGE_ALLOC_VALUE),
+                    "Local array not holding value.");
+
+    dax::cont::SetArrayAllocationPolicy(defaultPolicy);
+
+    try
+      {
+      dax::cont::ArrayAllocationPolicy badPolicy = defaultPolicy;
+      badPolicy.Alignment = 96;
+      dax::cont::SetArrayAllocationPolicy(badPolicy);
+      DAX_TEST_FAIL("Alignment that is not a power of two was accepted.");
+      }
+    catch(dax::cont::ErrorControlBadValue){}
+  }
+
   void operator()()
   {
     ValueType *stolenArray = StealArray1();
 
     BasicAllocation();
 
+    GrowAllocation();
+
+    AlignedAllocation();
+
     StealArray2(stolenArray);
   }
 };
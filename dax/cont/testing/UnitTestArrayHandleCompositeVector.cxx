@@ -0,0 +1,176 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleCompositeVector.h>
+
+#include <dax/cont/arg/FieldArrayHandleCompositeVector.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 10;
+
+typedef dax::cont::ArrayHandle<dax::Scalar> ScalarArrayHandle;
+typedef dax::cont::ArrayHandleCompositeVector<ScalarArrayHandle,3>
+    CompositeArrayHandle;
+
+struct Offset : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(const dax::Vector3 &value) const
+  {
+    return value + dax::make_Vector3(1, 2, 3);
+  }
+};
+
+dax::Scalar TestValue(dax::Id index, int component)
+{
+  return static_cast<dax::Scalar>(10*index + component);
+}
+
+ScalarArrayHandle MakeComponent(int component, std::vector<dax::Scalar> &buffer)
+{
+  buffer.resize(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    buffer[index] = TestValue(index, component);
+    }
+  return dax::cont::make_ArrayHandle(buffer);
+}
+
+void CheckComposite(const dax::cont::ArrayHandle<
+                      dax::Vector3,
+                      CompositeArrayHandle::ArrayContainerControlTag> &array,
+                    const dax::Vector3 &offset)
+{
+  DAX_TEST_ASSERT(array.GetNumberOfValues() == ARRAY_SIZE,
+                  "Composite array has wrong size.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    dax::Vector3 expected = dax::make_Vector3(TestValue(index, 0),
+                                              TestValue(index, 1),
+                                              TestValue(index, 2)) + offset;
+    DAX_TEST_ASSERT(test_equal(array.GetPortalConstControl().Get(index),
+                               expected),
+                    "Composite array has unexpected value.");
+    }
+}
+
+void TestCompositeVectorRead()
+{
+  std::cout << "Creating composite array of input arrays." << std::endl;
+  std::vector<dax::Scalar> buffers[3];
+  CompositeArrayHandle composite =
+      dax::cont::make_ArrayHandleCompositeVector(MakeComponent(0, buffers[0]),
+                                                 MakeComponent(1, buffers[1]),
+                                                 MakeComponent(2, buffers[2]));
+  CheckComposite(composite, dax::make_Vector3(0, 0, 0));
+
+  std::cout << "Checking execution portal." << std::endl;
+  CompositeArrayHandle::PortalConstExecution portal =
+      composite.PrepareForInput();
+  DAX_TEST_ASSERT(portal.GetNumberOfValues() == ARRAY_SIZE,
+                  "Execution portal has wrong size.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(portal.Get(index)[1] == TestValue(index, 1),
+                    "Execution portal has unexpected value.");
+    }
+}
+
+void TestCompositeVectorWrite()
+{
+  std::cout << "Creating composite array of output arrays." << std::endl;
+  ScalarArrayHandle x, y, z;
+  CompositeArrayHandle composite =
+      dax::cont::make_ArrayHandleCompositeVector(x, y, z);
+
+  std::vector<dax::Scalar> buffers[3];
+  CompositeArrayHandle input =
+      dax::cont::make_ArrayHandleCompositeVector(MakeComponent(0, buffers[0]),
+                                                 MakeComponent(1, buffers[1]),
+                                                 MakeComponent(2, buffers[2]));
+
+  std::cout << "Running worklet on composite arrays." << std::endl;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(Offset(), input, composite);
+
+  CheckComposite(composite, dax::make_Vector3(1, 2, 3));
+
+  std::cout << "Checking values were written to components." << std::endl;
+  DAX_TEST_ASSERT(x.GetNumberOfValues() == ARRAY_SIZE,
+                  "Component array has wrong size.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(x.GetPortalConstControl().Get(index)
+                    == TestValue(index, 0) + 1,
+                    "Bad x component.");
+    DAX_TEST_ASSERT(y.GetPortalConstControl().Get(index)
+                    == TestValue(index, 1) + 2,
+                    "Bad y component.");
+    DAX_TEST_ASSERT(z.GetPortalConstControl().Get(index)
+                    == TestValue(index, 2) + 3,
+                    "Bad z component.");
+    }
+
+  std::cout << "Writing through control portal." << std::endl;
+  composite.GetPortalControl().Set(0, dax::make_Vector3(-1, -2, -3));
+  DAX_TEST_ASSERT(y.GetPortalConstControl().Get(0) == -2,
+                  "Control portal did not write component.");
+}
+
+void TestCompositeVectorMismatch()
+{
+  std::cout << "Checking components of different sizes." << std::endl;
+  std::vector<dax::Scalar> buffer;
+  ScalarArrayHandle full = MakeComponent(0, buffer);
+  ScalarArrayHandle empty;
+  try
+    {
+    dax::cont::make_ArrayHandleCompositeVector(full, empty);
+    DAX_TEST_FAIL("Did not get error for mismatched components.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestCompositeVector()
+{
+  TestCompositeVectorRead();
+  TestCompositeVectorWrite();
+  TestCompositeVectorMismatch();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleCompositeVector(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestCompositeVector);
+}
@@ -0,0 +1,132 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleCompressedConnectivity.h>
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/ErrorExecution.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/cont/internal/testing/TestingGridGenerator.h>
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 5;
+
+typedef dax::CellTagTetrahedron CellTag;
+const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+
+typedef dax::cont::ArrayHandle<unsigned short> DeltaHandleType;
+typedef dax::cont::ArrayHandleCompressedConnectivity<
+    DeltaHandleType,NUM_VERTICES> CompressedHandleType;
+
+void TestCompressedConnectivity()
+{
+  typedef dax::cont::UnstructuredGrid<CellTag> GridType;
+  dax::cont::internal::TestGrid<GridType> gridGen(DIM);
+  GridType grid = gridGen.GetRealGrid();
+
+  std::cout << "Compressing connections." << std::endl;
+  CompressedHandleType compressed =
+      dax::cont::make_ArrayHandleCompressedConnectivity<CellTag,unsigned short>(
+        grid.GetCellConnections());
+  DAX_TEST_ASSERT(compressed.GetNumberOfValues()
+                  == grid.GetCellConnections().GetNumberOfValues(),
+                  "Compressed connections have wrong size.");
+
+  std::cout << "Checking control portal." << std::endl;
+  GridType::CellConnectionsType::PortalConstControl connections =
+      grid.GetCellConnections().GetPortalConstControl();
+  for (dax::Id index = 0; index < connections.GetNumberOfValues(); index++)
+    {
+    DAX_TEST_ASSERT(compressed.GetPortalConstControl().Get(index)
+                    == connections.Get(index),
+                    "Bad decompressed connection.");
+    }
+
+  std::cout << "Checking topology of grid with compressed connections."
+            << std::endl;
+  typedef dax::cont::UnstructuredGrid<
+      CellTag,
+      CompressedHandleType::ArrayContainerControlTag,
+      dax::cont::ArrayContainerControlTagBasic> CompressedGridType;
+  CompressedGridType compressedGrid(compressed, grid.GetPointCoordinates());
+  DAX_TEST_ASSERT(compressedGrid.GetNumberOfCells() == grid.GetNumberOfCells(),
+                  "Compressed grid has wrong number of cells.");
+
+  GridType::TopologyStructConstExecution topology = grid.PrepareForInput();
+  CompressedGridType::TopologyStructConstExecution compressedTopology =
+      compressedGrid.PrepareForInput();
+  for (dax::Id cellIndex = 0; cellIndex < grid.GetNumberOfCells(); cellIndex++)
+    {
+    DAX_TEST_ASSERT(
+          compressedTopology.GetCellConnections(cellIndex).GetAsTuple()
+          == topology.GetCellConnections(cellIndex).GetAsTuple(),
+          "Bad cell connections from compressed topology.");
+    }
+
+  std::cout << "Checking compressed connections cannot be output." << std::endl;
+  try
+    {
+    compressedGrid.PrepareForOutput(1);
+    DAX_TEST_FAIL("Did not get error for compressed output.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestDeltaOverflow()
+{
+  std::cout << "Checking connections that do not fit in deltas." << std::endl;
+  std::vector<dax::ConnectivityId> buffer(NUM_VERTICES);
+  buffer[0] = 5;
+  buffer[1] = 6;
+  buffer[2] = 7;
+  buffer[3] = 100000;
+  try
+    {
+    dax::cont::make_ArrayHandleCompressedConnectivity<CellTag,unsigned short>(
+          dax::cont::make_ArrayHandle(buffer));
+    DAX_TEST_FAIL("Did not get error for delta overflow.");
+    }
+  catch (dax::cont::ErrorExecution error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestCompressed()
+{
+  TestCompressedConnectivity();
+  TestDeltaOverflow();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleCompressedConnectivity(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestCompressed);
+}
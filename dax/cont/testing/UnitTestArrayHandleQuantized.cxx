@@ -0,0 +1,160 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleQuantized.h>
+
+#include <dax/cont/arg/FieldArrayHandleQuantized.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 256;
+
+typedef dax::cont::ArrayHandle<unsigned char> ByteArrayHandle;
+typedef dax::cont::ArrayHandleQuantized<ByteArrayHandle> QuantizedByteHandle;
+
+struct Negate : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT
+  dax::Scalar operator()(dax::Scalar value) const
+  {
+    return -value;
+  }
+};
+
+dax::Scalar RoundTripHalf(dax::Scalar value)
+{
+  typedef dax::cont::internal::QuantizedValueTraits<dax::cont::Half> Traits;
+  return Traits::Decode(Traits::Encode(value));
+}
+
+void TestHalfConversion()
+{
+  std::cout << "Checking half precision conversion." << std::endl;
+  const dax::Scalar exactValues[] = {
+    0, 1, -2.5f, 0.125f, 1024, 65504, -65504,
+    6.103515625e-5f, // smallest normal half
+    5.9604644775390625e-8f, // smallest denormal half
+    3.0517578125e-5f // a denormal half
+  };
+  const int numExact = sizeof(exactValues)/sizeof(dax::Scalar);
+  for (int index = 0; index < numExact; index++)
+    {
+    DAX_TEST_ASSERT(RoundTripHalf(exactValues[index]) == exactValues[index],
+                    "Half did not represent value exactly.");
+    }
+
+  DAX_TEST_ASSERT(test_equal(RoundTripHalf(1.0f/3.0f), 1.0f/3.0f, 0.001),
+                  "Half did not approximate value.");
+  DAX_TEST_ASSERT(RoundTripHalf(1e-9f) == 0, "Tiny value did not underflow.");
+  DAX_TEST_ASSERT(RoundTripHalf(1e6f) > 65504, "Big value did not overflow.");
+  // 2049 is halfway between two halves and should round to the even one.
+  DAX_TEST_ASSERT(RoundTripHalf(2049) == 2048, "Did not round to even.");
+}
+
+void TestQuantizedRead()
+{
+  std::cout << "Creating quantized array of bytes." << std::endl;
+  std::vector<unsigned char> buffer(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    buffer[index] = static_cast<unsigned char>(index);
+    }
+  const dax::Scalar scale = 1.0f/255.0f;
+  const dax::Scalar offset = -0.5f;
+  QuantizedByteHandle quantized =
+      dax::cont::make_ArrayHandleQuantized(dax::cont::make_ArrayHandle(buffer),
+                                           scale,
+                                           offset);
+  DAX_TEST_ASSERT(quantized.GetNumberOfValues() == ARRAY_SIZE,
+                  "Quantized array has wrong size.");
+
+  std::cout << "Checking control portal." << std::endl;
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(test_equal(quantized.GetPortalConstControl().Get(index),
+                               scale*index + offset),
+                    "Control portal has unexpected value.");
+    }
+
+  std::cout << "Checking execution portal." << std::endl;
+  QuantizedByteHandle::PortalConstExecution portal =
+      quantized.PrepareForInput();
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(test_equal(portal.Get(index), scale*index + offset),
+                    "Execution portal has unexpected value.");
+    }
+}
+
+void TestQuantizedWrite()
+{
+  std::cout << "Creating quantized arrays of halves." << std::endl;
+  std::vector<dax::Scalar> input(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    input[index] = static_cast<dax::Scalar>(index) - 100;
+    }
+
+  dax::cont::ArrayHandle<dax::cont::Half> halves;
+  dax::cont::ArrayHandleQuantized<dax::cont::ArrayHandle<dax::cont::Half> >
+      quantized = dax::cont::make_ArrayHandleQuantized(halves);
+
+  std::cout << "Running worklet with quantized output." << std::endl;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(Negate(), dax::cont::make_ArrayHandle(input), quantized);
+
+  DAX_TEST_ASSERT(halves.GetNumberOfValues() == ARRAY_SIZE,
+                  "Storage array has wrong size.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(quantized.GetPortalConstControl().Get(index)
+                    == -input[index],
+                    "Quantized output has unexpected value.");
+    }
+
+  std::cout << "Checking clamping of bytes." << std::endl;
+  typedef dax::cont::internal::QuantizedValueTraits<unsigned char> Traits;
+  DAX_TEST_ASSERT(Traits::Encode(-20) == 0, "Bad clamp.");
+  DAX_TEST_ASSERT(Traits::Encode(99.6f) == 100, "Bad round.");
+  DAX_TEST_ASSERT(Traits::Encode(300) == 255, "Bad clamp.");
+}
+
+void TestQuantized()
+{
+  TestHalfConversion();
+  TestQuantizedRead();
+  TestQuantizedWrite();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleQuantized(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestQuantized);
+}
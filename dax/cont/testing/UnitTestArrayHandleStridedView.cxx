@@ -0,0 +1,201 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleStridedView.h>
+
+#include <dax/cont/arg/FieldArrayHandleStridedView.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+// The parent is seen as a 10x8x5 block.
+const dax::Id3 PARENT_DIMENSIONS = dax::make_Id3(10, 8, 5);
+const dax::Id ARRAY_SIZE = 10*8*5;
+
+typedef dax::cont::ArrayHandle<dax::Scalar> ScalarArrayHandle;
+typedef dax::cont::ArrayHandleStridedView<ScalarArrayHandle>
+    ScalarStridedViewHandle;
+
+struct Square : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT
+  dax::Scalar operator()(dax::Scalar value) const
+  {
+    return value*value;
+  }
+};
+
+ScalarArrayHandle MakeParent()
+{
+  std::vector<dax::Scalar> buffer(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    buffer[index] = static_cast<dax::Scalar>(index);
+    }
+  ScalarArrayHandle parent;
+  dax::cont::internal::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+      ::Copy(dax::cont::make_ArrayHandle(buffer), parent);
+  return parent;
+}
+
+// Every other value in x and every third in z of the block starting at
+// (1, 2, 0).
+ScalarStridedViewHandle MakeView(ScalarArrayHandle parent)
+{
+  return dax::cont::make_ArrayHandleStridedView(
+        parent,
+        1 + 2*PARENT_DIMENSIONS[0],
+        dax::make_Id3(4, 3, 2),
+        dax::make_Id3(2,
+                      PARENT_DIMENSIONS[0],
+                      3*PARENT_DIMENSIONS[0]*PARENT_DIMENSIONS[1]));
+}
+
+dax::Id ExpectedParentIndex(dax::Id index)
+{
+  const dax::Id i = index % 4;
+  const dax::Id j = (index / 4) % 3;
+  const dax::Id k = index / 12;
+  return (1 + 2*i)
+      + PARENT_DIMENSIONS[0]*((2 + j) + PARENT_DIMENSIONS[1]*(3*k));
+}
+
+void TestStridedViewRead()
+{
+  std::cout << "Creating strided view of array." << std::endl;
+  ScalarArrayHandle parent = MakeParent();
+  ScalarStridedViewHandle view = MakeView(parent);
+  DAX_TEST_ASSERT(view.GetNumberOfValues() == 24, "View has wrong size.");
+
+  std::cout << "Checking control portal." << std::endl;
+  for (dax::Id index = 0; index < 24; index++)
+    {
+    DAX_TEST_ASSERT(view.GetPortalConstControl().Get(index)
+                    == ExpectedParentIndex(index),
+                    "Control portal has unexpected value.");
+    }
+
+  std::cout << "Checking execution portal." << std::endl;
+  ScalarStridedViewHandle::PortalConstExecution portal =
+      view.PrepareForInput();
+  DAX_TEST_ASSERT(portal.GetNumberOfValues() == 24,
+                  "Execution portal has wrong size.");
+  for (dax::Id index = 0; index < 24; index++)
+    {
+    DAX_TEST_ASSERT(portal.Get(index) == ExpectedParentIndex(index),
+                    "Execution portal has unexpected value.");
+    }
+
+  std::vector<dax::Scalar> copied(24);
+  view.CopyInto(copied.begin());
+  for (dax::Id index = 0; index < 24; index++)
+    {
+    DAX_TEST_ASSERT(copied[index] == ExpectedParentIndex(index),
+                    "CopyInto has unexpected value.");
+    }
+}
+
+void TestStridedViewWorklets()
+{
+  ScalarArrayHandle input = MakeParent();
+  ScalarArrayHandle parent = MakeParent();
+
+  std::cout << "Running worklet into a strided view." << std::endl;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(Square(), MakeView(input), MakeView(parent));
+
+  DAX_TEST_ASSERT(parent.GetNumberOfValues() == ARRAY_SIZE,
+                  "Parent array was resized.");
+  std::vector<bool> inView(ARRAY_SIZE, false);
+  for (dax::Id index = 0; index < 24; index++)
+    {
+    inView[ExpectedParentIndex(index)] = true;
+    }
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    const dax::Scalar expected =
+        inView[index] ? static_cast<dax::Scalar>(index*index)
+                      : static_cast<dax::Scalar>(index);
+    DAX_TEST_ASSERT(parent.GetPortalConstControl().Get(index) == expected,
+                    "Parent has unexpected value.");
+    }
+
+  std::cout << "Writing through control portal." << std::endl;
+  ScalarStridedViewHandle view = MakeView(parent);
+  view.GetPortalControl().Set(5, -1);
+  DAX_TEST_ASSERT(parent.GetPortalConstControl().Get(ExpectedParentIndex(5))
+                  == -1,
+                  "Control write did not reach parent.");
+  DAX_TEST_ASSERT(view.PrepareForInput().Get(5) == -1,
+                  "Execution portal did not see control write.");
+}
+
+void TestStridedViewErrors()
+{
+  ScalarArrayHandle parent = MakeParent();
+
+  std::cout << "Checking view outside of parent." << std::endl;
+  try
+    {
+    dax::cont::make_ArrayHandleStridedView(parent,
+                                           0,
+                                           dax::make_Id3(10, 8, 6),
+                                           dax::make_Id3(1, 10, 80));
+    DAX_TEST_FAIL("Created strided view past end of array.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+
+  std::cout << "Checking output of the wrong size." << std::endl;
+  ScalarStridedViewHandle view = MakeView(parent);
+  try
+    {
+    view.PrepareForOutput(23);
+    DAX_TEST_FAIL("Resized strided view.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestStridedView()
+{
+  TestStridedViewRead();
+  TestStridedViewWorklets();
+  TestStridedViewErrors();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleStridedView(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestStridedView);
+}
@@ -0,0 +1,167 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleUserMemory.h>
+
+#include <dax/cont/arg/FieldArrayHandleUserMemory.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 64;
+const dax::Id CAPACITY = 100;
+
+struct Square : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT
+  dax::Scalar operator()(dax::Scalar value) const
+  {
+    return value*value;
+  }
+};
+
+struct Increment : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In,Out));
+  typedef void ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Scalar &value) const
+  {
+    value = value + 1;
+  }
+};
+
+int NumberOfDeletes = 0;
+
+void CountingDelete(dax::Scalar *array)
+{
+  NumberOfDeletes++;
+  delete[] array;
+}
+
+void TestOutputIntoUserMemory()
+{
+  std::cout << "Writing worklet output into user memory." << std::endl;
+  std::vector<dax::Scalar> input(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    input[index] = static_cast<dax::Scalar>(index);
+    }
+
+  std::vector<dax::Scalar> simulationBuffer(CAPACITY, -1);
+  dax::cont::ArrayHandleUserMemory<dax::Scalar> output =
+      dax::cont::make_ArrayHandleUserMemory(&simulationBuffer.front(),
+                                            0,
+                                            CAPACITY);
+  DAX_TEST_ASSERT(output.GetCapacity() == CAPACITY, "Bad capacity.");
+
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(Square(), dax::cont::make_ArrayHandle(input), output);
+
+  DAX_TEST_ASSERT(output.GetNumberOfValues() == ARRAY_SIZE,
+                  "Output has wrong size.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(simulationBuffer[index] == index*index,
+                    "Output not written to user memory.");
+    }
+  DAX_TEST_ASSERT(simulationBuffer[ARRAY_SIZE] == -1,
+                  "Output written past its size.");
+  DAX_TEST_ASSERT(output.GetPortalConstControl().GetIteratorBegin()
+                  == &simulationBuffer.front(),
+                  "Control portal does not point to user memory.");
+
+  std::cout << "Modifying user memory in place." << std::endl;
+  scheduler.Invoke(Increment(), output);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(simulationBuffer[index] == index*index + 1,
+                    "In place result not written to user memory.");
+    }
+
+  std::cout << "Writing through control portal." << std::endl;
+  output.GetPortalControl().Set(0, 42);
+  DAX_TEST_ASSERT(simulationBuffer[0] == 42, "Control write not in buffer.");
+}
+
+void TestCapacity()
+{
+  std::cout << "Checking capacity limit." << std::endl;
+  std::vector<dax::Scalar> buffer(ARRAY_SIZE);
+  dax::cont::ArrayHandleUserMemory<dax::Scalar> array =
+      dax::cont::make_ArrayHandleUserMemory(&buffer.front(), ARRAY_SIZE);
+  try
+    {
+    array.PrepareForOutput(ARRAY_SIZE + 1);
+    DAX_TEST_FAIL("Allocated past the capacity of user memory.");
+    }
+  catch (dax::cont::ErrorControlOutOfMemory error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+
+  try
+    {
+    dax::cont::make_ArrayHandleUserMemory(&buffer.front(), 10, 5);
+    DAX_TEST_FAIL("Created user memory with more values than capacity.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestOwnership()
+{
+  std::cout << "Checking ownership of user memory." << std::endl;
+  NumberOfDeletes = 0;
+  {
+    dax::cont::ArrayHandleUserMemory<dax::Scalar> owner(
+          new dax::Scalar[ARRAY_SIZE], ARRAY_SIZE, ARRAY_SIZE, CountingDelete);
+    dax::cont::ArrayHandleUserMemory<dax::Scalar> copy = owner;
+    copy.ReleaseResources();
+    DAX_TEST_ASSERT(NumberOfDeletes == 0, "Memory released too soon.");
+  }
+  DAX_TEST_ASSERT(NumberOfDeletes == 1,
+                  "Owned memory not released exactly once.");
+}
+
+void TestUserMemory()
+{
+  TestOutputIntoUserMemory();
+  TestCapacity();
+  TestOwnership();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleUserMemory(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestUserMemory);
+}
@@ -0,0 +1,194 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleView.h>
+
+#include <dax/cont/arg/FieldArrayHandleView.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 100;
+const dax::Id VIEW_START = 20;
+const dax::Id VIEW_LENGTH = 50;
+
+typedef dax::cont::ArrayHandle<dax::Scalar> ScalarArrayHandle;
+typedef dax::cont::ArrayHandleView<ScalarArrayHandle> ScalarViewHandle;
+
+struct Square : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT
+  dax::Scalar operator()(dax::Scalar value) const
+  {
+    return value*value;
+  }
+};
+
+ScalarArrayHandle MakeParent()
+{
+  std::vector<dax::Scalar> buffer(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    buffer[index] = static_cast<dax::Scalar>(index);
+    }
+  ScalarArrayHandle parent;
+  dax::cont::internal::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+      ::Copy(dax::cont::make_ArrayHandle(buffer), parent);
+  return parent;
+}
+
+void TestViewRead()
+{
+  std::cout << "Creating view of array." << std::endl;
+  ScalarArrayHandle parent = MakeParent();
+  ScalarViewHandle view =
+      dax::cont::make_ArrayHandleView(parent, VIEW_START, VIEW_LENGTH);
+  DAX_TEST_ASSERT(view.GetNumberOfValues() == VIEW_LENGTH,
+                  "View has wrong size.");
+
+  std::cout << "Checking control portal." << std::endl;
+  for (dax::Id index = 0; index < VIEW_LENGTH; index++)
+    {
+    DAX_TEST_ASSERT(view.GetPortalConstControl().Get(index)
+                    == VIEW_START + index,
+                    "Control portal has unexpected value.");
+    }
+
+  std::cout << "Checking execution portal." << std::endl;
+  ScalarViewHandle::PortalConstExecution portal = view.PrepareForInput();
+  DAX_TEST_ASSERT(portal.GetNumberOfValues() == VIEW_LENGTH,
+                  "Execution portal has wrong size.");
+  DAX_TEST_ASSERT(
+        portal.GetIteratorBegin()
+        == parent.PrepareForInput().GetIteratorBegin() + VIEW_START,
+        "Execution portal does not point into the parent array.");
+  for (dax::Id index = 0; index < VIEW_LENGTH; index++)
+    {
+    DAX_TEST_ASSERT(portal.Get(index) == VIEW_START + index,
+                    "Execution portal has unexpected value.");
+    }
+
+  std::cout << "Checking view of view." << std::endl;
+  dax::cont::ArrayHandleView<ScalarViewHandle> subview =
+      dax::cont::make_ArrayHandleView(view, 10, 5);
+  for (dax::Id index = 0; index < 5; index++)
+    {
+    DAX_TEST_ASSERT(subview.GetPortalConstControl().Get(index)
+                    == VIEW_START + 10 + index,
+                    "View of view has unexpected value.");
+    }
+}
+
+void TestViewWorklets()
+{
+  ScalarArrayHandle parent = MakeParent();
+
+  std::cout << "Running worklet from one half of an array to the other."
+            << std::endl;
+  const dax::Id half = ARRAY_SIZE/2;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(Square(),
+                   dax::cont::make_ArrayHandleView(parent, 0, half),
+                   dax::cont::make_ArrayHandleView(parent, half, half));
+
+  DAX_TEST_ASSERT(parent.GetNumberOfValues() == ARRAY_SIZE,
+                  "Parent array was resized.");
+  for (dax::Id index = 0; index < half; index++)
+    {
+    DAX_TEST_ASSERT(parent.GetPortalConstControl().Get(index) == index,
+                    "Input half of parent was modified.");
+    DAX_TEST_ASSERT(parent.GetPortalConstControl().Get(half + index)
+                    == index*index,
+                    "Output half of parent has unexpected value.");
+    }
+
+  std::cout << "Sorting a window in place." << std::endl;
+  ScalarViewHandle window = dax::cont::make_ArrayHandleView(parent, 40, 20);
+  dax::cont::internal::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+      ::Sort(window);
+  for (dax::Id index = 1; index < 20; index++)
+    {
+    DAX_TEST_ASSERT(window.GetPortalConstControl().Get(index-1)
+                    <= window.GetPortalConstControl().Get(index),
+                    "Window not sorted.");
+    }
+  DAX_TEST_ASSERT(parent.GetPortalConstControl().Get(39) == 39,
+                  "Sort went before window.");
+  DAX_TEST_ASSERT(parent.GetPortalConstControl().Get(60) == 100,
+                  "Sort went past window.");
+
+  std::cout << "Writing through control portal." << std::endl;
+  window.GetPortalControl().Set(0, -1);
+  DAX_TEST_ASSERT(parent.GetPortalConstControl().Get(40) == -1,
+                  "Control write did not reach parent.");
+  DAX_TEST_ASSERT(window.PrepareForInput().Get(0) == -1,
+                  "Execution portal did not see control write.");
+}
+
+void TestViewErrors()
+{
+  ScalarArrayHandle parent = MakeParent();
+
+  std::cout << "Checking window outside of parent." << std::endl;
+  try
+    {
+    dax::cont::make_ArrayHandleView(parent, ARRAY_SIZE - 10, 20);
+    DAX_TEST_FAIL("Created view past end of array.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+
+  std::cout << "Checking output larger than window." << std::endl;
+  ScalarViewHandle view =
+      dax::cont::make_ArrayHandleView(parent, VIEW_START, VIEW_LENGTH);
+  try
+    {
+    view.PrepareForOutput(VIEW_LENGTH + 1);
+    DAX_TEST_FAIL("Grew view past its window.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestView()
+{
+  TestViewRead();
+  TestViewWorklets();
+  TestViewErrors();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleView(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestView);
+}
@@ -0,0 +1,226 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/BrickRangeIndex.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/GenerateInterpolatedCells.h>
+#include <dax/cont/GenerateTopology.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/math/Exp.h>
+#include <dax/worklet/MarchingCubes.h>
+#include <dax/worklet/Threshold.h>
+
+#include <dax/cont/internal/testing/TestingGridGenerator.h>
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// Not a multiple of the brick size so that the last bricks are partial.
+const dax::Id DIM = 30;
+const dax::Id BRICK_SIZE = 8;
+
+typedef dax::cont::ArrayHandle<dax::Id> IdArrayType;
+typedef dax::cont::UnstructuredGrid<dax::CellTagTriangle> TriangleGridType;
+typedef dax::cont::UnstructuredGrid<dax::CellTagHexahedron> HexahedronGridType;
+
+template<typename T>
+void CheckEqual(dax::cont::ArrayHandle<T> result,
+                dax::cont::ArrayHandle<T> expected)
+{
+  DAX_TEST_ASSERT(result.GetNumberOfValues()
+                  == expected.GetNumberOfValues(),
+                  "Accelerated result has the wrong size.");
+  std::vector<T> resultValues = dax::cont::internal::GetArrayValues(result);
+  std::vector<T> expectedValues =
+      dax::cont::internal::GetArrayValues(expected);
+  for (std::size_t index = 0; index < resultValues.size(); index++)
+    {
+    DAX_TEST_ASSERT(test_equal(resultValues[index], expectedValues[index]),
+                    "Accelerated result differs from full result.");
+    }
+}
+
+void CheckCandidates(IdArrayType candidates,
+                     IdArrayType classification,
+                     dax::Id numberOfCells)
+{
+  std::vector<dax::Id> cellIds =
+      dax::cont::internal::GetArrayValues(candidates);
+  std::sort(cellIds.begin(), cellIds.end());
+  DAX_TEST_ASSERT(std::adjacent_find(cellIds.begin(), cellIds.end())
+                  == cellIds.end(),
+                  "A cell is listed more than once.");
+  DAX_TEST_ASSERT(cellIds.empty() || (cellIds.front() >= 0
+                                      && cellIds.back() < numberOfCells),
+                  "Cell id out of range.");
+
+  std::vector<dax::Id> counts =
+      dax::cont::internal::GetArrayValues(classification);
+  for (dax::Id cellId = 0; cellId < numberOfCells; cellId++)
+    {
+    if (counts[cellId] > 0)
+      {
+      DAX_TEST_ASSERT(std::binary_search(cellIds.begin(), cellIds.end(),
+                                         cellId),
+                      "An active cell is missing from the candidates.");
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestBrickRangeIndex()
+{
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(DIM-1, DIM-1, DIM-1));
+
+  // Distance from a corner, so small values only cover a few bricks.
+  std::vector<dax::Scalar> fieldValues(grid.GetNumberOfPoints());
+  for (dax::Id index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    dax::Vector3 coordinates = grid.ComputePointCoordinates(index);
+    fieldValues[index] = dax::math::Sqrt(dax::dot(coordinates, coordinates));
+    }
+  dax::cont::ArrayHandle<dax::Scalar> field =
+      dax::cont::make_ArrayHandle(fieldValues);
+
+  dax::cont::BrickRangeIndex<> index(grid, field, BRICK_SIZE);
+  DAX_TEST_ASSERT(index.GetNumberOfBricks() == 4*4*4,
+                  "Wrong number of bricks.");
+
+  dax::cont::Scheduler<> scheduler;
+
+  std::cout << "Test isovalue queries." << std::endl;
+  const dax::Scalar isovalues[] = { 5.5f, 12.5f, 40.0f };
+  for (int isoIndex = 0; isoIndex < 3; isoIndex++)
+    {
+    const dax::Scalar isovalue = isovalues[isoIndex];
+    std::cout << "  isovalue " << isovalue << std::endl;
+
+    IdArrayType candidates;
+    const dax::Id numberOfCandidates =
+        index.GetCellsContaining(isovalue, candidates);
+    DAX_TEST_ASSERT(numberOfCandidates == candidates.GetNumberOfValues(),
+                    "Wrong number of candidates returned.");
+    DAX_TEST_ASSERT(numberOfCandidates < grid.GetNumberOfCells(),
+                    "The index did not skip any cell.");
+
+    dax::worklet::MarchingCubesClassify classifyWorklet(isovalue);
+    dax::worklet::MarchingCubesTopology topologyWorklet(isovalue);
+
+    IdArrayType classification;
+    scheduler.Invoke(classifyWorklet, grid, field, classification);
+    CheckCandidates(candidates, classification, grid.GetNumberOfCells());
+
+    IdArrayType candidateClassification;
+    scheduler.Invoke(classifyWorklet,
+                     dax::cont::make_Permutation(candidates, grid,
+                                                 grid.GetNumberOfCells()),
+                     field,
+                     candidateClassification);
+    DAX_TEST_ASSERT(candidateClassification.GetNumberOfValues()
+                    == numberOfCandidates,
+                    "Classification of candidates has wrong size.");
+
+    typedef dax::cont::GenerateInterpolatedCells<
+        dax::worklet::MarchingCubesTopology> GenerateType;
+    GenerateType generate(classification, topologyWorklet);
+    TriangleGridType surface;
+    scheduler.Invoke(generate, grid, surface, field);
+
+    GenerateType generateCandidates(candidateClassification, topologyWorklet);
+    generateCandidates.SetInputCellIds(candidates);
+    TriangleGridType candidateSurface;
+    scheduler.Invoke(generateCandidates, grid, candidateSurface, field);
+
+    DAX_TEST_ASSERT(surface.GetNumberOfCells() > 0, "Surface is empty.");
+    DAX_TEST_ASSERT(candidateSurface.GetNumberOfCells()
+                    == surface.GetNumberOfCells(),
+                    "Accelerated surface has wrong number of triangles.");
+    // Merged points are sorted, so they come out in the same order.
+    CheckEqual(candidateSurface.GetPointCoordinates(),
+               surface.GetPointCoordinates());
+    }
+
+  std::cout << "Test range queries." << std::endl;
+  {
+  const dax::Scalar low = 3.0f;
+  const dax::Scalar high = 9.0f;
+  IdArrayType candidates;
+  index.GetCellsOverlapping(low, high, candidates);
+  DAX_TEST_ASSERT(candidates.GetNumberOfValues() < grid.GetNumberOfCells(),
+                  "The index did not skip any cell.");
+
+  dax::worklet::ThresholdClassify<dax::Scalar> classifyWorklet(low, high);
+
+  IdArrayType classification;
+  scheduler.Invoke(classifyWorklet, grid, field, classification);
+  CheckCandidates(candidates, classification, grid.GetNumberOfCells());
+
+  IdArrayType candidateClassification;
+  scheduler.Invoke(classifyWorklet,
+                   dax::cont::make_Permutation(candidates, grid,
+                                               grid.GetNumberOfCells()),
+                   field,
+                   candidateClassification);
+
+  typedef dax::cont::GenerateTopology<
+      dax::worklet::ThresholdTopology, IdArrayType> GenerateType;
+  GenerateType generate(classification);
+  HexahedronGridType thresholded;
+  scheduler.Invoke(generate, grid, thresholded);
+
+  GenerateType generateCandidates(candidateClassification);
+  generateCandidates.SetInputCellIds(candidates);
+  HexahedronGridType candidateThresholded;
+  scheduler.Invoke(generateCandidates, grid, candidateThresholded);
+
+  DAX_TEST_ASSERT(thresholded.GetNumberOfCells() > 0,
+                  "Threshold is empty.");
+  DAX_TEST_ASSERT(candidateThresholded.GetNumberOfCells()
+                  == thresholded.GetNumberOfCells(),
+                  "Accelerated threshold has wrong number of cells.");
+  // Kept points are compacted in input order either way.
+  CheckEqual(candidateThresholded.GetPointCoordinates(),
+             thresholded.GetPointCoordinates());
+  }
+
+  std::cout << "Test query outside of the field range." << std::endl;
+  {
+  IdArrayType candidates;
+  DAX_TEST_ASSERT(index.GetCellsContaining(-1.0f, candidates) == 0,
+                  "Found cells for a value outside the field.");
+  DAX_TEST_ASSERT(candidates.GetNumberOfValues() == 0,
+                  "Candidates not empty.");
+  }
+}
+
+} // anonymous namespace
+
+int UnitTestBrickRangeIndex(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestBrickRangeIndex);
+}
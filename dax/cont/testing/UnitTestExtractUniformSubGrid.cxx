@@ -0,0 +1,217 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ExtractUniformSubGrid.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <dax/worklet/CellAverage.h>
+
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+typedef dax::cont::ArrayHandle<dax::Scalar> ScalarArrayHandle;
+
+dax::cont::UniformGrid<> MakeGrid()
+{
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(-2, 0, 1), dax::make_Id3(9, 8, 7));
+  grid.SetOrigin(dax::make_Vector3(1.0f, -1.0f, 0.5f));
+  grid.SetSpacing(dax::make_Vector3(0.5f, 1.0f, 0.25f));
+  return grid;
+}
+
+template<typename IndexFunctor>
+ScalarArrayHandle MakeField(dax::Id size, IndexFunctor value)
+{
+  std::vector<dax::Scalar> buffer(size);
+  for (dax::Id index = 0; index < size; index++)
+    {
+    buffer[index] = value(index);
+    }
+  ScalarArrayHandle field;
+  dax::cont::internal::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+      ::Copy(dax::cont::make_ArrayHandle(buffer), field);
+  return field;
+}
+
+struct IndexValue
+{
+  dax::Scalar operator()(dax::Id index) const
+  {
+    return static_cast<dax::Scalar>(index);
+  }
+};
+
+//-----------------------------------------------------------------------------
+void TestExtract(const dax::Extent3 &voi, const dax::Id3 &sampleRate)
+{
+  std::cout << "Extracting a region with sample rate " << sampleRate[0]
+            << " " << sampleRate[1] << " " << sampleRate[2] << std::endl;
+
+  const dax::cont::UniformGrid<> grid = MakeGrid();
+  dax::cont::ExtractUniformSubGrid<> extract(grid, voi, sampleRate);
+  const dax::cont::UniformGrid<> &subGrid = extract.GetOutputGrid();
+  const dax::Extent3 &clipped = extract.GetVolumeOfInterest();
+
+  DAX_TEST_ASSERT(subGrid.GetExtent().Min == clipped.Min,
+                  "Sub grid extent does not start at the region.");
+  const dax::Id3 lastLocation = clipped.Min
+      + (subGrid.GetExtent().Max - clipped.Min) * sampleRate;
+  for (int dimension = 0; dimension < 3; dimension++)
+    {
+    DAX_TEST_ASSERT(lastLocation[dimension] <= clipped.Max[dimension]
+                    && lastLocation[dimension] + sampleRate[dimension]
+                       > clipped.Max[dimension],
+                    "Sub grid extent does not cover the region.");
+    }
+
+  std::cout << "Checking points." << std::endl;
+  ScalarArrayHandle pointField =
+      MakeField(grid.GetNumberOfPoints(), IndexValue());
+  dax::cont::ArrayHandleStridedView<ScalarArrayHandle> pointView =
+      extract.GetPointFieldView(pointField);
+  DAX_TEST_ASSERT(pointView.GetNumberOfValues()
+                  == subGrid.GetNumberOfPoints(),
+                  "Point view has wrong size.");
+  for (dax::Id pointIndex = 0;
+       pointIndex < subGrid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    const dax::Id3 subLocation = subGrid.ComputePointLocation(pointIndex);
+    const dax::Id3 location = clipped.Min
+        + (subLocation - clipped.Min) * sampleRate;
+    DAX_TEST_ASSERT(test_equal(subGrid.ComputePointCoordinates(pointIndex),
+                               grid.ComputePointCoordinates(location)),
+                    "Sub grid point has wrong coordinates.");
+    DAX_TEST_ASSERT(pointView.GetPortalConstControl().Get(pointIndex)
+                    == grid.ComputePointIndex(location),
+                    "Point view has wrong value.");
+    }
+
+  std::cout << "Checking cells." << std::endl;
+  ScalarArrayHandle cellField =
+      MakeField(grid.GetNumberOfCells(), IndexValue());
+  dax::cont::ArrayHandleStridedView<ScalarArrayHandle> cellView =
+      extract.GetCellFieldView(cellField);
+  DAX_TEST_ASSERT(cellView.GetNumberOfValues() == subGrid.GetNumberOfCells(),
+                  "Cell view has wrong size.");
+  for (dax::Id cellIndex = 0;
+       cellIndex < subGrid.GetNumberOfCells();
+       cellIndex++)
+    {
+    const dax::Id3 subLocation = subGrid.ComputeCellLocation(cellIndex);
+    const dax::Id3 location = clipped.Min
+        + (subLocation - clipped.Min) * sampleRate;
+    DAX_TEST_ASSERT(cellView.GetPortalConstControl().Get(cellIndex)
+                    == grid.ComputeCellIndex(location),
+                    "Cell view has wrong value.");
+    }
+
+  std::cout << "Running a cell worklet on the sub grid." << std::endl;
+  ScalarArrayHandle averages;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(dax::worklet::CellAverage(), subGrid, pointView, averages);
+  DAX_TEST_ASSERT(averages.GetNumberOfValues() == subGrid.GetNumberOfCells(),
+                  "Wrong number of averages.");
+  for (dax::Id cellIndex = 0;
+       cellIndex < subGrid.GetNumberOfCells();
+       cellIndex++)
+    {
+    // The field is linear in the point location, so the average is the
+    // value at the cell center.
+    const dax::Id3 subLocation = subGrid.ComputeCellLocation(cellIndex);
+    const dax::Id3 location = clipped.Min
+        + (subLocation - clipped.Min) * sampleRate;
+    const dax::Id3 farLocation = location + sampleRate;
+    const dax::Scalar expected = 0.5f*static_cast<dax::Scalar>(
+          grid.ComputePointIndex(location)
+          + grid.ComputePointIndex(farLocation));
+    DAX_TEST_ASSERT(test_equal(averages.GetPortalConstControl().Get(cellIndex),
+                               expected),
+                    "Wrong cell average on sub grid.");
+    }
+}
+
+void TestExtractErrors()
+{
+  const dax::cont::UniformGrid<> grid = MakeGrid();
+
+  std::cout << "Checking region outside of the grid." << std::endl;
+  try
+    {
+    dax::Extent3 voi;
+    voi.Min = dax::make_Id3(10, 0, 1);
+    voi.Max = dax::make_Id3(12, 8, 7);
+    dax::cont::ExtractUniformSubGrid<> extract(grid, voi);
+    DAX_TEST_FAIL("Extracted a region outside of the grid.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+
+  std::cout << "Checking field of the wrong size." << std::endl;
+  try
+    {
+    dax::cont::ExtractUniformSubGrid<> extract(grid, grid.GetExtent());
+    extract.GetPointFieldView(MakeField(grid.GetNumberOfCells(),
+                                        IndexValue()));
+    DAX_TEST_FAIL("Made a point view of a cell field.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestExtractUniformSubGrid()
+{
+  dax::Extent3 voi;
+
+  voi.Min = dax::make_Id3(0, 1, 2);
+  voi.Max = dax::make_Id3(6, 7, 5);
+  TestExtract(voi, dax::make_Id3(1, 1, 1));
+  TestExtract(voi, dax::make_Id3(2, 3, 1));
+
+  // Clipped to the extent of the grid.
+  voi.Min = dax::make_Id3(-5, -5, 3);
+  voi.Max = dax::make_Id3(20, 4, 20);
+  TestExtract(voi, dax::make_Id3(3, 2, 2));
+
+  // A slice, which has points but no cells.
+  voi.Min = dax::make_Id3(-2, 0, 4);
+  voi.Max = dax::make_Id3(9, 8, 4);
+  TestExtract(voi, dax::make_Id3(2, 2, 2));
+
+  TestExtractErrors();
+}
+
+} // anonymous namespace
+
+int UnitTestExtractUniformSubGrid(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestExtractUniformSubGrid);
+}
@@ -0,0 +1,187 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/InvocationGroup.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleView.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <dax/worklet/CellGradient.h>
+#include <dax/worklet/Elevation.h>
+#include <dax/worklet/Magnitude.h>
+#include <dax/worklet/Square.h>
+
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 16;
+
+template<typename T>
+void CheckEqual(dax::cont::ArrayHandle<T> result,
+                dax::cont::ArrayHandle<T> expected)
+{
+  DAX_TEST_ASSERT(result.GetNumberOfValues()
+                  == expected.GetNumberOfValues(),
+                  "Concurrent result has the wrong size.");
+  std::vector<T> resultValues(result.GetNumberOfValues());
+  std::vector<T> expectedValues(expected.GetNumberOfValues());
+  result.CopyInto(resultValues.begin());
+  expected.CopyInto(expectedValues.begin());
+  for (std::size_t index = 0; index < resultValues.size(); index++)
+    {
+    DAX_TEST_ASSERT(test_equal(resultValues[index], expectedValues[index]),
+                    "Concurrent result differs from scheduled result.");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestIndependentInvocations()
+{
+  std::cout << "Running independent invocations concurrently" << std::endl;
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(DIM-1, DIM-1, DIM-1));
+
+  std::vector<dax::Scalar> fieldValues(grid.GetNumberOfPoints());
+  for (dax::Id index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    fieldValues[index] = 0.01f*static_cast<dax::Scalar>(index);
+    }
+  dax::cont::ArrayHandle<dax::Scalar> field =
+      dax::cont::make_ArrayHandle(fieldValues);
+
+  dax::cont::ArrayHandle<dax::Scalar> expectedMagnitude;
+  dax::cont::ArrayHandle<dax::Scalar> expectedElevation;
+  dax::cont::ArrayHandle<dax::Vector3> expectedGradient;
+  dax::cont::ArrayHandle<dax::Scalar> expectedSquare;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(dax::worklet::Magnitude(),
+                   grid.GetPointCoordinates(), expectedMagnitude);
+  scheduler.Invoke(dax::worklet::Elevation(),
+                   grid.GetPointCoordinates(), expectedElevation);
+  scheduler.Invoke(dax::worklet::CellGradient(),
+                   grid, grid.GetPointCoordinates(), field, expectedGradient);
+  scheduler.Invoke(dax::worklet::Square(), field, expectedSquare);
+
+  dax::cont::ArrayHandle<dax::Scalar> magnitude;
+  dax::cont::ArrayHandle<dax::Scalar> elevation;
+  dax::cont::ArrayHandle<dax::Vector3> gradient;
+  dax::cont::ArrayHandle<dax::Scalar> square;
+  dax::cont::InvocationGroup<> group;
+  group.Add(dax::worklet::Magnitude(), grid.GetPointCoordinates(), magnitude);
+  group.Add(dax::worklet::Elevation(), grid.GetPointCoordinates(), elevation);
+  group.Add(dax::worklet::CellGradient(),
+            grid, grid.GetPointCoordinates(), field, gradient);
+  group.Add(dax::worklet::Square(), field, square);
+  DAX_TEST_ASSERT(group.GetNumberOfInvocations() == 4,
+                  "Invocations not added.");
+  DAX_TEST_ASSERT(magnitude.GetNumberOfValues() == 0,
+                  "Group ran before it was scheduled.");
+
+  scheduler.InvokeConcurrently(group);
+  DAX_TEST_ASSERT(group.GetNumberOfInvocations() == 0,
+                  "Group not emptied.");
+
+  CheckEqual(magnitude, expectedMagnitude);
+  CheckEqual(elevation, expectedElevation);
+  CheckEqual(gradient, expectedGradient);
+  CheckEqual(square, expectedSquare);
+}
+
+//-----------------------------------------------------------------------------
+void TestDependentInvocations()
+{
+  std::cout << "Rejecting dependent invocations" << std::endl;
+  std::vector<dax::Scalar> values(100, 2.0f);
+  dax::cont::ArrayHandle<dax::Scalar> input =
+      dax::cont::make_ArrayHandle(values);
+  dax::cont::ArrayHandle<dax::Scalar> square;
+  dax::cont::ArrayHandle<dax::Scalar> fourth;
+
+  dax::cont::InvocationGroup<> group;
+  group.Add(dax::worklet::Square(), input, square);
+  group.Add(dax::worklet::Square(), square, fourth);
+
+  dax::cont::Scheduler<> scheduler;
+  try
+    {
+    scheduler.InvokeConcurrently(group);
+    DAX_TEST_FAIL("Dependent invocations were run concurrently.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+  DAX_TEST_ASSERT(square.GetNumberOfValues() == 0,
+                  "Invocation of a rejected group ran.");
+}
+
+//-----------------------------------------------------------------------------
+void TestAliasedInvocations()
+{
+  std::cout << "Rejecting invocations sharing an array through a view"
+            << std::endl;
+  std::vector<dax::Scalar> values(100, 2.0f);
+  dax::cont::ArrayHandle<dax::Scalar> input =
+      dax::cont::make_ArrayHandle(values);
+  dax::cont::ArrayHandle<dax::Scalar> parent;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(dax::worklet::Square(), input, parent);
+  dax::cont::ArrayHandle<dax::Scalar> square;
+
+  dax::cont::InvocationGroup<> group;
+  group.Add(dax::worklet::Square(),
+            input,
+            dax::cont::make_ArrayHandleView(parent, 25, 50));
+  group.Add(dax::worklet::Square(), parent, square);
+
+  try
+    {
+    scheduler.InvokeConcurrently(group);
+    DAX_TEST_FAIL("Invocations writing and reading the same array through "
+                  "a view were run concurrently.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+  DAX_TEST_ASSERT(square.GetNumberOfValues() == 0,
+                  "Invocation of a rejected group ran.");
+}
+
+//-----------------------------------------------------------------------------
+void TestInvocationGroup()
+{
+  TestIndependentInvocations();
+  TestDependentInvocations();
+  TestAliasedInvocations();
+}
+
+} // anonymous namespace
+
+int UnitTestInvocationGroup(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestInvocationGroup);
+}
@@ -0,0 +1,195 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/MultiBlockUniformGrid.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <dax/worklet/CellAverage.h>
+#include <dax/worklet/CellGradient.h>
+
+#include <dax/cont/internal/testing/TestingGridGenerator.h>
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id NUMBER_OF_BLOCKS = 5;
+
+dax::cont::UniformGrid<> MakeBlock(dax::Id blockIndex)
+{
+  // Blocks of different sizes, some with extents not starting at 0.
+  dax::cont::UniformGrid<> block;
+  block.SetExtent(dax::make_Id3(blockIndex, 0, -1),
+                  dax::make_Id3(2*blockIndex + 2, 3, blockIndex + 1));
+  block.SetOrigin(dax::make_Vector3(10.0f*blockIndex, 0.0f, 0.0f));
+  block.SetSpacing(dax::make_Vector3(0.5f, 1.0f, 0.25f*(blockIndex+1)));
+  return block;
+}
+
+//-----------------------------------------------------------------------------
+void TestMultiBlockUniformGrid()
+{
+  dax::cont::MultiBlockUniformGrid<> grid;
+  for (dax::Id blockIndex = 0; blockIndex < NUMBER_OF_BLOCKS; blockIndex++)
+    {
+    DAX_TEST_ASSERT(grid.AddBlock(MakeBlock(blockIndex)) == blockIndex,
+                    "Wrong index for added block.");
+    }
+
+  std::cout << "Test basic information." << std::endl;
+  DAX_TEST_ASSERT(grid.GetNumberOfBlocks() == NUMBER_OF_BLOCKS,
+                  "Wrong number of blocks.");
+  dax::Id numberOfPoints = 0;
+  dax::Id numberOfCells = 0;
+  for (dax::Id blockIndex = 0; blockIndex < NUMBER_OF_BLOCKS; blockIndex++)
+    {
+    DAX_TEST_ASSERT(grid.GetPointOffset(blockIndex) == numberOfPoints,
+                    "Wrong point offset.");
+    DAX_TEST_ASSERT(grid.GetCellOffset(blockIndex) == numberOfCells,
+                    "Wrong cell offset.");
+    numberOfPoints += grid.GetBlock(blockIndex).GetNumberOfPoints();
+    numberOfCells += grid.GetBlock(blockIndex).GetNumberOfCells();
+    }
+  DAX_TEST_ASSERT(grid.GetNumberOfPoints() == numberOfPoints,
+                  "Wrong number of points.");
+  DAX_TEST_ASSERT(grid.GetNumberOfCells() == numberOfCells,
+                  "Wrong number of cells.");
+
+  std::cout << "Test cell connections." << std::endl;
+  dax::cont::MultiBlockUniformGrid<>::TopologyStructConstExecution topology =
+      grid.PrepareForInput();
+  DAX_TEST_ASSERT(topology.GetNumberOfCells() == numberOfCells,
+                  "Topology has wrong number of cells.");
+  DAX_TEST_ASSERT(topology.GetNumberOfPoints() == numberOfPoints,
+                  "Topology has wrong number of points.");
+  for (dax::Id blockIndex = 0; blockIndex < NUMBER_OF_BLOCKS; blockIndex++)
+    {
+    const dax::cont::UniformGrid<> &block = grid.GetBlock(blockIndex);
+    dax::cont::UniformGrid<>::TopologyStructConstExecution blockTopology =
+        block.PrepareForInput();
+    for (dax::Id cellIndex = 0;
+         cellIndex < block.GetNumberOfCells();
+         cellIndex++)
+      {
+      dax::exec::CellVertices<dax::CellTagVoxel> blockVertices =
+          blockTopology.GetCellConnections(cellIndex);
+      dax::exec::CellVertices<dax::CellTagVoxel> vertices =
+          topology.GetCellConnections(grid.GetCellOffset(blockIndex)
+                                      + cellIndex);
+      for (int vertex = 0; vertex < blockVertices.NUM_VERTICES; vertex++)
+        {
+        DAX_TEST_ASSERT(vertices[vertex]
+                        == (grid.GetPointOffset(blockIndex)
+                            + blockVertices[vertex]),
+                        "Multi-block connections differ from block.");
+        }
+      }
+    }
+
+  std::cout << "Test point coordinates." << std::endl;
+  std::vector<dax::Vector3> coordinateValues =
+      dax::cont::internal::GetArrayValues(grid.GetPointCoordinates());
+  DAX_TEST_ASSERT(static_cast<dax::Id>(coordinateValues.size())
+                  == numberOfPoints,
+                  "Wrong number of point coordinates.");
+  for (dax::Id blockIndex = 0; blockIndex < NUMBER_OF_BLOCKS; blockIndex++)
+    {
+    const dax::cont::UniformGrid<> &block = grid.GetBlock(blockIndex);
+    for (dax::Id pointIndex = 0;
+         pointIndex < block.GetNumberOfPoints();
+         pointIndex++)
+      {
+      DAX_TEST_ASSERT(
+            coordinateValues[grid.GetPointOffset(blockIndex) + pointIndex]
+            == block.ComputePointCoordinates(pointIndex),
+            "Wrong point coordinates.");
+      }
+    }
+
+  std::cout << "Test scheduling over all blocks." << std::endl;
+  std::vector<dax::Scalar> fieldValues(numberOfPoints);
+  for (dax::Id index = 0; index < numberOfPoints; index++)
+    {
+    fieldValues[index] = static_cast<dax::Scalar>(index % 17);
+    }
+  dax::cont::ArrayHandle<dax::Scalar> field =
+      dax::cont::make_ArrayHandle(fieldValues);
+  dax::cont::ArrayHandle<dax::Vector3> coordinates =
+      dax::cont::make_ArrayHandle(coordinateValues);
+  dax::cont::ArrayHandle<dax::Scalar> average;
+  dax::cont::ArrayHandle<dax::Vector3> gradient;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(dax::worklet::CellAverage(), grid, field, average);
+  scheduler.Invoke(dax::worklet::CellGradient(),
+                   grid, coordinates, field, gradient);
+  DAX_TEST_ASSERT(average.GetNumberOfValues() == numberOfCells,
+                  "Cell field has wrong size.");
+  std::vector<dax::Scalar> averageValues =
+      dax::cont::internal::GetArrayValues(average);
+  std::vector<dax::Vector3> gradientValues =
+      dax::cont::internal::GetArrayValues(gradient);
+
+  for (dax::Id blockIndex = 0; blockIndex < NUMBER_OF_BLOCKS; blockIndex++)
+    {
+    const dax::cont::UniformGrid<> &block = grid.GetBlock(blockIndex);
+    dax::cont::ArrayHandle<dax::Scalar> blockField =
+        dax::cont::make_ArrayHandle(
+          &fieldValues[grid.GetPointOffset(blockIndex)],
+          block.GetNumberOfPoints());
+    dax::cont::ArrayHandle<dax::Vector3> blockCoordinates =
+        dax::cont::make_ArrayHandle(
+          &coordinateValues[grid.GetPointOffset(blockIndex)],
+          block.GetNumberOfPoints());
+    dax::cont::ArrayHandle<dax::Scalar> blockAverage;
+    dax::cont::ArrayHandle<dax::Vector3> blockGradient;
+    scheduler.Invoke(dax::worklet::CellAverage(),
+                     block, blockField, blockAverage);
+    scheduler.Invoke(dax::worklet::CellGradient(),
+                     block, blockCoordinates, blockField,
+                     blockGradient);
+    std::vector<dax::Scalar> blockAverageValues =
+        dax::cont::internal::GetArrayValues(blockAverage);
+    std::vector<dax::Vector3> blockGradientValues =
+        dax::cont::internal::GetArrayValues(blockGradient);
+    for (dax::Id cellIndex = 0;
+         cellIndex < block.GetNumberOfCells();
+         cellIndex++)
+      {
+      const dax::Id globalIndex = grid.GetCellOffset(blockIndex) + cellIndex;
+      DAX_TEST_ASSERT(test_equal(averageValues[globalIndex],
+                                 blockAverageValues[cellIndex]),
+                      "Multi-block average differs from block.");
+      DAX_TEST_ASSERT(test_equal(gradientValues[globalIndex],
+                                 blockGradientValues[cellIndex]),
+                      "Multi-block gradient differs from block.");
+      }
+    }
+}
+
+} // anonymous namespace
+
+int UnitTestMultiBlockUniformGrid(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestMultiBlockUniformGrid);
+}
@@ -0,0 +1,245 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/Pipeline.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <dax/worklet/CellAverage.h>
+#include <dax/worklet/Cosine.h>
+#include <dax/worklet/Sine.h>
+#include <dax/worklet/Square.h>
+
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+// Not a multiple of the pipeline block size.
+const dax::Id ARRAY_SIZE = 5000;
+const dax::Id SMALL_ARRAY_SIZE = 300;
+// Several pipeline chunks, the last one partial.
+const dax::Id CHUNKED_ARRAY_SIZE = 3*DAX_PIPELINE_CHUNK_SIZE + 123;
+const dax::Id DIM = 16;
+
+typedef dax::cont::ArrayHandle<dax::Scalar> ScalarArrayHandle;
+
+ScalarArrayHandle MakeInput(std::vector<dax::Scalar> &values, dax::Id size)
+{
+  values.resize(size);
+  for (dax::Id index = 0; index < size; index++)
+    {
+    values[index] = 0.001f*static_cast<dax::Scalar>(index);
+    }
+  return dax::cont::make_ArrayHandle(values);
+}
+
+void CheckEqual(ScalarArrayHandle result, ScalarArrayHandle expected)
+{
+  DAX_TEST_ASSERT(result.GetNumberOfValues()
+                  == expected.GetNumberOfValues(),
+                  "Pipeline result has the wrong size.");
+  std::vector<dax::Scalar> resultValues(result.GetNumberOfValues());
+  std::vector<dax::Scalar> expectedValues(expected.GetNumberOfValues());
+  result.CopyInto(resultValues.begin());
+  expected.CopyInto(expectedValues.begin());
+  for (std::size_t index = 0; index < resultValues.size(); index++)
+    {
+    DAX_TEST_ASSERT(test_equal(resultValues[index], expectedValues[index]),
+                    "Pipeline result differs from scheduled result.");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestChain(bool fusion, bool concurrency)
+{
+  std::cout << "Map field chain, fusion " << fusion
+            << ", concurrency " << concurrency << std::endl;
+  std::vector<dax::Scalar> inputValues;
+  ScalarArrayHandle input = MakeInput(inputValues, ARRAY_SIZE);
+
+  ScalarArrayHandle expected;
+  {
+  ScalarArrayHandle squared;
+  ScalarArrayHandle sine;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(dax::worklet::Square(), input, squared);
+  scheduler.Invoke(dax::worklet::Sine(), squared, sine);
+  scheduler.Invoke(dax::worklet::Cosine(), sine, expected);
+  }
+
+  ScalarArrayHandle result;
+  dax::cont::Pipeline<> pipeline;
+  pipeline.SetFusion(fusion);
+  pipeline.SetConcurrency(concurrency);
+  {
+  // The pipeline is the only owner of the intermediate arrays.
+  ScalarArrayHandle squared;
+  ScalarArrayHandle sine;
+  pipeline.Invoke(dax::worklet::Square(), input, squared);
+  pipeline.Invoke(dax::worklet::Sine(), squared, sine);
+  pipeline.Invoke(dax::worklet::Cosine(), sine, result);
+  }
+  DAX_TEST_ASSERT(pipeline.GetNumberOfInvocations() == 3,
+                  "Invocations not recorded.");
+  DAX_TEST_ASSERT(result.GetNumberOfValues() == 0,
+                  "Pipeline ran before Execute.");
+
+  pipeline.Execute();
+  DAX_TEST_ASSERT(pipeline.GetNumberOfInvocations() == 0,
+                  "Pipeline not emptied by Execute.");
+  CheckEqual(result, expected);
+}
+
+//-----------------------------------------------------------------------------
+void TestChunkedChain()
+{
+  std::cout << "Map field chain run in chunks" << std::endl;
+  std::vector<dax::Scalar> inputValues;
+  ScalarArrayHandle input = MakeInput(inputValues, CHUNKED_ARRAY_SIZE);
+
+  ScalarArrayHandle expectedSquared;
+  ScalarArrayHandle expected;
+  {
+  ScalarArrayHandle sine;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(dax::worklet::Square(), input, expectedSquared);
+  scheduler.Invoke(dax::worklet::Sine(), expectedSquared, sine);
+  scheduler.Invoke(dax::worklet::Cosine(), sine, expected);
+  }
+
+  // The calling code keeps squared, so it is written in full. Only the
+  // pipeline holds sine, which becomes a scratch array.
+  ScalarArrayHandle squared;
+  ScalarArrayHandle result;
+  dax::cont::Pipeline<> pipeline;
+  {
+  ScalarArrayHandle sine;
+  pipeline.Invoke(dax::worklet::Square(), input, squared);
+  pipeline.Invoke(dax::worklet::Sine(), squared, sine);
+  pipeline.Invoke(dax::worklet::Cosine(), sine, result);
+  }
+  pipeline.Execute();
+
+  CheckEqual(squared, expectedSquared);
+  CheckEqual(result, expected);
+}
+
+//-----------------------------------------------------------------------------
+void TestBranches(bool fusion, bool concurrency)
+{
+  std::cout << "Independent branches, fusion " << fusion
+            << ", concurrency " << concurrency << std::endl;
+  std::vector<dax::Scalar> inputValues;
+  ScalarArrayHandle input = MakeInput(inputValues, ARRAY_SIZE);
+  std::vector<dax::Scalar> smallInputValues;
+  ScalarArrayHandle smallInput = MakeInput(smallInputValues, SMALL_ARRAY_SIZE);
+
+  ScalarArrayHandle expectedSquare;
+  ScalarArrayHandle expectedSine;
+  ScalarArrayHandle expectedSmall;
+  ScalarArrayHandle expectedJoin;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(dax::worklet::Square(), input, expectedSquare);
+  scheduler.Invoke(dax::worklet::Sine(), input, expectedSine);
+  scheduler.Invoke(dax::worklet::Cosine(), smallInput, expectedSmall);
+  scheduler.Invoke(dax::worklet::Square(), expectedSine, expectedJoin);
+
+  ScalarArrayHandle square;
+  ScalarArrayHandle sine;
+  ScalarArrayHandle small;
+  ScalarArrayHandle join;
+  dax::cont::Pipeline<> pipeline;
+  pipeline.SetFusion(fusion);
+  pipeline.SetConcurrency(concurrency);
+  pipeline.Invoke(dax::worklet::Square(), input, square);
+  pipeline.Invoke(dax::worklet::Sine(), input, sine);
+  pipeline.Invoke(dax::worklet::Cosine(), smallInput, small);
+  pipeline.Invoke(dax::worklet::Square(), sine, join);
+  pipeline.Execute();
+
+  CheckEqual(square, expectedSquare);
+  CheckEqual(sine, expectedSine);
+  CheckEqual(small, expectedSmall);
+  CheckEqual(join, expectedJoin);
+}
+
+//-----------------------------------------------------------------------------
+void TestCells()
+{
+  std::cout << "Map field into map cell" << std::endl;
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(DIM-1, DIM-1, DIM-1));
+  std::vector<dax::Scalar> inputValues;
+  ScalarArrayHandle input = MakeInput(inputValues, grid.GetNumberOfPoints());
+
+  ScalarArrayHandle expectedSine;
+  ScalarArrayHandle expectedAverage;
+  ScalarArrayHandle expectedSquare;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(dax::worklet::Sine(), input, expectedSine);
+  scheduler.Invoke(dax::worklet::CellAverage(),
+                   grid, expectedSine, expectedAverage);
+  scheduler.Invoke(dax::worklet::Square(), expectedAverage, expectedSquare);
+
+  ScalarArrayHandle sine;
+  ScalarArrayHandle average;
+  ScalarArrayHandle square;
+  ScalarArrayHandle otherSquare;
+  dax::cont::Pipeline<> pipeline;
+  pipeline.Invoke(dax::worklet::Sine(), input, sine);
+  pipeline.Invoke(dax::worklet::CellAverage(), grid, sine, average);
+  pipeline.Invoke(dax::worklet::Square(), average, square);
+  pipeline.Invoke(dax::worklet::Square(), input, otherSquare);
+  pipeline.Execute();
+
+  CheckEqual(sine, expectedSine);
+  CheckEqual(average, expectedAverage);
+  CheckEqual(square, expectedSquare);
+
+  // A pipeline can be reused after Execute.
+  ScalarArrayHandle again;
+  pipeline.Invoke(dax::worklet::Sine(), input, again);
+  pipeline.Execute();
+  CheckEqual(again, expectedSine);
+}
+
+//-----------------------------------------------------------------------------
+void TestPipeline()
+{
+  TestChain(true, true);
+  TestChain(false, true);
+  TestChain(true, false);
+  TestChunkedChain();
+  TestBranches(true, true);
+  TestBranches(false, true);
+  TestBranches(true, false);
+  TestCells();
+}
+
+} // anonymous namespace
+
+int UnitTestPipeline(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestPipeline);
+}
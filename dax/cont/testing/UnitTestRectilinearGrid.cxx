@@ -0,0 +1,129 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/RectilinearGrid.h>
+
+#include <dax/cont/internal/testing/TestingGridGenerator.h>
+#include <dax/cont/internal/testing/Testing.h>
+
+namespace {
+
+void TestRectilinearGrid()
+{
+  const dax::Id DIM = 5;
+
+  dax::cont::internal::TestGrid<dax::cont::RectilinearGrid<> > gridGen(DIM);
+  dax::cont::RectilinearGrid<> grid = gridGen.GetRealGrid();
+
+  std::cout << "Test basic information." << std::endl;
+  DAX_TEST_ASSERT(grid.GetNumberOfCells() == (DIM-1)*(DIM-1)*(DIM-1),
+                  "Wrong number of cells.");
+  DAX_TEST_ASSERT(grid.GetNumberOfPoints() == DIM*DIM*DIM,
+                  "Wrong number of points.");
+
+  std::cout << "Test point indices and coordinates." << std::endl;
+  dax::Id index = 0;
+  dax::Id3 ijk;
+  for (ijk[2] = 0; ijk[2] < DIM; ijk[2]++)
+    {
+    for (ijk[1] = 0; ijk[1] < DIM; ijk[1]++)
+      {
+      for (ijk[0] = 0; ijk[0] < DIM; ijk[0]++)
+        {
+        DAX_TEST_ASSERT(grid.ComputePointIndex(ijk) == index,
+                        "Unexpected point index.");
+        DAX_TEST_ASSERT(grid.ComputePointLocation(index) == ijk,
+                        "Unexpected point location.");
+        dax::Vector3 expected = dax::make_Vector3(
+              grid.GetXCoordinates().GetPortalConstControl().Get(ijk[0]),
+              grid.GetYCoordinates().GetPortalConstControl().Get(ijk[1]),
+              grid.GetZCoordinates().GetPortalConstControl().Get(ijk[2]));
+        DAX_TEST_ASSERT(grid.ComputePointCoordinates(index) == expected,
+                        "Unexpected point coordinates.");
+        index++;
+        }
+      }
+    }
+
+  std::cout << "Test cell indices." << std::endl;
+  index = 0;
+  for (ijk[2] = 0; ijk[2] < DIM-1; ijk[2]++)
+    {
+    for (ijk[1] = 0; ijk[1] < DIM-1; ijk[1]++)
+      {
+      for (ijk[0] = 0; ijk[0] < DIM-1; ijk[0]++)
+        {
+        DAX_TEST_ASSERT(grid.ComputeCellIndex(ijk) == index,
+                        "Unexpected cell index.");
+        DAX_TEST_ASSERT(grid.ComputeCellLocation(index) == ijk,
+                        "Unexpected cell location.");
+        index++;
+        }
+      }
+    }
+
+  std::cout << "Test point coordinates portal." << std::endl;
+  dax::cont::RectilinearGrid<>::PointCoordinatesType coords =
+      grid.GetPointCoordinates();
+  DAX_TEST_ASSERT(coords.GetNumberOfValues() == grid.GetNumberOfPoints(),
+                  "Point coordinates array has wrong size.");
+  dax::cont::RectilinearGrid<>::PointCoordinatesType::PortalConstControl
+      coordsPortal = coords.GetPortalConstControl();
+  dax::cont::RectilinearGrid<>::PointCoordinatesType::PortalConstExecution
+      coordsExecPortal = coords.PrepareForInput();
+  for (index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    dax::Vector3 gridCoords = grid.ComputePointCoordinates(index);
+    DAX_TEST_ASSERT(gridCoords == coordsPortal.Get(index),
+                    "Point coordinates seem wrong.");
+    DAX_TEST_ASSERT(gridCoords == coordsExecPortal.Get(index),
+                    "Execution point coordinates seem wrong.");
+    }
+
+  std::cout << "Test PrepareForInput" << std::endl;
+  dax::cont::RectilinearGrid<>::TopologyStructConstExecution topology =
+      grid.PrepareForInput();
+  DAX_TEST_ASSERT(topology.Extent.Min == grid.GetExtent().Min,
+                  "Topology extent wrong.");
+  DAX_TEST_ASSERT(topology.Extent.Max == grid.GetExtent().Max,
+                  "Topology extent wrong.");
+  for (index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    DAX_TEST_ASSERT(topology.GetPointCoordinates(index)
+                    == grid.ComputePointCoordinates(index),
+                    "Topology point coordinates wrong.");
+    }
+
+  std::cout << "Test cell connections" << std::endl;
+  dax::cont::internal::TestGrid<dax::cont::UniformGrid<> > uniformGen(DIM);
+  for (index = 0; index < grid.GetNumberOfCells(); index++)
+    {
+    dax::exec::CellVertices<dax::CellTagVoxel> rectilinearVerts =
+        gridGen.GetCellConnections(index);
+    dax::exec::CellVertices<dax::CellTagVoxel> uniformVerts =
+        uniformGen.GetCellConnections(index);
+    DAX_TEST_ASSERT(rectilinearVerts.GetAsTuple()
+                    == uniformVerts.GetAsTuple(),
+                    "Rectilinear connections differ from uniform grid.");
+    }
+}
+
+} // anonymous namespace
+
+int UnitTestRectilinearGrid(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestRectilinearGrid);
+}
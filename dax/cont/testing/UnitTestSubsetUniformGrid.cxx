@@ -0,0 +1,153 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/SubsetUniformGrid.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <dax/cont/arg/Geometry.h>
+#include <dax/exec/CellField.h>
+#include <dax/exec/WorkletMapCell.h>
+
+#include <dax/worklet/CellAverage.h>
+#include <dax/worklet/Threshold.h>
+
+#include <dax/cont/internal/testing/TestingGridGenerator.h>
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+// Returns the center of each cell from its point coordinates.
+struct CellCenter : public dax::exec::WorkletMapCell
+{
+  typedef dax::cont::arg::Geometry Geometry;
+  typedef void ControlSignature(Topology, Geometry, Field(Out));
+  typedef _3 ExecutionSignature(_2);
+
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(
+      const dax::exec::CellField<dax::Vector3,dax::CellTagVoxel> &coords) const
+  {
+    dax::Vector3 center = dax::make_Vector3(0.0f, 0.0f, 0.0f);
+    for (int vertex = 0; vertex < coords.NUM_VERTICES; vertex++)
+      {
+      center = center + coords[vertex];
+      }
+    return (1.0f/coords.NUM_VERTICES) * center;
+  }
+};
+
+//-----------------------------------------------------------------------------
+void TestSubsetUniformGrid()
+{
+  const dax::cont::UniformGrid<> parent =
+      dax::cont::internal::MakeShiftedUniformGrid(
+        dax::make_Id3(9, 7, 9), DAX_DEFAULT_DEVICE_ADAPTER_TAG());
+  dax::cont::Scheduler<> scheduler;
+
+  std::vector<dax::Scalar> field(parent.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < parent.GetNumberOfPoints();
+       pointIndex++)
+    {
+    const dax::Id3 ijk = parent.ComputePointLocation(pointIndex);
+    field[pointIndex] = static_cast<dax::Scalar>(((ijk[0]*ijk[1]) % 11)
+                                                 + ijk[2]);
+    }
+  dax::cont::ArrayHandle<dax::Scalar> fieldHandle =
+      dax::cont::make_ArrayHandle(field);
+
+  std::cout << "Making subset from a threshold." << std::endl;
+  dax::cont::ArrayHandle<dax::ConnectivityId> classification;
+  scheduler.Invoke(dax::worklet::ThresholdClassify<dax::Scalar>(0.0f, 16.0f),
+                   parent, fieldHandle, classification);
+  std::vector<dax::ConnectivityId> classifyValues =
+      dax::cont::internal::GetArrayValues(classification);
+
+  dax::cont::SubsetUniformGrid<> subset =
+      dax::cont::make_SubsetUniformGrid(parent, classification);
+
+  std::vector<dax::Id> cellIds =
+      dax::cont::internal::GetArrayValues(subset.GetCellIds());
+  dax::Id numberOfCells = 0;
+  for (dax::Id cellIndex = 0;
+       cellIndex < parent.GetNumberOfCells();
+       cellIndex++)
+    {
+    if (classifyValues[cellIndex] != 0)
+      {
+      DAX_TEST_ASSERT(cellIds[numberOfCells] == cellIndex,
+                      "Subset has wrong cell id.");
+      numberOfCells++;
+      }
+    }
+  DAX_TEST_ASSERT(subset.GetNumberOfCells() == numberOfCells,
+                  "Subset has wrong number of cells.");
+  DAX_TEST_ASSERT(numberOfCells > 0
+                  && numberOfCells < parent.GetNumberOfCells(),
+                  "Threshold should keep some but not all cells.");
+  DAX_TEST_ASSERT(subset.GetNumberOfPoints() == parent.GetNumberOfPoints(),
+                  "Subset should have the points of its parent.");
+
+  std::cout << "Running a cell worklet on the topology." << std::endl;
+  dax::cont::ArrayHandle<dax::Scalar> parentAverages;
+  scheduler.Invoke(dax::worklet::CellAverage(),
+                   parent, fieldHandle, parentAverages);
+  dax::cont::ArrayHandle<dax::Scalar> subsetAverages;
+  scheduler.Invoke(dax::worklet::CellAverage(),
+                   subset, fieldHandle, subsetAverages);
+  std::vector<dax::Scalar> parentAverageValues =
+      dax::cont::internal::GetArrayValues(parentAverages);
+  std::vector<dax::Scalar> subsetAverageValues =
+      dax::cont::internal::GetArrayValues(subsetAverages);
+  DAX_TEST_ASSERT(subsetAverages.GetNumberOfValues() == numberOfCells,
+                  "Wrong number of cell averages.");
+  for (dax::Id cellIndex = 0; cellIndex < numberOfCells; cellIndex++)
+    {
+    DAX_TEST_ASSERT(test_equal(subsetAverageValues[cellIndex],
+                               parentAverageValues[cellIds[cellIndex]]),
+                    "Subset cell average differs from parent cell.");
+    }
+
+  std::cout << "Running a cell worklet on the geometry." << std::endl;
+  dax::cont::ArrayHandle<dax::Vector3> centers;
+  scheduler.Invoke(CellCenter(), subset, subset, centers);
+  std::vector<dax::Vector3> centerValues =
+      dax::cont::internal::GetArrayValues(centers);
+  for (dax::Id cellIndex = 0; cellIndex < numberOfCells; cellIndex++)
+    {
+    const dax::Id3 ijk = parent.ComputeCellLocation(cellIds[cellIndex]);
+    const dax::Vector3 expected = parent.ComputePointCoordinates(ijk)
+        + 0.5f*parent.GetSpacing();
+    DAX_TEST_ASSERT(test_equal(centerValues[cellIndex], expected),
+                    "Subset cell has wrong center.");
+    }
+}
+
+} // anonymous namespace
+
+int UnitTestSubsetUniformGrid(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestSubsetUniformGrid);
+}
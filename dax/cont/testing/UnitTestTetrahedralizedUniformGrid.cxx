@@ -0,0 +1,218 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/TetrahedralizedUniformGrid.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <dax/cont/arg/Geometry.h>
+#include <dax/exec/CellField.h>
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/WorkletMapCell.h>
+#include <dax/math/Sign.h>
+#include <dax/math/VectorAnalysis.h>
+
+#include <dax/worklet/CellAverage.h>
+
+#include <dax/cont/internal/testing/TestingGridGenerator.h>
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace {
+
+typedef dax::Tuple<dax::Id,4> TetConnectionsType;
+
+// Returns the point ids of each tetrahedron.
+struct TetConnections : public dax::exec::WorkletMapCell
+{
+  typedef void ControlSignature(Topology, Field(Out));
+  typedef _2 ExecutionSignature(Vertices(_1));
+
+  DAX_EXEC_EXPORT
+  TetConnectionsType operator()(
+      const dax::exec::CellVertices<dax::CellTagTetrahedron> &vertices) const
+  {
+    return vertices.GetAsTuple();
+  }
+};
+
+// Returns the signed volume of each tetrahedron.
+struct TetVolume : public dax::exec::WorkletMapCell
+{
+  typedef dax::cont::arg::Geometry Geometry;
+  typedef void ControlSignature(Topology, Geometry, Field(Out));
+  typedef _3 ExecutionSignature(_2);
+
+  DAX_EXEC_EXPORT
+  dax::Scalar operator()(
+      const dax::exec::CellField<dax::Vector3,dax::CellTagTetrahedron>
+          &coords) const
+  {
+    return dax::dot(coords[1] - coords[0],
+                    dax::math::Cross(coords[2] - coords[0],
+                                     coords[3] - coords[0])) / 6.0f;
+  }
+};
+
+// A face is identified by its sorted point ids.
+typedef std::vector<dax::Id> FaceType;
+
+// A face is on the boundary of the grid when all its points are on the same
+// side of the extent.
+bool IsBoundaryFace(const dax::cont::UniformGrid<> &grid, const FaceType &face)
+{
+  const dax::Extent3 &extent = grid.GetExtent();
+  const dax::Id3 p0 = grid.ComputePointLocation(face[0]);
+  const dax::Id3 p1 = grid.ComputePointLocation(face[1]);
+  const dax::Id3 p2 = grid.ComputePointLocation(face[2]);
+  for (int dim = 0; dim < 3; dim++)
+    {
+    if ((p0[dim] == extent.Min[dim] || p0[dim] == extent.Max[dim])
+        && p0[dim] == p1[dim] && p0[dim] == p2[dim])
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+void TestTetrahedralizedUniformGrid()
+{
+  const dax::cont::UniformGrid<> parent =
+      dax::cont::internal::MakeShiftedUniformGrid(
+        dax::make_Id3(6, 4, 7), DAX_DEFAULT_DEVICE_ADAPTER_TAG());
+  const dax::cont::TetrahedralizedUniformGrid<> tets(parent);
+  dax::cont::Scheduler<> scheduler;
+
+  DAX_TEST_ASSERT(tets.GetNumberOfCells() == 5*parent.GetNumberOfCells(),
+                  "Each voxel should be split in 5 tetrahedra.");
+  DAX_TEST_ASSERT(tets.GetNumberOfPoints() == parent.GetNumberOfPoints(),
+                  "Tetrahedra should use the points of the parent.");
+
+  std::cout << "Checking the connections of the tetrahedra." << std::endl;
+  dax::cont::ArrayHandle<TetConnectionsType> connections;
+  scheduler.Invoke(TetConnections(), tets, connections);
+  std::vector<TetConnectionsType> connectionValues =
+      dax::cont::internal::GetArrayValues(connections);
+  DAX_TEST_ASSERT(static_cast<dax::Id>(connectionValues.size())
+                  == tets.GetNumberOfCells(),
+                  "Wrong number of connections.");
+
+  std::map<FaceType,int> faceUses;
+  for (dax::Id cellIndex = 0; cellIndex < tets.GetNumberOfCells(); cellIndex++)
+    {
+    const TetConnectionsType &tet = connectionValues[cellIndex];
+    const dax::Id3 voxel = parent.ComputeCellLocation(cellIndex/5);
+    for (int vertex = 0; vertex < 4; vertex++)
+      {
+      const dax::Id3 offset = parent.ComputePointLocation(tet[vertex])
+          - voxel;
+      DAX_TEST_ASSERT(offset[0] >= 0 && offset[0] <= 1
+                      && offset[1] >= 0 && offset[1] <= 1
+                      && offset[2] >= 0 && offset[2] <= 1,
+                      "Tetrahedron point is not in its voxel.");
+      }
+    for (int skip = 0; skip < 4; skip++)
+      {
+      FaceType face;
+      for (int vertex = 0; vertex < 4; vertex++)
+        {
+        if (vertex != skip) { face.push_back(tet[vertex]); }
+        }
+      std::sort(face.begin(), face.end());
+      faceUses[face]++;
+      }
+    }
+
+  // Neighboring voxels must be split so that their faces match, which leaves
+  // only the two triangles of each boundary square used by one tetrahedron.
+  const dax::Id3 dims = dax::extentCellDimensions(parent.GetExtent());
+  const dax::Id expectedBoundaryFaces =
+      4*(dims[0]*dims[1] + dims[1]*dims[2] + dims[0]*dims[2]);
+  dax::Id boundaryFaces = 0;
+  for (std::map<FaceType,int>::const_iterator face = faceUses.begin();
+       face != faceUses.end();
+       face++)
+    {
+    DAX_TEST_ASSERT(face->second <= 2, "Face used by too many tetrahedra.");
+    if (face->second == 1)
+      {
+      DAX_TEST_ASSERT(IsBoundaryFace(parent, face->first),
+                      "Faces of neighboring voxels do not match.");
+      boundaryFaces++;
+      }
+    }
+  DAX_TEST_ASSERT(boundaryFaces == expectedBoundaryFaces,
+                  "Wrong number of boundary faces.");
+
+  std::cout << "Running a cell worklet on the geometry." << std::endl;
+  dax::cont::ArrayHandle<dax::Scalar> volumes;
+  scheduler.Invoke(TetVolume(), tets, tets, volumes);
+  std::vector<dax::Scalar> volumeValues =
+      dax::cont::internal::GetArrayValues(volumes);
+  dax::Scalar totalVolume = 0.0f;
+  for (dax::Id cellIndex = 0; cellIndex < tets.GetNumberOfCells(); cellIndex++)
+    {
+    const dax::Scalar volume = dax::math::Abs(volumeValues[cellIndex]);
+    DAX_TEST_ASSERT(volume > 0.0f, "Degenerate tetrahedron.");
+    totalVolume += volume;
+    }
+  const dax::Vector3 spacing = parent.GetSpacing();
+  const dax::Scalar expectedVolume =
+      parent.GetNumberOfCells()*spacing[0]*spacing[1]*spacing[2];
+  DAX_TEST_ASSERT(test_equal(totalVolume, expectedVolume),
+                  "Tetrahedra do not fill the grid.");
+
+  std::cout << "Running a cell worklet on the topology." << std::endl;
+  std::vector<dax::Scalar> field(parent.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < parent.GetNumberOfPoints();
+       pointIndex++)
+    {
+    const dax::Id3 ijk = parent.ComputePointLocation(pointIndex);
+    field[pointIndex] = static_cast<dax::Scalar>(((ijk[0]*ijk[1]) % 11)
+                                                 + ijk[2]);
+    }
+  dax::cont::ArrayHandle<dax::Scalar> averages;
+  scheduler.Invoke(dax::worklet::CellAverage(),
+                   tets, dax::cont::make_ArrayHandle(field), averages);
+  std::vector<dax::Scalar> averageValues =
+      dax::cont::internal::GetArrayValues(averages);
+  for (dax::Id cellIndex = 0; cellIndex < tets.GetNumberOfCells(); cellIndex++)
+    {
+    const TetConnectionsType &tet = connectionValues[cellIndex];
+    const dax::Scalar expected = 0.25f*(field[tet[0]] + field[tet[1]]
+                                        + field[tet[2]] + field[tet[3]]);
+    DAX_TEST_ASSERT(test_equal(averageValues[cellIndex], expected),
+                    "Wrong tetrahedron cell average.");
+    }
+}
+
+} // anonymous namespace
+
+int UnitTestTetrahedralizedUniformGrid(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestTetrahedralizedUniformGrid);
+}
@@ -82,6 +82,19 @@ void TestUniformGrid()
                     "Point coordinates seem wrong.");
     }
 
+  std::cout << "Test point coordinates portal of a shifted grid."
+            << std::endl;
+  dax::cont::UniformGrid<> shifted = grid;
+  shifted.SetOrigin(dax::make_Vector3(-1.0f, 2.0f, 0.5f));
+  shifted.SetSpacing(dax::make_Vector3(0.5f, 2.0f, 0.25f));
+  coordsPortal = shifted.GetPointCoordinates().GetPortalConstControl();
+  for (index = 0; index < shifted.GetNumberOfPoints(); index++)
+    {
+    DAX_TEST_ASSERT(test_equal(shifted.ComputePointCoordinates(index),
+                               coordsPortal.Get(index)),
+                    "Point coordinates of shifted grid seem wrong.");
+    }
+
   std::cout << "Test PrepareForInput" << std::endl;
   dax::cont::UniformGrid<>::TopologyStructConstExecution topology =
       grid.PrepareForInput();
@@ -32,7 +32,9 @@ namespace dax { namespace exec {
 //-----------------------------------------------------------------------------
 
 /// Special version of CellDerivative for Voxels or other axis aligned cells
-/// that do not require vertex coordinates.
+/// that do not require vertex coordinates. The widths are those of the cell
+/// being evaluated, so this works for the varying spacing of a rectilinear
+/// grid as well as for uniform grids.
 ///
 template<class CellTag>
 DAX_EXEC_EXPORT dax::Vector3 CellDerivativeAxisAligned(
@@ -0,0 +1,72 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_ExecutionWholeArray_h
+#define __dax_exec_ExecutionWholeArray_h
+
+#include <dax/Types.h>
+#include <dax/exec/ExecutionObjectBase.h>
+
+namespace dax { namespace exec {
+
+/// \headerfile ExecutionWholeArray.h dax/exec/ExecutionWholeArray.h
+/// \brief Gives a worklet read access to every value of an array.
+///
+/// Fields are otherwise bound to a worklet one value (or one value per cell
+/// vertex) at a time. This execution object, passed as an ExecObject()
+/// argument, lets the worklet read only the values it needs at any index:
+///
+/// \code
+/// scheduler.Invoke(worklet, grid,
+///                  dax::exec::make_ExecutionWholeArrayConst(
+///                    field.PrepareForInput()));
+/// \endcode
+///
+template<typename PortalType>
+class ExecutionWholeArrayConst : public dax::exec::ExecutionObjectBase
+{
+public:
+  typedef typename PortalType::ValueType ValueType;
+
+  DAX_CONT_EXPORT ExecutionWholeArrayConst(): Portal() {  }
+
+  DAX_CONT_EXPORT ExecutionWholeArrayConst(const PortalType &portal)
+    : Portal(portal) {  }
+
+  DAX_EXEC_EXPORT dax::Id GetNumberOfValues() const
+  {
+    return this->Portal.GetNumberOfValues();
+  }
+
+  DAX_EXEC_EXPORT ValueType Get(dax::Id index) const
+  {
+    return this->Portal.Get(index);
+  }
+
+private:
+  PortalType Portal;
+};
+
+template<typename PortalType>
+DAX_CONT_EXPORT
+ExecutionWholeArrayConst<PortalType>
+make_ExecutionWholeArrayConst(const PortalType &portal)
+{
+  return ExecutionWholeArrayConst<PortalType>(portal);
+}
+
+} } //namespace dax::exec
+
+#endif //__dax_exec_ExecutionWholeArray_h
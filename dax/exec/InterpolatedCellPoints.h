@@ -21,15 +21,75 @@
 namespace dax {
 namespace exec {
 
-/// \brief Holds the point indices for a cell of a particular type.
+/// \brief A point interpolated along an edge of the input cells.
+///
+/// The point lies at \c Weight of the way from point \c PointA to point
+/// \c PointB. The two point ids are kept sorted so that every cell sharing
+/// the edge gives the same record, which makes the id pair a key to merge
+/// the points generated by neighboring cells.
+///
+struct InterpolationEdge
+{
+  dax::Id PointA;
+  dax::Id PointB;
+  dax::Scalar Weight;
+
+  DAX_EXEC_CONT_EXPORT
+  InterpolationEdge() : PointA(0), PointB(0), Weight(0) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  InterpolationEdge(dax::Id pointA, dax::Id pointB, dax::Scalar weight)
+  {
+    if (pointB < pointA)
+      {
+      this->PointA = pointB;
+      this->PointB = pointA;
+      this->Weight = 1 - weight;
+      }
+    else
+      {
+      this->PointA = pointA;
+      this->PointB = pointB;
+      this->Weight = weight;
+      }
+  }
+
+  /// Edges are ordered by their point ids and then by weight, since several
+  /// points (for example of different isovalues) can lie on the same edge.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  bool operator<(const InterpolationEdge &other) const
+  {
+    if (this->PointA != other.PointA) { return this->PointA < other.PointA; }
+    if (this->PointB != other.PointB) { return this->PointB < other.PointB; }
+    return this->Weight < other.Weight;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  bool operator==(const InterpolationEdge &other) const
+  {
+    return (this->PointA == other.PointA) && (this->PointB == other.PointB)
+        && (this->Weight == other.Weight);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  bool operator!=(const InterpolationEdge &other) const
+  {
+    return !(*this == other);
+  }
+};
+
+/// \brief Holds the interpolation edges of the points of a new cell.
 ///
 /// This class is really is a convienience wrapper around a dax::Tuple.
 ///
 template<class CellTag>
-class InterpolatedCellPoints : public dax::exec::CellField<dax::Vector3, CellTag>
+class InterpolatedCellPoints
+    : public dax::exec::CellField<dax::exec::InterpolationEdge, CellTag>
 {
 private:
-  typedef dax::exec::CellField<dax::Vector3, CellTag> Superclass;
+  typedef dax::exec::CellField<dax::exec::InterpolationEdge, CellTag>
+      Superclass;
 public:
   const static int NUM_VERTICES = Superclass::NUM_VERTICES;
   typedef typename Superclass::TupleType TupleType;
@@ -38,10 +98,7 @@ public:
   InterpolatedCellPoints() {  }
 
   DAX_EXEC_CONT_EXPORT
-  InterpolatedCellPoints(const TupleType &pointIndices) : Superclass(pointIndices) {  }
-
-  DAX_CONT_EXPORT
-  InterpolatedCellPoints(dax::Id index) : Superclass(index) {  }
+  InterpolatedCellPoints(const TupleType &edges) : Superclass(edges) {  }
 
   // Although this copy constructor should be identical to the default copy
   // constructor, we have noticed that NVCC's default copy constructor can
@@ -54,16 +111,7 @@ public:
   void SetInterpolationPoint( dax::Id index, dax::Id pos1, dax::Id pos2,
                               dax::Scalar weight )
     {
-    //cast the memory location from an id to a scalar.
-    //Not a static cast, but instead convert the actual
-    //memory layout from representing a IEEE float to a signed integer. This
-    //works since IEEE float standard states that each float value memory
-    //representation is a valid signed integer.
-    //We do this so that we don't have to worry about the conversion to float
-    //losing any data
-    (*this)[index]=dax::Vector3( *(reinterpret_cast<dax::Scalar*>(&pos1)),
-                                 *(reinterpret_cast<dax::Scalar*>(&pos2)),
-                                 weight);
+    (*this)[index] = dax::exec::InterpolationEdge(pos1, pos2, weight);
     }
 };
 
@@ -79,7 +127,7 @@ template<class CellTag>
 struct VectorTraits<dax::exec::InterpolatedCellPoints<CellTag> >
 {
   typedef dax::exec::InterpolatedCellPoints<CellTag> InterpolatedCellPointsType;
-  typedef dax::Id ComponentType;
+  typedef dax::exec::InterpolationEdge ComponentType;
   static const int NUM_COMPONENTS = InterpolatedCellPointsType::NUM_VERTICES;
   typedef typename internal::VectorTraitsMultipleComponentChooser<
       NUM_COMPONENTS>::Type HasMultipleComponents;
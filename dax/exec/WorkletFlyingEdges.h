@@ -0,0 +1,38 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_WorkletFlyingEdges_h
+#define __dax_exec_WorkletFlyingEdges_h
+
+#include <dax/exec/internal/WorkletBase.h>
+
+namespace dax {
+namespace exec {
+
+///----------------------------------------------------------------------------
+/// Superclass for isosurface worklets run by the flying edges scheduler,
+/// which contours a point field of a uniform grid row by row. Subclasses
+/// give the isovalue with GetIsoValue.
+///
+class WorkletFlyingEdges : public dax::exec::internal::WorkletBase
+{
+public:
+  DAX_EXEC_EXPORT WorkletFlyingEdges() { }
+};
+
+}
+}
+
+#endif //__dax_exec_WorkletFlyingEdges_h
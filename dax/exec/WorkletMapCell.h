@@ -39,6 +39,8 @@ protected:
   typedef dax::cont::arg::Field Field;
   typedef dax::cont::arg::Topology Topology;
   typedef dax::cont::arg::Topology::Vertices Vertices;
+  typedef dax::cont::arg::Topology::CellId CellId;
+  typedef dax::cont::arg::Topology::CellIJK CellIJK;
   typedef dax::cont::sig::Point Point;
   typedef dax::cont::sig::Cell Cell;
 };
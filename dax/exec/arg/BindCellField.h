@@ -0,0 +1,78 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_arg_BindCellField_h
+#define __dax_exec_arg_BindCellField_h
+#if defined(DAX_DOXYGEN_ONLY)
+
+#else // !defined(DAX_DOXYGEN_ONLY)
+
+#include <dax/Types.h>
+#include <dax/cont/arg/ConceptMap.h>
+#include <dax/cont/arg/Topology.h>
+#include <dax/cont/internal/Bindings.h>
+#include <dax/cont/internal/FindBinding.h>
+
+#include <dax/exec/internal/WorkletBase.h>
+
+namespace dax { namespace exec { namespace arg {
+
+/// Binds an input Field(Cell) argument of a cell worklet. The value is
+/// looked up with the id of the cell the topology visits, so when the
+/// topology is a permutation of the cells of a grid (as in the generate
+/// schedulers) the field still holds one value per cell of that grid.
+/// Output Field(Cell) arguments hold one value per visited cell and are
+/// bound with BindDirect instead.
+template <typename Invocation, int N>
+class BindCellField
+{
+  typedef typename dax::cont::internal::Bindings<Invocation> BindingsType;
+  typedef typename dax::cont::internal::FindBinding<BindingsType, dax::cont::arg::Topology>::type TopoIndex;
+  typedef typename BindingsType::template GetType<TopoIndex::value>::type TopoControlBinding;
+  typedef typename TopoControlBinding::ExecArg TopoExecArgType;
+  TopoExecArgType TopoExecArg;
+
+  typedef typename dax::cont::internal::Bindings<Invocation>::template GetType<N>::type ControlBinding;
+  typedef typename ControlBinding::ExecArg ExecArgType;
+  ExecArgType ExecArg;
+
+public:
+  typedef typename ExecArgType::ReturnType ReturnType;
+
+  DAX_CONT_EXPORT BindCellField(dax::cont::internal::Bindings<Invocation>& bindings):
+    TopoExecArg(bindings.template Get<TopoIndex::value>().GetExecArg()),
+    ExecArg(bindings.template Get<N>().GetExecArg()) {}
+
+  template<typename IndexType>
+  DAX_EXEC_EXPORT ReturnType operator()(
+      const IndexType& cellIndex,
+      const dax::exec::internal::WorkletBase& work)
+    {
+    return this->ExecArg(this->TopoExecArg.GetCellIndex(cellIndex, work),
+                         work);
+    }
+
+  DAX_EXEC_EXPORT void SaveExecutionResult(
+      dax::Id,
+      const dax::exec::internal::WorkletBase&) const
+    {
+    // Inputs only, nothing to save.
+    }
+};
+
+}}} // namespace dax::exec::arg
+
+#endif // !defined(DAX_DOXYGEN_ONLY)
+#endif //__dax_exec_arg_BindCellField_h
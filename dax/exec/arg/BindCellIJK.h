@@ -0,0 +1,63 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_arg_BindCellIJK_h
+#define __dax_exec_arg_BindCellIJK_h
+#if defined(DAX_DOXYGEN_ONLY)
+
+#else // !defined(DAX_DOXYGEN_ONLY)
+
+#include <dax/Types.h>
+#include <dax/cont/internal/Bindings.h>
+
+#include <dax/exec/internal/WorkletBase.h>
+
+namespace dax { namespace exec { namespace arg {
+
+/// Binds CellIJK(_N) in an execution signature to the i,j,k location of
+/// the voxel the topology argument N visits. Like CellId, under the permuted
+/// topology of the generate schedulers this is the location of the input
+/// cell.
+template <typename Invocation, int N>
+class BindCellIJK
+{
+  typedef typename dax::cont::internal::Bindings<Invocation>::template GetType<N>::type ControlBinding;
+  typedef typename ControlBinding::ExecArg TopoExecArgType;
+  TopoExecArgType TopoExecArg;
+
+public:
+  typedef dax::Id3 ReturnType;
+
+  DAX_CONT_EXPORT BindCellIJK(dax::cont::internal::Bindings<Invocation>& bindings):
+    TopoExecArg(bindings.template Get<N>().GetExecArg()) {}
+
+  template<typename IndexType>
+  DAX_EXEC_EXPORT ReturnType operator()(
+      const IndexType& cellIndex,
+      const dax::exec::internal::WorkletBase& work)
+    {
+    return this->TopoExecArg.GetCellIJK(cellIndex, work);
+    }
+
+  DAX_EXEC_EXPORT void SaveExecutionResult(int,
+                 const dax::exec::internal::WorkletBase&) const
+    {
+    }
+};
+
+}}} // namespace dax::exec::arg
+
+#endif // !defined(DAX_DOXYGEN_ONLY)
+#endif //__dax_exec_arg_BindCellIJK_h
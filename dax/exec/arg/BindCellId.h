@@ -0,0 +1,75 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_arg_BindCellId_h
+#define __dax_exec_arg_BindCellId_h
+#if defined(DAX_DOXYGEN_ONLY)
+
+#else // !defined(DAX_DOXYGEN_ONLY)
+
+#include <dax/Types.h>
+#include <dax/cont/internal/Bindings.h>
+
+#include <dax/exec/internal/WorkletBase.h>
+
+namespace dax { namespace exec { namespace arg {
+
+/// Binds CellId(_N) in an execution signature to the id of the cell the
+/// topology argument N visits. Unlike WorkId, which is the index of the
+/// output, under the permuted topology of the generate schedulers this is
+/// the id of the input cell.
+template <typename Invocation, int N>
+class BindCellId
+{
+  typedef typename dax::cont::internal::Bindings<Invocation>::template GetType<N>::type ControlBinding;
+  typedef typename ControlBinding::ExecArg TopoExecArgType;
+  TopoExecArgType TopoExecArg;
+
+public:
+  typedef dax::Id ReturnType;
+
+  DAX_CONT_EXPORT BindCellId(dax::cont::internal::Bindings<Invocation>& bindings):
+    TopoExecArg(bindings.template Get<N>().GetExecArg()) {}
+
+  template<typename IndexType>
+  DAX_EXEC_EXPORT ReturnType operator()(
+      const IndexType& cellIndex,
+      const dax::exec::internal::WorkletBase& work)
+    {
+    return this->ToId(this->TopoExecArg.GetCellIndex(cellIndex, work));
+    }
+
+  DAX_EXEC_EXPORT void SaveExecutionResult(int,
+                 const dax::exec::internal::WorkletBase&) const
+    {
+    }
+
+private:
+  template<typename IndexType>
+  DAX_EXEC_EXPORT static dax::Id ToId(const IndexType& id)
+    {
+    return id.value();
+    }
+
+  DAX_EXEC_EXPORT static dax::Id ToId(const dax::Id& id)
+    {
+    return id;
+    }
+};
+
+}}} // namespace dax::exec::arg
+
+#endif // !defined(DAX_DOXYGEN_ONLY)
+#endif //__dax_exec_arg_BindCellId_h
@@ -40,18 +40,41 @@ public:
     {
     }
 
+  //keys can be stored as dax::ConnectivityId (for example the cell
+  //connections of an unstructured grid), so they are widened to dax::Id
+  //before being used as an index
   template<typename IndexType>
   DAX_EXEC_EXPORT ReturnType operator()(const IndexType& index,
                             const dax::exec::internal::WorkletBase& work)
     {
-    return ExecValueType::operator()(this->KeyArg(index, work), work);
+    return ExecValueType::operator()(
+          static_cast<dax::Id>(this->KeyArg(index, work)), work);
     }
 
   template<typename IndexType>
   DAX_EXEC_EXPORT ReturnType operator()(const IndexType& index,
                             const dax::exec::internal::WorkletBase& work) const
     {
-    return ExecValueType::operator()(this->KeyArg(index, work), work);
+    return ExecValueType::operator()(
+          static_cast<dax::Id>(this->KeyArg(index, work)), work);
+    }
+
+  //when the value is a topology, the id of the cell the key refers to
+  template<typename IndexType>
+  DAX_EXEC_EXPORT dax::Id GetCellIndex(const IndexType& index,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    return ExecValueType::GetCellIndex(
+          static_cast<dax::Id>(this->KeyArg(index, work)), work);
+    }
+
+  //when the value is a topology, the i,j,k of the cell the key refers to
+  template<typename IndexType>
+  DAX_EXEC_EXPORT dax::Id3 GetCellIJK(const IndexType& index,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    return ExecValueType::GetCellIJK(
+          static_cast<dax::Id>(this->KeyArg(index, work)), work);
     }
 
   DAX_EXEC_EXPORT void SaveExecutionResult(dax::Id index,
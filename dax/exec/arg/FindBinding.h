@@ -25,13 +25,18 @@
 #include <dax/cont/sig/Arg.h>
 #include <dax/cont/sig/Tag.h>
 #include <dax/cont/sig/WorkId.h>
+#include <dax/exec/arg/BindCellField.h>
+#include <dax/exec/arg/BindCellId.h>
+#include <dax/exec/arg/BindCellIJK.h>
 #include <dax/exec/arg/BindCellPoints.h>
 #include <dax/exec/arg/BindCellTag.h>
 #include <dax/exec/arg/BindDirect.h>
 #include <dax/exec/arg/BindWorkId.h>
 #include <dax/Types.h>
 
+#include <boost/mpl/and.hpp>
 #include <boost/mpl/if.hpp>
+#include <boost/mpl/not.hpp>
 #include <boost/type_traits/is_same.hpp>
 
 
@@ -57,19 +62,28 @@ public:
   typedef BindCellTag<Invocation,N> type;
 };
 
-//specialize on arg to field mapping, with Field(Point) being understood
-//as a specialization of the default bind direct behavior
+//specialize on arg to field mapping, with Field(Point) and Field(Cell) being
+//understood as specializations of the default bind direct behavior. Only
+//input Field(Cell) arguments are looked up through the topology; outputs
+//hold one value per visited cell and are bound directly.
 template<typename Tags, typename Invocation, int N>
 class BindArg<dax::cont::sig::Cell,
               dax::cont::arg::Field(Tags),
               Invocation,
               N>
 {
+  typedef boost::mpl::and_<
+    typename Tags::template Has<dax::cont::sig::Cell>,
+    boost::mpl::not_<typename Tags::template Has<dax::cont::sig::Out> >
+    > IsCellInput;
 public:
   typedef typename boost::mpl::if_<
     typename Tags::template Has<dax::cont::sig::Point>,
     BindCellPoints<Invocation, N>,
-    BindDirect<Invocation, N>
+    typename boost::mpl::if_<
+      IsCellInput,
+      BindCellField<Invocation, N>,
+      BindDirect<Invocation, N> >::type
     >::type type;
 };
 
@@ -105,6 +119,28 @@ public:
   typedef BindDirect<Invocation,N> type;
 };
 
+//specialize on Topology to CellId(_N) binding, which gives the id of the
+//cell the topology visits
+template<typename WorkletType, int N, typename Invocation>
+class FindBinding<WorkletType,
+                  dax::cont::arg::Topology::CellId(*)(dax::cont::sig::Arg<N>),
+                  Invocation>
+{
+public:
+  typedef BindCellId<Invocation,N> type;
+};
+
+//specialize on Topology to CellIJK(_N) binding, which gives the i,j,k
+//location of the voxel the topology visits
+template<typename WorkletType, int N, typename Invocation>
+class FindBinding<WorkletType,
+                  dax::cont::arg::Topology::CellIJK(*)(dax::cont::sig::Arg<N>),
+                  Invocation>
+{
+public:
+  typedef BindCellIJK<Invocation,N> type;
+};
+
 //bind workid in the execution signature to th bindworkId class
 template <typename WorkletType, typename Invocation>
 class FindBinding<WorkletType, dax::cont::sig::WorkId, Invocation>
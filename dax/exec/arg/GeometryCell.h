@@ -21,7 +21,8 @@
 
 #include <dax/Types.h>
 #include <dax/CellTag.h>
-#include <dax/exec/InterpolatedCellPoints.h>
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/CellField.h>
 #include <dax/exec/internal/FieldAccess.h>
 #include <dax/exec/internal/WorkletBase.h>
 
@@ -35,7 +36,7 @@ class GeometryCell
 {
 public:
   typedef typename TopologyType::CellTag CellTag;
-  typedef dax::exec::InterpolatedCellPoints<CellTag> GeometryCellType;
+  typedef dax::exec::CellField<dax::Vector3,CellTag> GeometryCellType;
 
   //if we are going with Out tag
   typedef typename boost::mpl::if_<typename Tags::template Has<dax::cont::sig::Out>,
@@ -53,16 +54,16 @@ public:
       const IndexType& index,
       const dax::exec::internal::WorkletBase& work)
   {
-    dax::Tuple<dax::Id, GeometryCellType::NUM_VERTICES> verts;
-    dax::exec::internal::FieldGetMultiple(this->Topo.CellConnections,
-                                dax::CellTraits<CellTag>::NUM_VERTICES * index,
-                                verts,
-                                work);
+    //ask the topology for the connections so that grids with implicit
+    //connectivity (uniform, rectilinear) work as well as unstructured grids
+    dax::exec::CellVertices<CellTag> verts =
+        this->Topo.GetCellConnections(index);
 
-    //we have the coordinates now stored in the cell, so we have to copy
-    //them into the portal
+    //we have the point indices of the cell, so we can now fetch the
+    //coordinates from the portal
     this->Cell =  dax::exec::internal::FieldGetMultiple(this->Portal,
-                                                        verts, work);
+                                                        verts.GetAsTuple(),
+                                                        work);
     return this->Cell;
   }
 
@@ -86,15 +87,12 @@ public:
                   HasOutTag,
                   typename boost::enable_if<HasOutTag>::type* = 0) const
     {
-    dax::Tuple<dax::Id, GeometryCellType::NUM_VERTICES > verts;
-    dax::exec::internal::FieldGetMultiple(this->Topo.CellConnections,
-                                dax::CellTraits<CellTag>::NUM_VERTICES * index,
-                                verts,
-                                work);
+    const dax::exec::CellVertices<CellTag> verts =
+        this->Topo.GetCellConnections(index);
 
     //we have the coordinates now stored in the cell, so we have to copy
     //them into the portal
-    dax::exec::internal::FieldSetMultiple(this->Portal, verts,
+    dax::exec::internal::FieldSetMultiple(this->Portal, verts.GetAsTuple(),
                                           this->Cell.GetAsTuple(), work);
     }
 
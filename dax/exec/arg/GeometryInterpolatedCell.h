@@ -0,0 +1,72 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_arg_GeometryInterpolatedCell_h
+#define __dax_exec_arg_GeometryInterpolatedCell_h
+#if defined(DAX_DOXYGEN_ONLY)
+
+#else // !defined(DAX_DOXYGEN_ONLY)
+
+#include <dax/Types.h>
+#include <dax/exec/InterpolatedCellPoints.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+namespace dax { namespace exec { namespace arg {
+
+/// \headerfile GeometryInterpolatedCell.h dax/exec/arg/GeometryInterpolatedCell.h
+/// \brief Execution environment representation of the interpolation edges
+/// of the new cells of a worklet. The points of each new cell are stored
+/// one after the other, so the cell index is all that is needed to find
+/// where they go.
+template <typename Tags, typename CellTag, typename PortalType>
+class GeometryInterpolatedCell
+{
+public:
+  typedef dax::exec::InterpolatedCellPoints<CellTag> GeometryCellType;
+
+  typedef GeometryCellType& ReturnType;
+  typedef GeometryCellType SaveType;
+  typedef GeometryCellType ValueType;
+
+  DAX_CONT_EXPORT GeometryInterpolatedCell(const PortalType& p):
+    Portal(p), Cell() {}
+
+  template<typename IndexType>
+  DAX_EXEC_EXPORT ReturnType operator()(
+      const IndexType&,
+      const dax::exec::internal::WorkletBase&)
+  {
+    return this->Cell;
+  }
+
+  DAX_EXEC_EXPORT void SaveExecutionResult(dax::Id index,
+                       const dax::exec::internal::WorkletBase&) const
+    {
+    const dax::Id offset = index * GeometryCellType::NUM_VERTICES;
+    for (int vertex = 0; vertex < GeometryCellType::NUM_VERTICES; ++vertex)
+      {
+      this->Portal.Set(offset + vertex, this->Cell[vertex]);
+      }
+    }
+
+private:
+  PortalType Portal;
+  GeometryCellType Cell;
+};
+
+}}} // namespace dax::exec::arg
+
+#endif // !defined(DAX_DOXYGEN_ONLY)
+#endif //__dax_exec_arg_GeometryInterpolatedCell_h
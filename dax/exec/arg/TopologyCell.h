@@ -22,6 +22,7 @@
 #include <dax/exec/CellVertices.h>
 
 #include <dax/exec/internal/FieldAccess.h>
+#include <dax/exec/internal/TopologyUniform.h>
 #include <dax/exec/internal/WorkletBase.h>
 
 #include <boost/mpl/if.hpp>
@@ -62,6 +63,28 @@ public:
     return this->Cell;
   }
 
+  //the id of the cell visited at the given index, which for a topology
+  //that is not permuted is the index itself
+  template<typename IndexType>
+  DAX_EXEC_EXPORT const IndexType& GetCellIndex(
+      const IndexType& index,
+      const dax::exec::internal::WorkletBase&) const
+  {
+    return index;
+  }
+
+  //the i,j,k location of the voxel visited at the given index. Uniform
+  //topologies know it from their extent; for other voxel topologies it is
+  //recovered from the point ids of the voxel, which is only meaningful when
+  //the points are numbered like those of a structured grid
+  template<typename IndexType>
+  DAX_EXEC_EXPORT dax::Id3 GetCellIJK(
+      const IndexType& index,
+      const dax::exec::internal::WorkletBase&) const
+  {
+    return CellIJK(this->Topo, index);
+  }
+
   DAX_EXEC_EXPORT void SaveExecutionResult(int index,
                        const dax::exec::internal::WorkletBase& work) const
     {
@@ -111,6 +134,27 @@ public:
     {
     }
 private:
+  template<typename IndexType>
+  DAX_EXEC_EXPORT static dax::Id3 CellIJK(
+      const dax::exec::internal::TopologyUniform& topology,
+      const IndexType& index)
+  {
+    return topology.GetCellIJK(index);
+  }
+
+  template<typename OtherTopologyType, typename IndexType>
+  DAX_EXEC_EXPORT static dax::Id3 CellIJK(const OtherTopologyType& topology,
+                                          const IndexType& index)
+  {
+    const dax::exec::CellVertices<dax::CellTagVoxel> vertices =
+        topology.GetCellConnections(index);
+    const dax::Id xDim = vertices[3] - vertices[0];
+    const dax::Id xyDim = vertices[4] - vertices[0];
+    return dax::make_Id3(vertices[0] % xDim,
+                         (vertices[0] % xyDim) / xDim,
+                         vertices[0] / xyDim);
+  }
+
   TopologyType Topo;
   CellVerticesType Cell;
 };
@@ -45,11 +45,11 @@ void FieldSet(const PortalType &arrayPortal,
   arrayPortal.Set(index, value);
 }
 
-template<class PortalType, class WorkType, int Size>
+template<class PortalType, class WorkType, typename T, int Size>
 DAX_EXEC_EXPORT
 void FieldSetMultiple(const PortalType &arrayPortal,
               dax::Id index,
-              const dax::Tuple<typename PortalType::ValueType,Size>& values,
+              const dax::Tuple<T,Size>& values,
               const WorkType &work)
 {
   for (int i = 0; i < Size; i++)
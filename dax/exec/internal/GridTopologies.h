@@ -16,6 +16,10 @@
 #ifndef __dax__exec__internal__GridTopologies_h
 #define __dax__exec__internal__GridTopologies_h
 
+#include <dax/exec/internal/TopologyMultiBlockUniform.h>
+#include <dax/exec/internal/TopologyRectilinear.h>
+#include <dax/exec/internal/TopologySubsetUniform.h>
+#include <dax/exec/internal/TopologyTetrahedralizedUniform.h>
 #include <dax/exec/internal/TopologyUniform.h>
 #include <dax/exec/internal/TopologyUnstructured.h>
 
@@ -0,0 +1,82 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_TetrahedralizeTable_h
+#define __dax_exec_internal_TetrahedralizeTable_h
+
+#include <dax/CellTag.h>
+#include <dax/Types.h>
+
+#include <dax/exec/CellVertices.h>
+
+#include <dax/Extent.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+//the two ways of splitting a voxel into 5 tetrahedra, the first 5 rows are
+//one way and the last 5 the other. Neighboring voxels have to be split in
+//different ways for the faces of their tetrahedra to match.
+DAX_EXEC_CONSTANT_EXPORT const unsigned char PossibleTetraSplitCases[10][4] =
+{
+{1,3,6,2},
+{0,1,3,4},
+{1,4,5,6},
+{3,6,7,4},
+{1,4,6,3},
+{2,1,5,0},
+{0,2,3,7},
+{2,5,6,7},
+{0,7,4,5},
+{0,2,7,5}
+};
+
+/// Returns the vertices of one of the tetrahedra a voxel is split into.
+/// \c splitCase is the row of PossibleTetraSplitCases, that is the index of
+/// the tetrahedron plus 5 when the voxel is split the second way.
+///
+DAX_EXEC_EXPORT
+dax::exec::CellVertices<dax::CellTagTetrahedron> VoxelTetrahedron(
+    const dax::exec::CellVertices<dax::CellTagVoxel> &voxelVertices,
+    dax::Id splitCase)
+{
+  dax::exec::CellVertices<dax::CellTagTetrahedron> tetVertices;
+  tetVertices[0] = voxelVertices[PossibleTetraSplitCases[splitCase][0]];
+  tetVertices[1] = voxelVertices[PossibleTetraSplitCases[splitCase][1]];
+  tetVertices[2] = voxelVertices[PossibleTetraSplitCases[splitCase][2]];
+  tetVertices[3] = voxelVertices[PossibleTetraSplitCases[splitCase][3]];
+  return tetVertices;
+}
+
+/// Returns the vertices of tetrahedron \c tetIndex (0 to 4) of the voxel at
+/// \c voxelIJK. The split is chosen by the parity of i+j+k so that the faces
+/// of neighboring voxels match.
+///
+DAX_EXEC_EXPORT
+dax::exec::CellVertices<dax::CellTagTetrahedron> TetrahedralizeVoxel(
+    const dax::exec::CellVertices<dax::CellTagVoxel> &voxelVertices,
+    const dax::Id3 &voxelIJK,
+    dax::Id tetIndex)
+{
+  const dax::Id parity = (voxelIJK[0] + voxelIJK[1] + voxelIJK[2]) & 1;
+  return VoxelTetrahedron(voxelVertices, tetIndex + 5*parity);
+}
+
+}
+}
+} // namespace dax::exec::internal
+
+#endif //__dax_exec_internal_TetrahedralizeTable_h
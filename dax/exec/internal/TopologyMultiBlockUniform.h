@@ -0,0 +1,116 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__exec__internal__TopologyMultiBlockUniform_h
+#define __dax__exec__internal__TopologyMultiBlockUniform_h
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Extent.h>
+
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/internal/TopologyUniform.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+/// Contains all the parameters necessary to specify the topology of a set of
+/// uniform grid blocks that are indexed as one grid. The cells of all the
+/// blocks are numbered one block after the other, and so are the points.
+/// \c CellOffsets and \c PointOffsets hold the index of the first cell and
+/// point of each block followed by the total number of cells and points, and
+/// \c PointDimensions holds the number of points along each axis of each
+/// block.
+///
+template<class IdPortalType, class Id3PortalType>
+struct TopologyMultiBlockUniform {
+  typedef dax::CellTagVoxel CellTag;
+
+  IdPortalType CellOffsets;
+  IdPortalType PointOffsets;
+  Id3PortalType PointDimensions;
+  dax::Id NumberOfBlocks;
+
+  DAX_EXEC_CONT_EXPORT
+  TopologyMultiBlockUniform() : NumberOfBlocks(0) {  }
+
+  /// Returns the number of points in all the blocks.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfPoints() const
+  {
+    return this->PointOffsets.Get(this->NumberOfBlocks);
+  }
+
+  /// Returns the number of cells in all the blocks.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfCells() const
+  {
+    return this->CellOffsets.Get(this->NumberOfBlocks);
+  }
+
+  /// Returns the block containing the given cell, that is the last block
+  /// whose first cell is not after \c cellIndex (empty blocks are skipped).
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id FindBlockOfCell(dax::Id cellIndex) const
+  {
+    dax::Id low = 0;
+    dax::Id high = this->NumberOfBlocks;
+    while (high - low > 1)
+      {
+      const dax::Id middle = (low + high)/2;
+      if (this->CellOffsets.Get(middle) <= cellIndex)
+        {
+        low = middle;
+        }
+      else
+        {
+        high = middle;
+        }
+      }
+    return low;
+  }
+
+  DAX_EXEC_EXPORT
+  detail::ImplicitCellVertices<dax::CellTagVoxel>
+  ComputeImplictVertices(dax::Id cellIndex) const
+  {
+    typedef detail::ImplicitCellVertices<dax::CellTagVoxel> ReturnType;
+    const dax::Id block = this->FindBlockOfCell(cellIndex);
+    const dax::Id3 dims = this->PointDimensions.Get(block);
+    const dax::Extent3 extent(dax::make_Id3(0, 0, 0),
+                              dims - dax::make_Id3(1, 1, 1));
+    return ReturnType(
+          dims,
+          this->PointOffsets.Get(block)
+          + indexToConnectivityIndex(
+            cellIndex - this->CellOffsets.Get(block), extent));
+  }
+
+  DAX_EXEC_EXPORT
+  dax::exec::CellVertices<CellTag>
+  GetCellConnections(dax::Id cellIndex) const
+  {
+    return detail::ImplicitVoxelConnections(
+          this->ComputeImplictVertices(cellIndex));
+  }
+};
+
+}  }  } //namespace dax::exec::internal
+
+#endif //__dax__exec__internal__TopologyMultiBlockUniform_h
@@ -0,0 +1,116 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__exec__internal__TopologyRectilinear_h
+#define __dax__exec__internal__TopologyRectilinear_h
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Extent.h>
+
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/internal/IJKIndex.h>
+#include <dax/exec/internal/TopologyUniform.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+/// Contains all the parameters necessary to specify the topology of a
+/// rectilinear grid. A rectilinear grid is axis aligned like a uniform grid,
+/// but the spacing along each axis can vary, so the point coordinates are
+/// given by one array portal per axis. The connectivity of the cells is the
+/// same implicit voxel connectivity as a uniform grid.
+///
+template<class AxisPortalType>
+struct TopologyRectilinear {
+  typedef dax::CellTagVoxel CellTag;
+
+  AxisPortalType XCoordinates;
+  AxisPortalType YCoordinates;
+  AxisPortalType ZCoordinates;
+  Extent3 Extent;
+
+  /// Returns the number of points in a rectilinear grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfPoints() const
+  {
+    dax::Id3 dims = dax::extentDimensions(this->Extent);
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Returns the number of cells in a rectilinear grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfCells() const
+  {
+    dax::Id3 dims = dax::extentDimensions(this->Extent)
+                    - dax::make_Id3(1, 1, 1);
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Returns the point position in a rectilinear grid for a given i, j, and k
+  /// value stored in /c ijk
+  ///
+  DAX_EXEC_EXPORT
+  dax::Vector3 GetPointCoordinates(dax::Id3 ijk) const
+  {
+    ijk = ijk - this->Extent.Min;
+    return dax::make_Vector3(this->XCoordinates.Get(ijk[0]),
+                             this->YCoordinates.Get(ijk[1]),
+                             this->ZCoordinates.Get(ijk[2]));
+  }
+
+  /// Returns the point position in a rectilinear grid for a given index
+  /// which is represented by /c pointIndex
+  ///
+  DAX_EXEC_EXPORT
+  dax::Vector3 GetPointCoordinates(dax::Id pointIndex) const
+  {
+    dax::Id3 ijk = flatIndexToIndex3(pointIndex, this->Extent);
+    return this->GetPointCoordinates(ijk);
+  }
+
+  DAX_EXEC_EXPORT
+  detail::ImplicitCellVertices<dax::CellTagVoxel>
+  ComputeImplictVertices(const dax::Id& cellIndex) const
+  {
+    typedef detail::ImplicitCellVertices<dax::CellTagVoxel> ReturnType;
+    return ReturnType( dax::extentDimensions(this->Extent),
+                       indexToConnectivityIndex(cellIndex,this->Extent));
+  }
+
+  DAX_EXEC_EXPORT
+  detail::ImplicitCellVertices<dax::CellTagVoxel>
+  ComputeImplictVertices(const dax::exec::internal::IJKIndex& cellIndex) const
+  {
+    typedef detail::ImplicitCellVertices<dax::CellTagVoxel> ReturnType;
+    return ReturnType(dax::extentDimensions(this->Extent), cellIndex);
+  }
+
+  template< class IndexType >
+  DAX_EXEC_EXPORT
+  dax::exec::CellVertices<CellTag>
+  GetCellConnections(const IndexType& cellIndex) const
+  {
+    return detail::ImplicitVoxelConnections(
+          this->ComputeImplictVertices(cellIndex));
+  }
+};
+
+}  }  } //namespace dax::exec::internal
+
+#endif //__dax__exec__internal__TopologyRectilinear_h
@@ -0,0 +1,68 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__exec__internal__TopologySubsetUniform_h
+#define __dax__exec__internal__TopologySubsetUniform_h
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/internal/TopologyUniform.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+/// Contains all the parameters necessary to specify the topology of a subset
+/// of the cells of a uniform grid. \c CellIds holds the id in \c Parent of
+/// each cell of the subset, and the points are those of \c Parent, so the
+/// connections of a cell are the implicit voxel connections of its parent
+/// cell.
+///
+template<class IdPortalType>
+struct TopologySubsetUniform {
+  typedef dax::CellTagVoxel CellTag;
+
+  dax::exec::internal::TopologyUniform Parent;
+  IdPortalType CellIds;
+
+  /// Returns the number of points of the parent grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfPoints() const
+  {
+    return this->Parent.GetNumberOfPoints();
+  }
+
+  /// Returns the number of cells in the subset.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfCells() const
+  {
+    return this->CellIds.GetNumberOfValues();
+  }
+
+  DAX_EXEC_EXPORT
+  dax::exec::CellVertices<CellTag>
+  GetCellConnections(dax::Id cellIndex) const
+  {
+    return this->Parent.GetCellConnections(this->CellIds.Get(cellIndex));
+  }
+};
+
+}  }  } //namespace dax::exec::internal
+
+#endif //__dax__exec__internal__TopologySubsetUniform_h
@@ -0,0 +1,76 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__exec__internal__TopologyTetrahedralizedUniform_h
+#define __dax__exec__internal__TopologyTetrahedralizedUniform_h
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Extent.h>
+
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/internal/TetrahedralizeTable.h>
+#include <dax/exec/internal/TopologyUniform.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+/// Contains all the parameters necessary to specify the topology of a
+/// uniform grid with every voxel split into 5 tetrahedra. Tetrahedron \c n
+/// is tetrahedron <tt>n % 5</tt> of voxel <tt>n / 5</tt> of \c Parent, and
+/// its connections are derived from the voxel connections with the
+/// PossibleTetraSplitCases table. Voxels are split one way or the other by
+/// the parity of their i, j, k location, so that neighboring voxels give
+/// matching faces.
+///
+struct TopologyTetrahedralizedUniform {
+  typedef dax::CellTagTetrahedron CellTag;
+
+  dax::exec::internal::TopologyUniform Parent;
+
+  /// Returns the number of points of the parent grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfPoints() const
+  {
+    return this->Parent.GetNumberOfPoints();
+  }
+
+  /// Returns the number of tetrahedra, 5 per voxel of the parent grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfCells() const
+  {
+    return 5*this->Parent.GetNumberOfCells();
+  }
+
+  DAX_EXEC_EXPORT
+  dax::exec::CellVertices<CellTag>
+  GetCellConnections(dax::Id cellIndex) const
+  {
+    const dax::Id voxelIndex = cellIndex / 5;
+    const dax::Id3 ijk =
+        dax::flatIndexToIndex3Cell(voxelIndex, this->Parent.Extent);
+    return dax::exec::internal::TetrahedralizeVoxel(
+          this->Parent.GetCellConnections(voxelIndex),
+          ijk,
+          cellIndex - 5*voxelIndex);
+  }
+};
+
+}  }  } //namespace dax::exec::internal
+
+#endif //__dax__exec__internal__TopologyTetrahedralizedUniform_h
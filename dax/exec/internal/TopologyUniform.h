@@ -67,6 +67,26 @@ public:
 
   dax::Id XDim, FirstPointIndex, SecondPointIndex;
 };
+
+/// Expands the implicit indices of a voxel into its eight point indices.
+/// This connectivity is shared by all structured grids of voxels.
+///
+DAX_EXEC_EXPORT
+dax::exec::CellVertices<dax::CellTagVoxel> ImplicitVoxelConnections(
+    const ImplicitCellVertices<dax::CellTagVoxel> &indices)
+{
+  dax::exec::CellVertices<dax::CellTagVoxel> values;
+
+  values[0] = indices.FirstPointIndex;
+  values[1] = indices.FirstPointIndex + 1;
+  values[2] = indices.FirstPointIndex + indices.XDim + 1;
+  values[3] = indices.FirstPointIndex + indices.XDim;
+  values[4] = indices.SecondPointIndex;
+  values[5] = indices.SecondPointIndex + 1;
+  values[6] = indices.SecondPointIndex + indices.XDim + 1;
+  values[7] = indices.SecondPointIndex + indices.XDim;
+  return values;
+}
 }
 
 /// Contains all the parameters necessary to specify the topology of a uniform
@@ -119,6 +139,21 @@ struct TopologyUniform {
     return this->GetPointCoordiantes(ijk);
   }
 
+  /// Returns the i, j, and k location in the extent of the cell with the
+  /// given index.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id3 GetCellIJK(dax::Id cellIndex) const
+  {
+    return dax::flatIndexToIndex3Cell(cellIndex, this->Extent);
+  }
+
+  DAX_EXEC_EXPORT
+  dax::Id3 GetCellIJK(const dax::exec::internal::IJKIndex& cellIndex) const
+  {
+    return cellIndex.GetIJK() + this->Extent.Min;
+  }
+
   DAX_EXEC_EXPORT
   detail::ImplicitCellVertices<dax::CellTagVoxel>
   ComputeImplictVertices(const dax::Id& cellIndex) const
@@ -141,21 +176,8 @@ struct TopologyUniform {
   dax::exec::CellVertices<CellTag>
   GetCellConnections(const IndexType& cellIndex) const
   {
-
-    typedef detail::ImplicitCellVertices<CellTag> ReturnType;
-    ReturnType indices = this->ComputeImplictVertices(cellIndex);
-
-    dax::exec::CellVertices<CellTag> values;
-
-    values[0] = indices.FirstPointIndex;
-    values[1] = indices.FirstPointIndex + 1;
-    values[2] = indices.FirstPointIndex + indices.XDim + 1;
-    values[3] = indices.FirstPointIndex + indices.XDim;
-    values[4] = indices.SecondPointIndex;
-    values[5] = indices.SecondPointIndex + 1;
-    values[6] = indices.SecondPointIndex + indices.XDim + 1;
-    values[7] = indices.SecondPointIndex + indices.XDim;
-    return values;
+    return detail::ImplicitVoxelConnections(
+          this->ComputeImplictVertices(cellIndex));
   }
 } __attribute__ ((aligned(DAX_SIZE_SCALAR)));
 
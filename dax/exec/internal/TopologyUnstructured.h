@@ -16,6 +16,7 @@
 #ifndef __dax__exec__internal__TopologyUnstructured_h
 #define __dax__exec__internal__TopologyUnstructured_h
 
+#include <dax/CellTraits.h>
 #include <dax/Types.h>
 
 #include <dax/exec/CellVertices.h>
@@ -24,6 +25,28 @@ namespace dax {
 namespace exec {
 namespace internal {
 
+/// Reads the connections of a cell out of a connections portal. The default
+/// reads each vertex index in turn. Containers that store connections in a
+/// compressed form specialize this to decode a whole cell at once.
+///
+template<class ConnectionsPortalType>
+struct CellConnectionsPortalTraits
+{
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  static void GetCellConnections(const ConnectionsPortalType &connections,
+                                 dax::Id cellIndex,
+                                 dax::exec::CellVertices<CellTag> &vertices)
+  {
+    const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+    dax::Id startConnectionIndex = cellIndex * NUM_VERTICES;
+    for (dax::Id vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
+      {
+      vertices[vertexIndex] =
+          connections.Get(startConnectionIndex + vertexIndex);
+      }
+  }
+};
 
 /// The basic data describing the topology of an unstructured grid. It
 /// comprises two arrays: an array of point coordinates and an array of cell
@@ -90,14 +113,9 @@ struct TopologyUnstructured
   DAX_EXEC_EXPORT
   dax::exec::CellVertices<CellTag> GetCellConnections(const IndexType& cellIndex) const
   {
-    const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
-    dax::Id startConnectionIndex = cellIndex * NUM_VERTICES;
     dax::exec::CellVertices<CellTag> vertices;
-    for (dax::Id vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
-      {
-      vertices[vertexIndex] =
-          this->CellConnections.Get(startConnectionIndex + vertexIndex);
-      }
+    CellConnectionsPortalTraits<CellConnectionsPortalType>::GetCellConnections(
+          this->CellConnections, cellIndex, vertices);
     return vertices;
   }
 };
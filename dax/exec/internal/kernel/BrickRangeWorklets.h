@@ -0,0 +1,197 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_BrickRangeWorklets_h
+#define __dax_exec_internal_kernel_BrickRangeWorklets_h
+
+#include <dax/Types.h>
+#include <dax/exec/WorkletMapField.h>
+#include <dax/exec/internal/ErrorMessageBuffer.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+namespace detail {
+
+//returns the first cell and number of cells along each axis of a brick. The
+//bricks on the high side of the grid can be smaller than the others.
+DAX_EXEC_EXPORT void BrickCells(dax::Id brick,
+                                const dax::Id3 &brickDimensions,
+                                const dax::Id3 &cellDimensions,
+                                dax::Id brickSize,
+                                dax::Id3 &start,
+                                dax::Id3 &size)
+{
+  start = dax::make_Id3(brick % brickDimensions[0],
+                        (brick / brickDimensions[0]) % brickDimensions[1],
+                        brick / (brickDimensions[0] * brickDimensions[1]));
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    start[axis] *= brickSize;
+    const dax::Id remaining = cellDimensions[axis] - start[axis];
+    size[axis] = (remaining < brickSize) ? remaining : brickSize;
+    }
+}
+
+}
+
+/// Computes the range of a point field over the points of each brick, along
+/// with the number of cells in the brick. Scheduled once per brick.
+template<class FieldPortalType, class RangePortalType, class IdPortalType>
+struct ComputeBrickRanges
+{
+  typedef typename FieldPortalType::ValueType ValueType;
+
+  DAX_CONT_EXPORT ComputeBrickRanges(const FieldPortalType &field,
+                                     const RangePortalType &minimums,
+                                     const RangePortalType &maximums,
+                                     const IdPortalType &cellCounts,
+                                     const dax::Id3 &cellDimensions,
+                                     const dax::Id3 &brickDimensions,
+                                     dax::Id brickSize) :
+    Field(field),
+    Minimums(minimums),
+    Maximums(maximums),
+    CellCounts(cellCounts),
+    CellDimensions(cellDimensions),
+    BrickDimensions(brickDimensions),
+    BrickSize(brickSize)
+  {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id brick) const
+  {
+    dax::Id3 start;
+    dax::Id3 size;
+    detail::BrickCells(brick, this->BrickDimensions, this->CellDimensions,
+                       this->BrickSize, start, size);
+
+    //the points of a brick include the ones shared with the next bricks,
+    //so that the range covers every vertex of every cell in the brick
+    const dax::Id xDim = this->CellDimensions[0] + 1;
+    const dax::Id yDim = this->CellDimensions[1] + 1;
+    ValueType minimum = this->Field.Get(
+          start[0] + xDim*(start[1] + yDim*start[2]));
+    ValueType maximum = minimum;
+    for (dax::Id k = start[2]; k <= start[2] + size[2]; ++k)
+      {
+      for (dax::Id j = start[1]; j <= start[1] + size[1]; ++j)
+        {
+        const dax::Id rowStart = xDim*(j + yDim*k);
+        for (dax::Id i = start[0]; i <= start[0] + size[0]; ++i)
+          {
+          const ValueType value = this->Field.Get(rowStart + i);
+          minimum = (value < minimum) ? value : minimum;
+          maximum = (maximum < value) ? value : maximum;
+          }
+        }
+      }
+
+    this->Minimums.Set(brick, minimum);
+    this->Maximums.Set(brick, maximum);
+    this->CellCounts.Set(brick, size[0]*size[1]*size[2]);
+  }
+
+  DAX_CONT_EXPORT void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &) {  }
+
+  FieldPortalType Field;
+  RangePortalType Minimums;
+  RangePortalType Maximums;
+  IdPortalType CellCounts;
+  dax::Id3 CellDimensions;
+  dax::Id3 BrickDimensions;
+  dax::Id BrickSize;
+};
+
+/// Gives the number of cells of a brick when its range overlaps the queried
+/// range and zero otherwise.
+template<typename T>
+struct CountBrickCandidates : public WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(In), Field(In), Field(Out));
+  typedef _4 ExecutionSignature(_1, _2, _3);
+
+  DAX_CONT_EXPORT CountBrickCandidates(T low, T high) : Low(low), High(high)
+  {  }
+
+  DAX_EXEC_EXPORT dax::Id operator()(T minimum,
+                                     T maximum,
+                                     dax::Id cellCount) const
+  {
+    return (!(this->High < minimum) && !(maximum < this->Low)) ? cellCount : 0;
+  }
+
+  T Low;
+  T High;
+};
+
+/// Converts the brick of each candidate cell, as found with UpperBounds on
+/// the scanned candidate counts, to the index of the cell in the grid.
+template<class IdPortalConstType, class IdPortalType>
+struct BrickCandidatesToCellIds
+{
+  DAX_CONT_EXPORT BrickCandidatesToCellIds(
+      const IdPortalConstType &scannedCounts,
+      const IdPortalConstType &counts,
+      const IdPortalType &cellIds,
+      const dax::Id3 &cellDimensions,
+      const dax::Id3 &brickDimensions,
+      dax::Id brickSize) :
+    ScannedCounts(scannedCounts),
+    Counts(counts),
+    CellIds(cellIds),
+    CellDimensions(cellDimensions),
+    BrickDimensions(brickDimensions),
+    BrickSize(brickSize)
+  {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    const dax::Id brick = this->CellIds.Get(index);
+    const dax::Id local =
+        index - (this->ScannedCounts.Get(brick) - this->Counts.Get(brick));
+
+    dax::Id3 start;
+    dax::Id3 size;
+    detail::BrickCells(brick, this->BrickDimensions, this->CellDimensions,
+                       this->BrickSize, start, size);
+
+    const dax::Id i = start[0] + local % size[0];
+    const dax::Id j = start[1] + (local / size[0]) % size[1];
+    const dax::Id k = start[2] + local / (size[0] * size[1]);
+    this->CellIds.Set(index, i + this->CellDimensions[0]*(
+                        j + this->CellDimensions[1]*k));
+  }
+
+  DAX_CONT_EXPORT void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &) {  }
+
+  IdPortalConstType ScannedCounts;
+  IdPortalConstType Counts;
+  IdPortalType CellIds;
+  dax::Id3 CellDimensions;
+  dax::Id3 BrickDimensions;
+  dax::Id BrickSize;
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+
+#endif // __dax_exec_internal_kernel_BrickRangeWorklets_h
@@ -0,0 +1,478 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_FlyingEdgesWorklets_h
+#define __dax_exec_internal_kernel_FlyingEdgesWorklets_h
+
+#include <dax/Types.h>
+#include <dax/exec/internal/ErrorMessageBuffer.h>
+
+#include <dax/worklet/internal/MarchingCubesTable.h>
+
+//All the kernels here are scheduled once per row of points along the x axis
+//of a uniform grid. The row of the points (j,k) is j + k*dims[1], and the
+//x edges of a row are numbered from the edge between points 0 and 1.
+//The row owns the intersections on its x edges and, at each of its points,
+//on the edges going to the next row in y and in z. The cells of a row are
+//the ones whose lowest point is in the row.
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+namespace detail {
+
+/// Answers the questions the flying edges passes ask about the x edge cases
+/// found by FlyingEdgesClassifyXEdges. An x edge case has bit 0 set when the
+/// first point of the edge is above the isovalue and bit 1 set when the
+/// second point is.
+template<class BytePortalType, class IdPortalType>
+struct FlyingEdgesCases
+{
+  DAX_CONT_EXPORT FlyingEdgesCases(const BytePortalType &edgeCases,
+                                   const IdPortalType &xMins,
+                                   const IdPortalType &xMaxs,
+                                   const dax::Id3 &dims) :
+    EdgeCases(edgeCases),
+    XMins(xMins),
+    XMaxs(xMaxs),
+    Dims(dims)
+  {  }
+
+  DAX_EXEC_EXPORT int GetEdgeCase(dax::Id row, dax::Id i) const
+  {
+    return this->EdgeCases.Get(row*(this->Dims[0]-1) + i);
+  }
+
+  DAX_EXEC_EXPORT bool IsAbove(dax::Id row, dax::Id i) const
+  {
+    return (i < this->Dims[0]-1) ? (this->GetEdgeCase(row, i) & 1) != 0
+                                 : (this->GetEdgeCase(row, i-1) & 2) != 0;
+  }
+
+  DAX_EXEC_EXPORT bool IsXCut(dax::Id row, dax::Id i) const
+  {
+    const int edgeCase = this->GetEdgeCase(row, i);
+    return edgeCase == 1 || edgeCase == 2;
+  }
+
+  DAX_EXEC_EXPORT bool IsCut(dax::Id row, dax::Id nextRow, dax::Id i) const
+  {
+    return this->IsAbove(row, i) != this->IsAbove(nextRow, i);
+  }
+
+  //the marching cubes case of the cell starting at point i of the rows
+  //(j,k), (j+1,k), (j,k+1) and (j+1,k+1), with the vertices ordered as in
+  //dax::CellTagVoxel
+  DAX_EXEC_EXPORT int GetCellCase(const dax::Id rows[4], dax::Id i) const
+  {
+    const int case0 = this->GetEdgeCase(rows[0], i);
+    const int case1 = this->GetEdgeCase(rows[1], i);
+    const int case2 = this->GetEdgeCase(rows[2], i);
+    const int case3 = this->GetEdgeCase(rows[3], i);
+    return (case0 & 1) | (case0 & 2)
+        | ((case1 & 2) << 1) | ((case1 & 1) << 3)
+        | ((case2 & 1) << 4) | ((case2 & 2) << 4)
+        | ((case3 & 2) << 5) | ((case3 & 1) << 7);
+  }
+
+  //finds the range of points [first, last] of the given rows outside of
+  //which no edge between or along the rows is cut. Out of the range of x
+  //edges cut in all the rows each row has a single state, so the ends only
+  //have to be kept when the rows disagree there.
+  DAX_EXEC_EXPORT void GetTrim(const dax::Id *rows,
+                               int numRows,
+                               dax::Id &first,
+                               dax::Id &last) const
+  {
+    first = this->Dims[0]-1;
+    last = 0;
+    bool firstAbove = this->IsAbove(rows[0], 0);
+    bool lastAbove = this->IsAbove(rows[0], this->Dims[0]-1);
+    bool firstSame = true;
+    bool lastSame = true;
+    for (int index = 0; index < numRows; ++index)
+      {
+      const dax::Id xMin = this->XMins.Get(rows[index]);
+      const dax::Id xMax = this->XMaxs.Get(rows[index]);
+      first = (xMin < first) ? xMin : first;
+      last = (last < xMax) ? xMax : last;
+      firstSame &= (this->IsAbove(rows[index], 0) == firstAbove);
+      lastSame &= (this->IsAbove(rows[index], this->Dims[0]-1) == lastAbove);
+      }
+    first = firstSame ? first : 0;
+    last = lastSame ? last : this->Dims[0]-1;
+  }
+
+  //the rows whose edges and cells are handled by the given row, which are
+  //the row itself, the next row in y, the next row in z and the next row in
+  //both. Returns how many of those exist.
+  DAX_EXEC_EXPORT int GetRows(dax::Id row, dax::Id rows[4]) const
+  {
+    const bool hasY = (row % this->Dims[1]) < this->Dims[1]-1;
+    const bool hasZ = (row / this->Dims[1]) < this->Dims[2]-1;
+    int numRows = 0;
+    rows[numRows++] = row;
+    if (hasY) { rows[numRows++] = row + 1; }
+    if (hasZ) { rows[numRows++] = row + this->Dims[1]; }
+    if (hasY && hasZ) { rows[numRows++] = row + this->Dims[1] + 1; }
+    return numRows;
+  }
+
+  BytePortalType EdgeCases;
+  IdPortalType XMins;
+  IdPortalType XMaxs;
+  dax::Id3 Dims;
+};
+
+}
+
+/// First pass of flying edges: computes the case of every x edge of a row,
+/// the number of them cut by the isosurface and the range of the cut ones.
+/// Rows without cut edges get an empty range.
+template<class FieldPortalType, class BytePortalType, class IdPortalType>
+struct FlyingEdgesClassifyXEdges
+{
+  DAX_CONT_EXPORT FlyingEdgesClassifyXEdges(const FieldPortalType &field,
+                                            dax::Scalar isoValue,
+                                            const BytePortalType &edgeCases,
+                                            const IdPortalType &xCounts,
+                                            const IdPortalType &xMins,
+                                            const IdPortalType &xMaxs,
+                                            const dax::Id3 &dims) :
+    Field(field),
+    IsoValue(isoValue),
+    EdgeCases(edgeCases),
+    XCounts(xCounts),
+    XMins(xMins),
+    XMaxs(xMaxs),
+    Dims(dims)
+  {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id row) const
+  {
+    const dax::Id numEdges = this->Dims[0]-1;
+    const dax::Id firstPoint = row*this->Dims[0];
+    const dax::Id firstEdge = row*numEdges;
+
+    dax::Id count = 0;
+    dax::Id xMin = numEdges;
+    dax::Id xMax = 0;
+    int above = this->Field.Get(firstPoint) > this->IsoValue;
+    for (dax::Id i = 0; i < numEdges; ++i)
+      {
+      const int nextAbove = this->Field.Get(firstPoint+i+1) > this->IsoValue;
+      this->EdgeCases.Set(firstEdge+i,
+                          static_cast<typename BytePortalType::ValueType>(
+                            above | (nextAbove << 1)));
+      if (above != nextAbove)
+        {
+        ++count;
+        xMin = (i < xMin) ? i : xMin;
+        xMax = i+1;
+        }
+      above = nextAbove;
+      }
+
+    this->XCounts.Set(row, count);
+    this->XMins.Set(row, xMin);
+    this->XMaxs.Set(row, xMax);
+  }
+
+  DAX_CONT_EXPORT void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &) {  }
+
+  FieldPortalType Field;
+  dax::Scalar IsoValue;
+  BytePortalType EdgeCases;
+  IdPortalType XCounts;
+  IdPortalType XMins;
+  IdPortalType XMaxs;
+  dax::Id3 Dims;
+};
+
+/// Second pass of flying edges: counts the y and z edges of a row cut by the
+/// isosurface, giving the number of points of the row, and the triangles of
+/// the cells of the row.
+template<class BytePortalType, class IdPortalConstType, class IdPortalType>
+struct FlyingEdgesCountRow
+{
+  typedef detail::FlyingEdgesCases<BytePortalType,IdPortalConstType>
+      CasesType;
+
+  DAX_CONT_EXPORT FlyingEdgesCountRow(const CasesType &cases,
+                                      const IdPortalConstType &xCounts,
+                                      const IdPortalType &yCounts,
+                                      const IdPortalType &pointCounts,
+                                      const IdPortalType &triangleCounts) :
+    Cases(cases),
+    XCounts(xCounts),
+    YCounts(yCounts),
+    PointCounts(pointCounts),
+    TriangleCounts(triangleCounts)
+  {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id row) const
+  {
+    using dax::worklet::internal::marchingcubes::NumFaces;
+
+    dax::Id rows[4];
+    const int numRows = this->Cases.GetRows(row, rows);
+    const bool hasY = (row % this->Cases.Dims[1]) < this->Cases.Dims[1]-1;
+    const bool hasZ = (row / this->Cases.Dims[1]) < this->Cases.Dims[2]-1;
+    const dax::Id yRow = row + 1;
+    const dax::Id zRow = row + this->Cases.Dims[1];
+
+    dax::Id first, last;
+    this->Cases.GetTrim(rows, numRows, first, last);
+
+    dax::Id yCount = 0;
+    dax::Id zCount = 0;
+    dax::Id triangleCount = 0;
+    for (dax::Id i = first; i <= last; ++i)
+      {
+      yCount += (hasY && this->Cases.IsCut(row, yRow, i)) ? 1 : 0;
+      zCount += (hasZ && this->Cases.IsCut(row, zRow, i)) ? 1 : 0;
+      }
+    if (numRows == 4)
+      {
+      for (dax::Id i = first; i < last; ++i)
+        {
+        triangleCount += NumFaces[this->Cases.GetCellCase(rows, i)];
+        }
+      }
+
+    this->YCounts.Set(row, yCount);
+    this->PointCounts.Set(row, this->XCounts.Get(row) + yCount + zCount);
+    this->TriangleCounts.Set(row, triangleCount);
+  }
+
+  DAX_CONT_EXPORT void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &) {  }
+
+  CasesType Cases;
+  IdPortalConstType XCounts;
+  IdPortalType YCounts;
+  IdPortalType PointCounts;
+  IdPortalType TriangleCounts;
+};
+
+/// Last pass of flying edges: writes the points of a row, first the ones on
+/// its x edges then the ones on its y and z edges, each in increasing order
+/// along x, and the triangles of the cells of the row. The ids of the points
+/// of a cell are found by counting the cut edges of the neighbouring rows as
+/// the row is walked, so no search or sort is needed.
+template<class FieldPortalType,
+         class BytePortalType,
+         class IdPortalConstType,
+         class CoordinatesPortalType,
+         class ConnectionsPortalType>
+struct FlyingEdgesGenerate
+{
+  typedef detail::FlyingEdgesCases<BytePortalType,IdPortalConstType>
+      CasesType;
+
+  DAX_CONT_EXPORT FlyingEdgesGenerate(
+      const FieldPortalType &field,
+      dax::Scalar isoValue,
+      const CasesType &cases,
+      const IdPortalConstType &xCounts,
+      const IdPortalConstType &yCounts,
+      const IdPortalConstType &pointOffsets,
+      const IdPortalConstType &triangleOffsets,
+      const dax::Vector3 &origin,
+      const dax::Vector3 &spacing,
+      const CoordinatesPortalType &coordinates,
+      const ConnectionsPortalType &connections) :
+    Field(field),
+    IsoValue(isoValue),
+    Cases(cases),
+    XCounts(xCounts),
+    YCounts(yCounts),
+    PointOffsets(pointOffsets),
+    TriangleOffsets(triangleOffsets),
+    Origin(origin),
+    Spacing(spacing),
+    Coordinates(coordinates),
+    Connections(connections)
+  {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id row) const
+  {
+    dax::Id rows[4];
+    const int numRows = this->Cases.GetRows(row, rows);
+    const bool hasY = (row % this->Cases.Dims[1]) < this->Cases.Dims[1]-1;
+    const bool hasZ = (row / this->Cases.Dims[1]) < this->Cases.Dims[2]-1;
+    const dax::Id yRow = row + 1;
+    const dax::Id zRow = row + this->Cases.Dims[1];
+
+    dax::Id first, last;
+    this->Cases.GetTrim(rows, numRows, first, last);
+
+    const dax::Id3 rowStart = dax::make_Id3(0,
+                                            row % this->Cases.Dims[1],
+                                            row / this->Cases.Dims[1]);
+
+    dax::Id pointId = this->PointOffsets.Get(row);
+    for (dax::Id i = this->Cases.XMins.Get(row);
+         i < this->Cases.XMaxs.Get(row);
+         ++i)
+      {
+      if (this->Cases.IsXCut(row, i))
+        {
+        this->WritePoint(pointId++, rowStart, i, 0, 1);
+        }
+      }
+    for (dax::Id i = first; hasY && i <= last; ++i)
+      {
+      if (this->Cases.IsCut(row, yRow, i))
+        {
+        this->WritePoint(pointId++, rowStart, i, 1, this->Cases.Dims[0]);
+        }
+      }
+    for (dax::Id i = first; hasZ && i <= last; ++i)
+      {
+      if (this->Cases.IsCut(row, zRow, i))
+        {
+        this->WritePoint(pointId++, rowStart, i, 2,
+                         this->Cases.Dims[0]*this->Cases.Dims[1]);
+        }
+      }
+
+    if (numRows == 4)
+      {
+      this->WriteTriangles(row, rows, first, last);
+      }
+  }
+
+  DAX_CONT_EXPORT void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &) {  }
+
+private:
+  //writes the point cutting the edge starting at point i of the row and
+  //going along the given axis, whose other end is pointStep points after
+  DAX_EXEC_EXPORT void WritePoint(dax::Id pointId,
+                                  dax::Id3 ijk,
+                                  dax::Id i,
+                                  int axis,
+                                  dax::Id pointStep) const
+  {
+    ijk[0] = i;
+    const dax::Id pointA =
+        i + this->Cases.Dims[0]*(ijk[1] + this->Cases.Dims[1]*ijk[2]);
+    const dax::Scalar valueA = this->Field.Get(pointA);
+    const dax::Scalar valueB = this->Field.Get(pointA + pointStep);
+    const dax::Scalar weight = (this->IsoValue - valueA) / (valueB - valueA);
+
+    dax::Vector3 coordinates;
+    for (int component = 0; component < 3; ++component)
+      {
+      coordinates[component] =
+          this->Origin[component] + this->Spacing[component]*ijk[component];
+      }
+    const dax::Scalar end =
+        this->Origin[axis] + this->Spacing[axis]*(ijk[axis]+1);
+    coordinates[axis] += weight*(end - coordinates[axis]);
+    this->Coordinates.Set(pointId, coordinates);
+  }
+
+  DAX_EXEC_EXPORT void WriteTriangles(dax::Id row,
+                                      const dax::Id rows[4],
+                                      dax::Id first,
+                                      dax::Id last) const
+  {
+    using dax::worklet::internal::marchingcubes::NumFaces;
+    using dax::worklet::internal::marchingcubes::TriTable;
+
+    //the first id of the points on the x edges of the four rows, on the
+    //y edges of rows (j,k) and (j,k+1) and on the z edges of rows (j,k) and
+    //(j+1,k). No edge before first is cut, so these are the ids of the
+    //next cut edges.
+    dax::Id xIds[4];
+    for (int index = 0; index < 4; ++index)
+      {
+      xIds[index] = this->PointOffsets.Get(rows[index]);
+      }
+    dax::Id yIds[2] = { xIds[0] + this->XCounts.Get(rows[0]),
+                        xIds[2] + this->XCounts.Get(rows[2]) };
+    dax::Id zIds[2] = { yIds[0] + this->YCounts.Get(rows[0]),
+                        xIds[1] + this->XCounts.Get(rows[1])
+                        + this->YCounts.Get(rows[1]) };
+    const dax::Id yRows[2][2] = { { rows[0], rows[1] }, { rows[2], rows[3] } };
+    const dax::Id zRows[2][2] = { { rows[0], rows[2] }, { rows[1], rows[3] } };
+
+    dax::Id triangle = this->TriangleOffsets.Get(row);
+    for (dax::Id i = first; i < last; ++i)
+      {
+      bool yCuts[2], zCuts[2];
+      for (int index = 0; index < 2; ++index)
+        {
+        yCuts[index] = this->Cases.IsCut(yRows[index][0], yRows[index][1], i);
+        zCuts[index] = this->Cases.IsCut(zRows[index][0], zRows[index][1], i);
+        }
+
+      //the point ids on the edges of the cell, numbered like the edges of
+      //the marching cubes tables
+      const dax::Id edgeIds[12] = {
+        xIds[0], yIds[0] + yCuts[0], xIds[1], yIds[0],
+        xIds[2], yIds[1] + yCuts[1], xIds[3], yIds[1],
+        zIds[0], zIds[0] + zCuts[0], zIds[1] + zCuts[1], zIds[1] };
+
+      const int cellCase = this->Cases.GetCellCase(rows, i);
+      const int numFaces = NumFaces[cellCase];
+      for (int face = 0; face < numFaces; ++face, ++triangle)
+        {
+        for (int vertex = 0; vertex < 3; ++vertex)
+          {
+          this->Connections.Set(
+                3*triangle + vertex,
+                static_cast<typename ConnectionsPortalType::ValueType>(
+                  edgeIds[TriTable[cellCase][3*face + vertex]]));
+          }
+        }
+
+      for (int index = 0; index < 4; ++index)
+        {
+        xIds[index] += this->Cases.IsXCut(rows[index], i) ? 1 : 0;
+        }
+      for (int index = 0; index < 2; ++index)
+        {
+        yIds[index] += yCuts[index] ? 1 : 0;
+        zIds[index] += zCuts[index] ? 1 : 0;
+        }
+      }
+  }
+
+  FieldPortalType Field;
+  dax::Scalar IsoValue;
+  CasesType Cases;
+  IdPortalConstType XCounts;
+  IdPortalConstType YCounts;
+  IdPortalConstType PointOffsets;
+  IdPortalConstType TriangleOffsets;
+  dax::Vector3 Origin;
+  dax::Vector3 Spacing;
+  CoordinatesPortalType Coordinates;
+  ConnectionsPortalType Connections;
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+
+#endif // __dax_exec_internal_kernel_FlyingEdgesWorklets_h
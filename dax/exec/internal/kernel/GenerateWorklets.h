@@ -17,6 +17,7 @@
 #define __dax_exec_internal_kernel_GenerateWorklets_h
 
 #include <dax/Types.h>
+#include <dax/exec/InterpolatedCellPoints.h>
 #include <dax/exec/WorkletMapField.h>
 #include <dax/math/VectorAnalysis.h>
 
@@ -48,59 +49,266 @@ struct Index : public WorkletMapField
   }
 };
 
-struct GetUsedPointsFunctor : public WorkletMapField
+struct CountToOffset : public WorkletMapField
 {
-  typedef void ControlSignature(Field(Out));
-  typedef void ExecutionSignature(_1);
+  typedef void ControlSignature(Field(In),Field(Out));
+  typedef _2 ExecutionSignature(_1);
 
-  template<typename T>
-  DAX_EXEC_EXPORT void operator()(T& t) const
+  DAX_EXEC_EXPORT dax::Id operator()(dax::Id count) const
+  {
+    return count;
+  }
+};
+
+//used with a permutation of the ids to gather them
+struct CopyId : public WorkletMapField
+{
+  typedef void ControlSignature(Field(In),Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT dax::Id operator()(dax::Id id) const
   {
-    t = static_cast<T>(1);
+    return id;
   }
 };
 
-template<class InVec3PortalType, class OutVec3PortalType>
-struct InterpolateEdgesToPoint
+//marks each point the connections refer to in the point mask. Points used
+//by several cells are marked several times, but always with the same value.
+template<class ConnectionsPortalType, class MaskPortalType>
+struct MarkUsedPoints
+  {
+    typedef typename MaskPortalType::ValueType MaskType;
+
+    DAX_CONT_EXPORT MarkUsedPoints(const ConnectionsPortalType &connections,
+                                   const MaskPortalType &mask) :
+    Connections(connections),
+    Mask(mask)
+    {  }
+
+    DAX_EXEC_EXPORT void operator()(dax::Id index) const
+    {
+      Mask.Set(static_cast<dax::Id>(Connections.Get(index)), MaskType(1));
+    }
+
+    DAX_CONT_EXPORT void SetErrorMessageBuffer(
+        const dax::exec::internal::ErrorMessageBuffer &) {  }
+
+    ConnectionsPortalType Connections;
+    MaskPortalType Mask;
+  };
+
+//replaces each point id in the connections with the new id of that point
+template<class PointMapPortalType, class ConnectionsPortalType>
+struct RenumberPoints
+  {
+    typedef typename ConnectionsPortalType::ValueType ConnectivityType;
+
+    DAX_CONT_EXPORT RenumberPoints(const PointMapPortalType &pointMap,
+                                   const ConnectionsPortalType &connections) :
+    PointMap(pointMap),
+    Connections(connections)
+    {  }
+
+    DAX_EXEC_EXPORT void operator()(dax::Id index) const
+    {
+      const dax::Id pointId = static_cast<dax::Id>(Connections.Get(index));
+      Connections.Set(index,
+                      static_cast<ConnectivityType>(PointMap.Get(pointId)));
+    }
+
+    DAX_CONT_EXPORT void SetErrorMessageBuffer(
+        const dax::exec::internal::ErrorMessageBuffer &) {  }
+
+    PointMapPortalType PointMap;
+    ConnectionsPortalType Connections;
+  };
+
+//the end of a list of fields moved together by the compaction and
+//interpolation kernels
+struct NoFieldPortals
+  {
+    DAX_EXEC_EXPORT void Copy(dax::Id, dax::Id) const {  }
+    DAX_EXEC_EXPORT void Interpolate(const dax::exec::InterpolationEdge &,
+                                     dax::Id) const {  }
+  };
+
+//a list of input and output fields moved together by the compaction and
+//interpolation kernels, so that any number of fields of any value types are
+//copied or interpolated in one pass
+template<class InFieldPortalType, class OutFieldPortalType,
+         class NextType = NoFieldPortals>
+struct FieldPortalPair
   {
-    DAX_CONT_EXPORT InterpolateEdgesToPoint(const InVec3PortalType &coords,
-                                            const OutVec3PortalType &interpCoords) :
-    Coords(coords),
-    InterpCoords(interpCoords)
+    typedef typename OutFieldPortalType::ValueType ValueType;
+
+    DAX_CONT_EXPORT FieldPortalPair(const InFieldPortalType &input,
+                                    const OutFieldPortalType &output,
+                                    const NextType &next = NextType()) :
+    Input(input),
+    Output(output),
+    Next(next)
     {  }
 
+    DAX_EXEC_EXPORT void Copy(dax::Id inIndex, dax::Id outIndex) const
+    {
+      Output.Set(outIndex, static_cast<ValueType>(Input.Get(inIndex)));
+      Next.Copy(inIndex, outIndex);
+    }
+
+    DAX_EXEC_EXPORT void Interpolate(const dax::exec::InterpolationEdge &edge,
+                                     dax::Id outIndex) const
+    {
+      const ValueType value1 = static_cast<ValueType>(Input.Get(edge.PointA));
+      const ValueType value2 = static_cast<ValueType>(Input.Get(edge.PointB));
+
+      //written out instead of using Lerp so that any value type works
+      Output.Set(outIndex, static_cast<ValueType>(
+                   value1 + edge.Weight * (value2 - value1)));
+      Next.Interpolate(edge, outIndex);
+    }
+
+    InFieldPortalType Input;
+    OutFieldPortalType Output;
+    NextType Next;
+  };
+
+template<class InFieldPortalType, class OutFieldPortalType>
+DAX_CONT_EXPORT
+FieldPortalPair<InFieldPortalType,OutFieldPortalType>
+make_FieldPortalPair(const InFieldPortalType &input,
+                     const OutFieldPortalType &output)
+{
+  return FieldPortalPair<InFieldPortalType,OutFieldPortalType>(input,output);
+}
+
+template<class InFieldPortalType, class OutFieldPortalType, class NextType>
+DAX_CONT_EXPORT
+FieldPortalPair<InFieldPortalType,OutFieldPortalType,NextType>
+make_FieldPortalPair(const InFieldPortalType &input,
+                     const OutFieldPortalType &output,
+                     const NextType &next)
+{
+  return FieldPortalPair<InFieldPortalType,OutFieldPortalType,NextType>(
+        input,output,next);
+}
+
+//like FieldPortalPair, but the vectors are normalized once interpolated,
+//which turns the gradients of a field at the points into normals
+template<class InFieldPortalType, class OutFieldPortalType,
+         class NextType = NoFieldPortals>
+struct NormalPortalPair
+  {
+    typedef typename OutFieldPortalType::ValueType ValueType;
+
+    DAX_CONT_EXPORT NormalPortalPair(const InFieldPortalType &input,
+                                     const OutFieldPortalType &output,
+                                     const NextType &next = NextType()) :
+    Input(input),
+    Output(output),
+    Next(next)
+    {  }
+
+    DAX_EXEC_EXPORT void Copy(dax::Id inIndex, dax::Id outIndex) const
+    {
+      Output.Set(outIndex, Normalized(Input.Get(inIndex)));
+      Next.Copy(inIndex, outIndex);
+    }
+
+    DAX_EXEC_EXPORT void Interpolate(const dax::exec::InterpolationEdge &edge,
+                                     dax::Id outIndex) const
+    {
+      const ValueType value1 = Input.Get(edge.PointA);
+      const ValueType value2 = Input.Get(edge.PointB);
+      Output.Set(outIndex, Normalized(value1 + edge.Weight * (value2 - value1)));
+      Next.Interpolate(edge, outIndex);
+    }
+
+    //vectors without length, where the gradient vanishes, are kept as is
+    DAX_EXEC_EXPORT static ValueType Normalized(const ValueType &vector)
+    {
+      const dax::Scalar magnitudeSquared = dax::math::MagnitudeSquared(vector);
+      return (magnitudeSquared > 0)
+          ? dax::math::RSqrt(magnitudeSquared) * vector
+          : vector;
+    }
+
+    InFieldPortalType Input;
+    OutFieldPortalType Output;
+    NextType Next;
+  };
+
+//copies the values of each point in the mask to the new id of that point
+template<class MaskPortalType, class PointMapPortalType, class FieldsType>
+struct CompactPointFields
+  {
+    DAX_CONT_EXPORT CompactPointFields(const MaskPortalType &mask,
+                                       const PointMapPortalType &pointMap,
+                                       const FieldsType &fields) :
+    Mask(mask),
+    PointMap(pointMap),
+    Fields(fields)
+    {  }
+
+    DAX_EXEC_EXPORT void operator()(dax::Id index) const
+    {
+      if(Mask.Get(index))
+        {
+        Fields.Copy(index, PointMap.Get(index));
+        }
+    }
+
+    DAX_CONT_EXPORT void SetErrorMessageBuffer(
+        const dax::exec::internal::ErrorMessageBuffer &) {  }
+
+    MaskPortalType Mask;
+    PointMapPortalType PointMap;
+    FieldsType Fields;
+  };
+
+//copies the values of the input cell of each output cell
+template<class CellMapPortalType, class FieldsType>
+struct CompactCellFields
+  {
+    DAX_CONT_EXPORT CompactCellFields(const CellMapPortalType &cellMap,
+                                      const FieldsType &fields) :
+    CellMap(cellMap),
+    Fields(fields)
+    {  }
+
+    DAX_EXEC_EXPORT void operator()(dax::Id index) const
+    {
+      Fields.Copy(CellMap.Get(index), index);
+    }
+
+    DAX_CONT_EXPORT void SetErrorMessageBuffer(
+        const dax::exec::internal::ErrorMessageBuffer &) {  }
+
+    CellMapPortalType CellMap;
+    FieldsType Fields;
+  };
+
+//interpolates point fields (the coordinates or any other) at the points
+//described by the given interpolation edges
+template<class InEdgePortalType, class FieldsType>
+struct InterpolateEdgesToFields
+  {
+    DAX_CONT_EXPORT InterpolateEdgesToFields(
+        const InEdgePortalType &interpInfo,
+        const FieldsType &fields) :
+    InterpInfo(interpInfo),
+    Fields(fields)
+    {  }
 
     DAX_EXEC_EXPORT void operator()(dax::Id index) const
     {
-      const dax::Vector3 pointInterpInfo = InterpCoords.Get(index);
-      //cast the memory location of the pointInterpInfo zero and one
-      //from a scalar to an id. Not a static cast, but instead convert the actual
-      //memory layout from representing a IEEE float to a signed integer. This
-      //works since IEEE float standard states that each float value memory
-      //representation is a valid signed integer.
-      //We do this so that we don't have to worry about the conversion to float
-      //losing any data
-      const dax::Id id1 = *(reinterpret_cast<const dax::Id*>(&(pointInterpInfo[0]) ));
-      const dax::Id id2 = *(reinterpret_cast<const dax::Id*>(&(pointInterpInfo[1]) ));
-      const dax::Vector3 point1 =Coords.Get(id1);
-      const dax::Vector3 point2 =Coords.Get(id2);
-
-      // if(index < 10)
-      //   {
-      //   std::cout << "id1: " << id1 <<  std::endl;
-      //   std::cout << "id2: " << id2 << std::endl;
-      //   std::cout << "w: " << pointInterpInfo[2] << std::endl;
-      //   std::cout << std::endl;
-      //   }
-
-      InterpCoords.Set(index, dax::math::Lerp(point1,point2,pointInterpInfo[2]));
+      Fields.Interpolate(InterpInfo.Get(index), index);
     }
 
     DAX_CONT_EXPORT void SetErrorMessageBuffer(
         const dax::exec::internal::ErrorMessageBuffer &) {  }
 
-    InVec3PortalType Coords;
-    OutVec3PortalType InterpCoords;
+    InEdgePortalType InterpInfo;
+    FieldsType Fields;
   };
 
 }
@@ -19,7 +19,10 @@
 #include <dax/openmp/cont/internal/SetThrustForOpenMP.h>
 
 #include <dax/openmp/cont/internal/DeviceAdapterTagOpenMP.h>
+#include <dax/openmp/cont/internal/ParallelForNumaDomains.h>
 
+#include <dax/cont/ArrayAllocationPolicy.h>
+#include <dax/cont/NumaDomainScheduling.h>
 #include <dax/cont/internal/ArrayManagerExecution.h>
 #include <dax/thrust/cont/internal/ArrayManagerExecutionThrustShare.h>
 
@@ -45,6 +48,51 @@ public:
 
   typedef typename Superclass::ThrustIteratorType ThrustIteratorType;
   typedef typename Superclass::ThrustIteratorConstType ThrustIteratorConstType;
+  typedef typename Superclass::ContainerType ContainerType;
+
+  /// Allocates the output array. When the ArrayAllocationPolicy asks for a
+  /// parallel first touch, large arrays are also initialized with a static
+  /// OpenMP schedule, which matches how thrust splits the worklet loop (or
+  /// with the NUMA domain decomposition, when on), so that each page is
+  /// placed on the NUMA node of the thread that will write it.
+  ///
+  DAX_CONT_EXPORT void AllocateArrayForOutput(ContainerType &controlArray,
+                                              dax::Id numberOfValues)
+  {
+    this->Superclass::AllocateArrayForOutput(controlArray, numberOfValues);
+
+    const dax::cont::ArrayAllocationPolicy &policy =
+        dax::cont::GetArrayAllocationPolicy();
+    if (policy.ParallelFirstTouch
+        && (numberOfValues*sizeof(ValueType) >= policy.LargeArrayThreshold))
+      {
+      ThrustIteratorType begin = this->GetPortal().GetIteratorBegin();
+      if (dax::cont::GetNumaDomainScheduling())
+        {
+        dax::openmp::cont::internal::ParallelForNumaDomains(
+              numberOfValues, 1, FirstTouchFunctor(begin));
+        return;
+        }
+#pragma omp parallel for schedule(static)
+      for (dax::Id index = 0; index < numberOfValues; index++)
+        {
+        begin[index] = ValueType();
+        }
+      }
+  }
+
+private:
+  struct FirstTouchFunctor
+  {
+    FirstTouchFunctor(ThrustIteratorType begin) : Begin(begin) {  }
+
+    void operator()(dax::Id index) const
+    {
+      this->Begin[index] = ValueType();
+    }
+
+    ThrustIteratorType Begin;
+  };
 };
 
 }
@@ -20,7 +20,10 @@
 
 #include <dax/openmp/cont/internal/DeviceAdapterTagOpenMP.h>
 #include <dax/openmp/cont/internal/ArrayManagerExecutionOpenMP.h>
+#include <dax/openmp/cont/internal/ParallelForNumaDomains.h>
 
+#include <dax/cont/ErrorExecution.h>
+#include <dax/cont/NumaDomainScheduling.h>
 #include <dax/cont/internal/DeviceAdapterAlgorithm.h>
 
 // Here are the actual implementation of the algorithms.
@@ -83,6 +86,34 @@ private:
     dax::exec::internal::ErrorMessageBuffer ErrorMessage;
   };
 
+  // Runs the schedule decomposed over NUMA domains (see
+  // dax::cont::SetNumaDomainScheduling). Thread ranges are aligned to
+  // granularity so that a 3D schedule is split on k planes.
+  template<class FunctorType>
+  DAX_CONT_EXPORT
+  static void ScheduleNumaDomains(FunctorType functor,
+                                  dax::Id numInstances,
+                                  dax::Id granularity)
+  {
+    const dax::Id MESSAGE_SIZE = 1024;
+    char errorString[MESSAGE_SIZE];
+    errorString[0] = '\0';
+    dax::exec::internal::ErrorMessageBuffer
+        errorMessage(errorString, MESSAGE_SIZE);
+
+    ScheduleKernel<FunctorType> kernel(functor);
+    kernel.SetErrorMessageBuffer(errorMessage);
+
+    dax::openmp::cont::internal::ParallelForNumaDomains(numInstances,
+                                                        granularity,
+                                                        kernel);
+
+    if (errorMessage.IsErrorRaised())
+      {
+      throw dax::cont::ErrorExecution(errorString);
+      }
+  }
+
 public:
   // Override the thrust version of Schedule to handle exceptions that can occur
   // because we are running on a CPU.
@@ -90,6 +121,11 @@ public:
   DAX_CONT_EXPORT
   static void Schedule(FunctorType functor, dax::Id numInstances)
   {
+    if (dax::cont::GetNumaDomainScheduling())
+      {
+      ScheduleNumaDomains(functor, numInstances, 1);
+      return;
+      }
      Superclass::Schedule(
            DeviceAdapterAlgorithm::ScheduleKernel<FunctorType>(functor),
            numInstances);
@@ -99,6 +135,13 @@ public:
   DAX_CONT_EXPORT
   static void Schedule(FunctorType functor, dax::Id3 rangeMax)
   {
+    if (dax::cont::GetNumaDomainScheduling())
+      {
+      ScheduleNumaDomains(functor,
+                          rangeMax[0]*rangeMax[1]*rangeMax[2],
+                          rangeMax[0]*rangeMax[1]);
+      return;
+      }
     //default behavior for the general algorithm is to defer to the default
     //schedule implementation.
     Superclass::Schedule(
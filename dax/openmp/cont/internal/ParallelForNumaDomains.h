@@ -0,0 +1,88 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_openmp_cont_internal_ParallelForNumaDomains_h
+#define __dax_openmp_cont_internal_ParallelForNumaDomains_h
+
+#include <dax/Types.h>
+#include <dax/cont/internal/NumaDomains.h>
+
+#include <omp.h>
+
+namespace dax {
+namespace openmp {
+namespace cont {
+namespace internal {
+
+/// Pins the calling OpenMP thread to \c domain unless it was already pinned
+/// there by a previous schedule. OpenMP keeps its thread pool between
+/// parallel regions, so the pinning is usually done only once per thread.
+///
+DAX_CONT_EXPORT
+void PinThreadToNumaDomain(int domain)
+{
+  static int pinnedDomain = -1;
+#pragma omp threadprivate(pinnedDomain)
+  if (pinnedDomain != domain)
+    {
+    dax::cont::internal::NumaDomains::Get().PinCurrentThread(domain);
+    pinnedDomain = domain;
+    }
+}
+
+/// Calls \c functor for every index in [0, \c numberOfValues). The team is
+/// split into one block of threads per NUMA domain, each thread is pinned to
+/// its domain, and each thread runs a fixed contiguous range whose
+/// boundaries fall on multiples of \c granularity. The threads of a domain
+/// therefore cover a contiguous slab, and a schedule of the same size always
+/// gives each thread the same range. Note that the calling thread, which is
+/// the first thread of the team, is pinned as well.
+///
+template<class FunctorType>
+DAX_CONT_EXPORT
+void ParallelForNumaDomains(dax::Id numberOfValues,
+                            dax::Id granularity,
+                            const FunctorType &functor)
+{
+  const dax::cont::internal::NumaDomains &domains =
+      dax::cont::internal::NumaDomains::Get();
+#pragma omp parallel
+  {
+    const int numberOfThreads = omp_get_num_threads();
+    const int threadIndex = omp_get_thread_num();
+    PinThreadToNumaDomain(
+          domains.GetDomainOfThread(threadIndex, numberOfThreads));
+
+    dax::Id begin;
+    dax::Id end;
+    dax::cont::internal::NumaDomains::GetThreadRange(threadIndex,
+                                                     numberOfThreads,
+                                                     numberOfValues,
+                                                     granularity,
+                                                     begin,
+                                                     end);
+    for (dax::Id index = begin; index < end; index++)
+      {
+      functor(index);
+      }
+  }
+}
+
+}
+}
+}
+} // namespace dax::openmp::cont::internal
+
+#endif //__dax_openmp_cont_internal_ParallelForNumaDomains_h
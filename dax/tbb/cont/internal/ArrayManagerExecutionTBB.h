@@ -17,10 +17,16 @@
 #define __dax_tbb_cont_internal_ArrayManagerExecutionTBB_h
 
 #include <dax/tbb/cont/internal/DeviceAdapterTagTBB.h>
+#include <dax/tbb/cont/internal/ParallelForNumaDomains.h>
 
+#include <dax/cont/ArrayAllocationPolicy.h>
+#include <dax/cont/NumaDomainScheduling.h>
 #include <dax/cont/internal/ArrayManagerExecution.h>
 #include <dax/thrust/cont/internal/ArrayManagerExecutionThrustShare.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 // These must be placed in the dax::cont::internal namespace so that
 // the template can be found.
 
@@ -43,6 +49,57 @@ public:
 
   typedef typename Superclass::ThrustIteratorType ThrustIteratorType;
   typedef typename Superclass::ThrustIteratorConstType ThrustIteratorConstType;
+  typedef typename Superclass::ContainerType ContainerType;
+
+  /// Allocates the output array. When the ArrayAllocationPolicy asks for a
+  /// parallel first touch, large arrays are also initialized with the same
+  /// TBB partitioning used to schedule worklets (including the NUMA domain
+  /// decomposition, when on) so that each page is placed on the NUMA node of
+  /// the thread that will write it.
+  ///
+  DAX_CONT_EXPORT void AllocateArrayForOutput(ContainerType &controlArray,
+                                              dax::Id numberOfValues)
+  {
+    this->Superclass::AllocateArrayForOutput(controlArray, numberOfValues);
+
+    const dax::cont::ArrayAllocationPolicy &policy =
+        dax::cont::GetArrayAllocationPolicy();
+    if (policy.ParallelFirstTouch
+        && (numberOfValues*sizeof(ValueType) >= policy.LargeArrayThreshold))
+      {
+      FirstTouchBody body(this->GetPortal().GetIteratorBegin());
+      if (dax::cont::GetNumaDomainScheduling())
+        {
+        dax::tbb::cont::internal::ParallelForNumaDomains(numberOfValues,
+                                                         128,
+                                                         body);
+        }
+      else
+        {
+        ::tbb::parallel_for(
+              ::tbb::blocked_range<dax::Id>(0, numberOfValues, 128), body);
+        }
+      }
+  }
+
+private:
+  struct FirstTouchBody
+  {
+    FirstTouchBody(ThrustIteratorType begin) : Begin(begin) {  }
+
+    void operator()(const ::tbb::blocked_range<dax::Id> &range) const
+    {
+      ThrustIteratorType end = this->Begin + range.end();
+      for (ThrustIteratorType iter = this->Begin + range.begin();
+           iter != end;
+           iter++)
+        {
+        *iter = ValueType();
+        }
+    }
+
+    ThrustIteratorType Begin;
+  };
 };
 
 }
@@ -18,6 +18,7 @@
 
 #include <dax/tbb/cont/internal/DeviceAdapterTagTBB.h>
 #include <dax/tbb/cont/internal/ArrayManagerExecutionTBB.h>
+#include <dax/tbb/cont/internal/ParallelForNumaDomains.h>
 
 #include <dax/exec/internal/ErrorMessageBuffer.h>
 
@@ -25,6 +26,7 @@
 #include <dax/cont/arg/Topology.h>
 #include <dax/cont/ArrayHandle.h>
 #include <dax/cont/ErrorExecution.h>
+#include <dax/cont/NumaDomainScheduling.h>
 #include <dax/cont/internal/DeviceAdapterAlgorithm.h>
 #include <dax/cont/internal/DeviceAdapterAlgorithmGeneral.h>
 #include <dax/cont/internal/FindBinding.h>
@@ -278,9 +280,18 @@ public:
 
     ScheduleKernel<FunctorType> kernel(functor);
 
-    ::tbb::blocked_range<dax::Id> range(0, numInstances, TBB_GRAIN_SIZE);
+    if (dax::cont::GetNumaDomainScheduling())
+      {
+      dax::tbb::cont::internal::ParallelForNumaDomains(numInstances,
+                                                       TBB_GRAIN_SIZE,
+                                                       kernel);
+      }
+    else
+      {
+      ::tbb::blocked_range<dax::Id> range(0, numInstances, TBB_GRAIN_SIZE);
 
-    ::tbb::parallel_for(range, kernel);
+      ::tbb::parallel_for(range, kernel);
+      }
 
     if (errorMessage.IsErrorRaised())
       {
@@ -340,6 +351,31 @@ public:
     dax::exec::internal::ErrorMessageBuffer ErrorMessage;
   };
 
+  // Runs whole k planes of a 3D schedule so that the planes can be
+  // decomposed over NUMA domains like a flat index space.
+  template<class FunctorType>
+  class ScheduleKernelPlanes
+  {
+  public:
+    DAX_CONT_EXPORT ScheduleKernelPlanes(
+        const ScheduleKernelId3<FunctorType> &kernel,
+        const dax::Id3& dims)
+      : Kernel(kernel),
+        Dims(dims)
+      {  }
+
+    DAX_EXEC_EXPORT
+    void operator()(const ::tbb::blocked_range<dax::Id> &planes) const {
+      this->Kernel(::tbb::blocked_range3d<dax::Id>(planes.begin(),
+                                                   planes.end(),
+                                                   0, this->Dims[1],
+                                                   0, this->Dims[0]));
+    }
+  private:
+    ScheduleKernelId3<FunctorType> Kernel;
+    dax::Id3 Dims;
+  };
+
   template<class FunctorType>
   DAX_CONT_EXPORT
   static void Schedule(FunctorType functor,
@@ -361,7 +397,15 @@ public:
                                           0, rangeMax[0]);
 
     ScheduleKernelId3<FunctorType> kernel(functor,rangeMax);
-    ::tbb::parallel_for(range, kernel);
+    if (dax::cont::GetNumaDomainScheduling())
+      {
+      dax::tbb::cont::internal::ParallelForNumaDomains(
+            rangeMax[2], 1, ScheduleKernelPlanes<FunctorType>(kernel,rangeMax));
+      }
+    else
+      {
+      ::tbb::parallel_for(range, kernel);
+      }
 
     if (errorMessage.IsErrorRaised())
       {
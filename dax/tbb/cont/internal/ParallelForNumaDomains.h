@@ -0,0 +1,269 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_tbb_cont_internal_ParallelForNumaDomains_h
+#define __dax_tbb_cont_internal_ParallelForNumaDomains_h
+
+// Observers attached to a task_arena are a preview feature in the TBB
+// releases before 2017.
+#ifndef TBB_PREVIEW_LOCAL_OBSERVER
+#define TBB_PREVIEW_LOCAL_OBSERVER 1
+#endif
+
+#include <dax/Types.h>
+#include <dax/cont/internal/NumaDomains.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#include <tbb/task_scheduler_observer.h>
+
+#include <vector>
+
+namespace dax {
+namespace tbb {
+namespace cont {
+namespace internal {
+
+/// Pins every thread that joins the task arena of a NUMA domain to the cpus
+/// of that domain. TBB workers move between arenas, and the control thread
+/// joins an arena to wait for it, so the previous affinity of a thread is
+/// restored when it leaves.
+///
+class NumaDomainArenaObserver : public ::tbb::task_scheduler_observer
+{
+public:
+  NumaDomainArenaObserver(::tbb::task_arena &arena, int domain)
+    : ::tbb::task_scheduler_observer(arena), Domain(domain)
+  {
+    this->observe(true);
+  }
+
+  ~NumaDomainArenaObserver()
+  {
+    this->observe(false);
+  }
+
+  virtual void on_scheduler_entry(bool)
+  {
+    dax::cont::internal::NumaDomains::SaveCurrentThreadAffinity(
+          this->SavedAffinity.local());
+    dax::cont::internal::NumaDomains::Get().PinCurrentThread(this->Domain);
+  }
+
+  virtual void on_scheduler_exit(bool)
+  {
+    dax::cont::internal::NumaDomains::RestoreCurrentThreadAffinity(
+          this->SavedAffinity.local());
+  }
+
+private:
+  int Domain;
+  ::tbb::enumerable_thread_specific<
+      dax::cont::internal::NumaDomains::ThreadAffinity> SavedAffinity;
+};
+
+/// The state kept between schedules: for each domain a task arena with as
+/// many slots as the domain has cpus, the observer pinning the threads of
+/// that arena, and an affinity partitioner. Only the threads of a domain's
+/// arena run the slab of that domain. The partitioner additionally replays
+/// the chunk-to-thread assignment within the slab the next time a slab of
+/// the same size is scheduled.
+///
+class NumaDomainScheduleState
+{
+public:
+  static NumaDomainScheduleState &Get()
+  {
+    static NumaDomainScheduleState state;
+    return state;
+  }
+
+  int GetNumberOfDomains() const
+  {
+    return static_cast<int>(this->Arenas.size());
+  }
+
+  ::tbb::task_arena &GetArena(int domain) { return *this->Arenas[domain]; }
+
+  ::tbb::task_group &GetTaskGroup(int domain)
+  {
+    return *this->TaskGroups[domain];
+  }
+
+  ::tbb::affinity_partitioner &GetPartitioner(int domain)
+  {
+    return *this->Partitioners[domain];
+  }
+
+  ~NumaDomainScheduleState()
+  {
+    for (int domain = 0; domain < this->GetNumberOfDomains(); domain++)
+      {
+      // The observer has to stop observing before its arena goes away.
+      delete this->Observers[domain];
+      delete this->TaskGroups[domain];
+      delete this->Partitioners[domain];
+      delete this->Arenas[domain];
+      }
+  }
+
+private:
+  NumaDomainScheduleState()
+  {
+    const dax::cont::internal::NumaDomains &domains =
+        dax::cont::internal::NumaDomains::Get();
+    for (int domain = 0; domain < domains.GetNumberOfDomains(); domain++)
+      {
+      const int numberOfCpus = domains.GetNumberOfCpus(domain);
+      ::tbb::task_arena *arena = (numberOfCpus > 0)
+          ? new ::tbb::task_arena(numberOfCpus)
+          : new ::tbb::task_arena();
+      this->Arenas.push_back(arena);
+      this->Observers.push_back(new NumaDomainArenaObserver(*arena, domain));
+      this->TaskGroups.push_back(new ::tbb::task_group);
+      this->Partitioners.push_back(new ::tbb::affinity_partitioner);
+      }
+  }
+
+  // Not implemented.
+  NumaDomainScheduleState(const NumaDomainScheduleState &);
+  void operator=(const NumaDomainScheduleState &);
+
+  std::vector< ::tbb::task_arena *> Arenas;
+  std::vector<NumaDomainArenaObserver *> Observers;
+  std::vector< ::tbb::task_group *> TaskGroups;
+  std::vector< ::tbb::affinity_partitioner *> Partitioners;
+};
+
+/// Runs the slab of one domain. It is run as a task of the task group of
+/// that domain, so the parallel_for splits the slab among the threads of
+/// the domain's arena only.
+///
+template<class BodyType>
+class NumaDomainSlabTask
+{
+public:
+  NumaDomainSlabTask(const BodyType &body,
+                     int domain,
+                     dax::Id begin,
+                     dax::Id end,
+                     dax::Id grainSize)
+    : Body(body), Domain(domain), Begin(begin), End(end),
+      GrainSize(grainSize) {  }
+
+  void operator()() const
+  {
+    ::tbb::parallel_for(
+          ::tbb::blocked_range<dax::Id>(this->Begin, this->End,
+                                        this->GrainSize),
+          this->Body,
+          NumaDomainScheduleState::Get().GetPartitioner(this->Domain));
+  }
+
+private:
+  BodyType Body;
+  int Domain;
+  dax::Id Begin;
+  dax::Id End;
+  dax::Id GrainSize;
+};
+
+/// Executed in the arena of a domain to start its slab without waiting for
+/// it, so that the slabs of all the domains run at the same time.
+///
+template<class BodyType>
+class NumaDomainStartSlab
+{
+public:
+  NumaDomainStartSlab(const NumaDomainSlabTask<BodyType> &task, int domain)
+    : Task(task), Domain(domain) {  }
+
+  void operator()() const
+  {
+    NumaDomainScheduleState::Get().GetTaskGroup(this->Domain).run(this->Task);
+  }
+
+private:
+  NumaDomainSlabTask<BodyType> Task;
+  int Domain;
+};
+
+/// Executed in the arena of a domain to wait for its slab.
+///
+class NumaDomainWaitSlab
+{
+public:
+  NumaDomainWaitSlab(int domain) : Domain(domain) {  }
+
+  void operator()() const
+  {
+    NumaDomainScheduleState::Get().GetTaskGroup(this->Domain).wait();
+  }
+
+private:
+  int Domain;
+};
+
+/// Runs \c body (a TBB body taking a <tt>blocked_range<dax::Id></tt>) over
+/// [0, \c numberOfValues) decomposed into one slab per NUMA domain. Each
+/// slab runs in the task arena of its domain, whose threads are pinned to
+/// the cpus of that domain, and the slabs of all domains run concurrently.
+/// \c grainSize is the TBB grain size of the split within a slab.
+///
+/// The task groups of the domains are shared, so schedules must not be
+/// started from several threads at once in this mode.
+///
+template<class BodyType>
+DAX_CONT_EXPORT
+void ParallelForNumaDomains(dax::Id numberOfValues,
+                            dax::Id grainSize,
+                            const BodyType &body)
+{
+  const dax::cont::internal::NumaDomains &domains =
+      dax::cont::internal::NumaDomains::Get();
+  NumaDomainScheduleState &state = NumaDomainScheduleState::Get();
+
+  std::vector<bool> started(state.GetNumberOfDomains(), false);
+  for (int domain = 0; domain < state.GetNumberOfDomains(); domain++)
+    {
+    dax::Id begin;
+    dax::Id end;
+    domains.GetDomainRange(domain, numberOfValues, 1, begin, end);
+    if (begin >= end) { continue; }
+    state.GetArena(domain).execute(
+          NumaDomainStartSlab<BodyType>(
+            NumaDomainSlabTask<BodyType>(body, domain, begin, end, grainSize),
+            domain));
+    started[domain] = true;
+    }
+  for (int domain = 0; domain < state.GetNumberOfDomains(); domain++)
+    {
+    if (started[domain])
+      {
+      state.GetArena(domain).execute(NumaDomainWaitSlab(domain));
+      }
+    }
+}
+
+}
+}
+}
+} // namespace dax::tbb::cont::internal
+
+#endif //__dax_tbb_cont_internal_ParallelForNumaDomains_h
@@ -285,9 +285,22 @@ struct TypeTestFunctor
   }
 };
 
+void TestConnectivityId()
+{
+  DAX_TEST_ASSERT(sizeof(dax::ConnectivityId) == DAX_SIZE_CONNECTIVITY_ID,
+                  "ConnectivityId has the wrong size.");
+  DAX_TEST_ASSERT(sizeof(dax::ConnectivityId) <= sizeof(dax::Id),
+                  "ConnectivityId is wider than Id.");
+#if defined(DAX_USE_64BIT_IDS) && !defined(DAX_USE_64BIT_CONNECTIVITY_IDS)
+  DAX_TEST_ASSERT(sizeof(dax::ConnectivityId) == 4,
+                  "ConnectivityId should stay 32 bits with 64-bit ids.");
+#endif
+}
+
 void TestTypes()
 {
   dax::internal::Testing::TryAllTypes(TypeTestFunctor());
+  TestConnectivityId();
 }
 
 } // anonymous namespace
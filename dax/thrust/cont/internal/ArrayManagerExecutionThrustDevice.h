@@ -22,6 +22,8 @@
 
 #include <dax/exec/internal/ArrayPortalFromIterators.h>
 
+#include <algorithm>
+
 // Disable GCC warnings we check Dax for but Thrust does not.
 #if defined(__GNUC__) && !defined(DAX_CUDA)
 #if (__GNUC__ >= 4) && (__GNUC_MINOR__ >= 6)
@@ -139,6 +141,28 @@ public:
     this->Array.resize(numberOfValues);
   }
 
+  /// Makes room in the device vector for \c numberOfValues values.
+  ///
+  DAX_CONT_EXPORT void Reserve(ContainerType &daxNotUsed(container),
+                               dax::Id numberOfValues)
+  {
+    this->Array.reserve(numberOfValues);
+  }
+
+  /// Grows the device vector, keeping its values. The capacity is at least
+  /// doubled each time the vector is reallocated.
+  ///
+  DAX_CONT_EXPORT void Grow(ContainerType &daxNotUsed(container),
+                            dax::Id numberOfValues)
+  {
+    const dax::Id capacity = static_cast<dax::Id>(this->Array.capacity());
+    if (numberOfValues > capacity)
+      {
+      this->Array.reserve(std::max(numberOfValues, 2*capacity));
+      }
+    this->Array.resize(numberOfValues);
+  }
+
   DAX_CONT_EXPORT PortalType GetPortal()
   {
     return PortalType(::thrust::raw_pointer_cast(&(*this->Array.begin())),
@@ -229,6 +229,16 @@ private:
                    IteratorBegin(output));
   }
 
+  template<class InputPortal, class OutputPortal>
+  DAX_CONT_EXPORT static void AppendPortal(const InputPortal &input,
+                                           const OutputPortal &output,
+                                           dax::Id outputOffset)
+  {
+    ::thrust::copy(IteratorBegin(input),
+                   IteratorEnd(input),
+                   IteratorBegin(output) + outputOffset);
+  }
+
   template<class InputPortal, class ValuesPortal, class OutputPortal>
   DAX_CONT_EXPORT static void LowerBoundsPortal(const InputPortal &input,
                                                 const ValuesPortal &values,
@@ -424,11 +434,26 @@ public:
                output.PrepareForOutput(numberOfValues));
   }
 
-  template<typename T, class CIn, class CVal, class COut>
+  template<typename T, class CIn, class COut>
+  DAX_CONT_EXPORT static void Append(
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTag> &output)
+  {
+    dax::Id inputSize = input.GetNumberOfValues();
+    dax::Id outputSize = output.GetNumberOfValues();
+    if (inputSize < 1) { return; }
+
+    output.Grow(outputSize + inputSize);
+    AppendPortal(input.PrepareForInput(),
+                 output.PrepareForInPlace(),
+                 outputSize);
+  }
+
+  template<typename T, typename U, class CIn, class CVal, class COut>
   DAX_CONT_EXPORT static void LowerBounds(
       const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag>& input,
       const dax::cont::ArrayHandle<T,CVal,DeviceAdapterTag>& values,
-      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag>& output)
+      dax::cont::ArrayHandle<U,COut,DeviceAdapterTag>& output)
   {
     dax::Id numberOfValues = values.GetNumberOfValues();
     LowerBoundsPortal(input.PrepareForInput(),
@@ -436,11 +461,11 @@ public:
                       output.PrepareForOutput(numberOfValues));
   }
 
-  template<typename T, class CIn, class CVal, class COut, class Compare>
+  template<typename T, typename U, class CIn, class CVal, class COut, class Compare>
   DAX_CONT_EXPORT static void LowerBounds(
       const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag>& input,
       const dax::cont::ArrayHandle<T,CVal,DeviceAdapterTag>& values,
-      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag>& output,
+      dax::cont::ArrayHandle<U,COut,DeviceAdapterTag>& output,
       Compare comp)
   {
     dax::Id numberOfValues = values.GetNumberOfValues();
@@ -450,10 +475,10 @@ public:
                       comp);
   }
 
-  template<class CIn, class COut>
+  template<typename T, class CIn, class COut>
   DAX_CONT_EXPORT static void LowerBounds(
-      const dax::cont::ArrayHandle<dax::Id,CIn,DeviceAdapterTag> &input,
-      dax::cont::ArrayHandle<dax::Id,COut,DeviceAdapterTag> &values_output)
+      const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,COut,DeviceAdapterTag> &values_output)
   {
     LowerBoundsPortal(input.PrepareForInput(),
                       values_output.PrepareForInPlace());
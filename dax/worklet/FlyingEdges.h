@@ -0,0 +1,53 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __FlyingEdges_worklet_
+#define __FlyingEdges_worklet_
+
+#include <dax/Types.h>
+#include <dax/exec/WorkletFlyingEdges.h>
+
+namespace dax {
+namespace worklet {
+
+// -----------------------------------------------------------------------------
+/// Isosurface of a point field of a uniform grid with the flying edges
+/// algorithm. It gives the same triangles as MarchingCubesClassify and
+/// MarchingCubesTopology with merged points, but in a single invoke that
+/// needs no sort or search:
+///
+/// \code
+/// dax::cont::UnstructuredGrid<dax::CellTagTriangle> outGrid;
+/// scheduler.Invoke(dax::worklet::FlyingEdges(isoValue),
+///                  uniformGrid, outGrid, field);
+/// \endcode
+///
+/// Only dax::cont::UniformGrid inputs are supported.
+class FlyingEdges : public dax::exec::WorkletFlyingEdges
+{
+public:
+  DAX_CONT_EXPORT FlyingEdges(dax::Scalar isoValue)
+    : IsoValue(isoValue) {  }
+
+  DAX_CONT_EXPORT dax::Scalar GetIsoValue() const { return this->IsoValue; }
+
+private:
+  dax::Scalar IsoValue;
+};
+
+}
+} //dax::worklet
+
+#endif
@@ -21,10 +21,12 @@
 #include <dax/CellTraits.h>
 #include <dax/exec/CellField.h>
 #include <dax/exec/CellVertices.h>
+#include <dax/exec/ExecutionWholeArray.h>
 #include <dax/exec/InterpolatedCellPoints.h>
 #include <dax/exec/WorkletInterpolatedCell.h>
 #include <dax/exec/WorkletMapCell.h>
 
+
 #include <dax/worklet/internal/MarchingCubesTable.h>
 
 namespace dax {
@@ -45,6 +47,74 @@ int GetHexahedronClassification(const T isoValue, const U& values )
           (values[7] > isoValue) << 7);
 }
 
+// -----------------------------------------------------------------------------
+//sets the point ids and ratios to interpolate the points of the given
+//triangle of a hexahedron classified by GetHexahedronClassification
+template<class CellTag>
+DAX_EXEC_EXPORT
+void BuildHexahedronTriangle(
+    const dax::exec::CellVertices<CellTag>& verts,
+    dax::exec::InterpolatedCellPoints<dax::CellTagTriangle>& outCell,
+    const dax::exec::CellField<dax::Scalar,CellTag> &values,
+    dax::Scalar isoValue,
+    int voxelClass,
+    dax::Id triangleIndex)
+{
+  using dax::worklet::internal::marchingcubes::EdgeVertices;
+  using dax::worklet::internal::marchingcubes::TriTable;
+
+  for (dax::Id outVertIndex = 0;
+       outVertIndex < outCell.NUM_VERTICES;
+       ++outVertIndex)
+    {
+    const unsigned char edge = TriTable[voxelClass][(triangleIndex*3)+outVertIndex];
+    const int vertA = EdgeVertices[edge][0];
+    const int vertB = EdgeVertices[edge][1];
+
+    // Find the weight for linear interpolation
+    const dax::Scalar weight = (isoValue - values[vertA]) /
+                              (values[vertB]-values[vertA]);
+
+    outCell.SetInterpolationPoint(outVertIndex,
+                                  verts[vertA],
+                                  verts[vertB],
+                                  weight);
+    }
+}
+
+// -----------------------------------------------------------------------------
+//the same as BuildHexahedronTriangle, but the scalars are read from the
+//whole point field so that only the two values of each cut edge are loaded
+template<class CellTag, class FieldType>
+DAX_EXEC_EXPORT
+void BuildHexahedronCaseTriangle(
+    const dax::exec::CellVertices<CellTag>& verts,
+    dax::exec::InterpolatedCellPoints<dax::CellTagTriangle>& outCell,
+    const FieldType &field,
+    dax::Scalar isoValue,
+    int voxelClass,
+    dax::Id triangleIndex)
+{
+  using dax::worklet::internal::marchingcubes::EdgeVertices;
+  using dax::worklet::internal::marchingcubes::TriTable;
+
+  for (dax::Id outVertIndex = 0;
+       outVertIndex < outCell.NUM_VERTICES;
+       ++outVertIndex)
+    {
+    const unsigned char edge = TriTable[voxelClass][(triangleIndex*3)+outVertIndex];
+    const dax::Id pointA = verts[EdgeVertices[edge][0]];
+    const dax::Id pointB = verts[EdgeVertices[edge][1]];
+    const dax::Scalar valueA = static_cast<dax::Scalar>(field.Get(pointA));
+    const dax::Scalar valueB = static_cast<dax::Scalar>(field.Get(pointB));
+
+    outCell.SetInterpolationPoint(outVertIndex,
+                                  pointA,
+                                  pointB,
+                                  (isoValue - valueA) / (valueB - valueA));
+    }
+}
+
 // -----------------------------------------------------------------------------
 class MarchingCubesClassify : public dax::exec::WorkletMapCell
 {
@@ -82,6 +152,22 @@ private:
 
 
 // -----------------------------------------------------------------------------
+/// Generates the triangles of the cells MarchingCubesClassify counted. To
+/// shade the surface, give the gradient of the field at the input points to
+/// GenerateInterpolatedCells::WithPointNormals, which interpolates it along
+/// with the coordinates into one normal per output point:
+///
+/// \code
+/// scheduler.Invoke(dax::worklet::PointGradient(grid), field,
+///                  dax::exec::make_ExecutionWholeArrayConst(
+///                    field.PrepareForInput()),
+///                  gradient);
+/// GenerateInterpolatedCells<MarchingCubesTopology> generate(
+///       classification, MarchingCubesTopology(isoValue));
+/// scheduler.Invoke(generate.WithPointNormals(gradient, normals),
+///                  grid, outGrid, field);
+/// \endcode
+///
 class MarchingCubesTopology : public dax::exec::WorkletInterpolatedCell
 {
 public:
@@ -121,34 +207,250 @@ private:
       dax::Id inputCellVisitIndex,
       dax::CellTagHexahedron) const
   {
-    using dax::worklet::internal::marchingcubes::TriTable;
-    // These should probably be available through the voxel class
-    const unsigned char voxelVertEdges[12][2] ={
-        {0,1}, {1,2}, {3,2}, {0,3},
-        {4,5}, {5,6}, {7,6}, {4,7},
-        {0,4}, {1,5}, {2,6}, {3,7},
-      };
-
     const int voxelClass = GetHexahedronClassification(IsoValue, values);
+    BuildHexahedronTriangle(verts,
+                            outCell,
+                            values,
+                            IsoValue,
+                            voxelClass,
+                            inputCellVisitIndex);
+  }
+};
+// -----------------------------------------------------------------------------
+/// Classifies each cell like MarchingCubesClassify, and also saves the case
+/// of each cell (the bit mask of its points above the isovalue) in the last
+/// argument, an array of unsigned char. MarchingCubesCaseTopology reads the
+/// case back instead of gathering the values of all the points of the cell
+/// and computing it again for every triangle.
+class MarchingCubesCaseClassify : public dax::exec::WorkletMapCell
+{
+public:
+  typedef void ControlSignature(Topology, Field(Point), Field(Out), Field(Out));
+  typedef void ExecutionSignature(_2, _3, _4);
+
+  DAX_CONT_EXPORT MarchingCubesCaseClassify(dax::Scalar isoValue)
+    : IsoValue(isoValue) {  }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  void operator()(
+      const dax::exec::CellField<dax::Scalar,CellTag> &values,
+      dax::Id &numFaces,
+      unsigned char &voxelClass) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    this->Classify(values,
+                   numFaces,
+                   voxelClass,
+                   typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+private:
+  dax::Scalar IsoValue;
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  void Classify(const dax::exec::CellField<dax::Scalar,CellTag> &values,
+                dax::Id &numFaces,
+                unsigned char &voxelClass,
+                dax::CellTagHexahedron) const
+  {
+    voxelClass = static_cast<unsigned char>(
+          GetHexahedronClassification(IsoValue,values));
+    numFaces = dax::worklet::internal::marchingcubes::NumFaces[voxelClass];
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Generates the triangles of a MarchingCubesCaseClassify. The third
+/// argument is the array of cases it saved, which has a value for each cell
+/// of the input grid, so the classification has to cover all the cells.
+/// The point field is passed as a dax::exec::ExecutionWholeArrayConst so that
+/// only the values at the ends of the cut edges are read:
+///
+/// \code
+/// GenerateInterpolatedCells<MarchingCubesCaseTopology> generate(
+///       classification, MarchingCubesCaseTopology(isoValue));
+/// scheduler.Invoke(generate, grid, outGrid, cases,
+///                  dax::exec::make_ExecutionWholeArrayConst(
+///                    field.PrepareForInput()));
+/// \endcode
+///
+class MarchingCubesCaseTopology : public dax::exec::WorkletInterpolatedCell
+{
+public:
+
+  typedef void ControlSignature(Topology, Geometry(Out), Field(Cell,In),
+                                ExecObject());
+  typedef void ExecutionSignature(Vertices(_1), _2, _3, _4, VisitIndex);
+
+  DAX_CONT_EXPORT MarchingCubesCaseTopology(dax::Scalar isoValue)
+    : IsoValue(isoValue){ }
+
+  template<class CellTag, class FieldType>
+  DAX_EXEC_EXPORT void operator()(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTriangle>& outCell,
+      unsigned char voxelClass,
+      const FieldType &field,
+      dax::Id inputCellVisitIndex) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    this->BuildTriangle(
+          verts,
+          outCell,
+          voxelClass,
+          field,
+          inputCellVisitIndex,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
 
-    //save the point ids and ratio to interpolate the points of the new cell
-    for (dax::Id outVertIndex = 0;
-         outVertIndex < outCell.NUM_VERTICES;
-         ++outVertIndex)
+private:
+  dax::Scalar IsoValue;
+
+  template<class CellTag, class FieldType>
+  DAX_EXEC_EXPORT void BuildTriangle(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTriangle>& outCell,
+      unsigned char voxelClass,
+      const FieldType &field,
+      dax::Id inputCellVisitIndex,
+      dax::CellTagHexahedron) const
+  {
+    BuildHexahedronCaseTriangle(verts,
+                                outCell,
+                                field,
+                                IsoValue,
+                                voxelClass,
+                                inputCellVisitIndex);
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Classifies each cell against several isovalues in one pass. The result is
+/// the number of triangles the cell has over all the isovalues, so that all
+/// the surfaces are generated by one MarchingCubesMultiTopology.
+template<int NumIsoValues>
+class MarchingCubesMultiClassify : public dax::exec::WorkletMapCell
+{
+public:
+  typedef void ControlSignature(Topology, Field(Point), Field(Out));
+  typedef _3 ExecutionSignature(_2);
+
+  typedef dax::Tuple<dax::Scalar,NumIsoValues> IsoValuesType;
+
+  DAX_CONT_EXPORT MarchingCubesMultiClassify(const IsoValuesType &isoValues)
+    : IsoValues(isoValues) {  }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Id operator()(
+      const dax::exec::CellField<dax::Scalar,CellTag> &values) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    return this->GetNumFaces(
+          values,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+private:
+  IsoValuesType IsoValues;
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Id GetNumFaces(const dax::exec::CellField<dax::Scalar,CellTag> &values,
+                      dax::CellTagHexahedron) const
+  {
+    dax::Id numFaces = 0;
+    for (int isoIndex = 0; isoIndex < NumIsoValues; ++isoIndex)
       {
-      const unsigned char edge = TriTable[voxelClass][(inputCellVisitIndex*3)+outVertIndex];
-      const int vertA = voxelVertEdges[edge][0];
-      const int vertB = voxelVertEdges[edge][1];
-
-      // Find the weight for linear interpolation
-      const dax::Scalar weight = (IsoValue - values[vertA]) /
-                                (values[vertB]-values[vertA]);
-
-      outCell.SetInterpolationPoint(outVertIndex,
-                                    verts[vertA],
-                                    verts[vertB],
-                                    weight);
+      const int voxelClass =
+          GetHexahedronClassification(this->IsoValues[isoIndex], values);
+      numFaces += dax::worklet::internal::marchingcubes::NumFaces[voxelClass];
       }
+    return numFaces;
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Generates the triangles of all the isovalues of a
+/// MarchingCubesMultiClassify. The triangles of a cell come ordered by
+/// isovalue, and the index of the isovalue of each triangle is written to the
+/// last argument.
+template<int NumIsoValues>
+class MarchingCubesMultiTopology : public dax::exec::WorkletInterpolatedCell
+{
+public:
+
+  typedef void ControlSignature(Topology, Geometry(Out), Field(Point,In),
+                                Field(Out));
+  typedef void ExecutionSignature(Vertices(_1), _2, _3, _4, VisitIndex);
+
+  typedef dax::Tuple<dax::Scalar,NumIsoValues> IsoValuesType;
+
+  DAX_CONT_EXPORT MarchingCubesMultiTopology(const IsoValuesType &isoValues)
+    : IsoValues(isoValues){ }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT void operator()(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTriangle>& outCell,
+      const dax::exec::CellField<dax::Scalar,CellTag> &values,
+      dax::Id &isoValueIndex,
+      dax::Id inputCellVisitIndex) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    this->BuildTriangle(
+          verts,
+          outCell,
+          values,
+          isoValueIndex,
+          inputCellVisitIndex,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+
+private:
+  IsoValuesType IsoValues;
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT void BuildTriangle(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTriangle>& outCell,
+      const dax::exec::CellField<dax::Scalar,CellTag> &values,
+      dax::Id &isoValueIndex,
+      dax::Id inputCellVisitIndex,
+      dax::CellTagHexahedron) const
+  {
+    //skip the triangles of the previous isovalues to find the isovalue
+    //and triangle this visit is for
+    dax::Id triangleIndex = inputCellVisitIndex;
+    int isoIndex = 0;
+    int voxelClass =
+        GetHexahedronClassification(this->IsoValues[isoIndex], values);
+    while (isoIndex < NumIsoValues - 1 &&
+           triangleIndex >=
+           dax::worklet::internal::marchingcubes::NumFaces[voxelClass])
+      {
+      triangleIndex -=
+          dax::worklet::internal::marchingcubes::NumFaces[voxelClass];
+      ++isoIndex;
+      voxelClass =
+          GetHexahedronClassification(this->IsoValues[isoIndex], values);
+      }
+
+    isoValueIndex = isoIndex;
+    BuildHexahedronTriangle(verts,
+                            outCell,
+                            values,
+                            this->IsoValues[isoIndex],
+                            voxelClass,
+                            triangleIndex);
   }
 };
 }
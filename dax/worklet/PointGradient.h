@@ -0,0 +1,91 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __PointGradient_worklet_
+#define __PointGradient_worklet_
+
+#include <dax/Extent.h>
+#include <dax/Types.h>
+#include <dax/exec/WorkletMapField.h>
+
+namespace dax {
+namespace worklet {
+
+// -----------------------------------------------------------------------------
+/// Gradient of a point field of a uniform grid at each of its points. It is
+/// the average of the dax::exec::CellDerivative of the voxels around the
+/// point, taken at the point, which for voxels is a central difference
+/// inside the grid and a one-sided difference on its boundary.
+///
+/// The field is given twice: as the field mapped to the points, and as a
+/// dax::exec::ExecutionWholeArrayConst to read the neighboring values:
+///
+/// \code
+/// scheduler.Invoke(dax::worklet::PointGradient(uniformGrid),
+///                  field,
+///                  dax::exec::make_ExecutionWholeArrayConst(
+///                    field.PrepareForInput()),
+///                  gradient);
+/// \endcode
+///
+/// Only dax::cont::UniformGrid inputs are supported.
+class PointGradient : public dax::exec::WorkletMapField
+{
+public:
+  typedef void ControlSignature(Field(In), ExecObject(), Field(Out));
+  typedef _3 ExecutionSignature(WorkId, _2);
+
+  template<class GridType>
+  DAX_CONT_EXPORT PointGradient(const GridType &grid)
+    : Extent(grid.GetExtent()), Spacing(grid.GetSpacing()) {  }
+
+  template<class FieldType>
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(dax::Id pointIndex, const FieldType &field) const
+  {
+    const dax::Id3 ijk = dax::flatIndexToIndex3(pointIndex, this->Extent);
+    const dax::Id3 dims = dax::extentDimensions(this->Extent);
+    const dax::Id3 strides = dax::make_Id3(1, dims[0], dims[0]*dims[1]);
+
+    dax::Vector3 gradient;
+    for (int component = 0; component < 3; ++component)
+      {
+      const dax::Id low =
+          (ijk[component] > this->Extent.Min[component]) ? 1 : 0;
+      const dax::Id high =
+          (ijk[component] < this->Extent.Max[component]) ? 1 : 0;
+      if (low + high == 0)
+        {
+        gradient[component] = 0;
+        continue;
+        }
+      const dax::Scalar difference =
+          field.Get(pointIndex + high*strides[component]) -
+          field.Get(pointIndex - low*strides[component]);
+      gradient[component] =
+          difference / ((low + high) * this->Spacing[component]);
+      }
+    return gradient;
+  }
+
+private:
+  dax::Extent3 Extent;
+  dax::Vector3 Spacing;
+};
+
+}
+} //dax::worklet
+
+#endif
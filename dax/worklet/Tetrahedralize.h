@@ -23,52 +23,55 @@
 #include <dax/exec/VectorOperations.h>
 #include <dax/exec/WorkletMapCell.h>
 #include <dax/exec/WorkletGenerateTopology.h>
+#include <dax/Extent.h>
 #include <dax/VectorTraits.h>
 
-//to make the lookup table faster on cuda machines, and smaller overall
-//I am going to declare as a constant lookup table
+#include <dax/exec/internal/TetrahedralizeTable.h>
 
 namespace dax { namespace worklet {
 
-namespace detail{
-DAX_EXEC_CONSTANT_EXPORT const unsigned char PossibleTetraSplitCases[10][4] =
-{
-{1,3,6,2},
-{0,1,3,4},
-{1,4,5,6},
-{3,6,7,4},
-{1,4,6,3},
-{2,1,5,0},
-{0,2,3,7},
-{2,5,6,7},
-{0,7,4,5},
-{0,2,7,5}
-};
-}
-
-//currently only supports voxel to tetra's
+//currently only supports voxel to tetra's. Each voxel is split into 5
+//tetrahedra, one way or the other by the parity of its i+j+k location, so
+//that the faces of neighboring voxels match. This gives the same tetrahedra
+//as dax::cont::TetrahedralizedUniformGrid.
+//
+//The location is taken from the input topology: a uniform grid knows it
+//from its extent, and for other voxel grids it is recovered from the point
+//ids of the voxel. Pass the extent the input cells are numbered in to the
+//constructor to use that instead.
 class Tetrahedralize : public dax::exec::WorkletGenerateTopology
 {
 public:
   typedef void ControlSignature(Topology, Topology(Out));
-  typedef void ExecutionSignature(Vertices(_1),Vertices(_2), WorkId, VisitIndex);
+  typedef void ExecutionSignature(Vertices(_1),Vertices(_2),
+                                  CellIJK(_1), CellId(_1), VisitIndex);
+
+  DAX_CONT_EXPORT
+  Tetrahedralize()
+    : UseInputExtent(false) {  }
+
+  DAX_CONT_EXPORT
+  Tetrahedralize(const dax::Extent3 &inputExtent)
+    : UseInputExtent(true), InputExtent(inputExtent) {  }
 
   DAX_EXEC_EXPORT
   void operator()(const dax::exec::CellVertices<dax::CellTagVoxel> &inVertices,
                   dax::exec::CellVertices<dax::CellTagTetrahedron> &outVertices,
+                  const dax::Id3 &inputCellIJK,
                   const dax::Id inputCellId,
                   const dax::Id visitIndex) const
   {
-  //instead of swtiching on id % 2, we take it as zero or one and multiple
-  //by 5 to get the correct index in our lookup table
-  dax::Id lookupTablePos = visitIndex + (  5 * inputCellId % 2 );
-
-  outVertices[0] = inVertices[ detail::PossibleTetraSplitCases[lookupTablePos][0] ];
-  outVertices[1] = inVertices[ detail::PossibleTetraSplitCases[lookupTablePos][1] ];
-  outVertices[2] = inVertices[ detail::PossibleTetraSplitCases[lookupTablePos][2] ];
-  outVertices[3] = inVertices[ detail::PossibleTetraSplitCases[lookupTablePos][3] ];
-  outVertices[4] = inVertices[ detail::PossibleTetraSplitCases[lookupTablePos][4] ];
+  outVertices = dax::exec::internal::TetrahedralizeVoxel(
+        inVertices,
+        this->UseInputExtent
+          ? dax::flatIndexToIndex3Cell(inputCellId, this->InputExtent)
+          : inputCellIJK,
+        visitIndex);
   }
+
+private:
+  bool UseInputExtent;
+  dax::Extent3 InputExtent;
 };
 
 }}
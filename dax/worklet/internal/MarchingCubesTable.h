@@ -44,6 +44,15 @@ DAX_EXEC_CONSTANT_EXPORT const unsigned char NumFaces[256] =
   2, 3, 3, 2, 3, 4, 2, 1, 3, 2, 4, 1, 2, 1, 1, 0,
 };
 
+// ............................................................... edgeVertices
+// the two vertices of a hexahedron at the ends of each edge used in triTable
+DAX_EXEC_CONSTANT_EXPORT const unsigned char EdgeVertices[12][2] =
+{
+  {0,1}, {1,2}, {3,2}, {0,3},
+  {4,5}, {5,6}, {7,6}, {4,7},
+  {0,4}, {1,5}, {2,6}, {3,7},
+};
+
 // ................................................................... triTable
 DAX_EXEC_CONSTANT_EXPORT const unsigned char TriTable[256][16] =
 {
@@ -142,6 +142,11 @@ void TestCellGradient()
         TestCellGradientWorklet(),
         dax::cont::ArrayContainerControlTagBasic(),
         dax::cont::DeviceAdapterTagSerial());
+
+  std::cout << "Testing rectilinear grid" << std::endl;
+  TestCellGradientWorklet()(
+        dax::cont::RectilinearGrid<dax::cont::ArrayContainerControlTagBasic,
+                                   dax::cont::DeviceAdapterTagSerial>());
   }
 
 
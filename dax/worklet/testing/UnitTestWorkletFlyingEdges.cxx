@@ -0,0 +1,258 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_ERROR
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_ERROR
+
+#include <dax/worklet/FlyingEdges.h>
+#include <dax/worklet/MarchingCubes.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/GenerateInterpolatedCells.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 17;
+
+typedef dax::cont::ArrayContainerControlTagBasic ArrayContainer;
+typedef dax::cont::DeviceAdapterTagSerial DeviceAdapter;
+
+typedef dax::cont::UniformGrid<DeviceAdapter> UniformGridType;
+typedef dax::cont::UnstructuredGrid<
+    dax::CellTagTriangle,ArrayContainer,ArrayContainer,DeviceAdapter>
+    TriangleGridType;
+typedef dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+    ScalarArrayType;
+typedef dax::cont::ArrayHandle<dax::Id,ArrayContainer,DeviceAdapter>
+    IdArrayType;
+
+bool VectorLess(const dax::Vector3 &a, const dax::Vector3 &b)
+{
+  for (int component = 0; component < 3; component++)
+    {
+    if (a[component] < b[component]) { return true; }
+    if (b[component] < a[component]) { return false; }
+    }
+  return false;
+}
+
+struct Triangle
+{
+  dax::Vector3 Points[3];
+
+  bool operator<(const Triangle &other) const
+  {
+    for (int vertex = 0; vertex < 3; vertex++)
+      {
+      if (VectorLess(this->Points[vertex], other.Points[vertex]))
+        {
+        return true;
+        }
+      if (VectorLess(other.Points[vertex], this->Points[vertex]))
+        {
+        return false;
+        }
+      }
+    return false;
+  }
+};
+
+// The triangles of a grid, each rotated to start at its lowest point so that
+// the orientation is kept, in sorted order.
+std::vector<Triangle> GetTriangles(const TriangleGridType &grid)
+{
+  std::vector<dax::Vector3> coordinates(grid.GetNumberOfPoints());
+  grid.GetPointCoordinates().CopyInto(coordinates.begin());
+  std::vector<dax::ConnectivityId> connections(
+        grid.GetCellConnections().GetNumberOfValues());
+  grid.GetCellConnections().CopyInto(connections.begin());
+
+  std::vector<Triangle> triangles(grid.GetNumberOfCells());
+  for (std::size_t cell = 0; cell < triangles.size(); cell++)
+    {
+    int lowest = 0;
+    for (int vertex = 0; vertex < 3; vertex++)
+      {
+      const dax::Id pointId = connections[3*cell + vertex];
+      DAX_TEST_ASSERT(pointId >= 0 && pointId < grid.GetNumberOfPoints(),
+                      "Bad point id in connections.");
+      triangles[cell].Points[vertex] = coordinates[pointId];
+      if (VectorLess(triangles[cell].Points[vertex],
+                     triangles[cell].Points[lowest]))
+        {
+        lowest = vertex;
+        }
+      }
+    std::rotate(triangles[cell].Points,
+                triangles[cell].Points + lowest,
+                triangles[cell].Points + 3);
+    }
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+
+ScalarArrayType MakeField(const UniformGridType &grid)
+{
+  // A ball with a bump, so that some rows are cut many times and others not
+  // at all. Integer values make some points lie exactly on the isovalues.
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (dax::Id index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    const dax::Id3 ijk = grid.ComputePointLocation(index)
+        - grid.GetExtent().Min;
+    const dax::Id3 offset = ijk - dax::make_Id3(DIM/2, DIM/2, DIM/3);
+    field[index] = static_cast<dax::Scalar>(
+          dax::dot(offset, offset) + 4*((ijk[0]*ijk[1]) % 5));
+    }
+  // Copied since the handle would otherwise reference the local vector.
+  ScalarArrayType fieldHandle;
+  dax::cont::internal::DeviceAdapterAlgorithm<DeviceAdapter>::Copy(
+        dax::cont::make_ArrayHandle(field, ArrayContainer(), DeviceAdapter()),
+        fieldHandle);
+  return fieldHandle;
+}
+
+TriangleGridType RunMarchingCubes(const UniformGridType &grid,
+                                  ScalarArrayType field,
+                                  dax::Scalar isoValue)
+{
+  typedef dax::cont::GenerateInterpolatedCells<
+      dax::worklet::MarchingCubesTopology,IdArrayType> GenerateIC;
+
+  dax::cont::Scheduler<DeviceAdapter> scheduler;
+  IdArrayType classification;
+  scheduler.Invoke(dax::worklet::MarchingCubesClassify(isoValue),
+                   grid, field, classification);
+
+  GenerateIC generate(classification,
+                      dax::worklet::MarchingCubesTopology(isoValue));
+  generate.SetRemoveDuplicatePoints(true);
+  TriangleGridType outGrid;
+  scheduler.Invoke(generate, grid, outGrid, field);
+  return outGrid;
+}
+
+//-----------------------------------------------------------------------------
+void TestFlyingEdges()
+{
+  UniformGridType grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(DIM-1, DIM-2, DIM-3));
+  ScalarArrayType field = MakeField(grid);
+
+  dax::cont::Scheduler<DeviceAdapter> scheduler;
+
+  const dax::Scalar isoValues[] = { 20.0f, 36.0f, 41.5f, 200.0f, 1000.0f };
+  for (int isoIndex = 0; isoIndex < 5; isoIndex++)
+    {
+    const dax::Scalar isoValue = isoValues[isoIndex];
+    std::cout << "Running Flying Edges with isovalue " << isoValue
+              << std::endl;
+
+    TriangleGridType flyingEdgesGrid;
+    scheduler.Invoke(dax::worklet::FlyingEdges(isoValue),
+                     grid, flyingEdgesGrid, field);
+    TriangleGridType marchingCubesGrid =
+        RunMarchingCubes(grid, field, isoValue);
+
+    std::cout << "  " << flyingEdgesGrid.GetNumberOfCells() << " triangles, "
+              << flyingEdgesGrid.GetNumberOfPoints() << " points" << std::endl;
+    DAX_TEST_ASSERT(flyingEdgesGrid.GetNumberOfCells()
+                    == marchingCubesGrid.GetNumberOfCells(),
+                    "Wrong number of triangles.");
+    DAX_TEST_ASSERT(flyingEdgesGrid.GetNumberOfPoints()
+                    == marchingCubesGrid.GetNumberOfPoints(),
+                    "Points not merged like marching cubes.");
+
+    std::vector<Triangle> flyingEdgesTriangles =
+        GetTriangles(flyingEdgesGrid);
+    std::vector<Triangle> marchingCubesTriangles =
+        GetTriangles(marchingCubesGrid);
+    for (std::size_t cell = 0; cell < flyingEdgesTriangles.size(); cell++)
+      {
+      for (int vertex = 0; vertex < 3; vertex++)
+        {
+        DAX_TEST_ASSERT(
+              test_equal(flyingEdgesTriangles[cell].Points[vertex],
+                         marchingCubesTriangles[cell].Points[vertex]),
+              "Flying edges triangle differs from marching cubes.");
+        }
+      }
+    }
+
+  std::cout << "Running Flying Edges on a shifted grid" << std::endl;
+  {
+  const dax::Scalar isoValue = 36.0f;
+  TriangleGridType unshiftedGrid;
+  scheduler.Invoke(dax::worklet::FlyingEdges(isoValue),
+                   grid, unshiftedGrid, field);
+
+  UniformGridType shifted;
+  shifted.SetExtent(dax::make_Id3(2, -1, 3),
+                    dax::make_Id3(DIM+1, DIM-3, DIM));
+  shifted.SetOrigin(dax::make_Vector3(1.0f, -2.0f, 0.5f));
+  shifted.SetSpacing(dax::make_Vector3(0.5f, 2.0f, 1.0f));
+  TriangleGridType shiftedGrid;
+  scheduler.Invoke(dax::worklet::FlyingEdges(isoValue),
+                   shifted, shiftedGrid, MakeField(shifted));
+
+  DAX_TEST_ASSERT(shiftedGrid.GetNumberOfCells()
+                  == unshiftedGrid.GetNumberOfCells(),
+                  "Shifted grid has wrong number of triangles.");
+  DAX_TEST_ASSERT(shiftedGrid.GetNumberOfPoints()
+                  == unshiftedGrid.GetNumberOfPoints(),
+                  "Shifted grid has wrong number of points.");
+  for (dax::Id pointIndex = 0;
+       pointIndex < shiftedGrid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    const dax::Vector3 location =
+        unshiftedGrid.ComputePointCoordinates(pointIndex);
+    const dax::Vector3 expected = shifted.GetOrigin() + shifted.GetSpacing()
+        * (location + dax::make_Vector3(2.0f, -1.0f, 3.0f));
+    DAX_TEST_ASSERT(test_equal(shiftedGrid.ComputePointCoordinates(pointIndex),
+                               expected),
+                    "Shifted grid has wrong point coordinates.");
+    }
+  }
+
+  std::cout << "Running Flying Edges on a flat grid" << std::endl;
+  {
+  UniformGridType flat;
+  flat.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(DIM-1, DIM-1, 0));
+  TriangleGridType flatGrid;
+  scheduler.Invoke(dax::worklet::FlyingEdges(36.0f),
+                   flat, flatGrid, MakeField(flat));
+  DAX_TEST_ASSERT(flatGrid.GetNumberOfCells() == 0
+                  && flatGrid.GetNumberOfPoints() == 0,
+                  "A grid without cells has no isosurface.");
+  }
+}
+
+} // anonymous namespace
+
+int UnitTestWorkletFlyingEdges(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestFlyingEdges);
+}
@@ -21,8 +21,10 @@
 #include <dax/cont/internal/testing/Testing.h>
 
 #include <dax/worklet/MarchingCubes.h>
+#include <dax/worklet/PointGradient.h>
 
 #include <math.h>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -142,6 +144,246 @@ struct TestMarchingCubesWorklet
     DAX_TEST_ASSERT(NumberOfUniquePoints == secondOutGrid.GetNumberOfPoints() &&
                     NumberOfUniquePoints != valid_num_points,
         "We didn't merge to the correct number of points");
+
+    //interpolate point fields of different types along with the coordinates
+    std::cout << "Running Marching Cubes with interpolated fields" << std::endl;
+    dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+        interpolatedField;
+    dax::cont::ArrayHandle<dax::Vector3,ArrayContainer,DeviceAdapter>
+        interpolatedCoordinates;
+    dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+        interpolatedFieldInPass;
+
+    UnstructuredGridType thirdOutGrid;
+    scheduler.Invoke(generate.WithInterpolatedPointFields(
+                       fieldHandle, interpolatedField)
+                     .WithInterpolatedPointFields(
+                       inGrid.GetRealGrid().GetPointCoordinates(),
+                       interpolatedCoordinates,
+                       fieldHandle, interpolatedFieldInPass),
+                     inGrid.GetRealGrid(),
+                     thirdOutGrid,
+                     fieldHandle);
+    DAX_TEST_ASSERT(interpolatedField.GetNumberOfValues() ==
+                    thirdOutGrid.GetNumberOfPoints() &&
+                    interpolatedCoordinates.GetNumberOfValues() ==
+                    thirdOutGrid.GetNumberOfPoints() &&
+                    interpolatedFieldInPass.GetNumberOfValues() ==
+                    thirdOutGrid.GetNumberOfPoints(),
+                    "Interpolated fields have the wrong size");
+
+    std::vector<dax::Scalar> fieldValues(
+          interpolatedField.GetNumberOfValues());
+    interpolatedField.CopyInto(fieldValues.begin());
+    std::vector<dax::Scalar> fieldInPassValues(
+          interpolatedFieldInPass.GetNumberOfValues());
+    interpolatedFieldInPass.CopyInto(fieldInPassValues.begin());
+    std::vector<dax::Vector3> coordinateValues(
+          interpolatedCoordinates.GetNumberOfValues());
+    interpolatedCoordinates.CopyInto(coordinateValues.begin());
+    std::vector<dax::Vector3> outCoordinates(
+          thirdOutGrid.GetNumberOfPoints());
+    thirdOutGrid.GetPointCoordinates().CopyInto(outCoordinates.begin());
+    for (std::size_t i = 0; i < fieldValues.size(); ++i)
+      {
+      DAX_TEST_ASSERT(test_equal(fieldValues[i], isoValue),
+                      "Interpolated field is not the isovalue");
+      DAX_TEST_ASSERT(test_equal(fieldInPassValues[i], fieldValues[i]),
+                      "Fields interpolated in chained calls differ");
+      DAX_TEST_ASSERT(test_equal(coordinateValues[i], outCoordinates[i]),
+                      "Interpolated coordinates are not the output points");
+      }
+
+    //the cases saved by the classification give the same surface
+    std::cout << "Running Marching Cubes with saved cases" << std::endl;
+    typedef dax::cont::GenerateInterpolatedCells<
+      dax::worklet::MarchingCubesCaseTopology,ClassifyResultType> GenerateCase;
+    ClassifyResultType caseClassification;
+    dax::cont::ArrayHandle<unsigned char,ArrayContainer,DeviceAdapter> cases;
+    scheduler.Invoke(dax::worklet::MarchingCubesCaseClassify(isoValue),
+                     inGrid.GetRealGrid(),
+                     fieldHandle,
+                     caseClassification,
+                     cases);
+    DAX_TEST_ASSERT(cases.GetNumberOfValues() ==
+                    inGrid->GetNumberOfCells(),
+                    "Wrong number of saved cases");
+
+    std::vector<dax::Id> counts(classification.GetNumberOfValues());
+    classification.CopyInto(counts.begin());
+    std::vector<dax::Id> caseCounts(caseClassification.GetNumberOfValues());
+    caseClassification.CopyInto(caseCounts.begin());
+    DAX_TEST_ASSERT(counts == caseCounts,
+                    "Saving the cases changed the classification");
+
+    GenerateCase generateCase(
+          caseClassification,
+          dax::worklet::MarchingCubesCaseTopology(isoValue));
+    generateCase.SetRemoveDuplicatePoints(true);
+    UnstructuredGridType caseOutGrid;
+    scheduler.Invoke(generateCase,
+                     inGrid.GetRealGrid(),
+                     caseOutGrid,
+                     cases,
+                     dax::exec::make_ExecutionWholeArrayConst(
+                       fieldHandle.PrepareForInput()));
+    DAX_TEST_ASSERT(caseOutGrid.GetNumberOfCells() ==
+                    secondOutGrid.GetNumberOfCells() &&
+                    caseOutGrid.GetNumberOfPoints() ==
+                    secondOutGrid.GetNumberOfPoints(),
+                    "Saved cases give a different surface");
+
+    std::vector<dax::Vector3> caseCoordinates(caseOutGrid.GetNumberOfPoints());
+    caseOutGrid.GetPointCoordinates().CopyInto(caseCoordinates.begin());
+    std::vector<dax::Vector3> secondCoordinates(
+          secondOutGrid.GetNumberOfPoints());
+    secondOutGrid.GetPointCoordinates().CopyInto(secondCoordinates.begin());
+    std::vector<dax::ConnectivityId> caseConnections(
+          caseOutGrid.GetCellConnections().GetNumberOfValues());
+    caseOutGrid.GetCellConnections().CopyInto(caseConnections.begin());
+    std::vector<dax::ConnectivityId> secondConnections(
+          secondOutGrid.GetCellConnections().GetNumberOfValues());
+    secondOutGrid.GetCellConnections().CopyInto(secondConnections.begin());
+    DAX_TEST_ASSERT(caseConnections == secondConnections,
+                    "Saved cases give different connections");
+    for (std::size_t i = 0; i < caseCoordinates.size(); ++i)
+      {
+      DAX_TEST_ASSERT(test_equal(caseCoordinates[i], secondCoordinates[i]),
+                      "Saved cases give different points");
+      }
+
+    //the cases are looked up by input cell id, so a case array that does
+    //not cover the input grid is rejected
+    std::vector<unsigned char> shortCaseValues(cases.GetNumberOfValues());
+    cases.CopyInto(shortCaseValues.begin());
+    shortCaseValues.pop_back();
+    dax::cont::ArrayHandle<unsigned char,ArrayContainer,DeviceAdapter>
+        shortCases = dax::cont::make_ArrayHandle(shortCaseValues,
+                                                 ArrayContainer(),
+                                                 DeviceAdapter());
+    GenerateCase generateShortCase(
+          caseClassification,
+          dax::worklet::MarchingCubesCaseTopology(isoValue));
+    UnstructuredGridType shortCaseOutGrid;
+    bool gotError = false;
+    try
+      {
+      scheduler.Invoke(generateShortCase,
+                       inGrid.GetRealGrid(),
+                       shortCaseOutGrid,
+                       shortCases,
+                       dax::exec::make_ExecutionWholeArrayConst(
+                         fieldHandle.PrepareForInput()));
+      }
+    catch (dax::cont::ErrorControlBadValue error)
+      {
+      std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+      gotError = true;
+      }
+    DAX_TEST_ASSERT(gotError, "A short case array was not rejected");
+
+    //the field is linear, so every normal is its normalized gradient
+    std::cout << "Running Marching Cubes with normals" << std::endl;
+    GenerateIC generateNormals(classification, generateWorklet);
+    generateNormals.SetReleaseClassification(false);
+    dax::cont::ArrayHandle<dax::Vector3,ArrayContainer,DeviceAdapter>
+        gradient = this->PointGradient(fieldHandle);
+    dax::cont::ArrayHandle<dax::Vector3,ArrayContainer,DeviceAdapter> normals;
+
+    const dax::Vector3 expectedNormal = dax::math::Normal(trueGradient);
+    for (int merge = 0; merge < 2; ++merge)
+      {
+      generateNormals.SetRemoveDuplicatePoints(merge == 1);
+      UnstructuredGridType normalsOutGrid;
+      scheduler.Invoke(generateNormals.WithPointNormals(gradient, normals),
+                       inGrid.GetRealGrid(),
+                       normalsOutGrid,
+                       fieldHandle);
+      DAX_TEST_ASSERT(normalsOutGrid.GetNumberOfCells() ==
+                      secondOutGrid.GetNumberOfCells() &&
+                      normals.GetNumberOfValues() ==
+                      normalsOutGrid.GetNumberOfPoints(),
+                      "Wrong number of normals");
+
+      std::vector<dax::Vector3> normalValues(normals.GetNumberOfValues());
+      normals.CopyInto(normalValues.begin());
+      for (std::size_t i = 0; i < normalValues.size(); ++i)
+        {
+        DAX_TEST_ASSERT(test_equal(normalValues[i], expectedNormal),
+                        "Wrong point normal");
+        }
+
+      //the normals are on the same side as the triangle winding, except for
+      //the triangles without area where the surface passes through points
+      std::vector<dax::Vector3> points(normalsOutGrid.GetNumberOfPoints());
+      normalsOutGrid.GetPointCoordinates().CopyInto(points.begin());
+      std::vector<dax::ConnectivityId> connections(
+            normalsOutGrid.GetCellConnections().GetNumberOfValues());
+      normalsOutGrid.GetCellConnections().CopyInto(connections.begin());
+      for (std::size_t cell = 0; cell < connections.size() / 3; ++cell)
+        {
+        const dax::Vector3 p0 = points[connections[3*cell]];
+        const dax::Vector3 faceNormal =
+            dax::math::Cross(points[connections[3*cell+1]] - p0,
+                             points[connections[3*cell+2]] - p0);
+        DAX_TEST_ASSERT(dax::dot(faceNormal, expectedNormal) >= 0,
+                        "Normal is on the wrong side of a triangle");
+        }
+      }
+
+    //on a sphere the interpolated gradients are exact inside the grid, where
+    //they are central differences, so the normal of each point away from
+    //the boundary is its direction from the center
+    std::cout << "Running Marching Cubes with normals of a curved field"
+              << std::endl;
+    std::vector<dax::Scalar> curvedField(numPoints);
+    for (dax::Id pointIndex = 0; pointIndex < numPoints; pointIndex++)
+      {
+      dax::Vector3 coordinates = inGrid.GetPointCoordinates(pointIndex);
+      curvedField[pointIndex] = dax::dot(coordinates, coordinates);
+      }
+    dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+        curvedFieldHandle = dax::cont::make_ArrayHandle(curvedField,
+                                                        ArrayContainer(),
+                                                        DeviceAdapter());
+    const dax::Scalar curvedIsoValue = 20;
+    ClassifyResultType curvedClassification;
+    scheduler.Invoke(dax::worklet::MarchingCubesClassify(curvedIsoValue),
+                     inGrid.GetRealGrid(),
+                     curvedFieldHandle,
+                     curvedClassification);
+    dax::worklet::MarchingCubesTopology curvedWorklet(curvedIsoValue);
+    GenerateIC generateCurvedNormals(curvedClassification, curvedWorklet);
+    UnstructuredGridType curvedOutGrid;
+    scheduler.Invoke(generateCurvedNormals.WithPointNormals(
+                       this->PointGradient(curvedFieldHandle), normals),
+                     inGrid.GetRealGrid(),
+                     curvedOutGrid,
+                     curvedFieldHandle);
+
+    std::vector<dax::Vector3> curvedNormalValues(normals.GetNumberOfValues());
+    normals.CopyInto(curvedNormalValues.begin());
+    std::vector<dax::Vector3> curvedPoints(curvedOutGrid.GetNumberOfPoints());
+    curvedOutGrid.GetPointCoordinates().CopyInto(curvedPoints.begin());
+    DAX_TEST_ASSERT(curvedNormalValues.size() == curvedPoints.size(),
+                    "Wrong number of normals");
+    std::size_t numInteriorPoints = 0;
+    for (std::size_t point = 0; point < curvedPoints.size(); ++point)
+      {
+      const dax::Vector3 &coordinates = curvedPoints[point];
+      if (coordinates[0] < 0.999 ||
+          coordinates[1] < 0.999 ||
+          coordinates[2] < 0.999)
+        {
+        continue;
+        }
+      ++numInteriorPoints;
+      DAX_TEST_ASSERT(test_equal(curvedNormalValues[point],
+                                 dax::math::Normal(coordinates)),
+                      "Wrong point normal on a curved surface");
+      }
+    DAX_TEST_ASSERT(numInteriorPoints > 0,
+                    "Curved surface has no points inside the grid");
     }
     catch (dax::cont::ErrorControl error)
       {
@@ -149,9 +391,144 @@ struct TestMarchingCubesWorklet
       DAX_TEST_ASSERT(true==false,error.GetMessage());
       }
     }
+
+  //----------------------------------------------------------------------------
+  //the gradient of a field of the test grids, which all have the points of
+  //the uniform one
+  dax::cont::ArrayHandle<dax::Vector3,ArrayContainer,DeviceAdapter>
+  PointGradient(
+      dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter> field)
+      const
+    {
+    dax::cont::internal::TestGrid<
+        dax::cont::UniformGrid<DeviceAdapter>,ArrayContainer,DeviceAdapter>
+        uniformGrid(DIM);
+    dax::cont::ArrayHandle<dax::Vector3,ArrayContainer,DeviceAdapter> gradient;
+    dax::cont::Scheduler<DeviceAdapter> scheduler;
+    scheduler.Invoke(dax::worklet::PointGradient(uniformGrid.GetRealGrid()),
+                     field,
+                     dax::exec::make_ExecutionWholeArrayConst(
+                       field.PrepareForInput()),
+                     gradient);
+    return gradient;
+    }
 };
 
 
+//-----------------------------------------------------------------------------
+struct TestMarchingCubesMultiWorklet
+{
+  typedef dax::cont::ArrayContainerControlTagBasic ArrayContainer;
+  typedef dax::cont::DeviceAdapterTagSerial DeviceAdapter;
+
+  typedef dax::CellTagTriangle CellType;
+
+  typedef dax::cont::UnstructuredGrid<
+      CellType,ArrayContainer,ArrayContainer,DeviceAdapter>
+      UnstructuredGridType;
+
+  typedef dax::cont::ArrayHandle<dax::Id, ArrayContainer, DeviceAdapter>
+    IdArrayType;
+
+  //----------------------------------------------------------------------------
+  template<class InputGridType>
+  void operator()(const InputGridType&) const
+    {
+    dax::cont::internal::TestGrid<InputGridType,ArrayContainer,DeviceAdapter>
+        inGrid(DIM);
+
+    dax::Vector3 trueGradient = dax::make_Vector3(1.0, 1.0, 1.0);
+    dax::Id numPoints = inGrid->GetNumberOfPoints();
+    std::vector<dax::Scalar> field(numPoints);
+    for (dax::Id pointIndex = 0; pointIndex < numPoints; pointIndex++)
+      {
+      dax::Vector3 coordinates = inGrid.GetPointCoordinates(pointIndex);
+      field[pointIndex] = dax::dot(coordinates, trueGradient);
+      }
+
+    dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+        fieldHandle = dax::cont::make_ArrayHandle(field,
+                                                  ArrayContainer(),
+                                                  DeviceAdapter());
+
+    const dax::Vector3 isoValues = dax::make_Vector3(ISOVALUE - 20,
+                                                     ISOVALUE,
+                                                     ISOVALUE - 40);
+
+    try
+      {
+      dax::cont::Scheduler<DeviceAdapter> scheduler;
+
+      std::cout << "Running Marching Cubes with several isovalues" << std::endl;
+      typedef dax::cont::GenerateInterpolatedCells<
+        dax::worklet::MarchingCubesMultiTopology<3>,IdArrayType> GenerateMulti;
+
+      IdArrayType classification;
+      scheduler.Invoke(dax::worklet::MarchingCubesMultiClassify<3>(isoValues),
+                       inGrid.GetRealGrid(),
+                       fieldHandle,
+                       classification);
+
+      GenerateMulti generate(
+            classification,
+            dax::worklet::MarchingCubesMultiTopology<3>(isoValues));
+      UnstructuredGridType outGrid;
+      IdArrayType isoValueIndices;
+      scheduler.Invoke(generate,
+                       inGrid.GetRealGrid(),
+                       outGrid,
+                       fieldHandle,
+                       isoValueIndices);
+
+      DAX_TEST_ASSERT(isoValueIndices.GetNumberOfValues()
+                      == outGrid.GetNumberOfCells(),
+                      "Wrong number of isovalue indices");
+      std::vector<dax::Id> indices(isoValueIndices.GetNumberOfValues());
+      isoValueIndices.CopyInto(indices.begin());
+
+      //each surface must match a run with only its isovalue
+      dax::Id numberOfPoints = 0;
+      for (int isoIndex = 0; isoIndex < 3; ++isoIndex)
+        {
+        IdArrayType singleClassification;
+        scheduler.Invoke(
+              dax::worklet::MarchingCubesClassify(isoValues[isoIndex]),
+              inGrid.GetRealGrid(),
+              fieldHandle,
+              singleClassification);
+
+        typedef dax::cont::GenerateInterpolatedCells<
+          dax::worklet::MarchingCubesTopology,IdArrayType> GenerateSingle;
+        GenerateSingle generateSingle(
+              singleClassification,
+              dax::worklet::MarchingCubesTopology(isoValues[isoIndex]));
+        UnstructuredGridType singleGrid;
+        scheduler.Invoke(generateSingle,
+                         inGrid.GetRealGrid(),
+                         singleGrid,
+                         fieldHandle);
+
+        const dax::Id numberOfTriangles =
+            std::count(indices.begin(), indices.end(), isoIndex);
+        std::cout << "  isovalue " << isoValues[isoIndex] << ": "
+                  << numberOfTriangles << " triangles" << std::endl;
+        DAX_TEST_ASSERT(numberOfTriangles == singleGrid.GetNumberOfCells(),
+                        "Wrong number of triangles for an isovalue");
+        numberOfPoints += singleGrid.GetNumberOfPoints();
+        }
+
+      //points of different isovalues are never merged together
+      DAX_TEST_ASSERT(numberOfPoints == outGrid.GetNumberOfPoints(),
+                      "Wrong number of merged points");
+      }
+    catch (dax::cont::ErrorControl error)
+      {
+      std::cout << "Got error: " << error.GetMessage() << std::endl;
+      DAX_TEST_ASSERT(true==false,error.GetMessage());
+      }
+    }
+};
+
 //-----------------------------------------------------------------------------
 void TestMarchingCubes()
   {
@@ -160,6 +537,11 @@ void TestMarchingCubes()
         dax::internal::Testing::CellCheckHexahedron(),
         dax::cont::ArrayContainerControlTagBasic(),
         dax::cont::DeviceAdapterTagSerial());
+  dax::cont::internal::GridTesting::TryAllGridTypes(
+        TestMarchingCubesMultiWorklet(),
+        dax::internal::Testing::CellCheckHexahedron(),
+        dax::cont::ArrayContainerControlTagBasic(),
+        dax::cont::DeviceAdapterTagSerial());
   }
 } // Anonymous namespace
 
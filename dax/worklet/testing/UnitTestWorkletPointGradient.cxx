@@ -0,0 +1,125 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/worklet/PointGradient.h>
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/exec/ExecutionWholeArray.h>
+
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+//-----------------------------------------------------------------------------
+std::vector<dax::Vector3> RunPointGradient(
+    const dax::cont::UniformGrid<> &grid,
+    const std::vector<dax::Scalar> &field)
+{
+  dax::cont::ArrayHandle<dax::Scalar> fieldHandle =
+      dax::cont::make_ArrayHandle(field);
+  dax::cont::ArrayHandle<dax::Vector3> gradientHandle;
+
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(dax::worklet::PointGradient(grid),
+                   fieldHandle,
+                   dax::exec::make_ExecutionWholeArrayConst(
+                     fieldHandle.PrepareForInput()),
+                   gradientHandle);
+
+  DAX_TEST_ASSERT(gradientHandle.GetNumberOfValues() ==
+                  grid.GetNumberOfPoints(),
+                  "Wrong number of gradients");
+  std::vector<dax::Vector3> gradient(gradientHandle.GetNumberOfValues());
+  gradientHandle.CopyInto(gradient.begin());
+  return gradient;
+}
+
+//-----------------------------------------------------------------------------
+void TestPointGradient()
+{
+  dax::cont::UniformGrid<> grid;
+  grid.SetOrigin(dax::make_Vector3(-1.0, 0.5, 2.0));
+  grid.SetSpacing(dax::make_Vector3(0.5, 1.0, 0.25));
+  grid.SetExtent(dax::make_Id3(1, -2, 0), dax::make_Id3(5, 2, 6));
+  const dax::Id numPoints = grid.GetNumberOfPoints();
+
+  //the gradient of a linear field is exact everywhere, boundary included
+  std::cout << "Gradient of a linear field" << std::endl;
+  const dax::Vector3 trueGradient = dax::make_Vector3(2.0, -3.0, 0.5);
+  std::vector<dax::Scalar> linearField(numPoints);
+  for (dax::Id pointIndex = 0; pointIndex < numPoints; pointIndex++)
+    {
+    linearField[pointIndex] =
+        dax::dot(grid.ComputePointCoordinates(pointIndex), trueGradient);
+    }
+  std::vector<dax::Vector3> linearGradient =
+      RunPointGradient(grid, linearField);
+  for (dax::Id pointIndex = 0; pointIndex < numPoints; pointIndex++)
+    {
+    DAX_TEST_ASSERT(test_equal(linearGradient[pointIndex], trueGradient),
+                    "Wrong gradient of a linear field");
+    }
+
+  //central differences are exact for a quadratic field inside the grid,
+  //and one-sided differences are off by the spacing on its boundary
+  std::cout << "Gradient of a quadratic field" << std::endl;
+  std::vector<dax::Scalar> quadraticField(numPoints);
+  for (dax::Id pointIndex = 0; pointIndex < numPoints; pointIndex++)
+    {
+    const dax::Vector3 coordinates = grid.ComputePointCoordinates(pointIndex);
+    quadraticField[pointIndex] = dax::dot(coordinates, coordinates);
+    }
+  std::vector<dax::Vector3> quadraticGradient =
+      RunPointGradient(grid, quadraticField);
+  const dax::Extent3 &extent = grid.GetExtent();
+  for (dax::Id pointIndex = 0; pointIndex < numPoints; pointIndex++)
+    {
+    const dax::Id3 ijk = grid.ComputePointLocation(pointIndex);
+    const dax::Vector3 coordinates = grid.ComputePointCoordinates(pointIndex);
+    for (int component = 0; component < 3; component++)
+      {
+      dax::Scalar expected = 2*coordinates[component];
+      if (ijk[component] == extent.Min[component])
+        {
+        expected += grid.GetSpacing()[component];
+        }
+      else if (ijk[component] == extent.Max[component])
+        {
+        expected -= grid.GetSpacing()[component];
+        }
+      DAX_TEST_ASSERT(test_equal(quadraticGradient[pointIndex][component],
+                                 expected),
+                      "Wrong gradient of a quadratic field");
+      }
+    }
+}
+
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestWorkletPointGradient(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestPointGradient);
+}
@@ -0,0 +1,144 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+// These macros help tease out when the default template arguments to
+// ArrayHandle are inappropriately used.
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_ERROR
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_ERROR
+
+#include <dax/cont/internal/testing/TestingGridGenerator.h>
+#include <dax/cont/internal/testing/Testing.h>
+
+#include <dax/worklet/CellGradient.h>
+#include <dax/worklet/MarchingCubes.h>
+#include <dax/worklet/Threshold.h>
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleQuantized.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+#include <dax/cont/Scheduler.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 16;
+const dax::Scalar SCALE = 0.01f;
+
+typedef dax::cont::ArrayContainerControlTagBasic ArrayContainer;
+typedef dax::cont::DeviceAdapterTagSerial DeviceAdapter;
+
+typedef dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+    ScalarHandle;
+typedef dax::cont::ArrayHandle<unsigned short,ArrayContainer,DeviceAdapter>
+    UShortHandle;
+typedef dax::cont::ArrayHandleQuantized<UShortHandle> QuantizedHandle;
+typedef dax::cont::ArrayHandle<dax::Id,ArrayContainer,DeviceAdapter>
+    IdHandle;
+typedef dax::cont::ArrayHandle<dax::Vector3,ArrayContainer,DeviceAdapter>
+    Vector3Handle;
+
+//-----------------------------------------------------------------------------
+template<class T>
+void CheckSame(const dax::cont::ArrayHandle<T,ArrayContainer,DeviceAdapter>
+                 &quantizedResult,
+               const dax::cont::ArrayHandle<T,ArrayContainer,DeviceAdapter>
+                 &scalarResult)
+{
+  DAX_TEST_ASSERT(quantizedResult.GetNumberOfValues()
+                  == scalarResult.GetNumberOfValues(),
+                  "Results have different sizes.");
+  for (dax::Id index = 0; index < scalarResult.GetNumberOfValues(); index++)
+    {
+    DAX_TEST_ASSERT(test_equal(quantizedResult.GetPortalConstControl().Get(index),
+                               scalarResult.GetPortalConstControl().Get(index)),
+                    "Quantized field gave a different result.");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestQuantizedField()
+{
+  typedef dax::cont::UniformGrid<DeviceAdapter> GridType;
+  dax::cont::internal::TestGrid<GridType,ArrayContainer,DeviceAdapter>
+      grid(DIM);
+
+  // Store the field as 16-bit fixed point values and build a full precision
+  // copy of the decoded values so the results should match exactly.
+  dax::Id numPoints = grid->GetNumberOfPoints();
+  std::vector<unsigned short> storage(numPoints);
+  std::vector<dax::Scalar> decoded(numPoints);
+  for (dax::Id pointIndex = 0; pointIndex < numPoints; pointIndex++)
+    {
+    dax::Vector3 coordinates = grid->ComputePointCoordinates(pointIndex);
+    dax::Scalar value = coordinates[0] + 2*coordinates[1] + 3*coordinates[2];
+    storage[pointIndex] =
+        static_cast<unsigned short>(value/SCALE + dax::Scalar(0.5));
+    decoded[pointIndex] = SCALE*storage[pointIndex];
+    }
+  QuantizedHandle quantizedField = dax::cont::make_ArrayHandleQuantized(
+        dax::cont::make_ArrayHandle(storage, ArrayContainer(), DeviceAdapter()),
+        SCALE);
+  ScalarHandle scalarField =
+      dax::cont::make_ArrayHandle(decoded, ArrayContainer(), DeviceAdapter());
+
+  dax::cont::Scheduler<DeviceAdapter> scheduler;
+
+  std::cout << "Running ThresholdClassify" << std::endl;
+  {
+  IdHandle quantizedResult;
+  IdHandle scalarResult;
+  dax::worklet::ThresholdClassify<dax::Scalar> classify(20, 40);
+  scheduler.Invoke(classify, grid.GetRealGrid(), quantizedField,
+                   quantizedResult);
+  scheduler.Invoke(classify, grid.GetRealGrid(), scalarField, scalarResult);
+  CheckSame(quantizedResult, scalarResult);
+  }
+
+  std::cout << "Running MarchingCubesClassify" << std::endl;
+  {
+  IdHandle quantizedResult;
+  IdHandle scalarResult;
+  dax::worklet::MarchingCubesClassify classify(30);
+  scheduler.Invoke(classify, grid.GetRealGrid(), quantizedField,
+                   quantizedResult);
+  scheduler.Invoke(classify, grid.GetRealGrid(), scalarField, scalarResult);
+  CheckSame(quantizedResult, scalarResult);
+  }
+
+  std::cout << "Running CellGradient" << std::endl;
+  {
+  Vector3Handle quantizedResult;
+  Vector3Handle scalarResult;
+  scheduler.Invoke(dax::worklet::CellGradient(), grid.GetRealGrid(),
+                   grid->GetPointCoordinates(), quantizedField,
+                   quantizedResult);
+  scheduler.Invoke(dax::worklet::CellGradient(), grid.GetRealGrid(),
+                   grid->GetPointCoordinates(), scalarField, scalarResult);
+  CheckSame(quantizedResult, scalarResult);
+  }
+}
+
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestWorkletQuantizedField(int, char *[])
+{
+  return dax::cont::internal::Testing::Run(TestQuantizedField);
+}
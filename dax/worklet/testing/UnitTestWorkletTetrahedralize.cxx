@@ -35,6 +35,7 @@
 
 #include <dax/cont/GenerateTopology.h>
 #include <dax/cont/Scheduler.h>
+#include <dax/cont/TetrahedralizedUniformGrid.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/UnstructuredGrid.h>
 #include <dax/cont/internal/testing/Testing.h>
@@ -44,6 +45,61 @@
 namespace {
 const dax::Id DIM = 26;
 
+// Tetrahedralize that also passes a cell field through: each tetrahedron
+// gets ten times the value of its voxel plus its visit index.
+class TetrahedralizeWithCellField : public dax::exec::WorkletGenerateTopology
+{
+public:
+  typedef void ControlSignature(Topology, Topology(Out),
+                                Field(Cell,In), Field(Cell,Out));
+  typedef void ExecutionSignature(Vertices(_1), Vertices(_2),
+                                  CellIJK(_1), CellId(_1), VisitIndex, _3, _4);
+
+  DAX_EXEC_EXPORT
+  void operator()(const dax::exec::CellVertices<dax::CellTagVoxel> &inVertices,
+                  dax::exec::CellVertices<dax::CellTagTetrahedron> &outVertices,
+                  const dax::Id3 &inputCellIJK,
+                  const dax::Id inputCellId,
+                  const dax::Id visitIndex,
+                  const dax::Id inValue,
+                  dax::Id &outValue) const
+  {
+    this->Worklet(inVertices, outVertices,
+                  inputCellIJK, inputCellId, visitIndex);
+    outValue = 10*inValue + visitIndex;
+  }
+
+private:
+  dax::worklet::Tetrahedralize Worklet;
+};
+
+//-----------------------------------------------------------------------------
+template<class OutGridType>
+void CheckMatchesTetrahedralizedUniformGrid(
+    const OutGridType &outGrid,
+    const dax::cont::TetrahedralizedUniformGrid<> &tets)
+  {
+  DAX_TEST_ASSERT(outGrid.GetNumberOfCells() == tets.GetNumberOfCells(),
+                  "Incorrect number of cells in the output grid");
+
+  std::vector<dax::ConnectivityId> connections(
+        outGrid.GetCellConnections().GetNumberOfValues());
+  outGrid.GetCellConnections().CopyInto(connections.begin());
+
+  dax::cont::TetrahedralizedUniformGrid<>::TopologyStructConstExecution
+      implicitTopology = tets.PrepareForInput();
+  for (dax::Id cellIndex = 0; cellIndex < tets.GetNumberOfCells(); cellIndex++)
+    {
+    const dax::exec::CellVertices<dax::CellTagTetrahedron> expected =
+        implicitTopology.GetCellConnections(cellIndex);
+    for (int vertex = 0; vertex < 4; vertex++)
+      {
+      DAX_TEST_ASSERT(connections[4*cellIndex + vertex] == expected[vertex],
+                      "Tetrahedron differs from TetrahedralizedUniformGrid.");
+      }
+    }
+  }
+
 //-----------------------------------------------------------------------------
 struct TestTetrahedralizeWorklet
 {
@@ -64,25 +120,36 @@ struct TestTetrahedralizeWorklet
     dax::cont::UnstructuredGrid<dax::CellTagTetrahedron> out;
 
     this->GridTetrahedralize(in.GetRealGrid(),out);
+
+    //the per cell counts can be narrower than the scanned offsets
+    dax::cont::UnstructuredGrid<dax::CellTagTetrahedron> narrowOut;
+    this->GridTetrahedralize<unsigned char>(in.GetRealGrid(),narrowOut);
     }
 
   //----------------------------------------------------------------------------
   template <typename InGridType,
             typename OutGridType>
+  void GridTetrahedralize(const InGridType& inGrid, OutGridType& outGrid) const
+    {
+    this->GridTetrahedralize<dax::Id>(inGrid,outGrid);
+    }
+
+  //----------------------------------------------------------------------------
+  template <typename CountType,
+            typename InGridType,
+            typename OutGridType>
   void GridTetrahedralize(const InGridType& inGrid, OutGridType& outGrid) const
     {
     try
       {
       typedef dax::cont::GenerateTopology<dax::worklet::Tetrahedralize,
-                                          dax::cont::ArrayHandleConstantValue<dax::Id>
+                                          dax::cont::ArrayHandleConstantValue<CountType>
                                           > GenerateT;
       typedef typename GenerateT::ClassifyResultType  ClassifyResultType;
 
       dax::cont::Scheduler<> scheduler;
       ClassifyResultType classification(5,inGrid.GetNumberOfCells());
-
-      dax::worklet::Tetrahedralize tetWorklet;
-      GenerateT generateTets(classification,tetWorklet);
+      GenerateT generateTets(classification);
 
       //don't remove duplicate points.
       generateTets.SetRemoveDuplicatePoints(false);
@@ -102,13 +169,158 @@ struct TestTetrahedralizeWorklet
     //to the unstructured grid
     DAX_TEST_ASSERT(outGrid.GetNumberOfPoints()==0,
                     "Incorrect number of points in the output grid");
+
+    //all the test grids number their points like the uniform one, so the
+    //voxels have to be split like those of the uniform grid
+    const dax::cont::TetrahedralizedUniformGrid<> tets(
+          dax::cont::internal::TestGrid<dax::cont::UniformGrid<> >(DIM)
+          .GetRealGrid());
+    CheckMatchesTetrahedralizedUniformGrid(outGrid, tets);
     }
 };
 
 
+//-----------------------------------------------------------------------------
+// The tetrahedra generated from a uniform grid have to be the ones of the
+// implicit TetrahedralizedUniformGrid, whose faces are known to match. The
+// extent is shifted so that the parity of the voxel locations differs from
+// that of the voxel ids.
+void TestMatchesTetrahedralizedUniformGrid()
+  {
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(1, -2, 0), dax::make_Id3(4, 2, 3));
+  const dax::cont::TetrahedralizedUniformGrid<> tets(grid);
+
+  typedef dax::cont::GenerateTopology<dax::worklet::Tetrahedralize,
+                                      dax::cont::ArrayHandleConstantValue<dax::Id>
+                                      > GenerateT;
+  dax::cont::Scheduler<> scheduler;
+
+  //the voxel locations come from the topology of the grid
+  GenerateT generateTets(
+        GenerateT::ClassifyResultType(5,grid.GetNumberOfCells()));
+  generateTets.SetRemoveDuplicatePoints(false);
+  dax::cont::UnstructuredGrid<dax::CellTagTetrahedron> outGrid;
+  scheduler.Invoke(generateTets,grid,outGrid);
+  CheckMatchesTetrahedralizedUniformGrid(outGrid, tets);
+
+  //or from the extent given to the worklet
+  dax::worklet::Tetrahedralize tetWorklet(grid.GetExtent());
+  GenerateT generateTetsInExtent(
+        GenerateT::ClassifyResultType(5,grid.GetNumberOfCells()), tetWorklet);
+  generateTetsInExtent.SetRemoveDuplicatePoints(false);
+  dax::cont::UnstructuredGrid<dax::CellTagTetrahedron> outGridInExtent;
+  scheduler.Invoke(generateTetsInExtent,grid,outGridInExtent);
+  CheckMatchesTetrahedralizedUniformGrid(outGridInExtent, tets);
+  }
+
+//-----------------------------------------------------------------------------
+// Voxels of an unstructured grid whose points are numbered like those of a
+// uniform grid have their locations recovered from their point ids.
+void TestUnstructuredVoxels()
+  {
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(3, 4, 3));
+  const dax::cont::TetrahedralizedUniformGrid<> tets(grid);
+
+  std::vector<dax::ConnectivityId> voxelConnections;
+  dax::cont::UniformGrid<>::TopologyStructConstExecution uniformTopology =
+      grid.PrepareForInput();
+  for (dax::Id cellIndex = 0; cellIndex < grid.GetNumberOfCells(); cellIndex++)
+    {
+    const dax::exec::CellVertices<dax::CellTagVoxel> vertices =
+        uniformTopology.GetCellConnections(cellIndex);
+    for (int vertex = 0; vertex < 8; vertex++)
+      {
+      voxelConnections.push_back(vertices[vertex]);
+      }
+    }
+  std::vector<dax::Vector3> coordinates(grid.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0; pointIndex < grid.GetNumberOfPoints(); pointIndex++)
+    {
+    coordinates[pointIndex] = grid.ComputePointCoordinates(pointIndex);
+    }
+  const dax::cont::UnstructuredGrid<dax::CellTagVoxel> voxels(
+        dax::cont::make_ArrayHandle(voxelConnections),
+        dax::cont::make_ArrayHandle(coordinates));
+
+  typedef dax::cont::GenerateTopology<dax::worklet::Tetrahedralize,
+                                      dax::cont::ArrayHandleConstantValue<dax::Id>
+                                      > GenerateT;
+  GenerateT generateTets(
+        GenerateT::ClassifyResultType(5,voxels.GetNumberOfCells()));
+  generateTets.SetRemoveDuplicatePoints(false);
+
+  dax::cont::UnstructuredGrid<dax::CellTagTetrahedron> outGrid;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(generateTets,voxels,outGrid);
+  CheckMatchesTetrahedralizedUniformGrid(outGrid, tets);
+  }
+
+//-----------------------------------------------------------------------------
+// An output Field(Cell) of a generate worklet holds one value per generated
+// cell, while an input Field(Cell) is looked up by input cell.
+void TestCellFields()
+  {
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(3, 3, 3));
+
+  std::vector<dax::Id> inValues(grid.GetNumberOfCells());
+  for (dax::Id cellIndex = 0; cellIndex < grid.GetNumberOfCells(); cellIndex++)
+    {
+    inValues[cellIndex] = cellIndex + 7;
+    }
+  dax::cont::ArrayHandle<dax::Id> inField =
+      dax::cont::make_ArrayHandle(inValues);
+  dax::cont::ArrayHandle<dax::Id> outField;
+
+  typedef dax::cont::GenerateTopology<TetrahedralizeWithCellField,
+                                      dax::cont::ArrayHandleConstantValue<dax::Id>
+                                      > GenerateT;
+  GenerateT generateTets(
+        GenerateT::ClassifyResultType(5,grid.GetNumberOfCells()));
+  generateTets.SetRemoveDuplicatePoints(false);
+
+  dax::cont::UnstructuredGrid<dax::CellTagTetrahedron> outGrid;
+  dax::cont::Scheduler<> scheduler;
+  scheduler.Invoke(generateTets,grid,outGrid,inField,outField);
+
+  DAX_TEST_ASSERT(outField.GetNumberOfValues() == outGrid.GetNumberOfCells(),
+                  "Output cell field has the wrong size.");
+  std::vector<dax::Id> outValues(outField.GetNumberOfValues());
+  outField.CopyInto(outValues.begin());
+  for (dax::Id cellIndex = 0; cellIndex < outGrid.GetNumberOfCells(); cellIndex++)
+    {
+    DAX_TEST_ASSERT(outValues[cellIndex]
+                    == 10*inValues[cellIndex/5] + cellIndex%5,
+                    "Output cell field not written at the output cell.");
+    }
+
+  std::cout << "Input cell field shorter than the grid" << std::endl;
+  inValues.pop_back();
+  dax::cont::ArrayHandle<dax::Id> shortInField =
+      dax::cont::make_ArrayHandle(inValues);
+  dax::cont::UnstructuredGrid<dax::CellTagTetrahedron> shortOutGrid;
+  bool gotError = false;
+  try
+    {
+    scheduler.Invoke(generateTets,grid,shortOutGrid,shortInField,outField);
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+    }
+  DAX_TEST_ASSERT(gotError, "A short input cell field was not rejected.");
+  }
+
 //-----------------------------------------------------------------------------
 void TestTetrahedralize()
   {
+  TestMatchesTetrahedralizedUniformGrid();
+  TestUnstructuredVoxels();
+  TestCellFields();
+
   // TODO: We should support more tetrahedralization than voxels, and we should
   // test that, too.
   dax::cont::internal::GridTesting::TryAllGridTypes(
@@ -23,6 +23,7 @@
 #include <dax/worklet/Threshold.h>
 
 #include <math.h>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -145,8 +146,37 @@ struct TestThresholdWorklet
     dax::cont::ArrayHandle<dax::Scalar> fieldHandle =
         dax::cont::make_ArrayHandle(field);
 
+    std::vector<dax::Id> pointIds(inGrid.GetNumberOfPoints());
+    for (dax::Id pointIndex = 0;
+         pointIndex < inGrid.GetNumberOfPoints();
+         pointIndex++)
+      {
+      pointIds[pointIndex] = pointIndex;
+      }
+    dax::cont::ArrayHandle<dax::Id> pointIdsHandle =
+        dax::cont::make_ArrayHandle(pointIds);
+
+    std::vector<dax::Id> cellIds(inGrid.GetNumberOfCells());
+    std::vector<dax::Scalar> cellField(inGrid.GetNumberOfCells());
+    for (dax::Id cellIndex = 0;
+         cellIndex < inGrid.GetNumberOfCells();
+         cellIndex++)
+      {
+      cellIds[cellIndex] = cellIndex;
+      cellField[cellIndex] = static_cast<dax::Scalar>(2*cellIndex);
+      }
+    dax::cont::ArrayHandle<dax::Id> cellIdsHandle =
+        dax::cont::make_ArrayHandle(cellIds);
+    dax::cont::ArrayHandle<dax::Scalar> cellFieldHandle =
+        dax::cont::make_ArrayHandle(cellField);
+
     //unkown size
     dax::cont::ArrayHandle<dax::Scalar> resultHandle;
+    dax::cont::ArrayHandle<dax::Scalar> batchResultHandle;
+    dax::cont::ArrayHandle<dax::Id> resultPointIdsHandle;
+    dax::cont::ArrayHandle<dax::Id> resultCellIdsHandle;
+    dax::cont::ArrayHandle<dax::Scalar> resultCellFieldHandle;
+    std::vector<dax::ConnectivityId> classifyValues;
 
     std::cout << "Running Threshold worklet" << std::endl;
     dax::Scalar min = MIN_THRESHOLD;
@@ -163,6 +193,10 @@ struct TestThresholdWorklet
       scheduler.Invoke(ThresholdClassifyType(min,max),
                 inGrid, fieldHandle, classification);
 
+      //kept to check the cell fields, the generation releases it
+      classifyValues.resize(classification.GetNumberOfValues());
+      classification.CopyInto(classifyValues.begin());
+
       //construct the topology generation worklet
       ScheduleGT generateTopo(classification);
 
@@ -172,6 +206,15 @@ struct TestThresholdWorklet
 
       //request to also compact the topology
       generateTopo.CompactPointField(fieldHandle,resultHandle);
+
+      //compact several point and cell fields in one pass each
+      DAX_TEST_ASSERT(generateTopo.CompactPointFields(fieldHandle,
+                                                      batchResultHandle,
+                                                      pointIdsHandle,
+                                                      resultPointIdsHandle),
+                      "Point fields were not compacted");
+      generateTopo.CompactCellFields(cellIdsHandle, resultCellIdsHandle,
+                                     cellFieldHandle, resultCellFieldHandle);
       }
     catch (dax::cont::ErrorControl error)
       {
@@ -182,6 +225,85 @@ struct TestThresholdWorklet
     CheckValues(resultHandle);
     DAX_TEST_ASSERT(resultHandle.GetNumberOfValues()==outGrid.GetNumberOfPoints(),
                     "Incorrect number of points in the result array");
+
+    //the compacted points keep their coordinates and field values, and the
+    //renumbered connections only refer to them
+    std::vector<dax::Scalar> compactField(resultHandle.GetNumberOfValues());
+    resultHandle.CopyInto(compactField.begin());
+    for (dax::Id pointIndex = 0;
+         pointIndex < outGrid.GetNumberOfPoints();
+         pointIndex++)
+      {
+      DAX_TEST_ASSERT(test_equal(compactField[pointIndex],
+                                 dax::dot(outGrid.ComputePointCoordinates(
+                                            pointIndex),
+                                          trueGradient)),
+                      "Compacted point field does not match the points");
+      }
+
+    //the batch compaction gives the same values, and each point keeps the
+    //coordinates of the input point it came from
+    DAX_TEST_ASSERT(batchResultHandle.GetNumberOfValues()
+                    == outGrid.GetNumberOfPoints() &&
+                    resultPointIdsHandle.GetNumberOfValues()
+                    == outGrid.GetNumberOfPoints(),
+                    "Incorrect number of points in the batch result arrays");
+    std::vector<dax::Scalar> batchField(outGrid.GetNumberOfPoints());
+    batchResultHandle.CopyInto(batchField.begin());
+    std::vector<dax::Id> compactPointIds(outGrid.GetNumberOfPoints());
+    resultPointIdsHandle.CopyInto(compactPointIds.begin());
+    for (dax::Id pointIndex = 0;
+         pointIndex < outGrid.GetNumberOfPoints();
+         pointIndex++)
+      {
+      DAX_TEST_ASSERT(batchField[pointIndex] == compactField[pointIndex],
+                      "Batch compacted point field differs");
+      DAX_TEST_ASSERT(test_equal(outGrid.ComputePointCoordinates(pointIndex),
+                                 inGrid.ComputePointCoordinates(
+                                   compactPointIds[pointIndex])),
+                      "Compacted point ids do not match the points");
+      }
+
+    //every output cell takes the values of the input cell it came from,
+    //which is one that passed the threshold
+    DAX_TEST_ASSERT(resultCellIdsHandle.GetNumberOfValues()
+                    == outGrid.GetNumberOfCells() &&
+                    resultCellFieldHandle.GetNumberOfValues()
+                    == outGrid.GetNumberOfCells(),
+                    "Incorrect number of cells in the cell result arrays");
+    std::vector<dax::Id> compactCellIds(outGrid.GetNumberOfCells());
+    resultCellIdsHandle.CopyInto(compactCellIds.begin());
+    std::vector<dax::Scalar> compactCellField(outGrid.GetNumberOfCells());
+    resultCellFieldHandle.CopyInto(compactCellField.begin());
+    for (dax::Id cellIndex = 0;
+         cellIndex < outGrid.GetNumberOfCells();
+         cellIndex++)
+      {
+      const dax::Id inCell = compactCellIds[cellIndex];
+      DAX_TEST_ASSERT(inCell >= 0 && inCell < inGrid.GetNumberOfCells(),
+                      "Compacted cell id out of range");
+      DAX_TEST_ASSERT(cellIndex == 0 || compactCellIds[cellIndex-1] < inCell,
+                      "Compacted cell ids out of order");
+      DAX_TEST_ASSERT(classifyValues[inCell] == 1,
+                      "Output cell came from a cell that was removed");
+      DAX_TEST_ASSERT(compactCellField[cellIndex] == cellField[inCell],
+                      "Compacted cell field does not match the cell ids");
+      }
+
+    std::vector<dax::ConnectivityId> connections(
+          outGrid.GetCellConnections().GetNumberOfValues());
+    outGrid.GetCellConnections().CopyInto(connections.begin());
+    std::vector<bool> usedPoints(outGrid.GetNumberOfPoints(), false);
+    for (std::size_t index = 0; index < connections.size(); index++)
+      {
+      DAX_TEST_ASSERT(connections[index] >= 0 &&
+                      connections[index] < outGrid.GetNumberOfPoints(),
+                      "Connections refer to a removed point");
+      usedPoints[connections[index]] = true;
+      }
+    DAX_TEST_ASSERT(std::find(usedPoints.begin(), usedPoints.end(), false)
+                    == usedPoints.end(),
+                    "An unused point was kept");
     }
 };
 